@@ -0,0 +1,77 @@
+﻿using BenchmarkDotNet.Attributes;
+using System;
+using System.Threading;
+
+namespace K4AdotNet.Benchmarks
+{
+    /// <summary>
+    /// Stress test of <see cref="ChildrenDisposer"/>: many children are registered and disposed concurrently from many threads.
+    /// Children are disposed in reverse order of registration, which was the worst case for search-based removal.
+    /// </summary>
+    [MemoryDiagnoser]
+    public class ChildrenDisposerBenchmarks
+    {
+        [Params(1_000, 10_000)]
+        public int ChildrenPerThread { get; set; }
+
+        [Params(1, 8)]
+        public int ThreadCount { get; set; }
+
+        [Benchmark]
+        public void RegisterAndDisposeChildren()
+        {
+            using var disposer = new ChildrenDisposer();
+            var threads = new Thread[ThreadCount];
+            for (var t = 0; t < threads.Length; t++)
+                threads[t] = new Thread(() => RegisterAndDisposeChildren(disposer, ChildrenPerThread));
+            foreach (var thread in threads)
+                thread.Start();
+            foreach (var thread in threads)
+                thread.Join();
+        }
+
+        [Benchmark]
+        public void RegisterChildrenAndDisposeParent()
+        {
+            var disposer = new ChildrenDisposer();
+            var threads = new Thread[ThreadCount];
+            for (var t = 0; t < threads.Length; t++)
+                threads[t] = new Thread(() => RegisterChildren(disposer, ChildrenPerThread));
+            foreach (var thread in threads)
+                thread.Start();
+            foreach (var thread in threads)
+                thread.Join();
+            disposer.Dispose();
+        }
+
+        private static void RegisterAndDisposeChildren(ChildrenDisposer disposer, int count)
+        {
+            var children = RegisterChildren(disposer, count);
+            for (var i = children.Length - 1; i >= 0; i--)
+                children[i].Dispose();
+        }
+
+        private static FakeChild[] RegisterChildren(ChildrenDisposer disposer, int count)
+        {
+            var children = new FakeChild[count];
+            for (var i = 0; i < children.Length; i++)
+                children[i] = disposer.Register(new FakeChild())!;
+            return children;
+        }
+
+        private sealed class FakeChild : IDisposablePlus
+        {
+            private int isDisposed;
+
+            public bool IsDisposed => isDisposed != 0;
+
+            public event EventHandler? Disposed;
+
+            public void Dispose()
+            {
+                if (Interlocked.Exchange(ref isDisposed, 1) == 0)
+                    Disposed?.Invoke(this, EventArgs.Empty);
+            }
+        }
+    }
+}
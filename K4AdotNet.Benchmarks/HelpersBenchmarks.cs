@@ -0,0 +1,80 @@
+﻿using BenchmarkDotNet.Attributes;
+using System;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Benchmarks
+{
+    /// <summary>
+    /// Cost of reading of variable-length values (serial numbers, tags, codec IDs, attachments)
+    /// by <see cref="Helpers.TryGetValueInByteBuffer{T}(Helpers.GetInByteBufferMethod{T}, T, out byte[])"/>.
+    /// </summary>
+    /// <remarks>
+    /// Native getter is emulated by managed method with the same contract:
+    /// if buffer is too small, it returns <see cref="NativeCallResults.BufferResult.TooSmall"/> and required size.
+    /// Thus, numbers show overhead of the helper itself: number of calls, temporary buffers and copying.
+    /// </remarks>
+    [MemoryDiagnoser]
+    public class HelpersBenchmarks
+    {
+        private readonly Helpers.GetInByteBufferMethod<byte[]> getMethod = GetValue;
+        private byte[] value = Array.Empty<byte>();
+
+        // 14 bytes ~ serial number, 64 bytes ~ tag value, 4 KB ~ codec context or attachment
+        [Params(14, 64, 4096)]
+        public int ValueSize { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            value = new byte[ValueSize];
+            new Random(ValueSize).NextBytes(value);
+        }
+
+        [Benchmark(Baseline = true)]
+        public int TryGetValueInByteBufferClassic()
+            => TryGetValueInByteBufferClassic(getMethod, value, out var result) ? result!.Length : -1;
+
+        [Benchmark]
+        public int TryGetValueInByteBuffer()
+            => Helpers.TryGetValueInByteBuffer(getMethod, value, out var result) ? result.Length : -1;
+
+        private static NativeCallResults.BufferResult GetValue(byte[] value, IntPtr buffer, ref UIntPtr size)
+        {
+            var available = Helpers.UIntPtrToInt32(size);
+            size = Helpers.Int32ToUIntPtr(value.Length);
+            if (buffer == IntPtr.Zero || available < value.Length)
+                return NativeCallResults.BufferResult.TooSmall;
+            Marshal.Copy(value, 0, buffer, value.Length);
+            return NativeCallResults.BufferResult.Succeeded;
+        }
+
+        // Implementation of Helpers.TryGetValueInByteBuffer as it was before: request of size, then reading to temporary unmanaged buffer
+        private static bool TryGetValueInByteBufferClassic<T>(Helpers.GetInByteBufferMethod<T> getMethod, T parameter, out byte[]? result)
+        {
+            var bufferSize = UIntPtr.Zero;
+            var res = getMethod(parameter, IntPtr.Zero, ref bufferSize);
+            if (res == NativeCallResults.BufferResult.TooSmall)
+            {
+                var size = Helpers.UIntPtrToInt32(bufferSize);
+                var buffer = Marshal.AllocHGlobal(size);
+                try
+                {
+                    res = getMethod(parameter, buffer, ref bufferSize);
+                    if (res == NativeCallResults.BufferResult.Succeeded)
+                    {
+                        result = new byte[Helpers.UIntPtrToInt32(bufferSize)];
+                        Marshal.Copy(buffer, result, 0, result.Length);
+                        return true;
+                    }
+                }
+                finally
+                {
+                    Marshal.FreeHGlobal(buffer);
+                }
+            }
+
+            result = null;
+            return false;
+        }
+    }
+}
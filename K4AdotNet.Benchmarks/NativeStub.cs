@@ -0,0 +1,67 @@
+﻿using System;
+using System.IO;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Benchmarks
+{
+    /// <summary>
+    /// Redirects loading of <see cref="Sdk.SENSOR_DLL_NAME"/> library to the stub from <c>NativeStub/k4a_stub.c</c>
+    /// if the real Sensor SDK is not available (typical case for CI machines without Azure Kinect SDK installed).
+    /// </summary>
+    /// <remarks><para>
+    /// Set environment variable <see cref="UseStubEnvironmentVariable"/> to <c>1</c> to use the stub even if the real SDK is available:
+    /// this gives numbers that do not depend on SDK version and that can be compared between releases of K4AdotNet.
+    /// </para><para>
+    /// BenchmarkDotNet runs benchmarks in child processes. Path to the stub is passed to them
+    /// via <see cref="StubPathEnvironmentVariable"/> environment variable which is inherited by child processes.
+    /// </para></remarks>
+    internal static class NativeStub
+    {
+        public const string UseStubEnvironmentVariable = "K4ADOTNET_BENCHMARKS_USE_STUB";
+        public const string StubPathEnvironmentVariable = "K4ADOTNET_BENCHMARKS_STUB_PATH";
+
+        private static readonly string stubFileName = OperatingSystem.IsWindows() ? "k4a_stub.dll" : "libk4a_stub.so";
+
+        /// <summary>Is stub used instead of the real Sensor SDK in the current process?</summary>
+        public static bool IsUsed { get; private set; }
+
+        [ModuleInitializer]
+        internal static void Initialize()
+        {
+            var stubPath = Environment.GetEnvironmentVariable(StubPathEnvironmentVariable);
+            if (string.IsNullOrEmpty(stubPath))
+            {
+                stubPath = Path.Combine(AppContext.BaseDirectory, stubFileName);
+                Environment.SetEnvironmentVariable(StubPathEnvironmentVariable, stubPath);
+            }
+
+            // Both K4AdotNet and this assembly (see InteropBenchmarks) import functions from Sensor SDK
+            NativeLibrary.SetDllImportResolver(typeof(Sdk).Assembly, Resolve);
+            NativeLibrary.SetDllImportResolver(typeof(NativeStub).Assembly, Resolve);
+        }
+
+        private static IntPtr Resolve(string libraryName, Assembly assembly, DllImportSearchPath? searchPath)
+        {
+            if (libraryName != Sdk.SENSOR_DLL_NAME)
+                return IntPtr.Zero;
+
+            if (Environment.GetEnvironmentVariable(UseStubEnvironmentVariable) != "1"
+                && NativeLibrary.TryLoad(libraryName, assembly, searchPath, out var handle))
+            {
+                return handle;
+            }
+
+            var stubPath = Environment.GetEnvironmentVariable(StubPathEnvironmentVariable);
+            if (!string.IsNullOrEmpty(stubPath) && NativeLibrary.TryLoad(stubPath, out handle))
+            {
+                IsUsed = true;
+                return handle;
+            }
+
+            // Default probing: will fail with the standard DllNotFoundException
+            return IntPtr.Zero;
+        }
+    }
+}
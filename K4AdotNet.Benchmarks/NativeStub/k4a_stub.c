@@ -0,0 +1,593 @@
+/*
+ * Minimal stub of Azure Kinect Sensor SDK (k4a) library for running benchmarks without the real SDK.
+ *
+ * Implements only that part of k4a API which is used by benchmarks: images, captures, memory allocator,
+ * calibration conversions (ideal pin-hole model without distortions) and transformation objects.
+ * Transformation functions validate arguments but do not touch output images:
+ * benchmarks on stub measure overhead of the wrapper, not performance of the SDK.
+ *
+ * Functions that require a real device (k4a_device_*) report that there are no devices.
+ *
+ * Build (Linux):
+ *   cc -shared -fPIC -O2 -I../../externals/k4a/include -o libk4a_stub.so k4a_stub.c
+ * Normally, it is built automatically by K4AdotNet.Benchmarks project on Linux.
+ */
+
+#if defined(_WIN32)
+#  define K4A_EXPORT __declspec(dllexport)
+#else
+#  define K4A_EXPORT __attribute__((visibility("default")))
+#endif
+#define K4A_DEPRECATED
+
+#include <k4a/k4a.h>
+#include <stdlib.h>
+
+typedef struct
+{
+    int ref_count;
+    k4a_image_format_t format;
+    int width_pixels;
+    int height_pixels;
+    int stride_bytes;
+    size_t size;
+    uint8_t *buffer;
+    k4a_memory_destroy_cb_t *buffer_release_cb;
+    void *buffer_release_cb_context;
+    uint64_t device_timestamp_usec;
+    uint64_t system_timestamp_nsec;
+    uint64_t exposure_usec;
+    uint32_t white_balance;
+    uint32_t iso_speed;
+} stub_image_t;
+
+typedef struct
+{
+    int ref_count;
+    stub_image_t *color;
+    stub_image_t *depth;
+    stub_image_t *ir;
+    float temperature_c;
+} stub_capture_t;
+
+typedef struct
+{
+    k4a_calibration_t calibration;
+} stub_transformation_t;
+
+static k4a_memory_allocate_cb_t *g_allocate_cb = NULL;
+static k4a_memory_destroy_cb_t *g_destroy_cb = NULL;
+
+static int add_ref(int *ref_count, int delta)
+{
+    return __atomic_add_fetch(ref_count, delta, __ATOMIC_ACQ_REL);
+}
+
+/* ---------------------------------------------------------------- Global settings */
+
+K4A_EXPORT k4a_result_t k4a_set_debug_message_handler(k4a_logging_message_cb_t *message_cb,
+                                                      void *message_cb_context,
+                                                      k4a_log_level_t min_level)
+{
+    (void)message_cb;
+    (void)message_cb_context;
+    (void)min_level;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+K4A_EXPORT k4a_result_t k4a_set_allocator(k4a_memory_allocate_cb_t allocate, k4a_memory_destroy_cb_t free)
+{
+    if ((allocate == NULL) != (free == NULL))
+        return K4A_RESULT_FAILED;
+    g_allocate_cb = allocate;
+    g_destroy_cb = free;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+/* ---------------------------------------------------------------- Devices (there are no devices) */
+
+K4A_EXPORT uint32_t k4a_device_get_installed_count(void)
+{
+    return 0;
+}
+
+K4A_EXPORT k4a_result_t k4a_device_open(uint32_t index, k4a_device_t *device_handle)
+{
+    (void)index;
+    if (device_handle != NULL)
+        *device_handle = NULL;
+    return K4A_RESULT_FAILED;
+}
+
+/* ---------------------------------------------------------------- Images */
+
+static int get_bytes_per_pixel(k4a_image_format_t format)
+{
+    switch (format)
+    {
+    case K4A_IMAGE_FORMAT_COLOR_BGRA32:
+        return 4;
+    case K4A_IMAGE_FORMAT_COLOR_YUY2:
+    case K4A_IMAGE_FORMAT_DEPTH16:
+    case K4A_IMAGE_FORMAT_IR16:
+    case K4A_IMAGE_FORMAT_CUSTOM16:
+        return 2;
+    case K4A_IMAGE_FORMAT_COLOR_NV12:
+    case K4A_IMAGE_FORMAT_CUSTOM8:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static size_t get_image_size(k4a_image_format_t format, int stride_bytes, int height_pixels)
+{
+    size_t size = (size_t)stride_bytes * (size_t)height_pixels;
+    return format == K4A_IMAGE_FORMAT_COLOR_NV12 ? size * 3 / 2 : size;
+}
+
+static stub_image_t *new_image(k4a_image_format_t format, int width_pixels, int height_pixels, int stride_bytes)
+{
+    stub_image_t *image = (stub_image_t *)calloc(1, sizeof(stub_image_t));
+    if (image == NULL)
+        return NULL;
+    image->ref_count = 1;
+    image->format = format;
+    image->width_pixels = width_pixels;
+    image->height_pixels = height_pixels;
+    image->stride_bytes = stride_bytes;
+    return image;
+}
+
+static void free_image_buffer(void *buffer, void *context)
+{
+    (void)context;
+    free(buffer);
+}
+
+K4A_EXPORT k4a_result_t k4a_image_create(k4a_image_format_t format,
+                                         int width_pixels,
+                                         int height_pixels,
+                                         int stride_bytes,
+                                         k4a_image_t *image_handle)
+{
+    if (image_handle == NULL || width_pixels <= 0 || height_pixels <= 0 || stride_bytes < 0)
+        return K4A_RESULT_FAILED;
+    *image_handle = NULL;
+
+    if (stride_bytes == 0)
+        stride_bytes = width_pixels * get_bytes_per_pixel(format);
+    if (stride_bytes == 0)
+        return K4A_RESULT_FAILED;
+
+    stub_image_t *image = new_image(format, width_pixels, height_pixels, stride_bytes);
+    if (image == NULL)
+        return K4A_RESULT_FAILED;
+
+    image->size = get_image_size(format, stride_bytes, height_pixels);
+    if (g_allocate_cb != NULL)
+    {
+        image->buffer = g_allocate_cb((int)image->size, &image->buffer_release_cb_context);
+        image->buffer_release_cb = g_destroy_cb;
+    }
+    else
+    {
+        image->buffer = (uint8_t *)malloc(image->size);
+        image->buffer_release_cb = free_image_buffer;
+    }
+
+    if (image->buffer == NULL)
+    {
+        free(image);
+        return K4A_RESULT_FAILED;
+    }
+
+    *image_handle = (k4a_image_t)image;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+K4A_EXPORT k4a_result_t k4a_image_create_from_buffer(k4a_image_format_t format,
+                                                     int width_pixels,
+                                                     int height_pixels,
+                                                     int stride_bytes,
+                                                     uint8_t *buffer,
+                                                     size_t buffer_size,
+                                                     k4a_memory_destroy_cb_t *buffer_release_cb,
+                                                     void *buffer_release_cb_context,
+                                                     k4a_image_t *image_handle)
+{
+    if (image_handle == NULL || buffer == NULL || width_pixels <= 0 || height_pixels <= 0 || stride_bytes < 0)
+        return K4A_RESULT_FAILED;
+    *image_handle = NULL;
+
+    stub_image_t *image = new_image(format, width_pixels, height_pixels, stride_bytes);
+    if (image == NULL)
+        return K4A_RESULT_FAILED;
+
+    image->buffer = buffer;
+    image->size = buffer_size;
+    image->buffer_release_cb = buffer_release_cb;
+    image->buffer_release_cb_context = buffer_release_cb_context;
+
+    *image_handle = (k4a_image_t)image;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+K4A_EXPORT void k4a_image_reference(k4a_image_t image_handle)
+{
+    if (image_handle != NULL)
+        add_ref(&((stub_image_t *)image_handle)->ref_count, 1);
+}
+
+K4A_EXPORT void k4a_image_release(k4a_image_t image_handle)
+{
+    stub_image_t *image = (stub_image_t *)image_handle;
+    if (image == NULL || add_ref(&image->ref_count, -1) != 0)
+        return;
+    if (image->buffer_release_cb != NULL)
+        image->buffer_release_cb(image->buffer, image->buffer_release_cb_context);
+    free(image);
+}
+
+#define IMAGE_GETTER(type, name, field)                                                                                \
+    K4A_EXPORT type k4a_image_get_##name(k4a_image_t image_handle)                                                     \
+    {                                                                                                                  \
+        return image_handle != NULL ? ((stub_image_t *)image_handle)->field : 0;                                       \
+    }
+
+#define IMAGE_SETTER(type, name, field)                                                                                \
+    K4A_EXPORT void k4a_image_set_##name(k4a_image_t image_handle, type value)                                         \
+    {                                                                                                                  \
+        if (image_handle != NULL)                                                                                      \
+            ((stub_image_t *)image_handle)->field = value;                                                             \
+    }
+
+IMAGE_GETTER(uint8_t *, buffer, buffer)
+IMAGE_GETTER(size_t, size, size)
+IMAGE_GETTER(k4a_image_format_t, format, format)
+IMAGE_GETTER(int, width_pixels, width_pixels)
+IMAGE_GETTER(int, height_pixels, height_pixels)
+IMAGE_GETTER(int, stride_bytes, stride_bytes)
+IMAGE_GETTER(uint64_t, device_timestamp_usec, device_timestamp_usec)
+IMAGE_GETTER(uint64_t, system_timestamp_nsec, system_timestamp_nsec)
+IMAGE_GETTER(uint64_t, exposure_usec, exposure_usec)
+IMAGE_GETTER(uint32_t, white_balance, white_balance)
+IMAGE_GETTER(uint32_t, iso_speed, iso_speed)
+
+IMAGE_SETTER(uint64_t, device_timestamp_usec, device_timestamp_usec)
+IMAGE_SETTER(uint64_t, system_timestamp_nsec, system_timestamp_nsec)
+IMAGE_SETTER(uint64_t, exposure_usec, exposure_usec)
+IMAGE_SETTER(uint32_t, white_balance, white_balance)
+IMAGE_SETTER(uint32_t, iso_speed, iso_speed)
+
+/* ---------------------------------------------------------------- Captures */
+
+K4A_EXPORT k4a_result_t k4a_capture_create(k4a_capture_t *capture_handle)
+{
+    if (capture_handle == NULL)
+        return K4A_RESULT_FAILED;
+    stub_capture_t *capture = (stub_capture_t *)calloc(1, sizeof(stub_capture_t));
+    if (capture == NULL)
+        return K4A_RESULT_FAILED;
+    capture->ref_count = 1;
+    *capture_handle = (k4a_capture_t)capture;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+K4A_EXPORT void k4a_capture_reference(k4a_capture_t capture_handle)
+{
+    if (capture_handle != NULL)
+        add_ref(&((stub_capture_t *)capture_handle)->ref_count, 1);
+}
+
+K4A_EXPORT void k4a_capture_release(k4a_capture_t capture_handle)
+{
+    stub_capture_t *capture = (stub_capture_t *)capture_handle;
+    if (capture == NULL || add_ref(&capture->ref_count, -1) != 0)
+        return;
+    k4a_image_release((k4a_image_t)capture->color);
+    k4a_image_release((k4a_image_t)capture->depth);
+    k4a_image_release((k4a_image_t)capture->ir);
+    free(capture);
+}
+
+static k4a_image_t get_capture_image(stub_image_t *image)
+{
+    k4a_image_reference((k4a_image_t)image);
+    return (k4a_image_t)image;
+}
+
+static void set_capture_image(stub_image_t **slot, k4a_image_t image_handle)
+{
+    k4a_image_reference(image_handle);
+    k4a_image_release((k4a_image_t)*slot);
+    *slot = (stub_image_t *)image_handle;
+}
+
+K4A_EXPORT k4a_image_t k4a_capture_get_color_image(k4a_capture_t capture_handle)
+{
+    return capture_handle != NULL ? get_capture_image(((stub_capture_t *)capture_handle)->color) : NULL;
+}
+
+K4A_EXPORT k4a_image_t k4a_capture_get_depth_image(k4a_capture_t capture_handle)
+{
+    return capture_handle != NULL ? get_capture_image(((stub_capture_t *)capture_handle)->depth) : NULL;
+}
+
+K4A_EXPORT k4a_image_t k4a_capture_get_ir_image(k4a_capture_t capture_handle)
+{
+    return capture_handle != NULL ? get_capture_image(((stub_capture_t *)capture_handle)->ir) : NULL;
+}
+
+K4A_EXPORT void k4a_capture_set_color_image(k4a_capture_t capture_handle, k4a_image_t image_handle)
+{
+    if (capture_handle != NULL)
+        set_capture_image(&((stub_capture_t *)capture_handle)->color, image_handle);
+}
+
+K4A_EXPORT void k4a_capture_set_depth_image(k4a_capture_t capture_handle, k4a_image_t image_handle)
+{
+    if (capture_handle != NULL)
+        set_capture_image(&((stub_capture_t *)capture_handle)->depth, image_handle);
+}
+
+K4A_EXPORT void k4a_capture_set_ir_image(k4a_capture_t capture_handle, k4a_image_t image_handle)
+{
+    if (capture_handle != NULL)
+        set_capture_image(&((stub_capture_t *)capture_handle)->ir, image_handle);
+}
+
+K4A_EXPORT void k4a_capture_set_temperature_c(k4a_capture_t capture_handle, float temperature_c)
+{
+    if (capture_handle != NULL)
+        ((stub_capture_t *)capture_handle)->temperature_c = temperature_c;
+}
+
+K4A_EXPORT float k4a_capture_get_temperature_c(k4a_capture_t capture_handle)
+{
+    return capture_handle != NULL ? ((stub_capture_t *)capture_handle)->temperature_c : 0.0f;
+}
+
+/* ---------------------------------------------------------------- Calibration (ideal pin-hole cameras) */
+
+static const k4a_calibration_camera_t *get_camera(const k4a_calibration_t *calibration, k4a_calibration_type_t camera)
+{
+    switch (camera)
+    {
+    case K4A_CALIBRATION_TYPE_DEPTH:
+        return &calibration->depth_camera_calibration;
+    case K4A_CALIBRATION_TYPE_COLOR:
+        return &calibration->color_camera_calibration;
+    default:
+        return NULL;
+    }
+}
+
+static int is_valid_geometry(k4a_calibration_type_t geometry)
+{
+    return geometry >= K4A_CALIBRATION_TYPE_DEPTH && geometry < K4A_CALIBRATION_TYPE_NUM;
+}
+
+static void transform_3d(const k4a_calibration_t *calibration,
+                         const k4a_float3_t *source,
+                         k4a_calibration_type_t source_type,
+                         k4a_calibration_type_t target_type,
+                         k4a_float3_t *target)
+{
+    if (source_type == target_type)
+    {
+        *target = *source;
+        return;
+    }
+
+    const k4a_calibration_extrinsics_t *e = &calibration->extrinsics[source_type][target_type];
+    const float *r = e->rotation;
+    const float *s = source->v;
+    k4a_float3_t result;
+    result.xyz.x = r[0] * s[0] + r[1] * s[1] + r[2] * s[2] + e->translation[0];
+    result.xyz.y = r[3] * s[0] + r[4] * s[1] + r[5] * s[2] + e->translation[1];
+    result.xyz.z = r[6] * s[0] + r[7] * s[1] + r[8] * s[2] + e->translation[2];
+    *target = result;
+}
+
+static int unproject(const k4a_calibration_camera_t *camera, const k4a_float2_t *point2d, float depth, k4a_float3_t *point3d)
+{
+    const struct _param *p = &camera->intrinsics.parameters.param;
+    if (p->fx == 0.0f || p->fy == 0.0f || depth <= 0.0f)
+        return 0;
+    point3d->xyz.x = (point2d->xy.x - p->cx) / p->fx * depth;
+    point3d->xyz.y = (point2d->xy.y - p->cy) / p->fy * depth;
+    point3d->xyz.z = depth;
+    return 1;
+}
+
+static int project(const k4a_calibration_camera_t *camera, const k4a_float3_t *point3d, k4a_float2_t *point2d)
+{
+    const struct _param *p = &camera->intrinsics.parameters.param;
+    if (point3d->xyz.z <= 0.0f)
+        return 0;
+    point2d->xy.x = point3d->xyz.x / point3d->xyz.z * p->fx + p->cx;
+    point2d->xy.y = point3d->xyz.y / point3d->xyz.z * p->fy + p->cy;
+    return point2d->xy.x >= -0.5f && point2d->xy.y >= -0.5f && point2d->xy.x < camera->resolution_width - 0.5f &&
+           point2d->xy.y < camera->resolution_height - 0.5f;
+}
+
+K4A_EXPORT k4a_result_t k4a_calibration_get_from_raw(char *raw_calibration,
+                                                     size_t raw_calibration_size,
+                                                     const k4a_depth_mode_t depth_mode,
+                                                     const k4a_color_resolution_t color_resolution,
+                                                     k4a_calibration_t *calibration)
+{
+    (void)raw_calibration;
+    (void)raw_calibration_size;
+    (void)depth_mode;
+    (void)color_resolution;
+    (void)calibration;
+    return K4A_RESULT_FAILED;
+}
+
+K4A_EXPORT k4a_result_t k4a_calibration_3d_to_3d(const k4a_calibration_t *calibration,
+                                                 const k4a_float3_t *source_point3d_mm,
+                                                 const k4a_calibration_type_t source_camera,
+                                                 const k4a_calibration_type_t target_camera,
+                                                 k4a_float3_t *target_point3d_mm)
+{
+    if (calibration == NULL || source_point3d_mm == NULL || target_point3d_mm == NULL ||
+        !is_valid_geometry(source_camera) || !is_valid_geometry(target_camera))
+        return K4A_RESULT_FAILED;
+    transform_3d(calibration, source_point3d_mm, source_camera, target_camera, target_point3d_mm);
+    return K4A_RESULT_SUCCEEDED;
+}
+
+K4A_EXPORT k4a_result_t k4a_calibration_2d_to_3d(const k4a_calibration_t *calibration,
+                                                 const k4a_float2_t *source_point2d,
+                                                 const float source_depth_mm,
+                                                 const k4a_calibration_type_t source_camera,
+                                                 const k4a_calibration_type_t target_camera,
+                                                 k4a_float3_t *target_point3d_mm,
+                                                 int *valid)
+{
+    const k4a_calibration_camera_t *camera = calibration != NULL ? get_camera(calibration, source_camera) : NULL;
+    if (camera == NULL || source_point2d == NULL || target_point3d_mm == NULL || valid == NULL ||
+        !is_valid_geometry(target_camera))
+        return K4A_RESULT_FAILED;
+
+    k4a_float3_t point3d;
+    *valid = unproject(camera, source_point2d, source_depth_mm, &point3d);
+    if (*valid)
+        transform_3d(calibration, &point3d, source_camera, target_camera, target_point3d_mm);
+    return K4A_RESULT_SUCCEEDED;
+}
+
+K4A_EXPORT k4a_result_t k4a_calibration_3d_to_2d(const k4a_calibration_t *calibration,
+                                                 const k4a_float3_t *source_point3d_mm,
+                                                 const k4a_calibration_type_t source_camera,
+                                                 const k4a_calibration_type_t target_camera,
+                                                 k4a_float2_t *target_point2d,
+                                                 int *valid)
+{
+    const k4a_calibration_camera_t *camera = calibration != NULL ? get_camera(calibration, target_camera) : NULL;
+    if (camera == NULL || source_point3d_mm == NULL || target_point2d == NULL || valid == NULL ||
+        !is_valid_geometry(source_camera))
+        return K4A_RESULT_FAILED;
+
+    k4a_float3_t point3d;
+    transform_3d(calibration, source_point3d_mm, source_camera, target_camera, &point3d);
+    *valid = project(camera, &point3d, target_point2d);
+    return K4A_RESULT_SUCCEEDED;
+}
+
+K4A_EXPORT k4a_result_t k4a_calibration_2d_to_2d(const k4a_calibration_t *calibration,
+                                                 const k4a_float2_t *source_point2d,
+                                                 const float source_depth_mm,
+                                                 const k4a_calibration_type_t source_camera,
+                                                 const k4a_calibration_type_t target_camera,
+                                                 k4a_float2_t *target_point2d,
+                                                 int *valid)
+{
+    k4a_float3_t point3d;
+    k4a_result_t result = k4a_calibration_2d_to_3d(
+        calibration, source_point2d, source_depth_mm, source_camera, target_camera, &point3d, valid);
+    if (result != K4A_RESULT_SUCCEEDED || !*valid)
+        return result;
+    return k4a_calibration_3d_to_2d(calibration, &point3d, target_camera, target_camera, target_point2d, valid);
+}
+
+K4A_EXPORT k4a_result_t k4a_calibration_color_2d_to_depth_2d(const k4a_calibration_t *calibration,
+                                                             const k4a_float2_t *source_point2d,
+                                                             const k4a_image_t depth_image,
+                                                             k4a_float2_t *target_point2d,
+                                                             int *valid)
+{
+    const stub_image_t *depth = (const stub_image_t *)depth_image;
+    if (calibration == NULL || source_point2d == NULL || depth == NULL || target_point2d == NULL || valid == NULL)
+        return K4A_RESULT_FAILED;
+
+    /* Unlike the real SDK, there is no search along epipolar line: depth of the central pixel is used */
+    const uint16_t *pixels = (const uint16_t *)depth->buffer;
+    int center = (depth->height_pixels / 2) * (depth->stride_bytes / 2) + depth->width_pixels / 2;
+    return k4a_calibration_2d_to_2d(calibration, source_point2d, (float)pixels[center],
+                                    K4A_CALIBRATION_TYPE_COLOR, K4A_CALIBRATION_TYPE_DEPTH, target_point2d, valid);
+}
+
+/* ---------------------------------------------------------------- Transformation (arguments are checked, images are not touched) */
+
+K4A_EXPORT k4a_transformation_t k4a_transformation_create(const k4a_calibration_t *calibration)
+{
+    if (calibration == NULL)
+        return NULL;
+    stub_transformation_t *transformation = (stub_transformation_t *)malloc(sizeof(stub_transformation_t));
+    if (transformation != NULL)
+        transformation->calibration = *calibration;
+    return (k4a_transformation_t)transformation;
+}
+
+K4A_EXPORT void k4a_transformation_destroy(k4a_transformation_t transformation_handle)
+{
+    free(transformation_handle);
+}
+
+static int check_image(k4a_image_t image_handle, k4a_image_format_t format, const k4a_calibration_camera_t *camera)
+{
+    const stub_image_t *image = (const stub_image_t *)image_handle;
+    return image != NULL && image->format == format && image->width_pixels == camera->resolution_width &&
+           image->height_pixels == camera->resolution_height;
+}
+
+K4A_EXPORT k4a_result_t k4a_transformation_depth_image_to_color_camera(k4a_transformation_t transformation_handle,
+                                                                       const k4a_image_t depth_image,
+                                                                       k4a_image_t transformed_depth_image)
+{
+    const stub_transformation_t *t = (const stub_transformation_t *)transformation_handle;
+    if (t == NULL ||
+        !check_image(depth_image, K4A_IMAGE_FORMAT_DEPTH16, &t->calibration.depth_camera_calibration) ||
+        !check_image(transformed_depth_image, K4A_IMAGE_FORMAT_DEPTH16, &t->calibration.color_camera_calibration))
+        return K4A_RESULT_FAILED;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+K4A_EXPORT k4a_result_t k4a_transformation_depth_image_to_color_camera_custom(
+    k4a_transformation_t transformation_handle,
+    const k4a_image_t depth_image,
+    const k4a_image_t custom_image,
+    k4a_image_t transformed_depth_image,
+    k4a_image_t transformed_custom_image,
+    k4a_transformation_interpolation_type_t interpolation_type,
+    uint32_t invalid_custom_value)
+{
+    (void)interpolation_type;
+    (void)invalid_custom_value;
+    if (custom_image == NULL || transformed_custom_image == NULL)
+        return K4A_RESULT_FAILED;
+    return k4a_transformation_depth_image_to_color_camera(transformation_handle, depth_image, transformed_depth_image);
+}
+
+K4A_EXPORT k4a_result_t k4a_transformation_color_image_to_depth_camera(k4a_transformation_t transformation_handle,
+                                                                       const k4a_image_t depth_image,
+                                                                       const k4a_image_t color_image,
+                                                                       k4a_image_t transformed_color_image)
+{
+    const stub_transformation_t *t = (const stub_transformation_t *)transformation_handle;
+    if (t == NULL ||
+        !check_image(depth_image, K4A_IMAGE_FORMAT_DEPTH16, &t->calibration.depth_camera_calibration) ||
+        !check_image(color_image, K4A_IMAGE_FORMAT_COLOR_BGRA32, &t->calibration.color_camera_calibration) ||
+        !check_image(transformed_color_image, K4A_IMAGE_FORMAT_COLOR_BGRA32, &t->calibration.depth_camera_calibration))
+        return K4A_RESULT_FAILED;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+K4A_EXPORT k4a_result_t k4a_transformation_depth_image_to_point_cloud(k4a_transformation_t transformation_handle,
+                                                                      const k4a_image_t depth_image,
+                                                                      const k4a_calibration_type_t camera,
+                                                                      k4a_image_t xyz_image)
+{
+    const stub_transformation_t *t = (const stub_transformation_t *)transformation_handle;
+    const k4a_calibration_camera_t *c = t != NULL ? get_camera(&t->calibration, camera) : NULL;
+    const stub_image_t *depth = (const stub_image_t *)depth_image;
+    const stub_image_t *xyz = (const stub_image_t *)xyz_image;
+    if (c == NULL || !check_image(depth_image, K4A_IMAGE_FORMAT_DEPTH16, c) || xyz == NULL ||
+        xyz->format != K4A_IMAGE_FORMAT_CUSTOM || xyz->width_pixels != depth->width_pixels ||
+        xyz->height_pixels != depth->height_pixels)
+        return K4A_RESULT_FAILED;
+    return K4A_RESULT_SUCCEEDED;
+}
@@ -0,0 +1,25 @@
+﻿using BenchmarkDotNet.Configs;
+using BenchmarkDotNet.Exporters.Json;
+using BenchmarkDotNet.Running;
+using System;
+
+namespace K4AdotNet.Benchmarks
+{
+    internal static class Program
+    {
+        // Usage examples:
+        //   K4ABenchmarks --filter *
+        //   K4ABenchmarks --filter *ImageMetadata*
+        //   K4ADOTNET_BENCHMARKS_USE_STUB=1 K4ABenchmarks --filter * --artifacts ./results/1.4.17
+        // Results are exported to BenchmarkDotNet.Artifacts/results/*-report-full.json in addition to default exporters.
+        private static void Main(string[] args)
+        {
+            Console.WriteLine(Environment.GetEnvironmentVariable(NativeStub.UseStubEnvironmentVariable) == "1"
+                ? $"Native Sensor SDK: stub from {Environment.GetEnvironmentVariable(NativeStub.StubPathEnvironmentVariable)}"
+                : $"Native Sensor SDK: real SDK if available, otherwise stub from {Environment.GetEnvironmentVariable(NativeStub.StubPathEnvironmentVariable)}");
+
+            var config = DefaultConfig.Instance.AddExporter(JsonExporter.Full);
+            BenchmarkSwitcher.FromAssembly(typeof(Program).Assembly).Run(args, config);
+        }
+    }
+}
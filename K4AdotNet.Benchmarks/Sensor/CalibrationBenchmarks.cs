@@ -0,0 +1,138 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+using System;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Cost of per-point conversions of <see cref="Calibration"/> structure.
+    /// Each conversion marshals calibration data to native code, thus cost is dominated by the wrapper.
+    /// </summary>
+    /// <remarks>
+    /// Each benchmark converts <see cref="PointsPerInvoke"/> points of a regular grid,
+    /// so the reported time is time per one point.
+    /// </remarks>
+    [MemoryDiagnoser]
+    public class CalibrationBenchmarks
+    {
+        private const int GridSize = 16;
+        private const int PointsPerInvoke = GridSize * GridSize;
+        private const float DepthMm = 1500f;
+
+        private Calibration calibration;
+        private Float2[] depthPoints2D = Array.Empty<Float2>();
+        private Float3[] depthPoints3D = Array.Empty<Float3>();
+        private Float2[] colorPoints2D = Array.Empty<Float2>();
+        private float[] depthsMm = Array.Empty<float>();
+        private Float3[] resultPoints3D = Array.Empty<Float3>();
+        private Float2[] resultPoints2D = Array.Empty<Float2>();
+        private bool[] validFlags = Array.Empty<bool>();
+        private Image? depthImage;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, 30f, out calibration);
+
+            depthPoints2D = CreateGrid(calibration.DepthMode.WidthPixels(), calibration.DepthMode.HeightPixels());
+            colorPoints2D = CreateGrid(calibration.ColorResolution.WidthPixels(), calibration.ColorResolution.HeightPixels());
+            depthPoints3D = new Float3[depthPoints2D.Length];
+            for (var i = 0; i < depthPoints2D.Length; i++)
+                depthPoints3D[i] = calibration.Convert2DTo3D(depthPoints2D[i], DepthMm, CalibrationGeometry.Depth, CalibrationGeometry.Depth) ?? default;
+
+            depthsMm = new float[PointsPerInvoke];
+            Array.Fill(depthsMm, DepthMm);
+            resultPoints3D = new Float3[PointsPerInvoke];
+            resultPoints2D = new Float2[PointsPerInvoke];
+            validFlags = new bool[PointsPerInvoke];
+
+            depthImage = new Image(ImageFormat.Depth16, calibration.DepthMode.WidthPixels(), calibration.DepthMode.HeightPixels());
+            var depthPixels = new short[depthImage.SizeBytes / sizeof(short)];
+            Array.Fill(depthPixels, (short)DepthMm);
+            depthImage.FillFrom(depthPixels);
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+            => depthImage?.Dispose();
+
+        private static Float2[] CreateGrid(int widthPixels, int heightPixels)
+        {
+            var points = new Float2[PointsPerInvoke];
+            for (var y = 0; y < GridSize; y++)
+            {
+                for (var x = 0; x < GridSize; x++)
+                    points[y * GridSize + x] = new Float2((x + 0.5f) * widthPixels / GridSize, (y + 0.5f) * heightPixels / GridSize);
+            }
+            return points;
+        }
+
+        [Benchmark(OperationsPerInvoke = PointsPerInvoke)]
+        public float Convert2DTo3D()
+        {
+            var sum = 0f;
+            foreach (var point in depthPoints2D)
+                sum += calibration.Convert2DTo3D(point, DepthMm, CalibrationGeometry.Depth, CalibrationGeometry.Color)?.Z ?? 0f;
+            return sum;
+        }
+
+        // Managed batch version of Convert2DTo3D()
+        [Benchmark(OperationsPerInvoke = PointsPerInvoke)]
+        public int Convert2DTo3DBatch()
+            => calibration.Convert2DTo3D(depthPoints2D, depthsMm, CalibrationGeometry.Depth, CalibrationGeometry.Color, resultPoints3D, validFlags);
+
+        [Benchmark(OperationsPerInvoke = PointsPerInvoke)]
+        public float Convert3DTo2D()
+        {
+            var sum = 0f;
+            foreach (var point in depthPoints3D)
+                sum += calibration.Convert3DTo2D(point, CalibrationGeometry.Depth, CalibrationGeometry.Color)?.X ?? 0f;
+            return sum;
+        }
+
+        // Managed batch version of Convert3DTo2D()
+        [Benchmark(OperationsPerInvoke = PointsPerInvoke)]
+        public int Convert3DTo2DBatch()
+            => calibration.Convert3DTo2D(depthPoints3D, CalibrationGeometry.Depth, CalibrationGeometry.Color, resultPoints2D, validFlags);
+
+        [Benchmark(OperationsPerInvoke = PointsPerInvoke)]
+        public float Convert3DTo3D()
+        {
+            var sum = 0f;
+            foreach (var point in depthPoints3D)
+                sum += calibration.Convert3DTo3D(point, CalibrationGeometry.Depth, CalibrationGeometry.Color).Z;
+            return sum;
+        }
+
+        // Managed batch version of Convert3DTo3D()
+        [Benchmark(OperationsPerInvoke = PointsPerInvoke)]
+        public float Convert3DTo3DBatch()
+        {
+            calibration.Convert3DTo3D(depthPoints3D, CalibrationGeometry.Depth, CalibrationGeometry.Color, resultPoints3D);
+            return resultPoints3D[0].Z;
+        }
+
+        [Benchmark(OperationsPerInvoke = PointsPerInvoke)]
+        public float Convert2DTo2D()
+        {
+            var sum = 0f;
+            foreach (var point in depthPoints2D)
+                sum += calibration.Convert2DTo2D(point, DepthMm, CalibrationGeometry.Depth, CalibrationGeometry.Color)?.X ?? 0f;
+            return sum;
+        }
+
+        [Benchmark(OperationsPerInvoke = PointsPerInvoke)]
+        public float ConvertColor2DToDepth2D()
+        {
+            var sum = 0f;
+            foreach (var point in colorPoints2D)
+                sum += calibration.ConvertColor2DToDepth2D(point, depthImage!)?.X ?? 0f;
+            return sum;
+        }
+
+        // Conversion of calibration data to the form that can be passed to native code
+        [Benchmark]
+        public int ToBlittable()
+            => calibration.ToBlittable().DepthCameraCalibration.ResolutionWidth;
+    }
+}
@@ -0,0 +1,85 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Cost of access to child images of <see cref="Capture"/>:
+    /// each read of image property creates new <see cref="Image"/> object unless <see cref="Capture.CacheImages"/> is on.
+    /// </summary>
+    [MemoryDiagnoser]
+    public class CaptureBenchmarks
+    {
+        private Image? colorImage;
+        private Image? depthImage;
+        private Image? irImage;
+        private Capture? capture;
+
+        [Params(false, true)]
+        public bool CacheImages { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            colorImage = new Image(ImageFormat.ColorBgra32, 1280, 720);
+            depthImage = new Image(ImageFormat.Depth16, 640, 576);
+            irImage = new Image(ImageFormat.IR16, 640, 576);
+            capture = new Capture
+            {
+                ColorImage = colorImage,
+                DepthImage = depthImage,
+                IRImage = irImage,
+                CacheImages = CacheImages,
+            };
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            capture?.Dispose();
+            colorImage?.Dispose();
+            depthImage?.Dispose();
+            irImage?.Dispose();
+        }
+
+        // Typical frame processing: each image is read once
+        [Benchmark(Baseline = true)]
+        public int ReadAllImages()
+        {
+            using var color = capture!.ColorImage!;
+            using var depth = capture.DepthImage!;
+            using var ir = capture.IRImage!;
+            return color.WidthPixels + depth.WidthPixels + ir.WidthPixels;
+        }
+
+        // Several processing stages that read image properties independently
+        [Benchmark]
+        public int ReadDepthImageFourTimes()
+        {
+            var sum = 0;
+            for (var i = 0; i < 4; i++)
+            {
+                using var depth = capture!.DepthImage!;
+                sum += depth.HeightPixels;
+            }
+            return sum;
+        }
+
+        [Benchmark]
+        public float ReadTemperature()
+            => capture!.TemperatureC;
+
+        [Benchmark]
+        public int CreateFillAndDispose()
+        {
+            using var newCapture = new Capture
+            {
+                ColorImage = colorImage,
+                DepthImage = depthImage,
+                IRImage = irImage,
+                CacheImages = CacheImages,
+            };
+            return newCapture.IsDisposed ? 0 : 1;
+        }
+    }
+}
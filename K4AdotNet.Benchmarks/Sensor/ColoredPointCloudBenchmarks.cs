@@ -0,0 +1,84 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+using System;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Colored point cloud for WFOV unbinned depth (1024x1024) and 720p color: three separate passes
+    /// (color to depth, depth to point cloud, merging) versus fused <see cref="ManagedTransformation.DepthImageToColoredPointCloud(Image, Image, Span{ColoredPoint}, bool, bool, TransformationInterpolation)"/>.
+    /// </summary>
+    /// <remarks>
+    /// Depth image is filled by synthetic data with about 10% of invalid (zero) pixels.
+    /// All variants are managed, thus numbers are meaningful with the stub (see <see cref="NativeStub"/>) too.
+    /// </remarks>
+    [MemoryDiagnoser]
+    public class ColoredPointCloudBenchmarks
+    {
+        private Calibration calibration;
+        private ManagedTransformation? transformation;
+        private Image? depthImage;
+        private Image? colorImage;
+        private Image? transformedColorImage;
+        private Float3[] positions = Array.Empty<Float3>();
+        private BgraPixel[] colors = Array.Empty<BgraPixel>();
+        private ColoredPoint[] points = Array.Empty<ColoredPoint>();
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            Calibration.CreateDummy(DepthMode.WideViewUnbinned, ColorResolution.R720p, 30f, out calibration);
+            transformation = calibration.CreateManagedTransformation();
+
+            var width = calibration.DepthMode.WidthPixels();
+            var height = calibration.DepthMode.HeightPixels();
+            depthImage = new Image(ImageFormat.Depth16, width, height);
+            var depthPixels = new short[width * height];
+            for (var i = 0; i < depthPixels.Length; i++)
+                depthPixels[i] = (short)(i % 10 == 0 ? 0 : 500 + i % 4000);
+            depthImage.FillFrom(depthPixels);
+
+            colorImage = new Image(ImageFormat.ColorBgra32, calibration.ColorResolution.WidthPixels(), calibration.ColorResolution.HeightPixels());
+            transformedColorImage = new Image(ImageFormat.ColorBgra32, width, height);
+            positions = new Float3[width * height];
+            colors = new BgraPixel[width * height];
+            points = new ColoredPoint[width * height];
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            depthImage?.Dispose();
+            colorImage?.Dispose();
+            transformedColorImage?.Dispose();
+        }
+
+        [Benchmark(Baseline = true)]
+        public int ThreePasses()
+        {
+            transformation!.ColorImageToDepthCamera(depthImage!, colorImage!, transformedColorImage!);
+            calibration.DepthImageToPointCloud(depthImage!, CalibrationGeometry.Depth, positions);
+            var transformedColors = transformedColorImage!.GetSpan<BgraPixel>();
+            var count = 0;
+            for (var i = 0; i < positions.Length; i++)
+            {
+                if (positions[i].Z != 0)
+                    points[count++] = new ColoredPoint(positions[i], transformedColors[i]);
+            }
+
+            return count;
+        }
+
+        [Benchmark]
+        public int FusedInterleaved()
+            => transformation!.DepthImageToColoredPointCloud(depthImage!, colorImage!, points);
+
+        [Benchmark]
+        public int FusedSeparateBuffers()
+            => transformation!.DepthImageToColoredPointCloud(depthImage!, colorImage!, positions, colors);
+
+        [Benchmark]
+        public int FusedColoredPointsOnly()
+            => transformation!.DepthImageToColoredPointCloud(depthImage!, colorImage!, points, coloredPointsOnly: true);
+    }
+}
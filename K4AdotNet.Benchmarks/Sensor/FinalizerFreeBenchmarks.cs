@@ -0,0 +1,58 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Per-frame churn of wrapper objects: capture is created, filled with images, images are read back and everything is disposed.
+    /// Compares default mode (wrappers with finalizers) with <see cref="Sdk.FinalizerFreeMode"/>.
+    /// </summary>
+    /// <remarks>
+    /// Look at Gen0/Gen1 columns of memory diagnoser: they show number of collections per 1000 frames.
+    /// For long synthetic run use something like <c>K4ABenchmarks --filter *FinalizerFree* --job long</c>.
+    /// </remarks>
+    [MemoryDiagnoser]
+    public class FinalizerFreeBenchmarks
+    {
+        private Image? colorImage;
+        private Image? depthImage;
+        private Image? irImage;
+
+        [Params(false, true)]
+        public bool FinalizerFree { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            colorImage = new Image(ImageFormat.ColorBgra32, 1280, 720);
+            depthImage = new Image(ImageFormat.Depth16, 640, 576);
+            irImage = new Image(ImageFormat.IR16, 640, 576);
+            Sdk.FinalizerFreeMode = FinalizerFree;
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            Sdk.FinalizerFreeMode = false;
+            colorImage?.Dispose();
+            depthImage?.Dispose();
+            irImage?.Dispose();
+        }
+
+        [Benchmark]
+        public int Frame()
+        {
+            using var capture = new Capture
+            {
+                ColorImage = colorImage,
+                DepthImage = depthImage,
+                IRImage = irImage,
+            };
+
+            using var color = capture.ColorImage!;
+            using var depth = capture.DepthImage!;
+            using var ir = capture.IRImage!;
+            return color.WidthPixels + depth.WidthPixels + ir.WidthPixels;
+        }
+    }
+}
@@ -0,0 +1,93 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+using System;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Throughput of copying of image data between <see cref="Image"/> and managed memory
+    /// via array-based methods (<see cref="Image.CopyTo(byte[])"/>, <see cref="Image.FillFrom(byte[])"/>)
+    /// and stride-aware span-based methods (<see cref="Image.CopyTo{T}(Span{T}, int)"/>, <see cref="Image.FillFrom{T}(ReadOnlySpan{T}, int)"/>).
+    /// </summary>
+    [MemoryDiagnoser]
+    public class ImageCopyBenchmarks
+    {
+        public enum FrameKind
+        {
+            DepthNfovUnbinned,
+            Color1080pBgra,
+        }
+
+        private Image? image;
+        private Image? dstImage;
+        private byte[] packed = Array.Empty<byte>();
+        private byte[] padded = Array.Empty<byte>();
+        private int paddedStrideBytes;
+
+        [Params(FrameKind.DepthNfovUnbinned, FrameKind.Color1080pBgra)]
+        public FrameKind Frame { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            image = Frame switch
+            {
+                FrameKind.DepthNfovUnbinned => new Image(ImageFormat.Depth16, 640, 576),
+                FrameKind.Color1080pBgra => new Image(ImageFormat.ColorBgra32, 1920, 1080),
+                _ => throw new NotSupportedException(),
+            };
+            dstImage = new Image(image.Format, image.WidthPixels, image.HeightPixels);
+
+            packed = new byte[image.SizeBytes];
+            new Random(1).NextBytes(packed);
+            image.FillFrom(packed);
+
+            // Row stride of destination is aligned to 256 bytes, like in GPU textures
+            paddedStrideBytes = (image.StrideBytes + 255) / 256 * 256;
+            padded = new byte[paddedStrideBytes * image.HeightPixels];
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            image?.Dispose();
+            dstImage?.Dispose();
+        }
+
+        [Benchmark(Baseline = true)]
+        public int CopyToArray()
+            => image!.CopyTo(packed);
+
+        [Benchmark]
+        public void CopyToSpan()
+            => image!.CopyTo<byte>(packed, 0);
+
+        [Benchmark]
+        public void CopyToSpanWithPaddedStride()
+            => image!.CopyTo<byte>(padded, paddedStrideBytes);
+
+        [Benchmark]
+        public void FillFromArray()
+            => dstImage!.FillFrom(packed);
+
+        [Benchmark]
+        public void FillFromSpan()
+            => dstImage!.FillFrom<byte>(packed, 0);
+
+        [Benchmark]
+        public void FillFromSpanWithPaddedStride()
+            => dstImage!.FillFrom<byte>(padded, paddedStrideBytes);
+
+        [Benchmark]
+        public void CopyToImage()
+            => image!.CopyTo(dstImage!);
+
+        // Central quarter of image
+        [Benchmark]
+        public void CopyRegionToImage()
+        {
+            var img = image!;
+            img.CopyRegionTo(img.WidthPixels / 4, img.HeightPixels / 4, img.WidthPixels / 2, img.HeightPixels / 2, dstImage!, 0, 0);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+using System;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Cost of creation and disposal of <see cref="Image"/> objects in different ways:
+    /// buffer allocated by native SDK, buffer from custom allocators, buffer from managed array and duplication of reference.
+    /// </summary>
+    [MemoryDiagnoser]
+    public class ImageLifetimeBenchmarks
+    {
+        public enum FrameKind
+        {
+            DepthNfovUnbinned,
+            Color720pBgra,
+        }
+
+        private ImageFormat format;
+        private int widthPixels;
+        private int heightPixels;
+        private int strideBytes;
+        private int sizeBytes;
+        private byte[]? array;
+        private PooledMemoryAllocator? pooledAllocator;
+        private Image? image;
+
+        [Params(FrameKind.DepthNfovUnbinned, FrameKind.Color720pBgra)]
+        public FrameKind Frame { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            (format, widthPixels, heightPixels) = Frame switch
+            {
+                FrameKind.DepthNfovUnbinned => (ImageFormat.Depth16, 640, 576),
+                FrameKind.Color720pBgra => (ImageFormat.ColorBgra32, 1280, 720),
+                _ => throw new NotSupportedException(),
+            };
+            strideBytes = format.StrideBytes(widthPixels);
+            sizeBytes = format.ImageSizeBytes(strideBytes, heightPixels);
+            array = new byte[sizeBytes];
+            pooledAllocator = new PooledMemoryAllocator();
+            image = new Image(format, widthPixels, heightPixels);
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            image?.Dispose();
+            pooledAllocator?.Trim();
+        }
+
+        [Benchmark(Baseline = true)]
+        public int CreateAndDispose()
+        {
+            using var img = new Image(format, widthPixels, heightPixels, strideBytes);
+            return img.SizeBytes;
+        }
+
+        [Benchmark]
+        public int CreateWithPooledAllocatorAndDispose()
+        {
+            using var img = new Image(format, widthPixels, heightPixels, strideBytes, sizeBytes, pooledAllocator);
+            return img.SizeBytes;
+        }
+
+        // Rows aligned to 64 bytes
+        [Benchmark]
+        public int CreateWithAlignedAllocatorAndDispose()
+        {
+            using var img = new Image(format, widthPixels, heightPixels, AlignedMemoryAllocator.Default, AlignedMemoryAllocator.DefaultAlignment);
+            return img.SizeBytes;
+        }
+
+        [Benchmark]
+        public int CreateFromArrayAndDispose()
+        {
+            using var img = Image.CreateFromArray(array!, format, widthPixels, heightPixels, strideBytes);
+            return img.SizeBytes;
+        }
+
+        [Benchmark]
+        public int DuplicateReferenceAndDispose()
+        {
+            using var img = image!.DuplicateReference();
+            return img.SizeBytes;
+        }
+    }
+}
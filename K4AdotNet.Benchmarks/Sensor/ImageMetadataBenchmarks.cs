@@ -0,0 +1,85 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+using System;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Compares cost of access to image metadata via properties of <see cref="Image"/> class
+    /// (cached on creation of wrapper) and via direct native calls (as it was before caching).
+    /// </summary>
+    [MemoryDiagnoser]
+    public class ImageMetadataBenchmarks
+    {
+        public enum FrameKind
+        {
+            DepthNfovUnbinned,
+            Color1080pBgra,
+        }
+
+        private Image? image;
+
+        [Params(FrameKind.DepthNfovUnbinned, FrameKind.Color1080pBgra)]
+        public FrameKind Frame { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            image = Frame switch
+            {
+                FrameKind.DepthNfovUnbinned => new Image(ImageFormat.Depth16, 640, 576),
+                FrameKind.Color1080pBgra => new Image(ImageFormat.ColorBgra32, 1920, 1080),
+                _ => throw new NotSupportedException(),
+            };
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+            => image?.Dispose();
+
+        [Benchmark(Baseline = true)]
+        public int AllPropertiesNative()
+        {
+            var handle = Image.ToHandle(image);
+            return (int)NativeApi.ImageGetBuffer(handle).ToInt64()
+                + (int)NativeApi.ImageGetSize(handle).ToUInt32()
+                + (int)NativeApi.ImageGetFormat(handle)
+                + NativeApi.ImageGetWidthPixels(handle)
+                + NativeApi.ImageGetHeightPixels(handle)
+                + NativeApi.ImageGetStrideBytes(handle);
+        }
+
+        [Benchmark]
+        public int AllPropertiesCached()
+        {
+            var img = image!;
+            return (int)img.Buffer.ToInt64()
+                + img.SizeBytes
+                + (int)img.Format
+                + img.WidthPixels
+                + img.HeightPixels
+                + img.StrideBytes;
+        }
+
+        // Typical per-row loop: buffer and stride are requested for every row
+        [Benchmark]
+        public long RowLoopNative()
+        {
+            var handle = Image.ToHandle(image);
+            var sum = 0L;
+            for (var y = 0; y < NativeApi.ImageGetHeightPixels(handle); y++)
+                sum += NativeApi.ImageGetBuffer(handle).ToInt64() + y * NativeApi.ImageGetStrideBytes(handle);
+            return sum;
+        }
+
+        [Benchmark]
+        public long RowLoopCached()
+        {
+            var img = image!;
+            var sum = 0L;
+            for (var y = 0; y < img.HeightPixels; y++)
+                sum += img.Buffer.ToInt64() + y * img.StrideBytes;
+            return sum;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+using System;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Cost of calls of trivial native getters: classic P/Invoke with GC transition (as declared before)
+    /// versus declarations from <c>NativeApi</c> marked with <see cref="SuppressGCTransitionAttribute"/>.
+    /// </summary>
+    /// <remarks>
+    /// Each benchmark performs <see cref="CallsPerInvoke"/> native calls,
+    /// so calls per second can be calculated as <c>1e9 / (reported time in ns)</c>.
+    /// </remarks>
+    public class InteropBenchmarks
+    {
+        private const int CallsPerInvoke = 1000;
+
+        private Image? image;
+        private Capture? capture;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            image = new Image(ImageFormat.Depth16, 640, 576);
+            capture = new Capture();
+            capture.DepthImage = image;
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            capture?.Dispose();
+            image?.Dispose();
+        }
+
+        [Benchmark(Baseline = true, OperationsPerInvoke = CallsPerInvoke)]
+        public int ImageGetWidthPixelsClassic()
+        {
+            var handle = Image.ToHandle(image);
+            var sum = 0;
+            for (var i = 0; i < CallsPerInvoke; i++)
+                sum += ClassicNativeApi.ImageGetWidthPixels(handle);
+            return sum;
+        }
+
+        [Benchmark(OperationsPerInvoke = CallsPerInvoke)]
+        public int ImageGetWidthPixelsSuppressedGCTransition()
+        {
+            var handle = Image.ToHandle(image);
+            var sum = 0;
+            for (var i = 0; i < CallsPerInvoke; i++)
+                sum += NativeApi.ImageGetWidthPixels(handle);
+            return sum;
+        }
+
+        [Benchmark(OperationsPerInvoke = CallsPerInvoke)]
+        public long ImageGetBufferClassic()
+        {
+            var handle = Image.ToHandle(image);
+            var sum = 0L;
+            for (var i = 0; i < CallsPerInvoke; i++)
+                sum += ClassicNativeApi.ImageGetBuffer(handle).ToInt64();
+            return sum;
+        }
+
+        [Benchmark(OperationsPerInvoke = CallsPerInvoke)]
+        public long ImageGetBufferSuppressedGCTransition()
+        {
+            var handle = Image.ToHandle(image);
+            var sum = 0L;
+            for (var i = 0; i < CallsPerInvoke; i++)
+                sum += NativeApi.ImageGetBuffer(handle).ToInt64();
+            return sum;
+        }
+
+        // Getting of image from capture increments reference counter, thus image handle has to be released after that
+        // (releasing is performed in the same way in both benchmarks)
+        [Benchmark(OperationsPerInvoke = CallsPerInvoke)]
+        public void CaptureGetDepthImageClassic()
+        {
+            var handle = Capture.ToHandle(capture);
+            for (var i = 0; i < CallsPerInvoke; i++)
+                ClassicNativeApi.CaptureGetDepthImage(handle).Release();
+        }
+
+        [Benchmark(OperationsPerInvoke = CallsPerInvoke)]
+        public void CaptureGetDepthImageSuppressedGCTransition()
+        {
+            var handle = Capture.ToHandle(capture);
+            for (var i = 0; i < CallsPerInvoke; i++)
+                NativeApi.CaptureGetDepthImage(handle).Release();
+        }
+
+        // The same declarations as in NativeApi but without SuppressGCTransition attribute
+        private static class ClassicNativeApi
+        {
+            [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_width_pixels", CallingConvention = CallingConvention.Cdecl)]
+            public static extern int ImageGetWidthPixels(NativeHandles.ImageHandle imageHandle);
+
+            [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_buffer", CallingConvention = CallingConvention.Cdecl)]
+            public static extern IntPtr ImageGetBuffer(NativeHandles.ImageHandle imageHandle);
+
+            [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_capture_get_depth_image", CallingConvention = CallingConvention.Cdecl)]
+            public static extern NativeHandles.ImageHandle CaptureGetDepthImage(NativeHandles.CaptureHandle captureHandle);
+        }
+    }
+}
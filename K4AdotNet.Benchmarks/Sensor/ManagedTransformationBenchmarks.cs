@@ -0,0 +1,122 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+using System;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Throughput of <see cref="ManagedTransformation"/> methods versus the same methods of native <see cref="Transformation"/>.
+    /// </summary>
+    /// <remarks>
+    /// Depth image is filled by synthetic data: slanted plane with about 10% of invalid (zero) pixels.
+    /// With the stub (see <see cref="NativeStub"/>), native transformation does nothing and only managed numbers are meaningful.
+    /// </remarks>
+    [MemoryDiagnoser]
+    public class ManagedTransformationBenchmarks
+    {
+        private Calibration calibration;
+        private Transformation? transformation;
+        private ManagedTransformation? managedTransformation;
+        private Image? depthImage;
+        private Image? transformedDepthImage;
+        private Image? colorImage;
+        private Image? yuy2Image;
+        private Image? transformedColorImage;
+        private Float2[] uvMap = Array.Empty<Float2>();
+        private bool[] uvMapValidFlags = Array.Empty<bool>();
+        private Float2[] colorPoints = Array.Empty<Float2>();
+        private Float2[] depthPoints = Array.Empty<Float2>();
+        private bool[] depthPointValidFlags = Array.Empty<bool>();
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, 30f, out calibration);
+            transformation = calibration.CreateTransformation();
+            managedTransformation = calibration.CreateManagedTransformation();
+
+            var depthWidth = calibration.DepthMode.WidthPixels();
+            var depthHeight = calibration.DepthMode.HeightPixels();
+            depthImage = new Image(ImageFormat.Depth16, depthWidth, depthHeight);
+            var depthPixels = new short[depthWidth * depthHeight];
+            for (var i = 0; i < depthPixels.Length; i++)
+                depthPixels[i] = (short)(i % 10 == 0 ? 0 : 1500 + i % depthWidth);
+            depthImage.FillFrom(depthPixels);
+
+            var colorWidth = calibration.ColorResolution.WidthPixels();
+            var colorHeight = calibration.ColorResolution.HeightPixels();
+            transformedDepthImage = new Image(ImageFormat.Depth16, colorWidth, colorHeight);
+            colorImage = new Image(ImageFormat.ColorBgra32, colorWidth, colorHeight);
+            yuy2Image = new Image(ImageFormat.ColorYUY2, colorWidth, colorHeight);
+            transformedColorImage = new Image(ImageFormat.ColorBgra32, depthWidth, depthHeight);
+            uvMap = new Float2[depthWidth * depthHeight];
+            uvMapValidFlags = new bool[depthWidth * depthHeight];
+
+            // Grid of 32x32 color pixels
+            colorPoints = new Float2[32 * 32];
+            for (var i = 0; i < colorPoints.Length; i++)
+                colorPoints[i] = new Float2((i % 32 + 0.5f) * colorWidth / 32, (i / 32 + 0.5f) * colorHeight / 32);
+            depthPoints = new Float2[colorPoints.Length];
+            depthPointValidFlags = new bool[colorPoints.Length];
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            transformation?.Dispose();
+            depthImage?.Dispose();
+            transformedDepthImage?.Dispose();
+            colorImage?.Dispose();
+            yuy2Image?.Dispose();
+            transformedColorImage?.Dispose();
+        }
+
+        [Benchmark]
+        public void NativeDepthImageToColorCamera()
+            => transformation!.DepthImageToColorCamera(depthImage!, transformedDepthImage!);
+
+        [Benchmark]
+        public void ManagedDepthImageToColorCamera()
+            => managedTransformation!.DepthImageToColorCamera(depthImage!, transformedDepthImage!);
+
+        [Benchmark]
+        public void NativeColorImageToDepthCamera()
+            => transformation!.ColorImageToDepthCamera(depthImage!, colorImage!, transformedColorImage!);
+
+        [Benchmark]
+        public void ManagedColorImageToDepthCamera()
+            => managedTransformation!.ColorImageToDepthCamera(depthImage!, colorImage!, transformedColorImage!);
+
+        [Benchmark]
+        public void ManagedColorImageToDepthCameraLinear()
+            => managedTransformation!.ColorImageToDepthCamera(depthImage!, colorImage!, transformedColorImage!, TransformationInterpolation.Linear);
+
+        [Benchmark]
+        public void ManagedYuy2ImageToDepthCamera()
+            => managedTransformation!.ColorImageToDepthCamera(depthImage!, yuy2Image!, transformedColorImage!);
+
+        [Benchmark]
+        public int ManagedDepthImageToColorUVMap()
+            => managedTransformation!.DepthImageToColorUVMap(depthImage!, uvMap, uvMapValidFlags);
+
+        [Benchmark]
+        public int NativeColor2DToDepth2D()
+        {
+            var validCount = 0;
+            for (var i = 0; i < colorPoints.Length; i++)
+            {
+                var point = calibration.ConvertColor2DToDepth2D(colorPoints[i], depthImage!);
+                depthPoints[i] = point ?? default;
+                depthPointValidFlags[i] = point.HasValue;
+                if (point.HasValue)
+                    validCount++;
+            }
+
+            return validCount;
+        }
+
+        [Benchmark]
+        public int ManagedColor2DToDepth2D()
+            => managedTransformation!.ConvertColor2DToDepth2D(colorPoints, depthImage!, depthPoints, depthPointValidFlags);
+    }
+}
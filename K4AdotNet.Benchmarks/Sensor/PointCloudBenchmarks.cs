@@ -0,0 +1,68 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+using System;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Throughput of conversion of depth image to point cloud: native <see cref="Transformation.DepthImageToPointCloud(Image, CalibrationGeometry, Image)"/>
+    /// versus managed <see cref="Calibration.DepthImageToPointCloud(Image, CalibrationGeometry, Span{Float3}, bool, bool)"/> for all depth modes.
+    /// </summary>
+    /// <remarks>
+    /// Depth image is filled by synthetic data with about 10% of invalid (zero) pixels.
+    /// With the stub (see <see cref="NativeStub"/>), native transformation does nothing and only managed numbers are meaningful.
+    /// </remarks>
+    [MemoryDiagnoser]
+    public class PointCloudBenchmarks
+    {
+        private Calibration calibration;
+        private Transformation? transformation;
+        private Image? depthImage;
+        private Image? xyzImage;
+        private Float3[] points = Array.Empty<Float3>();
+
+        [Params(DepthMode.NarrowView2x2Binned, DepthMode.NarrowViewUnbinned, DepthMode.WideView2x2Binned, DepthMode.WideViewUnbinned)]
+        public DepthMode DepthMode { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            Calibration.CreateDummy(DepthMode, ColorResolution.Off, 30f, out calibration);
+            transformation = calibration.CreateTransformation();
+
+            var width = DepthMode.WidthPixels();
+            var height = DepthMode.HeightPixels();
+            depthImage = new Image(ImageFormat.Depth16, width, height);
+            var depthPixels = new short[depthImage.SizeBytes / sizeof(short)];
+            for (var i = 0; i < depthPixels.Length; i++)
+                depthPixels[i] = (short)(i % 10 == 0 ? 0 : 500 + i % 4000);
+            depthImage.FillFrom(depthPixels);
+
+            xyzImage = new Image(ImageFormat.Custom, width, height, width * 3 * sizeof(short));
+            points = new Float3[width * height];
+
+            // Ray table is computed once per calibration: exclude it from measurements
+            calibration.GetRayTable(CalibrationGeometry.Depth);
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            transformation?.Dispose();
+            depthImage?.Dispose();
+            xyzImage?.Dispose();
+        }
+
+        [Benchmark(Baseline = true)]
+        public void Native()
+            => transformation!.DepthImageToPointCloud(depthImage!, CalibrationGeometry.Depth, xyzImage!);
+
+        [Benchmark]
+        public int ManagedMillimeters()
+            => calibration.DepthImageToPointCloud(depthImage!, CalibrationGeometry.Depth, points);
+
+        [Benchmark]
+        public int ManagedMetersValidPointsOnly()
+            => calibration.DepthImageToPointCloud(depthImage!, CalibrationGeometry.Depth, points, inMeters: true, validPointsOnly: true);
+    }
+}
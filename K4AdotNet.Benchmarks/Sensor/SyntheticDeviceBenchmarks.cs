@@ -0,0 +1,59 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+using System.Threading.Tasks;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Throughput of <see cref="SyntheticDevice"/> in non-real-time mode: cost of production of one capture per device,
+    /// including allocation of images and copying of content.
+    /// Several devices are read in parallel, like in pipeline that processes data from several cameras.
+    /// </summary>
+    [MemoryDiagnoser]
+    public class SyntheticDeviceBenchmarks
+    {
+        private SyntheticDevice[] devices = System.Array.Empty<SyntheticDevice>();
+
+        [Params(1, 4)]
+        public int DeviceCount { get; set; }
+
+        [Params(ImageFormat.ColorBgra32, ImageFormat.ColorNV12)]
+        public ImageFormat ColorFormat { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            var config = new DeviceConfiguration
+            {
+                DepthMode = DepthMode.NarrowViewUnbinned,
+                ColorResolution = ColorResolution.R720p,
+                ColorFormat = ColorFormat,
+                CameraFps = FrameRate.Thirty,
+                SynchronizedImagesOnly = true,
+            };
+
+            devices = new SyntheticDevice[DeviceCount];
+            for (var i = 0; i < devices.Length; i++)
+            {
+                devices[i] = new SyntheticDevice(new SyntheticDeviceSettings { RealTime = false });
+                devices[i].StartCameras(config);
+            }
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            foreach (var device in devices)
+                device.Dispose();
+        }
+
+        [Benchmark]
+        public void GetCaptureFromEachDevice()
+        {
+            Parallel.For(0, devices.Length, i =>
+            {
+                using var capture = devices[i].GetCapture();
+            });
+        }
+    }
+}
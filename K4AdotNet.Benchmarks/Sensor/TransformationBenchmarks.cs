@@ -0,0 +1,72 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Cost of calls of <see cref="Transformation"/> methods with preallocated output images.
+    /// </summary>
+    /// <remarks>
+    /// With the real SDK, numbers include the transformation itself (performed on GPU or CPU by depth engine).
+    /// With the stub (see <see cref="NativeStub"/>), output images are not touched and numbers show the overhead of the wrapper:
+    /// argument checks and native calls.
+    /// </remarks>
+    [MemoryDiagnoser]
+    public class TransformationBenchmarks
+    {
+        private Calibration calibration;
+        private Transformation? transformation;
+        private Image? depthImage;
+        private Image? colorImage;
+        private Image? transformedDepthImage;
+        private Image? transformedColorImage;
+        private Image? xyzImage;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, 30f, out calibration);
+            transformation = calibration.CreateTransformation();
+
+            var depthWidth = calibration.DepthMode.WidthPixels();
+            var depthHeight = calibration.DepthMode.HeightPixels();
+            var colorWidth = calibration.ColorResolution.WidthPixels();
+            var colorHeight = calibration.ColorResolution.HeightPixels();
+
+            depthImage = new Image(ImageFormat.Depth16, depthWidth, depthHeight);
+            colorImage = new Image(ImageFormat.ColorBgra32, colorWidth, colorHeight);
+            transformedDepthImage = new Image(ImageFormat.Depth16, colorWidth, colorHeight);
+            transformedColorImage = new Image(ImageFormat.ColorBgra32, depthWidth, depthHeight);
+            xyzImage = new Image(ImageFormat.Custom, depthWidth, depthHeight, depthWidth * 3 * sizeof(short));
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            transformation?.Dispose();
+            depthImage?.Dispose();
+            colorImage?.Dispose();
+            transformedDepthImage?.Dispose();
+            transformedColorImage?.Dispose();
+            xyzImage?.Dispose();
+        }
+
+        [Benchmark]
+        public void CreateAndDispose()
+        {
+            using var t = calibration.CreateTransformation();
+        }
+
+        [Benchmark]
+        public void DepthImageToColorCamera()
+            => transformation!.DepthImageToColorCamera(depthImage!, transformedDepthImage!);
+
+        [Benchmark]
+        public void ColorImageToDepthCamera()
+            => transformation!.ColorImageToDepthCamera(depthImage!, colorImage!, transformedColorImage!);
+
+        [Benchmark]
+        public void DepthImageToPointCloud()
+            => transformation!.DepthImageToPointCloud(depthImage!, CalibrationGeometry.Depth, xyzImage!);
+    }
+}
@@ -0,0 +1,65 @@
+﻿using BenchmarkDotNet.Attributes;
+using K4AdotNet.Sensor;
+
+namespace K4AdotNet.Benchmarks.Sensor
+{
+    /// <summary>
+    /// Throughput of <see cref="UndistortionMap.Remap(Image, Image)"/> for depth, infrared and color images.
+    /// </summary>
+    /// <remarks>Maps are computed in setup, thus only remapping is measured.</remarks>
+    [MemoryDiagnoser]
+    public class UndistortionMapBenchmarks
+    {
+        private UndistortionMap? depthMap;
+        private UndistortionMap? colorMap;
+        private Image? depthImage;
+        private Image? irImage;
+        private Image? colorImage;
+        private Image? undistortedDepthImage;
+        private Image? undistortedIrImage;
+        private Image? undistortedColorImage;
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, 30f, out var calibration);
+            depthMap = calibration.GetUndistortionMap(CalibrationGeometry.Depth);
+            colorMap = calibration.GetUndistortionMap(CalibrationGeometry.Color);
+
+            var depthWidth = calibration.DepthMode.WidthPixels();
+            var depthHeight = calibration.DepthMode.HeightPixels();
+            depthImage = new Image(ImageFormat.Depth16, depthWidth, depthHeight);
+            irImage = new Image(ImageFormat.IR16, depthWidth, depthHeight);
+            undistortedDepthImage = new Image(ImageFormat.Depth16, depthWidth, depthHeight);
+            undistortedIrImage = new Image(ImageFormat.IR16, depthWidth, depthHeight);
+
+            var colorWidth = calibration.ColorResolution.WidthPixels();
+            var colorHeight = calibration.ColorResolution.HeightPixels();
+            colorImage = new Image(ImageFormat.ColorBgra32, colorWidth, colorHeight);
+            undistortedColorImage = new Image(ImageFormat.ColorBgra32, colorWidth, colorHeight);
+        }
+
+        [GlobalCleanup]
+        public void Cleanup()
+        {
+            depthImage?.Dispose();
+            irImage?.Dispose();
+            colorImage?.Dispose();
+            undistortedDepthImage?.Dispose();
+            undistortedIrImage?.Dispose();
+            undistortedColorImage?.Dispose();
+        }
+
+        [Benchmark]
+        public void RemapDepth()
+            => depthMap!.Remap(depthImage!, undistortedDepthImage!);
+
+        [Benchmark]
+        public void RemapIR()
+            => depthMap!.Remap(irImage!, undistortedIrImage!);
+
+        [Benchmark]
+        public void RemapColor()
+            => colorMap!.Remap(colorImage!, undistortedColorImage!);
+    }
+}
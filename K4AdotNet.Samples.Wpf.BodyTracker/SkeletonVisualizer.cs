@@ -1,4 +1,5 @@
 ﻿using K4AdotNet.BodyTracking;
+using K4AdotNet.Sensor;
 using System;
 using System.Threading;
 using System.Windows;
@@ -9,7 +10,7 @@ namespace K4AdotNet.Samples.Wpf.BodyTracker
 {
     internal sealed class SkeletonVisualizer
     {
-        public SkeletonVisualizer(Dispatcher dispatcher, int widthPixels, int heightPixels, Func<Joint, Float2?> jointToImageProjector)
+        public SkeletonVisualizer(Dispatcher dispatcher, int widthPixels, int heightPixels, in Calibration calibration, CalibrationGeometry targetCamera)
         {
             if (dispatcher.Thread != Thread.CurrentThread)
             {
@@ -18,7 +19,8 @@ namespace K4AdotNet.Samples.Wpf.BodyTracker
             }
 
             this.dispatcher = dispatcher;
-            this.jointToImageProjector = jointToImageProjector;
+            this.calibration = calibration;
+            this.targetCamera = targetCamera;
 
             // WPF stuff to draw skeleton
             drawingRect = new(0, 0, widthPixels, heightPixels);
@@ -67,14 +69,19 @@ namespace K4AdotNet.Samples.Wpf.BodyTracker
             if (bodyFrame == null || bodyFrame.IsDisposed)
                 return;
 
-            // 1st step: get information about bodies
+            // 1st step: get information about bodies and project all their joints at once
             lock (skeletonsSync)
             {
                 var bodyCount = bodyFrame.BodyCount;
                 if (skeletons.Length != bodyCount)
+                {
                     skeletons = new Skeleton[bodyCount];
+                    jointPoints2D = new Float2[bodyCount * JointTypes.All.Count];
+                    jointValidFlags = new bool[bodyCount * JointTypes.All.Count];
+                }
                 for (var i = 0; i < bodyCount; i++)
                     bodyFrame.GetBodySkeleton(i, out skeletons[i]);
+                calibration.Convert3DTo2D(bodyFrame, targetCamera, jointPoints2D, jointValidFlags);
             }
 
             // 2nd step: we can update ImageSource only from its owner thread (as a rule, UI thread)
@@ -92,47 +99,47 @@ namespace K4AdotNet.Samples.Wpf.BodyTracker
                     dc.DrawRectangle(Brushes.Transparent, null, drawingRect);
 
                     // Draw skeleton for each tracked body
-                    foreach (var skeleton in skeletons)
+                    for (var i = 0; i < skeletons.Length; i++)
                     {
-                        DrawBones(dc, skeleton);
-                        DrawJoints(dc, skeleton);
+                        var jointOffset = i * JointTypes.All.Count;
+                        DrawBones(dc, jointOffset);
+                        DrawJoints(dc, skeletons[i], jointOffset);
                     }
                 }
             }
         }
 
         // Draws bone as line (stick) between two joints
-        private void DrawBones(DrawingContext dc, Skeleton skeleton)
+        private void DrawBones(DrawingContext dc, int jointOffset)
         {
             foreach (var jointType in JointTypes.All)
             {
                 if (!jointType.IsRoot() && !jointType.IsFaceFeature())
                 {
-                    var parentJoint = skeleton[jointType.GetParent()];
-                    var endJoint = skeleton[jointType];
-                    var parentPoint2D = ProjectJointToImage(parentJoint);
-                    var endPoint2D = ProjectJointToImage(endJoint);
+                    var parentPoint2D = GetJointPoint(jointOffset, jointType.GetParent());
+                    var endPoint2D = GetJointPoint(jointOffset, jointType);
                     if (parentPoint2D.HasValue && endPoint2D.HasValue)
                         dc.DrawLine(BonePen, parentPoint2D.Value, endPoint2D.Value);
                 }
             }
         }
 
-        private Point? ProjectJointToImage(Joint joint)
+        // Projected joints are stored in order of JointType for each body
+        private Point? GetJointPoint(int jointOffset, JointType jointType)
         {
-            var res = jointToImageProjector(joint);
-            if (!res.HasValue)
+            var index = jointOffset + (int)jointType;
+            if (!jointValidFlags[index])
                 return null;
-            return new(res.Value.X, res.Value.Y);
+            return new(jointPoints2D[index].X, jointPoints2D[index].Y);
         }
 
         // Draws joint as circle
-        private void DrawJoints(DrawingContext dc, Skeleton skeleton)
+        private void DrawJoints(DrawingContext dc, Skeleton skeleton, int jointOffset)
         {
             foreach (var jointType in JointTypes.All)
             {
                 var joint = skeleton[jointType];
-                var point2D = ProjectJointToImage(joint);
+                var point2D = GetJointPoint(jointOffset, jointType);
                 if (point2D.HasValue)
                 {
                     var radius = JointCircleRadius;
@@ -156,10 +163,14 @@ namespace K4AdotNet.Samples.Wpf.BodyTracker
         }
 
         private readonly Dispatcher dispatcher;
-        private readonly Func<Joint, Float2?> jointToImageProjector;
+        // Not readonly to avoid defensive copying of structure on each call
+        private Calibration calibration;
+        private readonly CalibrationGeometry targetCamera;
         private readonly Rect drawingRect;
         private readonly DrawingGroup drawingGroup;
         private Skeleton[] skeletons = Array.Empty<Skeleton>();
+        private Float2[] jointPoints2D = Array.Empty<Float2>();
+        private bool[] jointValidFlags = Array.Empty<bool>();
         private readonly object skeletonsSync = new();
     }
 }
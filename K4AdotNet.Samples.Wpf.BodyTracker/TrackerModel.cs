@@ -52,14 +52,14 @@ namespace K4AdotNet.Samples.Wpf.BodyTracker
             // Image and skeleton visualizers for depth
             var depthMode = readingLoop.DepthMode;
             depthImageVisualizer = ImageVisualizer.CreateForDepth(dispatcher, depthMode.WidthPixels(), depthMode.HeightPixels());
-            depthSkeletonVisualizer = new(dispatcher, depthMode.WidthPixels(), depthMode.HeightPixels(), ProjectJointToDepthMap);
+            depthSkeletonVisualizer = new(dispatcher, depthMode.WidthPixels(), depthMode.HeightPixels(), in calibration, CalibrationGeometry.Depth);
 
             // Image and skeleton visualizers for color
             var colorRes = readingLoop.ColorResolution;
             if (colorRes != ColorResolution.Off)
             {
                 colorImageVisualizer = ImageVisualizer.CreateForColorBgra(dispatcher, colorRes.WidthPixels(), colorRes.HeightPixels());
-                colorSkeletonVisualizer = new(dispatcher, colorRes.WidthPixels(), colorRes.HeightPixels(), ProjectJointToColorImage);
+                colorSkeletonVisualizer = new(dispatcher, colorRes.WidthPixels(), colorRes.HeightPixels(), in calibration, CalibrationGeometry.Color);
                 bodyIndexMapTransformation = new(in calibration);
             }
 
@@ -76,12 +76,6 @@ namespace K4AdotNet.Samples.Wpf.BodyTracker
             }
         }
 
-        private Float2? ProjectJointToDepthMap(Joint joint)
-            => calibration.Convert3DTo2D(joint.PositionMm, CalibrationGeometry.Depth, CalibrationGeometry.Depth);
-
-        private Float2? ProjectJointToColorImage(Joint joint)
-            => calibration.Convert3DTo2D(joint.PositionMm, CalibrationGeometry.Depth, CalibrationGeometry.Color);
-
         private void BackgroundLoop_Failed(object? sender, FailedEventArgs e)
             => dispatcher.BeginInvoke(new Action(() => app!.ShowErrorMessage(e.Exception.Message)));
 
@@ -83,7 +83,7 @@ namespace K4AdotNet.Samples.Wpf.Common
             if (image.Format == ImageFormat.ColorMjpg)
                 DecodeMjpegToInnerBuffer(image);        // special patch for OrbbecSDK-K4A-Wrapper
             else if (image.Format == Format)
-                FillInnerBuffer(image.Buffer, image.StrideBytes, image.SizeBytes);
+                FillInnerBuffer(image);
             else
                 return false;   // not compatible format
 
@@ -111,27 +111,14 @@ namespace K4AdotNet.Samples.Wpf.Common
         }
 
 
-        private void FillInnerBuffer(IntPtr srcPtr, int srcStrideBytes, int srcSizeBytes)
+        private void FillInnerBuffer(Image image)
         {
             // This method can be called from some background thread,
             // thus use synchronization
             lock (innerBuffer)
             {
-                if (srcStrideBytes == StrideBytes && srcSizeBytes == innerBuffer.Length)
-                {
-                    Marshal.Copy(srcPtr, innerBuffer, 0, innerBuffer.Length);
-                }
-                else
-                {
-                    var lineLength = Math.Min(srcStrideBytes, StrideBytes);
-                    var dstOffset = 0;
-                    for (var y = 0; y < HeightPixels; y++)
-                    {
-                        Marshal.Copy(srcPtr, innerBuffer, dstOffset, lineLength);
-                        srcPtr += srcSizeBytes;
-                        dstOffset += StrideBytes;
-                    }
-                }
+                // Rows are repacked to stride of inner buffer if needed
+                image.CopyTo<byte>(innerBuffer, StrideBytes);
             }
         }
 
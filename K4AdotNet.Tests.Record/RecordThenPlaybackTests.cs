@@ -1,6 +1,7 @@
 using K4AdotNet.Record;
 using K4AdotNet.Sensor;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
 using System.IO;
 using System.Linq;
 using System.Runtime.InteropServices;
@@ -189,6 +190,20 @@ namespace K4AdotNet.Tests.Record
 
                 Assert.IsFalse(playback.TryGetAttachment("some_unknown_attachment_name", out var tmp));
                 Assert.IsNull(tmp);
+
+                // Repeated reading returns the same data (from cache)
+                Assert.IsTrue(playback.TryGetAttachment(attachment1Name, out data1));
+                AssertAreEqual(attachment1Data, data1);
+
+                // Span-based reading
+                var buffer = new byte[attachment2Data.Length + 10];
+                Assert.IsFalse(playback.TryGetAttachment(attachment2Name, buffer.AsSpan(0, 5), out var size));
+                Assert.AreEqual(attachment2Data.Length, size);
+                Assert.IsTrue(playback.TryGetAttachment(attachment2Name, buffer, out size));
+                Assert.AreEqual(attachment2Data.Length, size);
+                AssertAreEqual(attachment2Data, buffer.AsSpan(0, size).ToArray());
+                Assert.IsFalse(playback.TryGetAttachment("some_unknown_attachment_name", buffer, out size));
+                Assert.AreEqual(0, size);
             }
 
             File.Delete(mkvPath);
@@ -0,0 +1,88 @@
+﻿using K4AdotNet.Sensor;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Tests.Unit
+{
+    [TestClass]
+    public class AlignedMemoryAllocatorTests
+    {
+        [TestMethod]
+        public void TestAlignment()
+        {
+            foreach (var alignment in new[] { 1, 16, 64, 4096 })
+            {
+                var allocator = new AlignedMemoryAllocator(alignment);
+                Assert.AreEqual(alignment, allocator.Alignment);
+
+                foreach (var size in new[] { 0, 1, 100, 640 * 576 * 2 })
+                {
+                    var buffer = allocator.Allocate(size, out var context);
+                    Assert.AreNotEqual(IntPtr.Zero, buffer);
+                    Assert.AreEqual(0, buffer.ToInt64() % alignment);
+
+                    // Buffer is writable for the whole requested size
+                    if (size > 0)
+                    {
+                        Marshal.WriteByte(buffer, 0, 1);
+                        Marshal.WriteByte(buffer, size - 1, 2);
+                    }
+
+                    allocator.Free(buffer, context);
+                }
+            }
+        }
+
+        [TestMethod]
+        public void TestInvalidArguments()
+        {
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => new AlignedMemoryAllocator(0));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => new AlignedMemoryAllocator(48));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => AlignedMemoryAllocator.Default.Allocate(-1, out _));
+        }
+
+        [TestMethod]
+        public void TestHugePages()
+        {
+            var allocator = new AlignedMemoryAllocator(AlignedMemoryAllocator.DefaultAlignment, useHugePages: true);
+            Assert.AreEqual(RuntimeInformation.IsOSPlatform(OSPlatform.Linux), allocator.UseHugePages);
+
+            // 4K BGRA frame
+            const int size = 3840 * 2160 * 4;
+            var buffer = allocator.Allocate(size, out var context);
+            Assert.AreNotEqual(IntPtr.Zero, buffer);
+            Assert.AreEqual(0, buffer.ToInt64() % AlignedMemoryAllocator.DefaultAlignment);
+            if (allocator.UseHugePages)
+                Assert.AreEqual(0, buffer.ToInt64() % AlignedMemoryAllocator.HugePageSize);
+            Marshal.WriteByte(buffer, size - 1, 1);
+            allocator.Free(buffer, context);
+
+            // Small buffers are allocated as usual
+            buffer = allocator.Allocate(1000, out context);
+            Assert.AreEqual(0, buffer.ToInt64() % AlignedMemoryAllocator.DefaultAlignment);
+            allocator.Free(buffer, context);
+        }
+
+        [TestMethod]
+        public void TestAlignedStride()
+        {
+            Assert.AreEqual(2560, ImageFormat.Depth16.StrideBytes(1280, 64));
+            Assert.AreEqual(704, ImageFormat.Depth16.StrideBytes(330, 64));
+            Assert.AreEqual(1024, ImageFormat.IR16.StrideBytes(320, 1024));
+            Assert.AreEqual(1280, ImageFormat.ColorNV12.StrideBytes(1280, 1));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => ImageFormat.Depth16.StrideBytes(320, 3));
+        }
+
+        [TestMethod]
+        public void TestImageWithAlignedRows()
+        {
+            var allocator = new AlignedMemoryAllocator(128);
+            using var image = new Image(ImageFormat.ColorBgra32, 1000, 10, allocator, allocator.Alignment);
+
+            Assert.AreEqual(4096, image.StrideBytes);
+            Assert.AreEqual(4096 * 10, image.SizeBytes);
+            Assert.AreEqual(0, image.Buffer.ToInt64() % allocator.Alignment);
+        }
+    }
+}
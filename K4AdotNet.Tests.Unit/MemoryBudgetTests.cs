@@ -0,0 +1,172 @@
+﻿using K4AdotNet.Sensor;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace K4AdotNet.Tests.Unit
+{
+    [TestClass]
+    public class MemoryBudgetTests
+    {
+        [TestMethod]
+        public void TestAccounting()
+        {
+            var budget = new MemoryBudget(1000);
+            Assert.AreEqual(1000, budget.LimitBytes);
+            Assert.AreEqual(0, budget.CurrentBytes);
+            Assert.IsFalse(budget.IsOverBudget);
+
+            var bufferA = budget.Allocate(600, out var contextA);
+            var bufferB = budget.Allocate(500, out var contextB);
+            Assert.AreEqual(1100, budget.CurrentBytes);
+            Assert.AreEqual(1100, budget.PeakBytes);
+            Assert.AreEqual(1100, budget.UnattributedBytes);
+            Assert.IsTrue(budget.IsOverBudget);
+            Assert.IsFalse(budget.WaitForBudget());
+
+            budget.Free(bufferA, contextA);
+            Assert.AreEqual(500, budget.CurrentBytes);
+            Assert.AreEqual(1100, budget.PeakBytes);
+            Assert.IsFalse(budget.IsOverBudget);
+            Assert.IsTrue(budget.WaitForBudget());
+
+            budget.ResetPeaks();
+            Assert.AreEqual(500, budget.PeakBytes);
+
+            budget.Free(bufferB, contextB);
+            Assert.AreEqual(0, budget.CurrentBytes);
+            Assert.AreEqual(0, budget.UnattributedBytes);
+        }
+
+        [TestMethod]
+        public void TestConcurrentAccounting()
+        {
+            var budget = new MemoryBudget(1_000_000);
+            Parallel.For(0, 4, _ =>
+            {
+                for (var i = 0; i < 1000; i++)
+                {
+                    var buffer = budget.Allocate(100 + i, out var context);
+                    budget.Free(buffer, context);
+                }
+            });
+
+            Assert.AreEqual(0, budget.CurrentBytes);
+            Assert.AreEqual(0, budget.UnattributedBytes);
+            Assert.IsTrue(budget.PeakBytes >= 1099 && budget.PeakBytes <= 4 * 1099);
+        }
+
+        [TestMethod]
+        public void TestInvalidArguments()
+        {
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => new MemoryBudget(0));
+            Assert.ThrowsException<ArgumentNullException>(() => new MemoryBudget(1, null!));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => new MemoryBudget(1).LimitBytes = -1);
+        }
+
+        [TestMethod]
+        public void TestWaitForBudget()
+        {
+            var budget = new MemoryBudget(100);
+            var buffer = budget.Allocate(200, out var context);
+
+            Assert.IsFalse(budget.WaitForBudget(TimeSpan.FromMilliseconds(20)));
+
+            var waiting = Task.Run(() => budget.WaitForBudget(Timeout.Infinite));
+            Thread.Sleep(20);
+            Assert.IsFalse(waiting.IsCompleted);
+            budget.Free(buffer, context);
+            Assert.IsTrue(waiting.Wait(TimeSpan.FromSeconds(5)));
+            Assert.IsTrue(waiting.Result);
+
+            // Raising of limit also unblocks waiters
+            buffer = budget.Allocate(200, out context);
+            waiting = Task.Run(() => budget.WaitForBudget(Timeout.Infinite));
+            Thread.Sleep(20);
+            budget.LimitBytes = 1000;
+            Assert.IsTrue(waiting.Wait(TimeSpan.FromSeconds(5)));
+            budget.Free(buffer, context);
+        }
+
+        [TestMethod]
+        public void TestPerFormatUsage()
+        {
+            var budget = new MemoryBudget(10_000_000);
+
+            using (var depth = new Image(ImageFormat.Depth16, 640, 576, 640 * 2, 640 * 576 * 2, budget))
+            using (var color = new Image(ImageFormat.ColorBgra32, 1280, 720, 1280 * 4, 1280 * 720 * 4, budget))
+            {
+                Assert.AreEqual(depth.SizeBytes + color.SizeBytes, budget.CurrentBytes);
+                Assert.AreEqual(depth.SizeBytes, budget.GetCurrentBytes(ImageFormat.Depth16));
+                Assert.AreEqual(color.SizeBytes, budget.GetCurrentBytes(ImageFormat.ColorBgra32));
+                Assert.AreEqual(0, budget.GetCurrentBytes(ImageFormat.IR16));
+                Assert.AreEqual(0, budget.UnattributedBytes);
+            }
+
+            Assert.AreEqual(0, budget.CurrentBytes);
+            Assert.AreEqual(0, budget.GetCurrentBytes(ImageFormat.Depth16));
+            Assert.AreEqual(640 * 576 * 2, budget.GetPeakBytes(ImageFormat.Depth16));
+        }
+
+        [TestMethod]
+        public void TestCaptureQueueDropOldest()
+        {
+            var budget = new MemoryBudget(1_000_000);
+            using var queue = new CaptureQueue(budget, MemoryBudgetPolicy.DropOldest);
+
+            for (var i = 0; i < 5; i++)
+                Assert.IsTrue(queue.TryEnqueue(CreateCapture(budget)));
+
+            // Each capture takes ~0.74 MB, so only one of them fits the budget
+            Assert.AreEqual(1, queue.Count);
+            Assert.AreEqual(4, queue.DroppedCount);
+            Assert.IsTrue(queue.TryDequeue(out var capture));
+            capture.Dispose();
+            Assert.AreEqual(0, budget.CurrentBytes);
+        }
+
+        [TestMethod]
+        public void TestCaptureQueueFailFast()
+        {
+            var budget = new MemoryBudget(1_000_000);
+            using var queue = new CaptureQueue(budget, MemoryBudgetPolicy.FailFast);
+
+            Assert.IsTrue(queue.TryEnqueue(CreateCapture(budget)));
+            using (var capture = CreateCapture(budget))
+                Assert.IsFalse(queue.TryEnqueue(capture));
+            Assert.AreEqual(1, queue.Count);
+            Assert.AreEqual(1, queue.RejectedCount);
+        }
+
+        [TestMethod]
+        public void TestCaptureQueueBlock()
+        {
+            var budget = new MemoryBudget(1_000_000);
+            using var queue = new CaptureQueue(budget, MemoryBudgetPolicy.Block);
+
+            Assert.IsTrue(queue.TryEnqueue(CreateCapture(budget)));
+            var capture = CreateCapture(budget);
+            Assert.IsFalse(queue.TryEnqueue(capture, TimeSpan.FromMilliseconds(20)));
+
+            var producer = Task.Run(() => queue.TryEnqueue(capture, Timeout.Infinite));
+            Thread.Sleep(20);
+            Assert.IsFalse(producer.IsCompleted);
+
+            // Consumer takes the first capture: queue is empty, producer is unblocked
+            Assert.IsTrue(queue.TryDequeue(out var first));
+            first.Dispose();
+            Assert.IsTrue(producer.Wait(TimeSpan.FromSeconds(5)));
+            Assert.IsTrue(producer.Result);
+            Assert.AreEqual(1, queue.Count);
+        }
+
+        private static Capture CreateCapture(MemoryBudget budget)
+        {
+            var capture = new Capture();
+            using (var depth = new Image(ImageFormat.Depth16, 640, 576, 640 * 2, 640 * 576 * 2, budget))
+                capture.DepthImage = depth;
+            return capture;
+        }
+    }
+}
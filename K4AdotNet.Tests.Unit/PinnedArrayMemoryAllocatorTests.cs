@@ -0,0 +1,164 @@
+﻿using K4AdotNet.Sensor;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Tests.Unit
+{
+    [TestClass]
+    public class PinnedArrayMemoryAllocatorTests
+    {
+        [TestMethod]
+        public void TestHitsAndMisses()
+        {
+            var allocator = new PinnedArrayMemoryAllocator();
+            const int size = 1280 * 720 * 4;
+
+            var bufferA = allocator.Allocate(size, out var contextA);
+            Assert.AreNotEqual(IntPtr.Zero, bufferA);
+            Assert.AreEqual(0, allocator.HitCount);
+            Assert.AreEqual(1, allocator.MissCount);
+
+            // Buffer is writable for the whole requested size
+            Marshal.WriteByte(bufferA, 0, 1);
+            Marshal.WriteByte(bufferA, size - 1, 2);
+
+            allocator.Free(bufferA, contextA);
+            Assert.IsTrue(allocator.PooledBytes >= size);
+
+            // The same size class -> the same buffer
+            var bufferB = allocator.Allocate(size - 100, out var contextB);
+            Assert.AreEqual(bufferA, bufferB);
+            Assert.AreEqual(contextA, contextB);
+            Assert.AreEqual(1, allocator.HitCount);
+            Assert.AreEqual(1, allocator.MissCount);
+            Assert.AreEqual(0, allocator.PooledBytes);
+
+            // Another size class -> new buffer in another slot
+            var bufferC = allocator.Allocate(size * 2, out var contextC);
+            Assert.AreNotEqual(bufferB, bufferC);
+            Assert.AreNotEqual(contextB, contextC);
+            Assert.AreEqual(1, allocator.HitCount);
+            Assert.AreEqual(2, allocator.MissCount);
+
+            allocator.Free(bufferB, contextB);
+            allocator.Free(bufferC, contextC);
+            allocator.Trim();
+            Assert.AreEqual(0, allocator.PooledBytes);
+        }
+
+        [TestMethod]
+        public void TestBuffersSurviveGarbageCollection()
+        {
+            var allocator = new PinnedArrayMemoryAllocator();
+            const int size = 640 * 576 * 2;
+
+            var buffer = allocator.Allocate(size, out var context);
+            Marshal.WriteInt64(buffer, 0x0123456789ABCDEF);
+
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            GC.Collect();
+
+            // Array is kept alive by allocator and is not moved
+            Assert.AreEqual(0x0123456789ABCDEF, Marshal.ReadInt64(buffer));
+
+            allocator.Free(buffer, context);
+            allocator.Trim();
+        }
+
+        [TestMethod]
+        public void TestMemoryCap()
+        {
+            const int size = 64 * 1024;
+            var allocator = new PinnedArrayMemoryAllocator(maxPooledBytes: size * 2);
+
+            var buffers = new IntPtr[5];
+            var contexts = new IntPtr[buffers.Length];
+            for (var i = 0; i < buffers.Length; i++)
+                buffers[i] = allocator.Allocate(size, out contexts[i]);
+            for (var i = 0; i < buffers.Length; i++)
+                allocator.Free(buffers[i], contexts[i]);
+
+            // Only two buffers fit into the cap, the rest must be released
+            Assert.AreEqual(size * 2, allocator.PooledBytes);
+
+            allocator.Trim();
+            Assert.AreEqual(0, allocator.PooledBytes);
+
+            // Slots of released arrays are reused
+            var buffer = allocator.Allocate(size, out var context);
+            Assert.IsTrue(Array.IndexOf(contexts, context) >= 0);
+            allocator.Free(buffer, context);
+        }
+
+        [TestMethod]
+        public void TestNotPooledHugeBuffers()
+        {
+            var allocator = new PinnedArrayMemoryAllocator();
+            var buffer = allocator.Allocate(PooledMemoryAllocator.MaxPooledBufferSize + 1, out var context);
+            Assert.AreNotEqual(IntPtr.Zero, buffer);
+            allocator.Free(buffer, context);
+            Assert.AreEqual(0, allocator.PooledBytes);
+        }
+
+        [TestMethod]
+        public void TestDoubleFree()
+        {
+            var allocator = new PinnedArrayMemoryAllocator();
+            const int size = 1000;
+
+            var buffer = allocator.Allocate(size, out var context);
+            allocator.Free(buffer, context);
+            var pooledBytes = allocator.PooledBytes;
+
+            // Second release is ignored: buffer is pooled only once
+            allocator.Free(buffer, context);
+            Assert.AreEqual(pooledBytes, allocator.PooledBytes);
+
+            var bufferA = allocator.Allocate(size, out var contextA);
+            var bufferB = allocator.Allocate(size, out var contextB);
+            Assert.AreNotEqual(bufferA, bufferB);
+            Assert.AreEqual(1, allocator.HitCount);
+
+            // Stale release of buffer with another context is ignored too
+            allocator.Free(bufferB, contextA);
+            Assert.AreEqual(0, allocator.PooledBytes);
+
+            allocator.Free(bufferA, contextA);
+            allocator.Free(bufferB, contextB);
+        }
+
+#if !ORBBECSDK_K4A_WRAPPER
+
+        [TestMethod]
+        public void TestImageCreationWithPinnedArrayAllocator()
+        {
+            var allocator = new PinnedArrayMemoryAllocator();
+            var format = ImageFormat.Depth16;
+            var stride = format.StrideBytes(640);
+            var size = format.ImageSizeBytes(stride, 576);
+
+            IntPtr firstBuffer;
+            using (var image = new Image(format, 640, 576, stride, size, allocator))
+            {
+                firstBuffer = image.Buffer;
+                Assert.AreEqual(size, image.SizeBytes);
+            }
+
+            Assert.AreEqual(1, allocator.MissCount);
+            Assert.IsTrue(allocator.PooledBytes >= size);
+
+            using (var image = new Image(format, 640, 576, stride, size, allocator))
+            {
+                Assert.AreEqual(firstBuffer, image.Buffer);
+            }
+
+            Assert.AreEqual(1, allocator.HitCount);
+            Assert.AreEqual(1, allocator.MissCount);
+            allocator.Trim();
+        }
+
+#endif
+    }
+}
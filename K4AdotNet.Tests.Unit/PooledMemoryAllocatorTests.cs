@@ -0,0 +1,217 @@
+﻿using K4AdotNet.Sensor;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Threading;
+
+namespace K4AdotNet.Tests.Unit
+{
+    [TestClass]
+    public class PooledMemoryAllocatorTests
+    {
+        [TestMethod]
+        public void TestSizeClasses()
+        {
+            var allocator = new PooledMemoryAllocator();
+
+            for (var size = 1; size <= 64 * 1024 * 1024; size = size * 3 / 2 + 1)
+            {
+                var buffer = allocator.Allocate(size, out var context);
+                allocator.Free(buffer, context);
+                var pooledSize = allocator.PooledBytes;
+                allocator.Trim();
+
+                // Pooled buffer must be big enough
+                Assert.IsTrue(pooledSize >= size);
+                // But not too big: no more than 25% overhead for non-minimal size classes
+                if (size > PooledMemoryAllocator.MinPooledBufferSize)
+                    Assert.IsTrue(pooledSize - size <= pooledSize / 4);
+            }
+
+            // Buffers of power-of-two sizes (like WFOV unbinned depth map) have exact size classes
+            var depthWfovSize = 1024 * 1024 * 2;
+            var depthWfovBuffer = allocator.Allocate(depthWfovSize, out var depthWfovContext);
+            allocator.Free(depthWfovBuffer, depthWfovContext);
+            Assert.AreEqual(depthWfovSize, allocator.PooledBytes);
+            allocator.Trim();
+        }
+
+        [TestMethod]
+        public void TestHitsAndMisses()
+        {
+            var allocator = new PooledMemoryAllocator();
+            const int size = 1280 * 720 * 4;
+
+            var bufferA = allocator.Allocate(size, out var contextA);
+            Assert.AreNotEqual(IntPtr.Zero, bufferA);
+            Assert.AreEqual(0, allocator.HitCount);
+            Assert.AreEqual(1, allocator.MissCount);
+
+            allocator.Free(bufferA, contextA);
+            Assert.IsTrue(allocator.PooledBytes >= size);
+
+            // The same size class -> the same buffer
+            var bufferB = allocator.Allocate(size - 100, out var contextB);
+            Assert.AreEqual(bufferA, bufferB);
+            Assert.AreEqual(contextA, contextB);
+            Assert.AreEqual(1, allocator.HitCount);
+            Assert.AreEqual(1, allocator.MissCount);
+            Assert.AreEqual(0, allocator.PooledBytes);
+
+            // Another size class -> new buffer
+            var bufferC = allocator.Allocate(size * 2, out var contextC);
+            Assert.AreNotEqual(bufferB, bufferC);
+            Assert.AreEqual(1, allocator.HitCount);
+            Assert.AreEqual(2, allocator.MissCount);
+
+            allocator.Free(bufferB, contextB);
+            allocator.Free(bufferC, contextC);
+            allocator.Trim();
+            Assert.AreEqual(0, allocator.PooledBytes);
+        }
+
+        [TestMethod]
+        public void TestBuffersReleasedOnOtherThreadAreReused()
+        {
+            var allocator = new PooledMemoryAllocator();
+            const int size = 640 * 576 * 2;
+
+            var buffers = new IntPtr[4];
+            var contexts = new IntPtr[buffers.Length];
+            for (var i = 0; i < buffers.Length; i++)
+                buffers[i] = allocator.Allocate(size, out contexts[i]);
+
+            var thread = new Thread(() =>
+            {
+                for (var i = 0; i < buffers.Length; i++)
+                    allocator.Free(buffers[i], contexts[i]);
+            });
+            thread.Start();
+            thread.Join();
+
+            for (var i = 0; i < buffers.Length; i++)
+            {
+                var buffer = allocator.Allocate(size, out var context);
+                Assert.AreNotEqual(Array.IndexOf(buffers, buffer), -1);
+                allocator.Free(buffer, context);
+            }
+
+            Assert.AreEqual(buffers.Length, allocator.HitCount);
+            Assert.AreEqual(buffers.Length, allocator.MissCount);
+            allocator.Trim();
+        }
+
+        [TestMethod]
+        public void TestMemoryCap()
+        {
+            const int size = 64 * 1024;
+            var allocator = new PooledMemoryAllocator(maxPooledBytes: size * 2, System.Threading.Timeout.InfiniteTimeSpan);
+
+            var buffers = new IntPtr[5];
+            var contexts = new IntPtr[buffers.Length];
+            for (var i = 0; i < buffers.Length; i++)
+                buffers[i] = allocator.Allocate(size, out contexts[i]);
+            for (var i = 0; i < buffers.Length; i++)
+                allocator.Free(buffers[i], contexts[i]);
+
+            // Only two buffers fit into the cap, the rest must be released
+            Assert.AreEqual(size * 2, allocator.PooledBytes);
+
+            allocator.Trim();
+            Assert.AreEqual(0, allocator.PooledBytes);
+        }
+
+        [TestMethod]
+        public void TestIdleTimeout()
+        {
+            const int size = 64 * 1024;
+            var allocator = new PooledMemoryAllocator(PooledMemoryAllocator.DefaultMaxPooledBytes, TimeSpan.FromMilliseconds(50));
+
+            var bufferA = allocator.Allocate(size, out var contextA);
+            var bufferB = allocator.Allocate(size, out var contextB);
+            allocator.Free(bufferA, contextA);
+            allocator.Free(bufferB, contextB);      // bufferA goes from thread-local slot to global free list
+            Assert.AreEqual(size * 2, allocator.PooledBytes);
+
+            Thread.Sleep(200);
+
+            // Releasing of some buffer triggers trimming of idle buffers in global free list
+            var bufferC = allocator.Allocate(size * 4, out var contextC);
+            allocator.Free(bufferC, contextC);
+            Assert.AreEqual(size + size * 4, allocator.PooledBytes);
+
+            allocator.Trim();
+            Assert.AreEqual(0, allocator.PooledBytes);
+        }
+
+        [TestMethod]
+        public void TestIdleTimeoutOfExitedThreadCache()
+        {
+            const int size = 64 * 1024;
+            var allocator = new PooledMemoryAllocator(PooledMemoryAllocator.DefaultMaxPooledBytes, TimeSpan.FromMilliseconds(50));
+
+            // Buffer released by a thread is kept in its thread-local slot
+            var thread = new Thread(() =>
+            {
+                var buffer = allocator.Allocate(size, out var context);
+                allocator.Free(buffer, context);
+            });
+            thread.Start();
+            thread.Join();
+            Assert.AreEqual(size, allocator.PooledBytes);
+
+            // The first idle check moves it to the global free list, the next one releases it
+            for (var i = 0; i < 2; i++)
+            {
+                Thread.Sleep(100);
+                var other = allocator.Allocate(size * 4, out var otherContext);
+                allocator.Free(other, otherContext);
+            }
+
+            Assert.AreEqual(size * 4, allocator.PooledBytes);
+            allocator.Trim();
+            Assert.AreEqual(0, allocator.PooledBytes);
+        }
+
+        [TestMethod]
+        public void TestNotPooledHugeBuffers()
+        {
+            var allocator = new PooledMemoryAllocator();
+            var buffer = allocator.Allocate(PooledMemoryAllocator.MaxPooledBufferSize + 1, out var context);
+            Assert.AreNotEqual(IntPtr.Zero, buffer);
+            allocator.Free(buffer, context);
+            Assert.AreEqual(0, allocator.PooledBytes);
+        }
+
+#if !ORBBECSDK_K4A_WRAPPER
+
+        [TestMethod]
+        public void TestImageCreationWithPooledAllocator()
+        {
+            var allocator = new PooledMemoryAllocator();
+            var format = ImageFormat.Depth16;
+            var stride = format.StrideBytes(640);
+            var size = format.ImageSizeBytes(stride, 576);
+
+            IntPtr firstBuffer;
+            using (var image = new Image(format, 640, 576, stride, size, allocator))
+            {
+                firstBuffer = image.Buffer;
+                Assert.AreEqual(size, image.SizeBytes);
+            }
+
+            Assert.AreEqual(1, allocator.MissCount);
+            Assert.IsTrue(allocator.PooledBytes >= size);
+
+            using (var image = new Image(format, 640, 576, stride, size, allocator))
+            {
+                Assert.AreEqual(firstBuffer, image.Buffer);
+            }
+
+            Assert.AreEqual(1, allocator.HitCount);
+            Assert.AreEqual(1, allocator.MissCount);
+            allocator.Trim();
+        }
+
+#endif
+    }
+}
@@ -32,9 +32,9 @@ namespace K4AdotNet.Tests.Unit.Sensor
             }
         }
 
-        private byte[] ReadRawCalibrationFromResources()
+        internal static byte[] ReadRawCalibrationFromResources()
         {
-            var assembly = GetType().Assembly;
+            var assembly = typeof(CalibrationTests).Assembly;
             using (var stream = assembly.GetManifestResourceStream("K4AdotNet.Tests.Unit.raw_calibration.bin"))
             {
                 var rawCalibration = new byte[stream.Length];
@@ -69,6 +69,62 @@ namespace K4AdotNet.Tests.Unit.Sensor
             Assert.AreEqual(colorResolution, calibration.ColorResolution);
         }
 
+#endregion
+
+        #region Blittable calibration
+
+        [TestMethod]
+        public void TestBlittableCalibrationRoundTrip()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R1080p, 32f, out var calibration);
+            calibration.SetExtrinsics(CalibrationGeometry.Gyro, CalibrationGeometry.Accel,
+                new CalibrationExtrinsics { Rotation = Float3x3.Identity, Translation = new Float3(1f, 2f, 3f) });
+
+            var blittable = calibration.ToBlittable();
+            Assert.IsTrue(blittable.IsValid);
+            Assert.AreEqual(calibration.DepthMode, blittable.DepthMode);
+            Assert.AreEqual(calibration.ColorResolution, blittable.ColorResolution);
+            Assert.AreEqual(calibration.DepthCameraCalibration.Intrinsics.Parameters.Fx, blittable.DepthCameraCalibration.Intrinsics.Parameters.Fx);
+            Assert.AreEqual(calibration.ColorCameraCalibration.ResolutionWidth, blittable.ColorCameraCalibration.ResolutionWidth);
+
+            foreach (CalibrationGeometry source in Enum.GetValues(typeof(CalibrationGeometry)))
+            {
+                foreach (CalibrationGeometry target in Enum.GetValues(typeof(CalibrationGeometry)))
+                {
+                    if (source < 0 || source >= CalibrationGeometry.Count || target < 0 || target >= CalibrationGeometry.Count)
+                        continue;
+                    var expected = calibration.GetExtrinsics(source, target);
+                    var actual = blittable.GetExtrinsics(source, target);
+                    Assert.AreEqual(expected.Rotation, actual.Rotation);
+                    Assert.AreEqual(expected.Translation, actual.Translation);
+                }
+            }
+
+            blittable.ToCalibration(out var restored);
+            Assert.IsTrue(restored.IsValid);
+            Assert.AreEqual(new Float3(1f, 2f, 3f), restored.GetExtrinsics(CalibrationGeometry.Gyro, CalibrationGeometry.Accel).Translation);
+            Assert.AreEqual(new Float3(32f, 0f, 0f), restored.GetExtrinsics(CalibrationGeometry.Color, CalibrationGeometry.Depth).Translation);
+        }
+
+        [TestMethod]
+        public void TestBlittableCalibrationConversions()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, 32f, out var calibration);
+            var blittable = calibration.ToBlittable();
+
+            var point3d = new Float3(100f, -50f, 1500f);
+            Assert.AreEqual(calibration.Convert3DTo2D(point3d, CalibrationGeometry.Depth, CalibrationGeometry.Color),
+                blittable.Convert3DTo2D(point3d, CalibrationGeometry.Depth, CalibrationGeometry.Color));
+            Assert.AreEqual(calibration.Convert3DTo3D(point3d, CalibrationGeometry.Depth, CalibrationGeometry.Color),
+                blittable.Convert3DTo3D(point3d, CalibrationGeometry.Depth, CalibrationGeometry.Color));
+
+            var point2d = new Float2(300f, 200f);
+            Assert.AreEqual(calibration.Convert2DTo3D(point2d, 1500f, CalibrationGeometry.Depth, CalibrationGeometry.Color),
+                blittable.Convert2DTo3D(point2d, 1500f, CalibrationGeometry.Depth, CalibrationGeometry.Color));
+            Assert.AreEqual(calibration.Convert2DTo2D(point2d, 1500f, CalibrationGeometry.Depth, CalibrationGeometry.Color),
+                blittable.Convert2DTo2D(point2d, 1500f, CalibrationGeometry.Depth, CalibrationGeometry.Color));
+        }
+
 #endregion
 
         #region Convert2DTo2D
@@ -0,0 +1,357 @@
+﻿using K4AdotNet.BodyTracking;
+using K4AdotNet.Sensor;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Collections.Generic;
+
+namespace K4AdotNet.Tests.Unit.Sensor
+{
+    [TestClass]
+    public class CameraModelTests
+    {
+        #region Comparison with native implementation
+
+        [TestMethod]
+        public void TestConvert2DTo3DOnDummyCalibration()
+        {
+            TestConvert2DTo3DOnDummyCalibration(DepthMode.NarrowView2x2Binned, ColorResolution.R720p);
+            TestConvert2DTo3DOnDummyCalibration(DepthMode.NarrowViewUnbinned, ColorResolution.R1080p);
+#if !ORBBECSDK_K4A_WRAPPER
+            TestConvert2DTo3DOnDummyCalibration(DepthMode.WideView2x2Binned, ColorResolution.R1536p);
+            TestConvert2DTo3DOnDummyCalibration(DepthMode.WideViewUnbinned, ColorResolution.R3072p);
+#endif
+        }
+
+        private static void TestConvert2DTo3DOnDummyCalibration(DepthMode depthMode, ColorResolution colorResolution)
+        {
+            Calibration.CreateDummy(depthMode, colorResolution, 30, out var calibration);
+            CompareWithNative(in calibration);
+        }
+
+        [TestMethod]
+        public void TestConvert2DTo3DOnRawCalibration()
+        {
+            var rawCalibration = CalibrationTests.ReadRawCalibrationFromResources();
+
+            Calibration.CreateFromRaw(rawCalibration, DepthMode.NarrowViewUnbinned, ColorResolution.R1080p, out var calibration);
+            CompareWithNative(in calibration);
+
+#if !ORBBECSDK_K4A_WRAPPER
+            Calibration.CreateFromRaw(rawCalibration, DepthMode.WideViewUnbinned, ColorResolution.R3072p, out calibration);
+            CompareWithNative(in calibration);
+#endif
+        }
+
+        private static void CompareWithNative(in Calibration calibration)
+        {
+            foreach (var sourceCamera in new[] { CalibrationGeometry.Depth, CalibrationGeometry.Color })
+            {
+                var cameraCalibration = sourceCamera == CalibrationGeometry.Depth ? calibration.DepthCameraCalibration : calibration.ColorCameraCalibration;
+                var points2D = CreatePointGrid(cameraCalibration.ResolutionWidth, cameraCalibration.ResolutionHeight, step: 37);
+                var depthsMm = new float[points2D.Length];
+                for (var i = 0; i < depthsMm.Length; i++)
+                    depthsMm[i] = i % 11 == 0 ? 0f : 500f + (i * 7919) % 4000;
+
+                foreach (var targetCamera in CalibrationGeometries.All)
+                {
+                    var points3DMm = new Float3[points2D.Length];
+                    var validFlags = new bool[points2D.Length];
+                    var validCount = calibration.Convert2DTo3D(points2D, depthsMm, sourceCamera, targetCamera, points3DMm, validFlags);
+
+                    var expectedValidCount = 0;
+                    for (var i = 0; i < points2D.Length; i++)
+                    {
+                        var expected = calibration.Convert2DTo3D(points2D[i], depthsMm[i], sourceCamera, targetCamera);
+                        Assert.AreEqual(expected.HasValue, validFlags[i], $"{sourceCamera}->{targetCamera}: {points2D[i]}");
+                        if (expected.HasValue)
+                        {
+                            expectedValidCount++;
+                            Assert.AreEqual(expected.Value.X, points3DMm[i].X, 0.05f);
+                            Assert.AreEqual(expected.Value.Y, points3DMm[i].Y, 0.05f);
+                            Assert.AreEqual(expected.Value.Z, points3DMm[i].Z, 0.05f);
+                        }
+                        else
+                        {
+                            Assert.AreEqual(Float3.Zero, points3DMm[i]);
+                        }
+                    }
+
+                    Assert.AreEqual(expectedValidCount, validCount);
+
+                    CompareProjectionWithNative(in calibration, points3DMm, validFlags, targetCamera);
+                }
+            }
+        }
+
+        private static void CompareProjectionWithNative(in Calibration calibration, Float3[] points3DMm, bool[] pointFlags, CalibrationGeometry sourceCameraOrSensor)
+        {
+            foreach (var targetCamera in new[] { CalibrationGeometry.Depth, CalibrationGeometry.Color })
+            {
+                var points2D = new Float2[points3DMm.Length];
+                var validFlags = new bool[points3DMm.Length];
+                var validCount = calibration.Convert3DTo2D(points3DMm, sourceCameraOrSensor, targetCamera, points2D, validFlags);
+
+                var transformedPoints3DMm = new Float3[points3DMm.Length];
+                calibration.Convert3DTo3D(points3DMm, sourceCameraOrSensor, targetCamera, transformedPoints3DMm);
+
+                var expectedValidCount = 0;
+                for (var i = 0; i < points3DMm.Length; i++)
+                {
+                    var expected3D = calibration.Convert3DTo3D(points3DMm[i], sourceCameraOrSensor, targetCamera);
+                    Assert.AreEqual(expected3D.X, transformedPoints3DMm[i].X, 0.05f);
+                    Assert.AreEqual(expected3D.Y, transformedPoints3DMm[i].Y, 0.05f);
+                    Assert.AreEqual(expected3D.Z, transformedPoints3DMm[i].Z, 0.05f);
+
+                    // Skip zero points (invalid results of unprojection)
+                    if (!pointFlags[i])
+                        continue;
+
+                    var expected = calibration.Convert3DTo2D(points3DMm[i], sourceCameraOrSensor, targetCamera);
+                    Assert.AreEqual(expected.HasValue, validFlags[i], $"{sourceCameraOrSensor}->{targetCamera}: {points3DMm[i]}");
+                    if (expected.HasValue)
+                    {
+                        expectedValidCount++;
+                        Assert.AreEqual(expected.Value.X, points2D[i].X, 0.01f);
+                        Assert.AreEqual(expected.Value.Y, points2D[i].Y, 0.01f);
+                    }
+                    else
+                    {
+                        Assert.AreEqual(Float2.Zero, points2D[i]);
+                    }
+                }
+
+                for (var i = 0; i < points3DMm.Length; i++)
+                {
+                    if (!pointFlags[i])
+                        Assert.IsFalse(validFlags[i]);
+                }
+                Assert.AreEqual(expectedValidCount, validCount);
+            }
+        }
+
+        // Grid of points covering image and some margin outside of it
+        private static Float2[] CreatePointGrid(int width, int height, int step)
+        {
+            var points = new List<Float2>();
+            for (var y = -step; y < height + step; y += step)
+            {
+                for (var x = -step; x < width + step; x += step)
+                    points.Add(new Float2(x + 0.25f, y + 0.5f));
+            }
+            return points.ToArray();
+        }
+
+        #endregion
+
+        #region Managed implementation
+
+        [TestMethod]
+        public void TestUnprojectionOfDistortedCamera()
+        {
+            TestUnprojectionOfDistortedCamera(CalibrationModel.BrownConrady);
+#pragma warning disable CS0612 // Type or member is obsolete
+            TestUnprojectionOfDistortedCamera(CalibrationModel.Rational6KT);
+#pragma warning restore CS0612 // Type or member is obsolete
+        }
+
+        private static void TestUnprojectionOfDistortedCamera(CalibrationModel calibrationModel)
+        {
+            var model = new CameraModel(CreateDistortedCameraCalibration(calibrationModel));
+
+            // Principal point is not distorted
+            Assert.IsTrue(model.TryUnproject(new Float2(508.8f, 512.8f), out var ray));
+            Assert.AreEqual(0f, ray.X, 1e-6f);
+            Assert.AreEqual(0f, ray.Y, 1e-6f);
+
+            // Distortion is not negligible: compare with ray of pin-hole camera
+            Assert.IsTrue(model.TryUnproject(new Float2(200f, 800f), out ray));
+            Assert.IsTrue(Math.Abs(ray.X - (200f - 508.8f) / 504.5f) > 0.1f);
+
+            // Point far from center is outside of metric radius
+            Assert.IsFalse(model.TryUnproject(new Float2(-5000f, -5000f), out _));
+
+            // Batch results are the same as results of one-by-one processing (and it does not matter whether batch is vectorized or not)
+            var points2D = CreatePointGrid(1024, 1024, step: 29);
+            var depthsMm = new float[points2D.Length];
+            for (var i = 0; i < depthsMm.Length; i++)
+                depthsMm[i] = i % 13 == 0 ? 0f : 1000f;
+            var points3DMm = new Float3[points2D.Length];
+            var validFlags = new bool[points2D.Length];
+            var validCount = model.Unproject(points2D, depthsMm, points3DMm, validFlags);
+
+            var expectedValidCount = 0;
+            for (var i = 0; i < points2D.Length; i++)
+            {
+                var isValid = depthsMm[i] != 0f && model.TryUnproject(points2D[i], out ray);
+                Assert.AreEqual(isValid, validFlags[i], points2D[i].ToString());
+                if (isValid)
+                {
+                    expectedValidCount++;
+                    Assert.AreEqual(ray.X * 1000f, points3DMm[i].X, 0.01f);
+                    Assert.AreEqual(ray.Y * 1000f, points3DMm[i].Y, 0.01f);
+                    Assert.AreEqual(1000f, points3DMm[i].Z);
+                }
+            }
+
+            Assert.AreEqual(expectedValidCount, validCount);
+            Assert.IsTrue(validCount > 0);
+            Assert.IsTrue(validCount < points2D.Length);
+        }
+
+        [TestMethod]
+        public void TestProjectionOfDistortedCamera()
+        {
+            TestProjectionOfDistortedCamera(CalibrationModel.BrownConrady);
+#pragma warning disable CS0612 // Type or member is obsolete
+            TestProjectionOfDistortedCamera(CalibrationModel.Rational6KT);
+#pragma warning restore CS0612 // Type or member is obsolete
+        }
+
+        private static void TestProjectionOfDistortedCamera(CalibrationModel calibrationModel)
+        {
+            var model = new CameraModel(CreateDistortedCameraCalibration(calibrationModel));
+
+            // Points behind camera cannot be projected
+            Assert.IsFalse(model.TryProject(new Float3(10f, 10f, 0f), out _));
+            Assert.IsFalse(model.TryProject(new Float3(10f, 10f, -1000f), out _));
+
+            // Projection is inverse of unprojection
+            var points2D = CreatePointGrid(1024, 1024, step: 29);
+            var points3DMm = new Float3[points2D.Length];
+            var unprojectedFlags = new bool[points2D.Length];
+            var depthsMm = new float[points2D.Length];
+            depthsMm.AsSpan().Fill(1500f);
+            model.Unproject(points2D, depthsMm, points3DMm, unprojectedFlags);
+
+            var projectedPoints2D = new Float2[points2D.Length];
+            var validFlags = new bool[points2D.Length];
+            var validCount = model.Project(points3DMm, projectedPoints2D, validFlags);
+
+            var expectedValidCount = 0;
+            for (var i = 0; i < points2D.Length; i++)
+            {
+                var isValid = model.TryProject(points3DMm[i], out var point2D);
+                Assert.AreEqual(isValid, validFlags[i], points3DMm[i].ToString());
+                if (isValid)
+                {
+                    expectedValidCount++;
+                    Assert.AreEqual(point2D.X, projectedPoints2D[i].X, 1e-3f);
+                    Assert.AreEqual(point2D.Y, projectedPoints2D[i].Y, 1e-3f);
+                }
+
+                if (unprojectedFlags[i])
+                {
+                    Assert.IsTrue(validFlags[i]);
+                    Assert.AreEqual(points2D[i].X, projectedPoints2D[i].X, 0.01f);
+                    Assert.AreEqual(points2D[i].Y, projectedPoints2D[i].Y, 0.01f);
+                }
+            }
+
+            Assert.AreEqual(expectedValidCount, validCount);
+        }
+
+        [TestMethod]
+        public void TestProjectionOfSkeleton()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+
+            var skeleton = new Skeleton();
+            foreach (var jointType in JointTypes.All)
+            {
+                var index = (int)jointType;
+                skeleton[jointType] = new Joint
+                {
+                    PositionMm = new Float3(-400f + index * 25f, 300f - index * 20f, 1500f + index * 10f),
+                    Orientation = Quaternion.Identity,
+                };
+            }
+            // One joint is behind camera
+            skeleton.Head = new Joint { PositionMm = new Float3(0f, 0f, -100f), Orientation = Quaternion.Identity };
+
+            foreach (var targetCamera in new[] { CalibrationGeometry.Depth, CalibrationGeometry.Color })
+            {
+                var points2D = new Float2[JointTypes.All.Count];
+                var validFlags = new bool[JointTypes.All.Count];
+                var validCount = calibration.Convert3DTo2D(in skeleton, targetCamera, points2D, validFlags);
+
+                Assert.AreEqual(JointTypes.All.Count - 1, validCount);
+                Assert.IsFalse(validFlags[(int)JointType.Head]);
+                foreach (var jointType in JointTypes.All)
+                {
+                    var expected = calibration.Convert3DTo2D(skeleton[jointType].PositionMm, CalibrationGeometry.Depth, targetCamera);
+                    var index = (int)jointType;
+                    Assert.AreEqual(expected.HasValue, validFlags[index]);
+                    if (expected.HasValue)
+                    {
+                        Assert.AreEqual(expected.Value.X, points2D[index].X, 0.01f);
+                        Assert.AreEqual(expected.Value.Y, points2D[index].Y, 0.01f);
+                    }
+                }
+            }
+
+            Assert.ThrowsException<ArgumentException>(() => calibration.Convert3DTo2D(in skeleton, CalibrationGeometry.Depth, new Float2[10], new bool[32]));
+        }
+
+        // Intrinsics similar to real depth camera in 1024x1024 mode
+        internal static CameraCalibration CreateDistortedCameraCalibration(CalibrationModel calibrationModel)
+        {
+            var calibration = new CameraCalibration
+            {
+                ResolutionWidth = 1024,
+                ResolutionHeight = 1024,
+                MetricRadius = 1.74f,
+            };
+            calibration.Intrinsics.Model = calibrationModel;
+            calibration.Intrinsics.ParameterCount = 14;
+            calibration.Intrinsics.Parameters = new CalibrationIntrinsicParameters
+            {
+                Cx = 508.8f,
+                Cy = 512.8f,
+                Fx = 504.5f,
+                Fy = 504.6f,
+                K1 = 1.0900357f,
+                K2 = 0.59171402f,
+                K3 = 0.031530701f,
+                K4 = 1.4247553f,
+                K5 = 0.90157372f,
+                K6 = 0.16505491f,
+                P2 = -2.9178953e-5f,
+                P1 = -5.2796036e-5f,
+            };
+            return calibration;
+        }
+
+        [TestMethod]
+        public void TestInvalidArguments()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.Off, out var calibration);
+
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => calibration.GetCameraModel(CalibrationGeometry.Gyro));
+            Assert.ThrowsException<InvalidOperationException>(() => calibration.GetCameraModel(CalibrationGeometry.Color));
+            Assert.ThrowsException<ArgumentException>(() => new CameraModel(calibration.ColorCameraCalibration));
+
+            var model = calibration.GetCameraModel(CalibrationGeometry.Depth);
+            var points2D = new Float2[10];
+            Assert.ThrowsException<ArgumentException>(() => model.Unproject(points2D, new float[9], new Float3[10], new bool[10]));
+            Assert.ThrowsException<ArgumentException>(() => model.Unproject(points2D, new float[10], new Float3[9], new bool[10]));
+            Assert.ThrowsException<ArgumentException>(() => model.Unproject(points2D, new float[10], new Float3[10], new bool[9]));
+            Assert.AreEqual(0, model.Unproject(points2D, new float[10], new Float3[11], new bool[11]));
+
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => calibration.Convert2DTo3D(points2D, new float[10],
+                CalibrationGeometry.Gyro, CalibrationGeometry.Depth, new Float3[10], new bool[10]));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => calibration.Convert2DTo3D(points2D, new float[10],
+                CalibrationGeometry.Depth, CalibrationGeometry.Unknown, new Float3[10], new bool[10]));
+
+            var points3D = new Float3[10];
+            Assert.ThrowsException<ArgumentException>(() => model.Project(points3D, new Float2[9], new bool[10]));
+            Assert.ThrowsException<ArgumentException>(() => model.Project(points3D, new Float2[10], new bool[9]));
+            Assert.AreEqual(0, model.Project(points3D, new Float2[10], new bool[10]));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => calibration.Convert3DTo2D(points3D,
+                CalibrationGeometry.Depth, CalibrationGeometry.Gyro, new Float2[10], new bool[10]));
+            Assert.ThrowsException<ArgumentException>(() => calibration.Convert3DTo3D(points3D,
+                CalibrationGeometry.Depth, CalibrationGeometry.Gyro, new Float3[9]));
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,302 @@
+﻿using K4AdotNet.Sensor;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Threading.Tasks;
+
+namespace K4AdotNet.Tests.Unit.Sensor
+{
+    [TestClass]
+    public class CameraRayTableTests
+    {
+        [TestMethod]
+        public void TestDistortedCamera()
+        {
+            var cameraCalibration = CameraModelTests.CreateDistortedCameraCalibration(CalibrationModel.BrownConrady);
+            var table = CameraRayTable.GetOrCreate(in cameraCalibration);
+            CheckTable(table, new CameraModel(in cameraCalibration));
+
+            // Corners are outside of metric radius
+            Assert.IsFalse(table.IsValid(0, 0));
+            Assert.IsTrue(table.ValidCount < table.WidthPixels * table.HeightPixels);
+        }
+
+        [TestMethod]
+        public void TestWidthIsNotMultipleOfBitmapWord()
+        {
+            var cameraCalibration = CameraModelTests.CreateDistortedCameraCalibration(CalibrationModel.BrownConrady);
+            cameraCalibration.ResolutionWidth = 101;
+            cameraCalibration.ResolutionHeight = 37;
+            cameraCalibration.Intrinsics.Parameters.Cx = 50f;
+            cameraCalibration.Intrinsics.Parameters.Cy = 18f;
+            cameraCalibration.Intrinsics.Parameters.Fx = 20f;
+            cameraCalibration.Intrinsics.Parameters.Fy = 20f;
+
+            var table = CameraRayTable.GetOrCreate(in cameraCalibration);
+            Assert.AreEqual(101, table.WidthPixels);
+            Assert.AreEqual(37, table.HeightPixels);
+            Assert.AreEqual((101 * 37 + 63) / 64, table.ValidityBitmap.Length);
+            CheckTable(table, new CameraModel(in cameraCalibration));
+        }
+
+        [TestMethod]
+        public void TestCalibrationCameras()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+
+            var depthTable = calibration.GetRayTable(CalibrationGeometry.Depth);
+            Assert.AreEqual(640, depthTable.WidthPixels);
+            Assert.AreEqual(576, depthTable.HeightPixels);
+            CheckTable(depthTable, calibration.GetCameraModel(CalibrationGeometry.Depth));
+
+            var colorTable = calibration.GetRayTable(CalibrationGeometry.Color);
+            Assert.AreEqual(1280, colorTable.WidthPixels);
+            Assert.AreEqual(720, colorTable.HeightPixels);
+            CheckTable(colorTable, calibration.GetCameraModel(CalibrationGeometry.Color));
+
+            // Depth multiplied by ray gives 3D point
+            var x = 123;
+            var y = 456;
+            var ray = depthTable.Rays[y * depthTable.WidthPixels + x];
+            var point3DMm = calibration.Convert2DTo3D(new Float2(x, y), 1000f, CalibrationGeometry.Depth, CalibrationGeometry.Depth);
+            Assert.IsNotNull(point3DMm);
+            Assert.AreEqual(point3DMm.Value.X, ray.X * 1000f, 0.05f);
+            Assert.AreEqual(point3DMm.Value.Y, ray.Y * 1000f, 0.05f);
+        }
+
+        [TestMethod]
+        public void TestCaching()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var table = calibration.GetRayTable(CalibrationGeometry.Depth);
+
+            // Tables are shared between consumers of the same calibration data
+            Assert.AreSame(table, calibration.GetRayTable(CalibrationGeometry.Depth));
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R1080p, out var otherCalibration);
+            Assert.AreSame(table, otherCalibration.GetRayTable(CalibrationGeometry.Depth));
+            Assert.AreSame(table, CameraRayTable.GetOrCreate(calibration.DepthCameraCalibration));
+
+            // Extrinsics do not matter
+            var cameraCalibration = calibration.DepthCameraCalibration;
+            cameraCalibration.Extrinsics.Translation = new Float3(1f, 2f, 3f);
+            Assert.AreSame(table, CameraRayTable.GetOrCreate(in cameraCalibration));
+
+            // But intrinsics do
+            cameraCalibration.Intrinsics.Parameters.Cx += 0.5f;
+            Assert.AreNotSame(table, CameraRayTable.GetOrCreate(in cameraCalibration));
+            Calibration.CreateDummy(DepthMode.WideView2x2Binned, ColorResolution.R720p, out otherCalibration);
+            Assert.AreNotSame(table, otherCalibration.GetRayTable(CalibrationGeometry.Depth));
+        }
+
+        [TestMethod]
+        public void TestConcurrentCreation()
+        {
+            var cameraCalibration = CameraModelTests.CreateDistortedCameraCalibration(CalibrationModel.BrownConrady);
+            cameraCalibration.Intrinsics.Parameters.Cy += 0.25f;
+
+            // Concurrent consumers get one and the same table, which stays in cache after garbage collection
+            var tables = new CameraRayTable[4];
+            Parallel.For(0, tables.Length, i => tables[i] = CameraRayTable.GetOrCreate(in cameraCalibration));
+            foreach (var table in tables)
+                Assert.AreSame(tables[0], table);
+            var reference = new WeakReference<CameraRayTable>(tables[0]);
+            Array.Clear(tables, 0, tables.Length);
+
+            GC.Collect();
+            Assert.IsTrue(reference.TryGetTarget(out var cachedTable));
+            Assert.AreSame(cachedTable, CameraRayTable.GetOrCreate(in cameraCalibration));
+        }
+
+        [TestMethod]
+        public void TestClearCache()
+        {
+            var cameraCalibration = CameraModelTests.CreateDistortedCameraCalibration(CalibrationModel.BrownConrady);
+            cameraCalibration.Intrinsics.Parameters.Cy += 0.5f;
+
+            // After clearing, table is released and computed again
+            var reference = CreateWeakReference(in cameraCalibration);
+            CameraRayTable.ClearCache();
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            Assert.IsFalse(reference.TryGetTarget(out _));
+
+            var table = CameraRayTable.GetOrCreate(in cameraCalibration);
+            Assert.AreSame(table, CameraRayTable.GetOrCreate(in cameraCalibration));
+        }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        private static WeakReference<CameraRayTable> CreateWeakReference(in CameraCalibration cameraCalibration)
+            => new(CameraRayTable.GetOrCreate(in cameraCalibration));
+
+        [TestMethod]
+        public void TestInvalidArguments()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.Off, out var calibration);
+
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => calibration.GetRayTable(CalibrationGeometry.Accel));
+            Assert.ThrowsException<InvalidOperationException>(() => calibration.GetRayTable(CalibrationGeometry.Color));
+            Assert.ThrowsException<ArgumentException>(() => CameraRayTable.GetOrCreate(calibration.ColorCameraCalibration));
+
+            var table = calibration.GetRayTable(CalibrationGeometry.Depth);
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => table.IsValid(-1, 0));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => table.IsValid(0, table.HeightPixels));
+        }
+
+        [TestMethod]
+        public void TestDepthToPointCloud()
+        {
+            var cameraCalibration = CameraModelTests.CreateDistortedCameraCalibration(CalibrationModel.BrownConrady);
+            TestDepthToPointCloud(CameraRayTable.GetOrCreate(in cameraCalibration));
+
+            // Width is not multiple of vector size, rows are padded
+            cameraCalibration.ResolutionWidth = 101;
+            cameraCalibration.ResolutionHeight = 37;
+            cameraCalibration.Intrinsics.Parameters.Fx = 20f;
+            cameraCalibration.Intrinsics.Parameters.Fy = 20f;
+            cameraCalibration.Intrinsics.Parameters.Cx = 50f;
+            cameraCalibration.Intrinsics.Parameters.Cy = 18f;
+            TestDepthToPointCloud(CameraRayTable.GetOrCreate(in cameraCalibration));
+        }
+
+        private static void TestDepthToPointCloud(CameraRayTable table)
+        {
+            var width = table.WidthPixels;
+            var height = table.HeightPixels;
+            var strideBytes = (width + 3) * sizeof(short);
+            var depthData = new short[strideBytes / sizeof(short) * height];
+            for (var y = 0; y < height; y++)
+            {
+                for (var x = 0; x < width; x++)
+                    depthData[y * strideBytes / sizeof(short) + x] = (short)((x * 7 + y * 13) % 17 == 0 ? 0 : 500 + (x * 31 + y * 17) % 60000);
+            }
+
+            var pin = GCHandle.Alloc(depthData, GCHandleType.Pinned);
+            try
+            {
+                var depthMap = new ReadOnlyImageView<short>(pin.AddrOfPinnedObject(), width, height, strideBytes);
+
+                var points = new Float3[width * height];
+                var validCount = table.DepthToPointCloud(depthMap, points);
+
+                var pointsInMeters = new Vector3[width * height];
+                Assert.AreEqual(validCount, table.DepthToPointCloud(depthMap, pointsInMeters, inMeters: true));
+
+                var compactPoints = new Float3[width * height];
+                Assert.AreEqual(validCount, table.DepthToPointCloud(depthMap, compactPoints, validPointsOnly: true));
+
+                var expectedValidCount = 0;
+                for (var y = 0; y < height; y++)
+                {
+                    for (var x = 0; x < width; x++)
+                    {
+                        var i = y * width + x;
+                        var depth = (ushort)depthMap[x, y];
+                        if (depth != 0 && table.IsValid(x, y))
+                        {
+                            var ray = table.Rays[i];
+                            var expected = new Float3(ray.X * depth, ray.Y * depth, depth);
+                            Assert.AreEqual(expected, points[i], $"({x}, {y})");
+                            Assert.AreEqual(expected, compactPoints[expectedValidCount]);
+                            Assert.AreEqual(expected.X / 1000f, pointsInMeters[i].X, 1e-4f);
+                            Assert.AreEqual(expected.Y / 1000f, pointsInMeters[i].Y, 1e-4f);
+                            Assert.AreEqual(expected.Z / 1000f, pointsInMeters[i].Z, 1e-4f);
+                            expectedValidCount++;
+                        }
+                        else
+                        {
+                            Assert.AreEqual(Float3.Zero, points[i], $"({x}, {y})");
+                            Assert.AreEqual(Vector3.Zero, pointsInMeters[i]);
+                        }
+                    }
+                }
+
+                Assert.AreEqual(expectedValidCount, validCount);
+                Assert.IsTrue(validCount > 0);
+
+                Assert.ThrowsException<ArgumentException>(() => table.DepthToPointCloud(
+                    new ReadOnlyImageView<short>(pin.AddrOfPinnedObject(), width, height, strideBytes), new Float3[width * height - 1]));
+                Assert.ThrowsException<ArgumentException>(() => table.DepthToPointCloud(
+                    new ReadOnlyImageView<short>(pin.AddrOfPinnedObject(), width - 1, height, strideBytes), new Float3[width * height]));
+            }
+            finally
+            {
+                pin.Free();
+            }
+        }
+
+        [TestMethod]
+        public void TestDepthImageToPointCloud()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowView2x2Binned, ColorResolution.Off, out var calibration);
+            var width = calibration.DepthMode.WidthPixels();
+            var height = calibration.DepthMode.HeightPixels();
+
+            using var depthImage = new Image(ImageFormat.Depth16, width, height);
+            var depthPixels = new short[depthImage.SizeBytes / sizeof(short)];
+            for (var i = 0; i < depthPixels.Length; i++)
+                depthPixels[i] = (short)(i % 5 == 0 ? 0 : 1000 + i % 3000);
+            depthImage.FillFrom(depthPixels);
+
+            var points = new Float3[width * height];
+            var validCount = calibration.DepthImageToPointCloud(depthImage, CalibrationGeometry.Depth, points);
+            Assert.IsTrue(validCount > 0);
+
+            for (var y = 0; y < height; y += 7)
+            {
+                for (var x = 0; x < width; x += 5)
+                {
+                    var depth = depthPixels[y * depthImage.StrideBytes / sizeof(short) + x];
+                    var expected = calibration.Convert2DTo3D(new Float2(x, y), depth, CalibrationGeometry.Depth, CalibrationGeometry.Depth);
+                    var point = points[y * width + x];
+                    if (expected.HasValue)
+                    {
+                        Assert.AreEqual(expected.Value.X, point.X, 0.05f);
+                        Assert.AreEqual(expected.Value.Y, point.Y, 0.05f);
+                        Assert.AreEqual(expected.Value.Z, point.Z, 0.05f);
+                    }
+                    else
+                    {
+                        Assert.AreEqual(Float3.Zero, point);
+                    }
+                }
+            }
+
+            Assert.ThrowsException<ArgumentNullException>(() => calibration.DepthImageToPointCloud(null!, CalibrationGeometry.Depth, points));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => calibration.DepthImageToPointCloud(depthImage, CalibrationGeometry.Gyro, points));
+            Assert.ThrowsException<InvalidOperationException>(() => calibration.DepthImageToPointCloud(depthImage, CalibrationGeometry.Color, points));
+        }
+
+        private static void CheckTable(CameraRayTable table, CameraModel model)
+        {
+            Assert.AreEqual(table.WidthPixels * table.HeightPixels, table.Rays.Length);
+
+            var validCount = 0;
+            foreach (var bits in table.ValidityBitmap)
+                validCount += BitOperations.PopCount((ulong)bits);
+            Assert.AreEqual(table.ValidCount, validCount);
+            Assert.IsTrue(validCount > 0);
+
+            var step = Math.Max(1, table.HeightPixels / 50);
+            for (var y = 0; y < table.HeightPixels; y += step)
+            {
+                for (var x = 0; x < table.WidthPixels; x += step)
+                {
+                    var ray = table.Rays[y * table.WidthPixels + x];
+                    var isValid = model.TryUnproject(new Float2(x, y), out var expectedRay);
+                    Assert.AreEqual(isValid, table.IsValid(x, y), $"({x}, {y})");
+                    if (isValid)
+                    {
+                        Assert.AreEqual(expectedRay.X, ray.X, 1e-5f);
+                        Assert.AreEqual(expectedRay.Y, ray.Y, 1e-5f);
+                    }
+                    else
+                    {
+                        Assert.AreEqual(Float2.Zero, ray);
+                    }
+                }
+            }
+        }
+    }
+}
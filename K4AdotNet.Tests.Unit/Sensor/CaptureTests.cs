@@ -272,5 +272,54 @@ namespace K4AdotNet.Tests.Unit.Sensor
             Assert.IsTrue(depthImage.IsDisposed);
             Assert.IsTrue(irImage.IsDisposed);
         }
+
+        [TestMethod]
+        public void TestCachedImages()
+        {
+            var capture = new Capture { CacheImages = true };
+            Assert.IsTrue(capture.CacheImages);
+            Assert.IsNull(capture.DepthImage);
+
+            using (var image = new Image(ImageFormat.Depth16, 2, 2))
+            {
+                capture.DepthImage = image;
+            }
+
+            // One and the same borrowed object is returned on each call
+            var depthImage1 = capture.DepthImage;
+            var depthImage2 = capture.DepthImage;
+            Assert.IsNotNull(depthImage1);
+            Assert.AreSame(depthImage1, depthImage2);
+            Assert.IsTrue(depthImage1.IsBorrowed);
+
+            // Dispose() does nothing for borrowed image
+            using (var depthImage3 = capture.DepthImage)
+            {
+                Assert.AreSame(depthImage1, depthImage3);
+            }
+            Assert.IsFalse(depthImage1.IsDisposed);
+
+            // But owned reference can be created
+            var ownedDepthImage = depthImage1.DuplicateReference();
+            Assert.IsFalse(ownedDepthImage.IsBorrowed);
+
+            // Setter invalidates cached image
+            using (var image = new Image(ImageFormat.Depth16, 4, 4))
+            {
+                capture.DepthImage = image;
+            }
+            Assert.IsTrue(depthImage1.IsDisposed);
+            var depthImage4 = capture.DepthImage;
+            Assert.IsNotNull(depthImage4);
+            Assert.AreNotSame(depthImage1, depthImage4);
+            Assert.AreEqual(4, depthImage4.WidthPixels);
+
+            // Disposing of capture disposes borrowed images but not owned ones
+            capture.Dispose();
+            Assert.IsTrue(depthImage4.IsDisposed);
+            Assert.IsFalse(ownedDepthImage.IsDisposed);
+            Assert.AreEqual(2, ownedDepthImage.WidthPixels);
+            ownedDepthImage.Dispose();
+        }
     }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
-using Microsoft.VisualStudio.TestTools.UnitTesting;
+﻿using Microsoft.VisualStudio.TestTools.UnitTesting;
 using K4AdotNet.Sensor;
 using System;
+using System.Linq;
 using System.Runtime.InteropServices;
 
 namespace K4AdotNet.Tests.Unit.Sensor
@@ -210,6 +211,66 @@ namespace K4AdotNet.Tests.Unit.Sensor
             Assert.AreEqual(1, disposedEventCounter);
         }
 
+        [TestMethod]
+        public void TestFinalizerFreeObjectTracking()
+        {
+            Image image;
+            Sdk.FinalizerFreeMode = true;
+            Sdk.FinalizerFreeObjectTracking = true;
+            try
+            {
+                image = new Image(ImageFormat.Depth16, testWidth, testHeight);
+            }
+            finally
+            {
+                Sdk.FinalizerFreeMode = false;
+                Sdk.FinalizerFreeObjectTracking = false;
+            }
+
+            // Not disposed object is reported with its type and creation point
+            var leak = Sdk.GetUndisposedFinalizerFreeObjects().Single(item => item.Contains(nameof(TestFinalizerFreeObjectTracking)));
+            StringAssert.StartsWith(leak, typeof(Image).FullName);
+
+            image.Dispose();
+            Assert.IsFalse(Sdk.GetUndisposedFinalizerFreeObjects().Any(item => item.Contains(nameof(TestFinalizerFreeObjectTracking))));
+        }
+
+        [TestMethod]
+        public void TestDisposingInFinalizerFreeMode()
+        {
+            var initialCount = Sdk.FinalizerFreeObjectCount;
+
+            Image image;
+            Sdk.FinalizerFreeMode = true;
+            try
+            {
+                image = new Image(ImageFormat.Depth16, testWidth, testHeight);
+            }
+            finally
+            {
+                Sdk.FinalizerFreeMode = false;
+            }
+
+            // Not disposed object is counted
+            Assert.AreEqual(initialCount + 1, Sdk.FinalizerFreeObjectCount);
+
+            // Sender of event is image object itself
+            object? sender = null;
+            image.Disposed += (s, _) => sender = s;
+            image.Dispose();
+            Assert.IsTrue(image.IsDisposed);
+            Assert.AreSame(image, sender);
+            Assert.AreEqual(initialCount, Sdk.FinalizerFreeObjectCount);
+
+            // Second call of Dispose() doesn't change counter
+            image.Dispose();
+            Assert.AreEqual(initialCount, Sdk.FinalizerFreeObjectCount);
+
+            // Objects created in default mode are not counted
+            using (new Image(ImageFormat.Depth16, testWidth, testHeight))
+                Assert.AreEqual(initialCount, Sdk.FinalizerFreeObjectCount);
+        }
+
         private Image CreateImageFromArray(out WeakReference<byte[]> weakReferenceToArray)
         {
             var format = ImageFormat.ColorBgra32;
@@ -392,6 +453,79 @@ namespace K4AdotNet.Tests.Unit.Sensor
             }
         }
 
+        [TestMethod]
+        public void TestCopyToAndFillFromForSpanWithStride()
+        {
+            // Image with padding at the end of each row
+            using (var image = new Image(ImageFormat.Depth16, 3, 2, 4 * sizeof(short)))
+            {
+                // Tightly packed source
+                var src = new short[] { 1, 2, 3, 4, 5, 6 };
+                image.FillFrom<short>(src, 0);
+                var view = image.GetReadOnlyView<short>();
+                Assert.AreEqual(3, view[2, 0]);
+                Assert.AreEqual(4, view[0, 1]);
+
+                // Destination with stride of 5 elements
+                var dst = new short[5 + 3];
+                image.CopyTo<short>(dst, 5 * sizeof(short));
+                CollectionAssert.AreEqual(new short[] { 1, 2, 3, 0, 0, 4, 5, 6 }, dst);
+
+                // Too small destination
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => image.CopyTo<short>(new short[5], 0));
+                // Too small stride
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => image.CopyTo<short>(new short[100], 2 * sizeof(short)));
+            }
+        }
+
+        [TestMethod]
+        public void TestCopyToImageWithAnotherStride()
+        {
+            using (var src = new Image(ImageFormat.ColorBgra32, 3, 2))
+            using (var dst = new Image(ImageFormat.ColorBgra32, 3, 2, 8 * sizeof(int)))
+            {
+                src.FillFrom(new int[] { 1, 2, 3, 4, 5, 6 });
+                src.CopyTo(dst);
+
+                var view = dst.GetReadOnlyView<int>();
+                Assert.AreEqual(1, view[0, 0]);
+                Assert.AreEqual(3, view[2, 0]);
+                Assert.AreEqual(4, view[0, 1]);
+                Assert.AreEqual(6, view[2, 1]);
+
+                // Size must be the same
+                using (var another = new Image(ImageFormat.ColorBgra32, 2, 2))
+                    Assert.ThrowsException<ArgumentException>(() => src.CopyTo(another));
+            }
+        }
+
+        [TestMethod]
+        public void TestCopyRegionTo()
+        {
+            using (var src = new Image(ImageFormat.Custom8, 4, 3))
+            using (var dst = new Image(ImageFormat.Custom8, 5, 5))
+            {
+                src.FillFrom(new byte[] { 0, 1, 2, 3, 10, 11, 12, 13, 20, 21, 22, 23 });
+
+                var region = new byte[4];
+                src.CopyRegionTo<byte>(1, 1, 2, 2, region, 0);
+                CollectionAssert.AreEqual(new byte[] { 11, 12, 21, 22 }, region);
+
+                dst.FillFrom(new byte[25]);
+                src.CopyRegionTo(1, 1, 2, 2, dst, 3, 3);
+                var view = dst.GetReadOnlyView<byte>();
+                Assert.AreEqual(11, view[3, 3]);
+                Assert.AreEqual(12, view[4, 3]);
+                Assert.AreEqual(21, view[3, 4]);
+                Assert.AreEqual(22, view[4, 4]);
+                Assert.AreEqual(0, view[2, 3]);
+
+                // Out of bounds
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => src.CopyRegionTo<byte>(3, 0, 2, 1, region, 0));
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => src.CopyRegionTo(1, 1, 2, 2, dst, 4, 0));
+            }
+        }
+
         #endregion
 
         #region Test image size calculations
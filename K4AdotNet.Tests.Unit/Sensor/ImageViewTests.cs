@@ -0,0 +1,171 @@
+using K4AdotNet.Sensor;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Tests.Unit.Sensor
+{
+    [TestClass]
+    public class ImageViewTests
+    {
+        private const int testWidth = 5;
+        private const int testHeight = 4;
+        private const int testStride = 16;      // 5 pixels of 2 bytes + 6 bytes of padding
+
+        [TestMethod]
+        public void TestRowsAndIndexing()
+        {
+            var data = new byte[testStride * testHeight];
+            var pin = GCHandle.Alloc(data, GCHandleType.Pinned);
+            try
+            {
+                var view = new ImageView<ushort>(pin.AddrOfPinnedObject(), testWidth, testHeight, testStride);
+                Assert.AreEqual(testWidth, view.WidthPixels);
+                Assert.AreEqual(testHeight, view.HeightPixels);
+                Assert.AreEqual(testStride, view.StrideBytes);
+                Assert.IsFalse(view.IsEmpty);
+
+                for (var y = 0; y < testHeight; y++)
+                {
+                    var row = view.GetRow(y);
+                    Assert.AreEqual(testWidth, row.Length);
+                    for (var x = 0; x < testWidth; x++)
+                        row[x] = (ushort)(y * 100 + x);
+                }
+
+                for (var y = 0; y < testHeight; y++)
+                {
+                    for (var x = 0; x < testWidth; x++)
+                    {
+                        Assert.AreEqual((ushort)(y * 100 + x), view[x, y]);
+                        Assert.AreEqual((ushort)(y * 100 + x), BitConverter.ToUInt16(data, y * testStride + x * sizeof(ushort)));
+                    }
+
+                    // Padding is not touched
+                    for (var i = testWidth * sizeof(ushort); i < testStride; i++)
+                        Assert.AreEqual(0, data[y * testStride + i]);
+                }
+
+                view[1, 2] = 12345;
+                ReadOnlyImageView<ushort> readOnlyView = view;
+                Assert.AreEqual(12345, readOnlyView[1, 2]);
+                Assert.AreEqual(12345, readOnlyView.GetRow(2)[1]);
+            }
+            finally
+            {
+                pin.Free();
+            }
+        }
+
+        [TestMethod]
+        public void TestSlicing()
+        {
+            var data = new byte[testStride * testHeight];
+            var pin = GCHandle.Alloc(data, GCHandleType.Pinned);
+            try
+            {
+                var view = new ImageView<ushort>(pin.AddrOfPinnedObject(), testWidth, testHeight, testStride);
+                for (var y = 0; y < testHeight; y++)
+                    for (var x = 0; x < testWidth; x++)
+                        view[x, y] = (ushort)(y * 100 + x);
+
+                var slice = view.Slice(1, 2, 3, 2);
+                Assert.AreEqual(3, slice.WidthPixels);
+                Assert.AreEqual(2, slice.HeightPixels);
+                Assert.AreEqual(testStride, slice.StrideBytes);
+                Assert.AreEqual((ushort)201, slice[0, 0]);
+                Assert.AreEqual((ushort)303, slice[2, 1]);
+                Assert.AreEqual((ushort)302, slice.GetRow(1)[1]);
+
+                slice.Fill(7);
+                Assert.AreEqual((ushort)200, view[0, 2]);
+                Assert.AreEqual((ushort)7, view[1, 2]);
+                Assert.AreEqual((ushort)7, view[3, 3]);
+                Assert.AreEqual((ushort)304, view[4, 3]);
+
+                var empty = view.AsReadOnly().Slice(testWidth, testHeight, 0, 0);
+                Assert.IsTrue(empty.IsEmpty);
+            }
+            finally
+            {
+                pin.Free();
+            }
+        }
+
+        [TestMethod]
+        public void TestBoundsChecking()
+        {
+            var data = new byte[testStride * testHeight];
+            var pin = GCHandle.Alloc(data, GCHandleType.Pinned);
+            try
+            {
+                var buffer = pin.AddrOfPinnedObject();
+
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => new ImageView<ushort>(buffer, testWidth, testHeight, testWidth));
+                Assert.ThrowsException<ArgumentNullException>(() => new ImageView<ushort>(IntPtr.Zero, testWidth, testHeight, testStride));
+
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => new ImageView<ushort>(buffer, testWidth, testHeight, testStride)[testWidth, 0]);
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => new ImageView<ushort>(buffer, testWidth, testHeight, testStride)[0, testHeight]);
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => new ImageView<ushort>(buffer, testWidth, testHeight, testStride)[-1, 0]);
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => new ImageView<ushort>(buffer, testWidth, testHeight, testStride).GetRow(-1).Length);
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => new ReadOnlyImageView<ushort>(buffer, testWidth, testHeight, testStride).GetRow(testHeight).Length);
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => new ImageView<ushort>(buffer, testWidth, testHeight, testStride).Slice(2, 0, testWidth - 1, 1).WidthPixels);
+                Assert.ThrowsException<ArgumentOutOfRangeException>(() => new ReadOnlyImageView<ushort>(buffer, testWidth, testHeight, testStride).Slice(0, 1, 1, testHeight).WidthPixels);
+            }
+            finally
+            {
+                pin.Free();
+            }
+        }
+
+        [TestMethod]
+        public void TestBgraPixelLayout()
+        {
+            Assert.AreEqual(4, Marshal.SizeOf<BgraPixel>());
+            var pixel = new BgraPixel(1, 2, 3, 4);
+            var data = new byte[4];
+            var pin = GCHandle.Alloc(data, GCHandleType.Pinned);
+            try
+            {
+                var view = new ImageView<BgraPixel>(pin.AddrOfPinnedObject(), 1, 1, 4);
+                view[0, 0] = pixel;
+                CollectionAssert.AreEqual(new byte[] { 1, 2, 3, 4 }, data);
+            }
+            finally
+            {
+                pin.Free();
+            }
+        }
+
+        [TestMethod]
+        public void TestImageViews()
+        {
+            using (var depth = new Image(ImageFormat.Depth16, testWidth, testHeight))
+            {
+                var view = depth.GetView<ushort>();
+                Assert.AreEqual(depth.WidthPixels, view.WidthPixels);
+                Assert.AreEqual(depth.HeightPixels, view.HeightPixels);
+                Assert.AreEqual(depth.StrideBytes, view.StrideBytes);
+                Assert.AreEqual(depth.Buffer, view.Buffer);
+
+                view[testWidth - 1, testHeight - 1] = 1000;
+                Assert.AreEqual((short)1000, depth.GetReadOnlyView<short>()[testWidth - 1, testHeight - 1]);
+
+                Assert.ThrowsException<InvalidOperationException>(() => depth.GetView<byte>().WidthPixels);
+                Assert.ThrowsException<InvalidOperationException>(() => depth.GetReadOnlyView<BgraPixel>().WidthPixels);
+            }
+
+            using (var color = new Image(ImageFormat.ColorBgra32, testWidth, testHeight))
+            {
+                color.GetView<BgraPixel>()[2, 3] = new BgraPixel(10, 20, 30);
+                Assert.AreEqual(new BgraPixel(10, 20, 30), color.GetReadOnlyView<BgraPixel>()[2, 3]);
+                Assert.AreEqual(0xFF1E140Au, color.GetReadOnlyView<uint>()[2, 3]);
+                Assert.ThrowsException<InvalidOperationException>(() => color.GetView<ushort>().WidthPixels);
+            }
+
+            var disposed = new Image(ImageFormat.Depth16, testWidth, testHeight);
+            disposed.Dispose();
+            Assert.ThrowsException<ObjectDisposedException>(() => disposed.GetView<ushort>().WidthPixels);
+        }
+    }
+}
@@ -0,0 +1,720 @@
+﻿using K4AdotNet.Sensor;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Tests.Unit.Sensor
+{
+    [TestClass]
+    public class ManagedTransformationTests
+    {
+        private const int DepthWidth = 640;
+        private const int DepthHeight = 576;
+        private const int ColorWidth = 1280;
+        private const int ColorHeight = 720;
+
+        #region Depth to color
+
+        [TestMethod]
+        public void TestDepthToColorOfPlane()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+
+            var depthMap = new short[DepthWidth * DepthHeight];
+            depthMap.AsSpan().Fill(2000);
+            var transformedDepthMap = DepthToColor(transformation, depthMap);
+
+            // Center of color image is covered by depth
+            Assert.AreNotEqual(0, transformedDepthMap[ColorHeight / 2 * ColorWidth + ColorWidth / 2]);
+
+            // Each pixel with depth corresponds to a point of the plane Z = 2000 mm in depth camera space
+            var colorModel = calibration.GetCameraModel(CalibrationGeometry.Color);
+            var coveredCount = 0;
+            for (var y = 0; y < ColorHeight; y += 3)
+            {
+                for (var x = 0; x < ColorWidth; x += 3)
+                {
+                    var depth = (ushort)transformedDepthMap[y * ColorWidth + x];
+                    if (depth == 0)
+                        continue;
+
+                    coveredCount++;
+                    Assert.IsTrue(colorModel.TryUnproject(new Float2(x, y), out var ray));
+                    var colorPoint = new[] { new Float3(ray.X * depth, ray.Y * depth, depth) };
+                    var depthPoint = new Float3[1];
+                    calibration.Convert3DTo3D(colorPoint, CalibrationGeometry.Color, CalibrationGeometry.Depth, depthPoint);
+                    Assert.AreEqual(2000f, depthPoint[0].Z, 2f, $"({x}, {y})");
+                }
+            }
+
+            Assert.IsTrue(coveredCount > 1000);
+        }
+
+        [TestMethod]
+        public void TestDepthToColorZTest()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+
+            // Foreground square over background
+            var depthMap = new short[DepthWidth * DepthHeight];
+            depthMap.AsSpan().Fill(3000);
+            for (var y = 200; y < 380; y++)
+                depthMap.AsSpan(y * DepthWidth + 230, 180).Fill(1000);
+            var transformedDepthMap = DepthToColor(transformation, depthMap);
+
+            var foreground = GetTransformedDepth(calibration, transformedDepthMap, 320, 290, 1000);
+            Assert.AreEqual(1000f, foreground, 10f);
+            var background = GetTransformedDepth(calibration, transformedDepthMap, 100, 100, 3000);
+            Assert.AreEqual(3000f, background, 30f);
+
+            // Background never overwrites foreground
+            foreach (var depth in transformedDepthMap)
+                Assert.IsTrue((ushort)depth <= 3100);
+        }
+
+        [TestMethod]
+        public void TestDepthToColorOfEmptyDepthMap()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+
+            // Output is fully overwritten
+            var transformedDepthMap = DepthToColor(transformation, new short[DepthWidth * DepthHeight], initialValue: 123);
+            foreach (var depth in transformedDepthMap)
+                Assert.AreEqual(0, depth);
+        }
+
+        [TestMethod]
+        public void TestDepthToColorComparedWithNative()
+        {
+            // Native transformation needs depth engine. Tolerances below are not verified yet against real Sensor SDK.
+            if (!NativeLibrary.TryLoad(Sdk.DEPTHENGINE_DLL_NAME, typeof(Sdk).Assembly, null, out var depthEngine))
+                Assert.Inconclusive($"{Sdk.DEPTHENGINE_DLL_NAME} library is not available: there is nothing to compare with.");
+            NativeLibrary.Free(depthEngine);
+
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var managedTransformation = calibration.CreateManagedTransformation();
+            using var transformation = calibration.CreateTransformation();
+
+            using var depthImage = new Image(ImageFormat.Depth16, DepthWidth, DepthHeight);
+            var depthPixels = new short[DepthWidth * DepthHeight];
+            for (var y = 0; y < DepthHeight; y++)
+            {
+                for (var x = 0; x < DepthWidth; x++)
+                    depthPixels[y * DepthWidth + x] = (short)(x > 300 && x < 400 && y > 250 && y < 350 ? 1200 : 2500 + x + y);
+            }
+            depthImage.FillFrom(depthPixels);
+
+            using var nativeResult = new Image(ImageFormat.Depth16, ColorWidth, ColorHeight);
+            using var managedResult = new Image(ImageFormat.Depth16, ColorWidth, ColorHeight);
+            transformation.DepthImageToColorCamera(depthImage, nativeResult);
+            managedTransformation.DepthImageToColorCamera(depthImage, managedResult);
+
+            var nativePixels = new short[ColorWidth * ColorHeight];
+            var managedPixels = new short[ColorWidth * ColorHeight];
+            nativeResult.CopyTo(nativePixels);
+            managedResult.CopyTo(managedPixels);
+
+            int nativeCount = 0, managedCount = 0, bothCount = 0, closeCount = 0;
+            for (var i = 0; i < nativePixels.Length; i++)
+            {
+                if (nativePixels[i] != 0)
+                    nativeCount++;
+                if (managedPixels[i] != 0)
+                    managedCount++;
+                if (nativePixels[i] != 0 && managedPixels[i] != 0)
+                {
+                    bothCount++;
+                    if (Math.Abs(nativePixels[i] - managedPixels[i]) <= 2)
+                        closeCount++;
+                }
+            }
+
+            Assert.IsTrue(nativeCount > 0);
+            Assert.AreEqual(nativeCount, managedCount, nativeCount * 0.02);
+            Assert.IsTrue(bothCount > nativeCount * 0.98);
+            Assert.IsTrue(closeCount > bothCount * 0.99);
+        }
+
+        [TestMethod]
+        public void TestDepthToColorInvalidArguments()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+            Assert.ThrowsException<ArgumentException>(() => DepthToColor(transformation, new short[DepthWidth * DepthHeight], depthWidth: DepthWidth - 1));
+            Assert.ThrowsException<ArgumentException>(() => DepthToColor(transformation, new short[DepthWidth * DepthHeight], colorWidth: ColorWidth - 1));
+            Assert.ThrowsException<ArgumentNullException>(() => transformation.DepthImageToColorCamera(null!, null!));
+
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.Off, out calibration);
+            transformation = calibration.CreateManagedTransformation();
+            Assert.ThrowsException<InvalidOperationException>(() => DepthToColor(transformation, new short[DepthWidth * DepthHeight]));
+
+            Assert.ThrowsException<InvalidOperationException>(() => new ManagedTransformation(default(Calibration)));
+        }
+
+        // Depth of transformed depth map at projection of a given depth pixel assuming a given depth of it
+        private static float GetTransformedDepth(in Calibration calibration, short[] transformedDepthMap, int depthX, int depthY, float depthMm)
+        {
+            var ray = calibration.GetRayTable(CalibrationGeometry.Depth).Rays[depthY * DepthWidth + depthX];
+            var point3DMm = new[] { new Float3(ray.X * depthMm, ray.Y * depthMm, depthMm) };
+            var point2D = new Float2[1];
+            Assert.AreEqual(1, calibration.Convert3DTo2D(point3DMm, CalibrationGeometry.Depth, CalibrationGeometry.Color, point2D, new bool[1]));
+            var x = (int)MathF.Round(point2D[0].X);
+            var y = (int)MathF.Round(point2D[0].Y);
+            return (ushort)transformedDepthMap[y * ColorWidth + x];
+        }
+
+        private static short[] DepthToColor(ManagedTransformation transformation, short[] depthMap,
+            int depthWidth = DepthWidth, int colorWidth = ColorWidth, short initialValue = 0)
+        {
+            var transformedDepthMap = new short[ColorWidth * ColorHeight];
+            transformedDepthMap.AsSpan().Fill(initialValue);
+            var depthPin = GCHandle.Alloc(depthMap, GCHandleType.Pinned);
+            var transformedDepthPin = GCHandle.Alloc(transformedDepthMap, GCHandleType.Pinned);
+            try
+            {
+                transformation.DepthImageToColorCamera(
+                    new ReadOnlyImageView<short>(depthPin.AddrOfPinnedObject(), depthWidth, DepthHeight, DepthWidth * sizeof(short)),
+                    new ImageView<short>(transformedDepthPin.AddrOfPinnedObject(), colorWidth, ColorHeight, ColorWidth * sizeof(short)));
+                return transformedDepthMap;
+            }
+            finally
+            {
+                depthPin.Free();
+                transformedDepthPin.Free();
+            }
+        }
+
+        #endregion
+
+        #region Color to depth
+
+        [TestMethod]
+        public void TestColorToDepthOfBgra()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+
+            // Color of pixel encodes its coordinates
+            var colorImage = new BgraPixel[ColorWidth * ColorHeight];
+            for (var y = 0; y < ColorHeight; y++)
+            {
+                for (var x = 0; x < ColorWidth; x++)
+                    colorImage[y * ColorWidth + x] = new BgraPixel((byte)x, (byte)y, (byte)((x >> 8) | ((y >> 8) << 4)));
+            }
+
+            var depthMap = CreateSlantedDepthMap();
+            var transformedColor = ColorToDepth(transformation, depthMap, colorImage, TransformationInterpolation.Nearest);
+
+            var validCount = 0;
+            for (var i = 0; i < depthMap.Length; i++)
+            {
+                var pixel = transformedColor[i];
+                if (!TryProjectDepthPixel(calibration, depthMap, i, out var point2D))
+                {
+                    Assert.AreEqual(default, pixel, $"Pixel {i}");
+                    continue;
+                }
+
+                validCount++;
+                Assert.AreEqual(byte.MaxValue, pixel.A);
+                var x = pixel.B | ((pixel.R & 0x0F) << 8);
+                var y = pixel.G | ((pixel.R >> 4) << 8);
+                Assert.AreEqual(point2D.X, x, 0.501f);
+                Assert.AreEqual(point2D.Y, y, 0.501f);
+            }
+
+            Assert.IsTrue(validCount > depthMap.Length / 4);
+        }
+
+        [TestMethod]
+        public void TestColorToDepthLinear()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+
+            // Linear gradients in both directions
+            var colorImage = new BgraPixel[ColorWidth * ColorHeight];
+            for (var y = 0; y < ColorHeight; y++)
+            {
+                for (var x = 0; x < ColorWidth; x++)
+                    colorImage[y * ColorWidth + x] = new BgraPixel((byte)(x / 5), (byte)(y / 3), 77);
+            }
+
+            var depthMap = CreateSlantedDepthMap();
+            var nearest = ColorToDepth(transformation, depthMap, colorImage, TransformationInterpolation.Nearest);
+            var linear = ColorToDepth(transformation, depthMap, colorImage, TransformationInterpolation.Linear);
+
+            for (var i = 0; i < depthMap.Length; i++)
+            {
+                // The same pixels are valid regardless of interpolation
+                Assert.AreEqual(nearest[i] == default, linear[i] == default, $"Pixel {i}");
+                if (linear[i] == default)
+                    continue;
+
+                Assert.IsTrue(TryProjectDepthPixel(calibration, depthMap, i, out var point2D));
+                var x = Math.Clamp(point2D.X, 0f, ColorWidth - 1);
+                var y = Math.Clamp(point2D.Y, 0f, ColorHeight - 1);
+                Assert.AreEqual(x / 5, linear[i].B, 1.5f);
+                Assert.AreEqual(y / 3, linear[i].G, 1.5f);
+                Assert.AreEqual(77, linear[i].R);
+            }
+        }
+
+        [TestMethod]
+        public void TestColorToDepthOfYuy2AndNv12()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+
+            // The same content in YUY2, NV12 and BGRA (reference conversion in floating point)
+            var yuy2Image = new byte[ColorWidth * ColorHeight * 2];
+            var nv12Image = new byte[ColorWidth * ColorHeight * 3 / 2];
+            var bgraImage = new BgraPixel[ColorWidth * ColorHeight];
+            for (var y = 0; y < ColorHeight; y++)
+            {
+                for (var x = 0; x < ColorWidth; x++)
+                {
+                    var luma = (byte)(16 + (x + 2 * y) % 220);
+                    var u = (byte)(128 + (x / 2) % 64 - 32);
+                    var v = (byte)(128 + 40 - (y / 2) % 80);
+                    yuy2Image[y * ColorWidth * 2 + x * 2] = luma;
+                    yuy2Image[y * ColorWidth * 2 + (x & ~1) * 2 + 1] = u;
+                    yuy2Image[y * ColorWidth * 2 + (x & ~1) * 2 + 3] = v;
+                    nv12Image[y * ColorWidth + x] = luma;
+                    nv12Image[(ColorHeight + y / 2) * ColorWidth + (x & ~1)] = u;
+                    nv12Image[(ColorHeight + y / 2) * ColorWidth + (x & ~1) + 1] = v;
+                    bgraImage[y * ColorWidth + x] = YuvToBgra(luma, u, v);
+                }
+            }
+
+            var depthMap = CreateSlantedDepthMap();
+            foreach (var interpolation in new[] { TransformationInterpolation.Nearest, TransformationInterpolation.Linear })
+            {
+                var fromYuy2 = ColorToDepth(transformation, depthMap, yuy2Image, nv12: false, interpolation);
+                var fromNv12 = ColorToDepth(transformation, depthMap, nv12Image, nv12: true, interpolation);
+                var fromBgra = ColorToDepth(transformation, depthMap, bgraImage, interpolation);
+                for (var i = 0; i < depthMap.Length; i++)
+                {
+                    Assert.AreEqual(fromYuy2[i], fromNv12[i], $"Pixel {i}");
+                    Assert.AreEqual(fromBgra[i] == default, fromYuy2[i] == default, $"Pixel {i}");
+                    if (interpolation == TransformationInterpolation.Nearest)
+                    {
+                        Assert.AreEqual(fromBgra[i].B, fromYuy2[i].B, 2);
+                        Assert.AreEqual(fromBgra[i].G, fromYuy2[i].G, 2);
+                        Assert.AreEqual(fromBgra[i].R, fromYuy2[i].R, 2);
+                    }
+                }
+            }
+        }
+
+        [TestMethod]
+        public void TestColorToDepthInvalidArguments()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+            var depthMap = new short[DepthWidth * DepthHeight];
+            Assert.ThrowsException<ArgumentException>(() => ColorToDepth(transformation, depthMap, new BgraPixel[ColorWidth * ColorHeight], colorHeight: ColorHeight - 1));
+            Assert.ThrowsException<ArgumentException>(() => ColorToDepth(transformation, depthMap, new BgraPixel[ColorWidth * ColorHeight], depthWidth: DepthWidth - 1));
+            Assert.ThrowsException<ArgumentNullException>(() => transformation.ColorImageToDepthCamera(null!, null!, null!));
+
+            Calibration.CreateDummy(DepthMode.Off, ColorResolution.R720p, out calibration);
+            transformation = calibration.CreateManagedTransformation();
+            Assert.ThrowsException<InvalidOperationException>(() => ColorToDepth(transformation, depthMap, new BgraPixel[ColorWidth * ColorHeight]));
+        }
+
+        // Slanted plane from 1000 mm (top) to 2500 mm (bottom) with holes
+        private static short[] CreateSlantedDepthMap()
+        {
+            var depthMap = new short[DepthWidth * DepthHeight];
+            for (var y = 0; y < DepthHeight; y++)
+            {
+                for (var x = 0; x < DepthWidth; x++)
+                    depthMap[y * DepthWidth + x] = (short)((x + y) % 13 == 0 ? 0 : 1000 + 1500 * y / DepthHeight);
+            }
+
+            return depthMap;
+        }
+
+        // Projection of depth pixel to color camera (only if it hits color image)
+        private static bool TryProjectDepthPixel(in Calibration calibration, short[] depthMap, int pixelIndex, out Float2 point2D)
+        {
+            point2D = default;
+            var depth = (ushort)depthMap[pixelIndex];
+            var rayTable = calibration.GetRayTable(CalibrationGeometry.Depth);
+            if (depth == 0 || !rayTable.IsValid(pixelIndex % DepthWidth, pixelIndex / DepthWidth))
+                return false;
+
+            var ray = rayTable.Rays[pixelIndex];
+            var points2D = new Float2[1];
+            if (calibration.Convert3DTo2D(new[] { new Float3(ray.X * depth, ray.Y * depth, depth) }, CalibrationGeometry.Depth, CalibrationGeometry.Color, points2D, new bool[1]) == 0)
+                return false;
+
+            point2D = points2D[0];
+            return point2D.X >= -0.5f && point2D.X < ColorWidth - 0.5f && point2D.Y >= -0.5f && point2D.Y < ColorHeight - 0.5f;
+        }
+
+        private static BgraPixel YuvToBgra(byte y, byte u, byte v)
+        {
+            static byte Clamp(float value) => (byte)Math.Clamp(MathF.Round(value), 0f, 255f);
+            var c = 1.164f * (y - 16);
+            return new BgraPixel(
+                Clamp(c + 2.018f * (u - 128)),
+                Clamp(c - 0.391f * (u - 128) - 0.813f * (v - 128)),
+                Clamp(c + 1.596f * (v - 128)));
+        }
+
+        private static BgraPixel[] ColorToDepth(ManagedTransformation transformation, short[] depthMap, BgraPixel[] colorImage,
+            TransformationInterpolation interpolation = TransformationInterpolation.Nearest,
+            int depthWidth = DepthWidth, int colorHeight = ColorHeight)
+        {
+            using var pins = new PinnedArrays();
+            var transformedColor = new BgraPixel[DepthWidth * DepthHeight];
+            transformation.ColorImageToDepthCamera(
+                new ReadOnlyImageView<short>(pins.Pin(depthMap), depthWidth, DepthHeight, DepthWidth * sizeof(short)),
+                new ReadOnlyImageView<BgraPixel>(pins.Pin(colorImage), ColorWidth, colorHeight, ColorWidth * 4),
+                new ImageView<BgraPixel>(pins.Pin(transformedColor), DepthWidth, DepthHeight, DepthWidth * 4),
+                interpolation);
+            return transformedColor;
+        }
+
+        private static BgraPixel[] ColorToDepth(ManagedTransformation transformation, short[] depthMap, byte[] colorImage, bool nv12,
+            TransformationInterpolation interpolation)
+        {
+            using var pins = new PinnedArrays();
+            var transformedColor = new BgraPixel[DepthWidth * DepthHeight];
+            var depthView = new ReadOnlyImageView<short>(pins.Pin(depthMap), DepthWidth, DepthHeight, DepthWidth * sizeof(short));
+            var transformedView = new ImageView<BgraPixel>(pins.Pin(transformedColor), DepthWidth, DepthHeight, DepthWidth * 4);
+            if (nv12)
+            {
+                transformation.ColorImageToDepthCamera(depthView,
+                    new ReadOnlyImageView<byte>(pins.Pin(colorImage), ColorWidth, ColorHeight, ColorWidth), transformedView, interpolation);
+            }
+            else
+            {
+                transformation.ColorImageToDepthCamera(depthView,
+                    new ReadOnlyImageView<short>(pins.Pin(colorImage), ColorWidth, ColorHeight, ColorWidth * 2), transformedView, interpolation);
+            }
+
+            return transformedColor;
+        }
+
+        private sealed class PinnedArrays : IDisposable
+        {
+            private readonly List<GCHandle> handles = new();
+
+            public IntPtr Pin(Array array)
+            {
+                var handle = GCHandle.Alloc(array, GCHandleType.Pinned);
+                handles.Add(handle);
+                return handle.AddrOfPinnedObject();
+            }
+
+            public void Dispose()
+            {
+                foreach (var handle in handles)
+                    handle.Free();
+            }
+        }
+
+        #endregion
+
+        #region Colored point cloud
+
+        [TestMethod]
+        public void TestColoredPointCloud()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+
+            var colorImage = new BgraPixel[ColorWidth * ColorHeight];
+            for (var i = 0; i < colorImage.Length; i++)
+                colorImage[i] = new BgraPixel((byte)i, (byte)(i >> 8), (byte)(i >> 16));
+            var depthMap = CreateSlantedDepthMap();
+
+            // Reference: separate point cloud and color-to-depth transformation
+            var expectedPositions = new Float3[depthMap.Length];
+            var expectedColors = ColorToDepth(transformation, depthMap, colorImage, TransformationInterpolation.Linear);
+            int expectedCount;
+            using (var pins = new PinnedArrays())
+            {
+                var depthView = new ReadOnlyImageView<short>(pins.Pin(depthMap), DepthWidth, DepthHeight, DepthWidth * sizeof(short));
+                expectedCount = calibration.GetRayTable(CalibrationGeometry.Depth).DepthToPointCloud(depthView, expectedPositions);
+            }
+
+            foreach (var coloredPointsOnly in new[] { false, true })
+            {
+                var points = new ColoredPoint[depthMap.Length];
+                var positions = new Float3[depthMap.Length];
+                var colors = new BgraPixel[depthMap.Length];
+                int count, separateCount;
+                using (var pins = new PinnedArrays())
+                {
+                    var depthView = new ReadOnlyImageView<short>(pins.Pin(depthMap), DepthWidth, DepthHeight, DepthWidth * sizeof(short));
+                    var colorView = new ReadOnlyImageView<BgraPixel>(pins.Pin(colorImage), ColorWidth, ColorHeight, ColorWidth * 4);
+                    count = transformation.DepthImageToColoredPointCloud(depthView, colorView, points,
+                        coloredPointsOnly, inMeters: false, TransformationInterpolation.Linear);
+                    separateCount = transformation.DepthImageToColoredPointCloud(depthView, colorView, positions, colors,
+                        coloredPointsOnly, inMeters: true, TransformationInterpolation.Linear);
+                }
+
+                Assert.AreEqual(count, separateCount);
+
+                var j = 0;
+                for (var i = 0; i < depthMap.Length; i++)
+                {
+                    if (depthMap[i] == 0 || expectedPositions[i].Z == 0)
+                        continue;
+                    if (coloredPointsOnly && expectedColors[i] == default)
+                        continue;
+
+                    Assert.AreEqual(expectedPositions[i], points[j].Position, $"Pixel {i}");
+                    Assert.AreEqual(expectedColors[i], points[j].Color, $"Pixel {i}");
+                    Assert.AreEqual(points[j].Position.X / 1000, positions[j].X, 1e-6f);
+                    Assert.AreEqual(points[j].Position.Y / 1000, positions[j].Y, 1e-6f);
+                    Assert.AreEqual(points[j].Position.Z / 1000, positions[j].Z, 1e-6f);
+                    Assert.AreEqual(points[j].Color, colors[j]);
+                    j++;
+                }
+
+                Assert.AreEqual(j, count);
+                if (coloredPointsOnly)
+                    Assert.IsTrue(count > 0 && count < expectedCount);
+                else
+                    Assert.AreEqual(expectedCount, count);
+            }
+        }
+
+        [TestMethod]
+        public void TestColoredPointCloudInvalidArguments()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+            var depthMap = new short[DepthWidth * DepthHeight];
+            var colorImage = new BgraPixel[ColorWidth * ColorHeight];
+            Assert.ThrowsException<ArgumentException>(() => ColoredPointCloud(transformation, depthMap, colorImage, new ColoredPoint[depthMap.Length - 1]));
+            Assert.ThrowsException<ArgumentNullException>(() => transformation.DepthImageToColoredPointCloud(null!, null!, Span<ColoredPoint>.Empty));
+
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.Off, out calibration);
+            transformation = calibration.CreateManagedTransformation();
+            Assert.ThrowsException<InvalidOperationException>(() => ColoredPointCloud(transformation, depthMap, colorImage, new ColoredPoint[depthMap.Length]));
+        }
+
+        private static int ColoredPointCloud(ManagedTransformation transformation, short[] depthMap, BgraPixel[] colorImage, ColoredPoint[] points)
+        {
+            using var pins = new PinnedArrays();
+            return transformation.DepthImageToColoredPointCloud(
+                new ReadOnlyImageView<short>(pins.Pin(depthMap), DepthWidth, DepthHeight, DepthWidth * sizeof(short)),
+                new ReadOnlyImageView<BgraPixel>(pins.Pin(colorImage), ColorWidth, ColorHeight, ColorWidth * 4),
+                points);
+        }
+
+        #endregion
+
+        #region UV map
+
+        [TestMethod]
+        public void TestColorUVMap()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+            var depthMap = CreateSlantedDepthMap();
+
+            var uvMap = new Float2[depthMap.Length];
+            var validFlags = new bool[depthMap.Length];
+            var normalizedUVMap = new Float2[depthMap.Length];
+            var normalizedValidFlags = new bool[depthMap.Length];
+            int validCount, normalizedValidCount;
+            using (var pins = new PinnedArrays())
+            {
+                var depthView = new ReadOnlyImageView<short>(pins.Pin(depthMap), DepthWidth, DepthHeight, DepthWidth * sizeof(short));
+                validCount = transformation.DepthImageToColorUVMap(depthView, uvMap, validFlags);
+                normalizedValidCount = transformation.DepthImageToColorUVMap(depthView, normalizedUVMap, normalizedValidFlags, normalized: true);
+            }
+
+            Assert.AreEqual(validCount, normalizedValidCount);
+            var expectedValidCount = 0;
+            for (var i = 0; i < depthMap.Length; i++)
+            {
+                Assert.AreEqual(validFlags[i], normalizedValidFlags[i]);
+                if (!TryProjectDepthPixel(calibration, depthMap, i, out var expected))
+                {
+                    Assert.IsFalse(validFlags[i], $"Pixel {i}");
+                    Assert.AreEqual(default, uvMap[i]);
+                    Assert.AreEqual(default, normalizedUVMap[i]);
+                    continue;
+                }
+
+                expectedValidCount++;
+                Assert.IsTrue(validFlags[i], $"Pixel {i}");
+                Assert.AreEqual(expected, uvMap[i]);
+                Assert.AreEqual((expected.X + 0.5f) / ColorWidth, normalizedUVMap[i].X, 1e-6f);
+                Assert.AreEqual((expected.Y + 0.5f) / ColorHeight, normalizedUVMap[i].Y, 1e-6f);
+                Assert.IsTrue(normalizedUVMap[i].X >= 0f && normalizedUVMap[i].X < 1f);
+                Assert.IsTrue(normalizedUVMap[i].Y >= 0f && normalizedUVMap[i].Y < 1f);
+            }
+
+            Assert.AreEqual(expectedValidCount, validCount);
+            Assert.IsTrue(validCount > 0);
+        }
+
+        [TestMethod]
+        public void TestColorUVMapInvalidArguments()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+            var depthMap = new short[DepthWidth * DepthHeight];
+            Assert.ThrowsException<ArgumentException>(() => ColorUVMap(transformation, depthMap, new Float2[depthMap.Length - 1], new bool[depthMap.Length]));
+            Assert.ThrowsException<ArgumentException>(() => ColorUVMap(transformation, depthMap, new Float2[depthMap.Length], new bool[depthMap.Length - 1]));
+            Assert.ThrowsException<ArgumentNullException>(() => transformation.DepthImageToColorUVMap(null!, Span<Float2>.Empty, Span<bool>.Empty));
+
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.Off, out calibration);
+            transformation = calibration.CreateManagedTransformation();
+            Assert.ThrowsException<InvalidOperationException>(() => ColorUVMap(transformation, depthMap, new Float2[depthMap.Length], new bool[depthMap.Length]));
+        }
+
+        private static int ColorUVMap(ManagedTransformation transformation, short[] depthMap, Float2[] uvMap, bool[] validFlags)
+        {
+            using var pins = new PinnedArrays();
+            return transformation.DepthImageToColorUVMap(
+                new ReadOnlyImageView<short>(pins.Pin(depthMap), DepthWidth, DepthHeight, DepthWidth * sizeof(short)),
+                uvMap, validFlags);
+        }
+
+        #endregion
+
+        #region Color 2D to depth 2D
+
+        [TestMethod]
+        public void TestColor2DToDepth2DOfSlantedPlane()
+        {
+            // Epipolar search needs some distance between cameras
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, 30, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+            var depthMap = CreateSlantedDepthMap();
+
+            // Color pixels are projections of depth pixels, thus they should be found back
+            var expectedPoints = new List<Float2>();
+            var colorPoints = new List<Float2>();
+            for (var y = 8; y < DepthHeight - 8; y += 17)
+            {
+                for (var x = 8; x < DepthWidth - 8; x += 17)
+                {
+                    if (TryProjectDepthPixel(calibration, depthMap, y * DepthWidth + x, out var colorPoint))
+                    {
+                        expectedPoints.Add(new Float2(x, y));
+                        colorPoints.Add(colorPoint);
+                    }
+                }
+            }
+
+            // Plus points which are not visible by depth camera
+            colorPoints.Add(new Float2(-1000f, -1000f));
+            expectedPoints.Add(default);
+
+            var depthPoints = new Float2[colorPoints.Count];
+            var validFlags = new bool[colorPoints.Count];
+            var validCount = Color2DToDepth2D(transformation, depthMap, colorPoints.ToArray(), depthPoints, validFlags);
+
+            Assert.AreEqual(colorPoints.Count - 1, validCount);
+            Assert.IsTrue(validCount > 100);
+            for (var i = 0; i < validCount; i++)
+            {
+                Assert.IsTrue(validFlags[i], $"Point {i}");
+                Assert.AreEqual(expectedPoints[i].X, depthPoints[i].X, 0.5f, $"Point {i}");
+                Assert.AreEqual(expectedPoints[i].Y, depthPoints[i].Y, 0.5f, $"Point {i}");
+            }
+
+            Assert.IsFalse(validFlags[validCount]);
+            Assert.AreEqual(default, depthPoints[validCount]);
+        }
+
+        [TestMethod]
+        public void TestColor2DToDepth2DOfEmptyDepthMap()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+
+            var colorPoints = new[] { new Float2(ColorWidth / 2, ColorHeight / 2), new Float2(100f, 100f) };
+            var depthPoints = new[] { new Float2(1f, 1f), new Float2(1f, 1f) };
+            var validFlags = new[] { true, true };
+            var validCount = Color2DToDepth2D(transformation, new short[DepthWidth * DepthHeight], colorPoints, depthPoints, validFlags);
+
+            Assert.AreEqual(0, validCount);
+            CollectionAssert.AreEqual(new[] { false, false }, validFlags);
+            CollectionAssert.AreEqual(new Float2[2], depthPoints);
+        }
+
+        [TestMethod]
+        public void TestColor2DToDepth2DComparedWithNative()
+        {
+            // Unlike other native transformations, this one does not need depth engine
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, 30, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+            var depthMap = CreateSlantedDepthMap();
+            using var depthImage = new Image(ImageFormat.Depth16, DepthWidth, DepthHeight);
+            depthImage.FillFrom(depthMap);
+
+            var colorPoints = new List<Float2>();
+            for (var y = 5; y < ColorHeight; y += 23)
+            {
+                for (var x = 5; x < ColorWidth; x += 23)
+                    colorPoints.Add(new Float2(x, y));
+            }
+
+            var depthPoints = new Float2[colorPoints.Count];
+            var validFlags = new bool[colorPoints.Count];
+            Color2DToDepth2D(transformation, depthMap, colorPoints.ToArray(), depthPoints, validFlags);
+
+            int nativeCount = 0, sameValidityCount = 0, closeCount = 0;
+            for (var i = 0; i < colorPoints.Count; i++)
+            {
+                var nativePoint = calibration.ConvertColor2DToDepth2D(colorPoints[i], depthImage);
+                if (nativePoint.HasValue)
+                    nativeCount++;
+                if (nativePoint.HasValue == validFlags[i])
+                    sameValidityCount++;
+                if (nativePoint.HasValue && validFlags[i]
+                    && Math.Abs(nativePoint.Value.X - depthPoints[i].X) <= 0.01f && Math.Abs(nativePoint.Value.Y - depthPoints[i].Y) <= 0.01f)
+                {
+                    closeCount++;
+                }
+            }
+
+            // Native search unprojects depth pixels iteratively, thus rare ties can be resolved differently
+            Assert.IsTrue(nativeCount > colorPoints.Count / 4);
+            Assert.IsTrue(sameValidityCount > colorPoints.Count * 0.99);
+            Assert.IsTrue(closeCount > nativeCount * 0.99);
+        }
+
+        [TestMethod]
+        public void TestColor2DToDepth2DInvalidArguments()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var transformation = calibration.CreateManagedTransformation();
+            var depthMap = new short[DepthWidth * DepthHeight];
+            Assert.ThrowsException<ArgumentException>(() => Color2DToDepth2D(transformation, depthMap, new Float2[2], new Float2[1], new bool[2]));
+            Assert.ThrowsException<ArgumentException>(() => Color2DToDepth2D(transformation, depthMap, new Float2[2], new Float2[2], new bool[1]));
+            Assert.ThrowsException<ArgumentException>(() => Color2DToDepth2D(transformation, new short[DepthWidth * (DepthHeight - 1)], new Float2[2], new Float2[2], new bool[2], DepthHeight - 1));
+            Assert.ThrowsException<ArgumentNullException>(() => transformation.ConvertColor2DToDepth2D(ReadOnlySpan<Float2>.Empty, null!, Span<Float2>.Empty, Span<bool>.Empty));
+
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.Off, out calibration);
+            transformation = calibration.CreateManagedTransformation();
+            Assert.ThrowsException<InvalidOperationException>(() => Color2DToDepth2D(transformation, depthMap, new Float2[2], new Float2[2], new bool[2]));
+        }
+
+        private static int Color2DToDepth2D(ManagedTransformation transformation, short[] depthMap, Float2[] colorPoints, Float2[] depthPoints, bool[] validFlags,
+            int depthHeight = DepthHeight)
+        {
+            using var pins = new PinnedArrays();
+            return transformation.ConvertColor2DToDepth2D(colorPoints,
+                new ReadOnlyImageView<short>(pins.Pin(depthMap), DepthWidth, depthHeight, DepthWidth * sizeof(short)),
+                depthPoints, validFlags);
+        }
+
+        #endregion
+    }
+}
@@ -0,0 +1,280 @@
+﻿using K4AdotNet.Sensor;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Threading;
+
+namespace K4AdotNet.Tests.Unit.Sensor
+{
+    [TestClass]
+    public class SyntheticDeviceTests
+    {
+        private static readonly DeviceConfiguration config = new DeviceConfiguration
+        {
+            DepthMode = DepthMode.NarrowViewUnbinned,
+            ColorResolution = ColorResolution.R720p,
+            ColorFormat = ImageFormat.ColorBgra32,
+            CameraFps = FrameRate.Thirty,
+        };
+
+        [TestMethod]
+        public void TestCreationAndDisposing()
+        {
+            ICaptureSource device = new SyntheticDevice(new SyntheticDeviceSettings { SerialNumber = "SYN-TEST" });
+            Assert.AreEqual("SYN-TEST", device.SerialNumber);
+            Assert.IsTrue(device.IsConnected);
+            Assert.IsFalse(device.IsDisposed);
+
+            var disposedCount = 0;
+            device.Disposed += (_, _) => disposedCount++;
+            device.Dispose();
+            device.Dispose();
+
+            Assert.IsTrue(device.IsDisposed);
+            Assert.IsFalse(device.IsConnected);
+            Assert.AreEqual(1, disposedCount);
+            Assert.ThrowsException<ObjectDisposedException>(() => device.StartCameras(config));
+            Assert.ThrowsException<ObjectDisposedException>(() => device.TryGetCapture(out _));
+        }
+
+        [TestMethod]
+        public void TestSerialNumbersAndSeeds()
+        {
+            using var device1 = new SyntheticDevice();
+            using var device2 = new SyntheticDevice();
+            Assert.AreNotEqual(device1.SerialNumber, device2.SerialNumber);
+            Assert.AreNotEqual(device1.Seed, device2.Seed);
+
+            using var device3 = new SyntheticDevice(new SyntheticDeviceSettings { SerialNumber = device1.SerialNumber });
+            Assert.AreEqual(device1.Seed, device3.Seed);
+
+            using var device4 = new SyntheticDevice(new SyntheticDeviceSettings { Seed = 42 });
+            Assert.AreEqual(42, device4.Seed);
+        }
+
+        [TestMethod]
+        public void TestInvalidSettings()
+        {
+            Assert.ThrowsException<ArgumentNullException>(() => new SyntheticDevice(null!));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => new SyntheticDevice(new SyntheticDeviceSettings { DropProbability = 1.5 }));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => new SyntheticDevice(new SyntheticDeviceSettings { Jitter = -1 }));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => new SyntheticDevice(new SyntheticDeviceSettings { ScrollRowsPerFrame = -1 }));
+        }
+
+        [TestMethod]
+        public void TestStartCamerasValidation()
+        {
+            using var device = new SyntheticDevice();
+
+            Assert.ThrowsException<ArgumentException>(() => device.StartCameras(DeviceConfiguration.DisableAll));
+
+            var invalidConfig = config;
+            invalidConfig.DepthMode = DepthMode.WideViewUnbinned;
+            Assert.ThrowsException<ArgumentException>(() => device.StartCameras(invalidConfig));
+
+            // MJPEG needs content
+            var mjpgConfig = config;
+            mjpgConfig.ColorFormat = ImageFormat.ColorMjpg;
+            Assert.ThrowsException<ArgumentException>(() => device.StartCameras(mjpgConfig));
+
+            // Wrong size of content
+            device.Settings.DepthContent = new byte[10];
+            Assert.ThrowsException<ArgumentException>(() => device.StartCameras(config));
+            device.Settings.DepthContent = null;
+
+            device.StartCameras(config);
+            Assert.ThrowsException<InvalidOperationException>(() => device.StartCameras(config));
+            device.StopCameras();
+            device.StartCameras(config);
+        }
+
+        [TestMethod]
+        public void TestStreamingIsNotRunning()
+        {
+            using var device = new SyntheticDevice();
+
+            Assert.ThrowsException<InvalidOperationException>(() => device.TryGetCapture(out _));
+            Assert.ThrowsException<InvalidOperationException>(() => device.TryGetImuSample(out _));
+            Assert.ThrowsException<InvalidOperationException>(() => device.StartImu());
+
+            device.StartCameras(config);
+            device.StartImu();
+            Assert.ThrowsException<InvalidOperationException>(() => device.StartImu());
+            device.StopImu();
+            Assert.ThrowsException<InvalidOperationException>(() => device.TryGetImuSample(out _));
+        }
+
+        [TestMethod]
+        public void TestStopImuUnblocksWaitingThread()
+        {
+            using var device = new SyntheticDevice();
+            device.StartCameras(config);
+            device.StartImu();
+
+            Exception? exception = null;
+            using var started = new ManualResetEventSlim();
+            var thread = new Thread(() =>
+            {
+                try
+                {
+                    started.Set();
+                    while (true)
+                        device.GetImuSample();
+                }
+                catch (Exception ex)
+                {
+                    exception = ex;
+                }
+            });
+            thread.Start();
+            started.Wait();
+            Thread.Sleep(20);
+            device.StopImu();
+
+            Assert.IsTrue(thread.Join(TimeSpan.FromSeconds(5)));
+            Assert.IsTrue(exception is InvalidOperationException);
+        }
+
+        [TestMethod]
+        public void TestCalibration()
+        {
+            using var device = new SyntheticDevice();
+
+            device.GetCalibration(DepthMode.WideView2x2Binned, ColorResolution.R1536p, out var calibration);
+            Assert.IsTrue(calibration.IsValid);
+            Assert.AreEqual(DepthMode.WideView2x2Binned, calibration.DepthMode);
+            Assert.AreEqual(ColorResolution.R1536p, calibration.ColorResolution);
+
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => device.GetCalibration(DepthMode.Off, ColorResolution.Off, out _));
+        }
+
+        [TestMethod]
+        public void TestImuSamples()
+        {
+            using var device = new SyntheticDevice(new SyntheticDeviceSettings { RealTime = false, Seed = 1 });
+            device.StartCameras(config);
+            device.StartImu();
+
+            var prevSample = device.GetImuSample();
+            for (var i = 0; i < 100; i++)
+            {
+                var sample = device.GetImuSample();
+
+                // 1.6 kHz
+                Assert.AreEqual(prevSample.AccelerometerTimestamp.ValueUsec + 625, sample.AccelerometerTimestamp.ValueUsec);
+                Assert.AreEqual(sample.AccelerometerTimestamp, sample.GyroTimestamp);
+
+                // Device is standing still
+                Assert.AreEqual(-9.81f, sample.AccelerometerSample.Z, 0.1f);
+                Assert.AreEqual(0f, sample.AccelerometerSample.X, 0.1f);
+                Assert.AreEqual(0f, sample.GyroSample.Y, 0.01f);
+                Assert.AreEqual(30f, sample.Temperature, 1f);
+
+                prevSample = sample;
+            }
+
+            Assert.AreEqual(0, device.DroppedImuSampleCount);
+        }
+
+        [TestMethod]
+        public void TestImuSamplesAreDeterministic()
+        {
+            var settings = new SyntheticDeviceSettings { RealTime = false, Seed = 7 };
+            using var device1 = new SyntheticDevice(settings);
+            using var device2 = new SyntheticDevice(settings);
+            device1.StartCameras(config);
+            device1.StartImu();
+            device2.StartCameras(config);
+            device2.StartImu();
+
+            for (var i = 0; i < 10; i++)
+            {
+                var sample1 = device1.GetImuSample();
+                var sample2 = device2.GetImuSample();
+                Assert.AreEqual(sample1.AccelerometerSample, sample2.AccelerometerSample);
+                Assert.AreEqual(sample1.GyroSample, sample2.GyroSample);
+            }
+        }
+
+        [TestMethod]
+        public void TestRealTimeImuSamples()
+        {
+            using var device = new SyntheticDevice();
+            device.StartCameras(config);
+            device.StartImu();
+
+            // Right after start there is nothing to read
+            Assert.IsFalse(device.TryGetImuSample(out _));
+
+            Assert.IsTrue(device.TryGetImuSample(out var sample, TimeSpan.FromSeconds(1)));
+            Assert.IsTrue(device.TryGetImuSample(out var nextSample, TimeSpan.FromSeconds(1)));
+            Assert.IsTrue(nextSample.AccelerometerTimestamp > sample.AccelerometerTimestamp);
+        }
+
+        [TestMethod]
+        public void TestCaptures()
+        {
+            var configWithDelay = config;
+            configWithDelay.DepthDelayOffColor = 100;
+            using var device = new SyntheticDevice(new SyntheticDeviceSettings { RealTime = false });
+            device.StartCameras(configWithDelay);
+
+            var prevTimestamp = Microseconds64.Zero;
+            for (var i = 0; i < 5; i++)
+            {
+                using var capture = device.GetCapture();
+                using var color = capture.ColorImage;
+                using var depth = capture.DepthImage;
+                using var ir = capture.IRImage;
+
+                Assert.IsNotNull(color);
+                Assert.IsNotNull(depth);
+                Assert.IsNotNull(ir);
+                Assert.AreEqual(ImageFormat.ColorBgra32, color.Format);
+                Assert.AreEqual(1280, color.WidthPixels);
+                Assert.AreEqual(720, color.HeightPixels);
+                Assert.AreEqual(ImageFormat.Depth16, depth.Format);
+                Assert.AreEqual(640, depth.WidthPixels);
+                Assert.AreEqual(576, depth.HeightPixels);
+                Assert.AreEqual(ImageFormat.IR16, ir.Format);
+
+                Assert.AreEqual(color.DeviceTimestamp.ValueUsec + 100, depth.DeviceTimestamp.ValueUsec);
+                Assert.AreEqual(depth.DeviceTimestamp, ir.DeviceTimestamp);
+                if (i > 0)
+                    Assert.AreEqual(33_333.3, color.DeviceTimestamp.ValueUsec - prevTimestamp.ValueUsec, 1.0);
+                prevTimestamp = color.DeviceTimestamp;
+            }
+        }
+
+        [TestMethod]
+        public void TestCaptureDrops()
+        {
+            var settings = new SyntheticDeviceSettings { RealTime = false, DropProbability = 0.5, ScrollRowsPerFrame = 0 };
+            var lowResConfig = new DeviceConfiguration
+            {
+                DepthMode = DepthMode.NarrowView2x2Binned,
+                ColorResolution = ColorResolution.R720p,
+                ColorFormat = ImageFormat.ColorNV12,
+                CameraFps = FrameRate.Thirty,
+                SynchronizedImagesOnly = true,
+            };
+            using var device = new SyntheticDevice(settings);
+            device.StartCameras(lowResConfig);
+
+            var prevTimestamp = Microseconds64.Zero;
+            var gaps = 0;
+            for (var i = 0; i < 20; i++)
+            {
+                using var capture = device.GetCapture();
+                using var color = capture.ColorImage;
+                using var depth = capture.DepthImage;
+                Assert.IsNotNull(color);
+                Assert.IsNotNull(depth);
+                if (i > 0 && color.DeviceTimestamp.ValueUsec - prevTimestamp.ValueUsec > 40_000)
+                    gaps++;
+                prevTimestamp = color.DeviceTimestamp;
+            }
+
+            Assert.IsTrue(gaps > 0);
+        }
+    }
+}
@@ -0,0 +1,316 @@
+﻿using K4AdotNet.Sensor;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Tests.Unit.Sensor
+{
+    [TestClass]
+    public class UndistortionMapTests
+    {
+        [TestMethod]
+        public void TestDistortedCamera()
+        {
+            var cameraCalibration = CameraModelTests.CreateDistortedCameraCalibration(CalibrationModel.BrownConrady);
+            var target = PinholeIntrinsics.FromCameraCalibration(in cameraCalibration);
+            var map = UndistortionMap.GetOrCreate(in cameraCalibration, in target);
+            Assert.AreEqual(target, map.Target);
+
+            var sourcePoints = ProjectTargetPixels(new CameraModel(in cameraCalibration), target, out var validFlags);
+            var width = target.WidthPixels;
+            var height = target.HeightPixels;
+            var expectedValidCount = 0;
+            for (var i = 0; i < validFlags.Length; i++)
+            {
+                Assert.AreEqual(validFlags[i], map.IsValid(i % width, i / width), $"Pixel {i}");
+                if (validFlags[i])
+                    expectedValidCount++;
+            }
+
+            Assert.AreEqual(expectedValidCount, map.ValidCount);
+            Assert.IsTrue(map.ValidCount > width * height / 2);
+
+            // Linear function of coordinates is reproduced by bilinear interpolation up to quantization of weights
+            var source = new short[width * height];
+            for (var i = 0; i < source.Length; i++)
+                source[i] = (short)(30 * (i % width) + 30 * (i / width));
+            var linear = Remap(map, source, TransformationInterpolation.Linear);
+            for (var i = 0; i < linear.Length; i++)
+            {
+                var value = (ushort)linear[i];
+                if (!validFlags[i])
+                {
+                    Assert.AreEqual(0, value);
+                    continue;
+                }
+
+                var u = Math.Clamp(sourcePoints[i].X, 0f, width - 1);
+                var v = Math.Clamp(sourcePoints[i].Y, 0f, height - 1);
+                Assert.AreEqual(30f * u + 30f * v, value, 1f, $"Pixel {i}");
+            }
+
+            // Nearest sampling takes values of source pixels as is
+            for (var i = 0; i < source.Length; i++)
+                source[i] = (short)(i * 7919);
+            var nearest = Remap(map, source, TransformationInterpolation.Nearest);
+            for (var i = 0; i < nearest.Length; i++)
+            {
+                if (!validFlags[i])
+                {
+                    Assert.AreEqual(0, nearest[i]);
+                    continue;
+                }
+
+                var x = (int)MathF.Floor(sourcePoints[i].X + 0.5f);
+                var y = (int)MathF.Floor(sourcePoints[i].Y + 0.5f);
+                Assert.AreEqual(source[y * width + x], nearest[i], $"Pixel {i}");
+            }
+        }
+
+        [TestMethod]
+        public void TestRemapOfBgra()
+        {
+            var cameraCalibration = CameraModelTests.CreateDistortedCameraCalibration(CalibrationModel.BrownConrady);
+            // Target camera with wider field of view and odd width (for processing of row tails)
+            var target = new PinholeIntrinsics(400f, 300f, 200f, 200f, 803, 601);
+            var map = UndistortionMap.GetOrCreate(in cameraCalibration, in target);
+            // Corners of target image are not seen by source camera
+            Assert.IsFalse(map.IsValid(0, 0));
+            Assert.IsTrue(map.ValidCount > 0);
+
+            var width = cameraCalibration.ResolutionWidth;
+            var height = cameraCalibration.ResolutionHeight;
+            var source = new BgraPixel[width * height];
+            var sourceX = new short[width * height];
+            var sourceY = new short[width * height];
+            for (var i = 0; i < source.Length; i++)
+            {
+                var x = (byte)(i % width);
+                var y = (byte)(i / width);
+                source[i] = new BgraPixel(x, y, (byte)(255 - x), (byte)(255 - y));
+                sourceX[i] = x;
+                sourceY[i] = y;
+            }
+
+            // Nearest sampling of color image takes the same pixels as sampling of 16-bit images
+            var nearest = Remap(map, source, TransformationInterpolation.Nearest);
+            var nearestX = Remap(map, sourceX, TransformationInterpolation.Nearest);
+            var nearestY = Remap(map, sourceY, TransformationInterpolation.Nearest);
+            for (var i = 0; i < nearest.Length; i++)
+            {
+                var expected = map.IsValid(i % target.WidthPixels, i / target.WidthPixels)
+                    ? new BgraPixel((byte)nearestX[i], (byte)nearestY[i], (byte)(255 - nearestX[i]), (byte)(255 - nearestY[i]))
+                    : default;
+                Assert.AreEqual(expected, nearest[i], $"Pixel {i}");
+            }
+
+            // Linear function of coordinates is reproduced by bilinear interpolation up to rounding (where it does not wrap around)
+            var sourcePoints = ProjectTargetPixels(new CameraModel(in cameraCalibration), target, out var validFlags);
+            var linear = Remap(map, source, TransformationInterpolation.Linear);
+            var checkedCount = 0;
+            for (var i = 0; i < linear.Length; i++)
+            {
+                if (!validFlags[i])
+                {
+                    Assert.AreEqual(default, linear[i]);
+                    continue;
+                }
+
+                var u = Math.Clamp(sourcePoints[i].X, 0f, width - 1);
+                var v = Math.Clamp(sourcePoints[i].Y, 0f, height - 1);
+                if ((int)u % 256 == 255 || (int)v % 256 == 255)
+                    continue;
+
+                checkedCount++;
+                Assert.AreEqual(u % 256, linear[i].B, 1.5f, $"Pixel {i}");
+                Assert.AreEqual(v % 256, linear[i].G, 1.5f, $"Pixel {i}");
+                Assert.AreEqual(255 - u % 256, linear[i].R, 1.5f, $"Pixel {i}");
+                Assert.AreEqual(255 - v % 256, linear[i].A, 1.5f, $"Pixel {i}");
+            }
+
+            Assert.IsTrue(checkedCount > 0);
+        }
+
+        [TestMethod]
+        public void TestCalibrationCameras()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+
+            var depthMap = calibration.GetUndistortionMap(CalibrationGeometry.Depth);
+            Assert.AreEqual(PinholeIntrinsics.FromCameraCalibration(calibration.DepthCameraCalibration), depthMap.Target);
+            Assert.AreEqual(640, depthMap.Target.WidthPixels);
+            Assert.AreEqual(576, depthMap.Target.HeightPixels);
+            Assert.IsTrue(depthMap.IsValid(320, 288));
+
+            var target = new PinholeIntrinsics(320f, 240f, 500f, 500f, 640, 480);
+            var colorMap = calibration.GetUndistortionMap(CalibrationGeometry.Color, target);
+            Assert.AreEqual(target, colorMap.Target);
+            Assert.AreEqual(640 * 480, colorMap.ValidCount);
+        }
+
+        [TestMethod]
+        public void TestCaching()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var map = calibration.GetUndistortionMap(CalibrationGeometry.Depth);
+
+            // Maps are shared between consumers of the same calibration data and target
+            Assert.AreSame(map, calibration.GetUndistortionMap(CalibrationGeometry.Depth));
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R1080p, out var otherCalibration);
+            Assert.AreSame(map, otherCalibration.GetUndistortionMap(CalibrationGeometry.Depth));
+            Assert.AreSame(map, UndistortionMap.GetOrCreate(calibration.DepthCameraCalibration, map.Target));
+
+            // But target matters
+            var target = map.Target;
+            target.Fx *= 0.9f;
+            Assert.AreNotSame(map, calibration.GetUndistortionMap(CalibrationGeometry.Depth, target));
+        }
+
+        [TestMethod]
+        public void TestClearCache()
+        {
+            Calibration.CreateDummy(DepthMode.WideView2x2Binned, ColorResolution.Off, out var calibration);
+            var target = PinholeIntrinsics.FromCameraCalibration(calibration.DepthCameraCalibration);
+            target.Cx += 0.5f;
+
+            // After clearing, map is released and computed again
+            var reference = CreateWeakReference(in calibration, in target);
+            UndistortionMap.ClearCache();
+            GC.Collect();
+            GC.WaitForPendingFinalizers();
+            Assert.IsFalse(reference.TryGetTarget(out _));
+
+            var map = calibration.GetUndistortionMap(CalibrationGeometry.Depth, target);
+            Assert.AreSame(map, calibration.GetUndistortionMap(CalibrationGeometry.Depth, target));
+        }
+
+        [MethodImpl(MethodImplOptions.NoInlining)]
+        private static WeakReference<UndistortionMap> CreateWeakReference(in Calibration calibration, in PinholeIntrinsics target)
+            => new(calibration.GetUndistortionMap(CalibrationGeometry.Depth, target));
+
+        [TestMethod]
+        public void TestInvalidArguments()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.Off, out var calibration);
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => calibration.GetUndistortionMap(CalibrationGeometry.Gyro));
+            Assert.ThrowsException<InvalidOperationException>(() => calibration.GetUndistortionMap(CalibrationGeometry.Color));
+            Assert.ThrowsException<ArgumentException>(() => calibration.GetUndistortionMap(CalibrationGeometry.Depth, new PinholeIntrinsics(320f, 240f, 0f, 500f, 640, 480)));
+            Assert.ThrowsException<ArgumentException>(() => calibration.GetUndistortionMap(CalibrationGeometry.Depth, new PinholeIntrinsics(320f, 240f, 500f, 500f, 0, 480)));
+
+            // Offsets of pixels in BGRA images of these resolutions do not fit into 32 bits
+            Assert.ThrowsException<ArgumentException>(() => calibration.GetUndistortionMap(CalibrationGeometry.Depth, new PinholeIntrinsics(16000f, 16000f, 500f, 500f, 32000, 32000)));
+            var hugeCamera = calibration.DepthCameraCalibration;
+            hugeCamera.ResolutionWidth = hugeCamera.ResolutionHeight = 32000;
+            Assert.ThrowsException<ArgumentException>(() => UndistortionMap.GetOrCreate(in hugeCamera, new PinholeIntrinsics(320f, 288f, 500f, 500f, 640, 576)));
+
+            var map = calibration.GetUndistortionMap(CalibrationGeometry.Depth);
+            var width = map.Target.WidthPixels;
+            var height = map.Target.HeightPixels;
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => map.IsValid(width, 0));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => map.IsValid(0, -1));
+            Assert.ThrowsException<ArgumentException>(() => Remap(map, new short[width * (height - 1)], TransformationInterpolation.Nearest, height - 1));
+            Assert.ThrowsException<ArgumentOutOfRangeException>(() => Remap(map, new short[width * height], (TransformationInterpolation)2));
+            Assert.ThrowsException<ArgumentNullException>(() => map.Remap(null!, null!));
+
+            // Source stride is too large for 32-bit offsets
+            var pixels = new short[width * height];
+            var handle = GCHandle.Alloc(pixels, GCHandleType.Pinned);
+            try
+            {
+                Assert.ThrowsException<ArgumentException>(() => map.Remap(
+                    new ReadOnlyImageView<short>(handle.AddrOfPinnedObject(), width, height, 4_000_000),
+                    new ImageView<short>(handle.AddrOfPinnedObject(), width, height, width * sizeof(short)),
+                    TransformationInterpolation.Nearest));
+            }
+            finally
+            {
+                handle.Free();
+            }
+        }
+
+        [TestMethod]
+        public void TestRemapOfImages()
+        {
+            Calibration.CreateDummy(DepthMode.NarrowViewUnbinned, ColorResolution.R720p, out var calibration);
+            var map = calibration.GetUndistortionMap(CalibrationGeometry.Depth);
+
+            using var depthImage = new Image(ImageFormat.Depth16, 640, 576);
+            using var irImage = new Image(ImageFormat.IR16, 640, 576);
+            using var targetImage = new Image(ImageFormat.Depth16, 640, 576);
+            depthImage.FillFrom(new short[640 * 576]);
+            map.Remap(depthImage, targetImage);
+            Assert.ThrowsException<ArgumentException>(() => map.Remap(irImage, targetImage));
+
+            using var customImage = new Image(ImageFormat.Custom16, 640, 576, 640 * sizeof(short));
+            using var otherCustomImage = new Image(ImageFormat.Custom16, 640, 576, 640 * sizeof(short));
+            Assert.ThrowsException<ArgumentException>(() => map.Remap(customImage, otherCustomImage));
+        }
+
+        // Projections of rays of target pixels to source camera (in the same way as map does)
+        private static Float2[] ProjectTargetPixels(CameraModel model, PinholeIntrinsics target, out bool[] validFlags)
+        {
+            var rays = new Float3[target.WidthPixels * target.HeightPixels];
+            for (var i = 0; i < rays.Length; i++)
+            {
+                var x = i % target.WidthPixels;
+                var y = i / target.WidthPixels;
+                rays[i] = new Float3((x - target.Cx) / target.Fx, (y - target.Cy) / target.Fy, 1f);
+            }
+
+            var points = new Float2[rays.Length];
+            validFlags = new bool[rays.Length];
+            model.Project(rays, points, validFlags);
+
+            var width = model.CameraCalibration.ResolutionWidth;
+            var height = model.CameraCalibration.ResolutionHeight;
+            for (var i = 0; i < points.Length; i++)
+                validFlags[i] &= points[i].X >= -0.5f && points[i].X < width - 0.5f && points[i].Y >= -0.5f && points[i].Y < height - 0.5f;
+            return points;
+        }
+
+        private static short[] Remap(UndistortionMap map, short[] source, TransformationInterpolation interpolation, int? sourceHeight = null)
+        {
+            var sourceWidth = map.CameraCalibration.ResolutionWidth;
+            var target = new short[map.Target.WidthPixels * map.Target.HeightPixels];
+            var sourceHandle = GCHandle.Alloc(source, GCHandleType.Pinned);
+            var targetHandle = GCHandle.Alloc(target, GCHandleType.Pinned);
+            try
+            {
+                map.Remap(
+                    new ReadOnlyImageView<short>(sourceHandle.AddrOfPinnedObject(), sourceWidth, sourceHeight ?? map.CameraCalibration.ResolutionHeight, sourceWidth * sizeof(short)),
+                    new ImageView<short>(targetHandle.AddrOfPinnedObject(), map.Target.WidthPixels, map.Target.HeightPixels, map.Target.WidthPixels * sizeof(short)),
+                    interpolation);
+            }
+            finally
+            {
+                sourceHandle.Free();
+                targetHandle.Free();
+            }
+
+            return target;
+        }
+
+        private static BgraPixel[] Remap(UndistortionMap map, BgraPixel[] source, TransformationInterpolation interpolation)
+        {
+            var sourceWidth = map.CameraCalibration.ResolutionWidth;
+            var target = new BgraPixel[map.Target.WidthPixels * map.Target.HeightPixels];
+            var sourceHandle = GCHandle.Alloc(source, GCHandleType.Pinned);
+            var targetHandle = GCHandle.Alloc(target, GCHandleType.Pinned);
+            try
+            {
+                map.Remap(
+                    new ReadOnlyImageView<BgraPixel>(sourceHandle.AddrOfPinnedObject(), sourceWidth, map.CameraCalibration.ResolutionHeight, sourceWidth * 4),
+                    new ImageView<BgraPixel>(targetHandle.AddrOfPinnedObject(), map.Target.WidthPixels, map.Target.HeightPixels, map.Target.WidthPixels * 4),
+                    interpolation);
+            }
+            finally
+            {
+                sourceHandle.Free();
+                targetHandle.Free();
+            }
+
+            return target;
+        }
+    }
+}
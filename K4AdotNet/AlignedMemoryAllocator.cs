@@ -0,0 +1,167 @@
+﻿using System;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace K4AdotNet
+{
+    /// <summary>
+    /// Implementation of <see cref="ICustomMemoryAllocator"/> interface that returns buffers aligned to specified boundary
+    /// and optionally backs large buffers by transparent huge pages on Linux.
+    /// </summary>
+    /// <remarks><para>
+    /// Aligned buffers are needed by SIMD code that uses aligned loads and stores, for example, with 64-byte alignment for AVX-512.
+    /// Alignment of buffer gives alignment of every row only if stride is a multiple of alignment too:
+    /// use <see cref="Sensor.Image(Sensor.ImageFormat, int, int, ICustomMemoryAllocator, int)"/> constructor to create such images.
+    /// </para><para>
+    /// On .NET 6 and higher memory is allocated by <c>NativeMemory.AlignedAlloc</c>.
+    /// On .NET Standard 2.0 and .NET Framework it is allocated by <see cref="Marshal.AllocHGlobal(int)"/> with extra bytes for alignment.
+    /// </para><para>
+    /// If <see cref="UseHugePages"/> is on (.NET 6 and higher on Linux only), buffers of at least <see cref="HugePageSize"/> bytes
+    /// are aligned to <see cref="HugePageSize"/>, their size is rounded up to multiple of <see cref="HugePageSize"/>
+    /// and kernel is advised to back them by transparent huge pages (<c>madvise(MADV_HUGEPAGE)</c>).
+    /// It reduces TLB misses for large images like 4K color frames. Advice is ignored by kernel if transparent huge pages are disabled.
+    /// </para><para>
+    /// Use instance of this class as allocator for <see cref="Sensor.Image(Sensor.ImageFormat, int, int, int, int, ICustomMemoryAllocator)"/> constructor
+    /// or as <see cref="Sdk.CustomMemoryAllocator"/>. Implementation is thread safe.
+    /// </para></remarks>
+    /// <seealso cref="HGlobalMemoryAllocator"/>
+    public sealed class AlignedMemoryAllocator : ICustomMemoryAllocator
+    {
+        /// <summary>Default alignment in bytes: size of cache line and of AVX-512 register.</summary>
+        public const int DefaultAlignment = 64;
+
+        /// <summary>Size of huge page on x86-64 and on most of ARM64 Linux systems: 2 MB.</summary>
+        public const int HugePageSize = 2 * 1024 * 1024;
+
+        /// <summary>Allocator with <see cref="DefaultAlignment"/> and without huge pages.</summary>
+        public static readonly AlignedMemoryAllocator Default = new(DefaultAlignment);
+
+        private long hugePageBufferCount;
+
+        /// <summary>Creates allocator with specified alignment and without huge pages.</summary>
+        /// <param name="alignment">Alignment of buffers in bytes. Must be a power of two.</param>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="alignment"/> is not a positive power of two.</exception>
+        public AlignedMemoryAllocator(int alignment)
+            : this(alignment, useHugePages: false)
+        { }
+
+        /// <summary>Creates allocator with specified alignment.</summary>
+        /// <param name="alignment">Alignment of buffers in bytes. Must be a power of two.</param>
+        /// <param name="useHugePages">Use transparent huge pages for large buffers (.NET 6 and higher on Linux only). See <see cref="UseHugePages"/> for details.</param>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="alignment"/> is not a positive power of two.</exception>
+        public AlignedMemoryAllocator(int alignment, bool useHugePages)
+        {
+            if (!IsPowerOfTwo(alignment))
+                throw new ArgumentOutOfRangeException(nameof(alignment), $"{nameof(alignment)} must be a positive power of two.");
+            Alignment = alignment;
+            UseHugePages = useHugePages && IsHugePagesSupported;
+        }
+
+        /// <summary>Alignment of buffers in bytes. Power of two.</summary>
+        public int Alignment { get; }
+
+        /// <summary>
+        /// Are buffers of at least <see cref="HugePageSize"/> bytes backed by transparent huge pages?
+        /// Can be <see langword="true"/> only on Linux and on .NET 6 and higher.
+        /// </summary>
+        public bool UseHugePages { get; }
+
+        /// <summary>Number of buffers allocated with huge pages advice accepted by kernel.</summary>
+        public long HugePageBufferCount => Interlocked.Read(ref hugePageBufferCount);
+
+        /// <summary>Allocates a buffer of size at least <paramref name="size"/> bytes aligned to <see cref="Alignment"/>.</summary>
+        /// <param name="size">Minimum size in bytes needed for the buffer. Cannot be negative.</param>
+        /// <param name="context">For internal usage. Must be passed to <see cref="Free(IntPtr, IntPtr)"/>.</param>
+        /// <returns>A pointer to the newly allocated memory. This memory must be released using the <see cref="Free(IntPtr, IntPtr)"/> method.</returns>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="size"/> is negative,
+        /// or on .NET Standard 2.0 and .NET Framework <paramref name="size"/> plus <c><see cref="Alignment"/> - 1</c> exceeds <see cref="int.MaxValue"/>.
+        /// </exception>
+        /// <exception cref="OutOfMemoryException">There is insufficient memory to satisfy the request.</exception>
+        public IntPtr Allocate(int size, out IntPtr context)
+        {
+            if (size < 0)
+                throw new ArgumentOutOfRangeException(nameof(size));
+
+#if NETSTANDARD2_0 || NET461
+            // Extra bytes for alignment must not overflow size of buffer
+            if (size > int.MaxValue - (Alignment - 1))
+                throw new ArgumentOutOfRangeException(nameof(size), $"{nameof(size)} plus alignment cannot exceed {int.MaxValue} bytes on this platform.");
+
+            // Original pointer is kept as context
+            context = Marshal.AllocHGlobal(size + Alignment - 1);
+            return new IntPtr((context.ToInt64() + Alignment - 1) & ~(long)(Alignment - 1));
+#else
+            context = IntPtr.Zero;
+
+            if (UseHugePages && size >= HugePageSize)
+            {
+                var hugeSize = (nuint)((size + (long)HugePageSize - 1) & ~(long)(HugePageSize - 1));
+                IntPtr hugeBuffer;
+                unsafe
+                {
+                    hugeBuffer = new IntPtr(NativeMemory.AlignedAlloc(hugeSize, (nuint)Math.Max(Alignment, HugePageSize)));
+                }
+                if (TryAdviseHugePages(hugeBuffer, hugeSize))
+                    Interlocked.Increment(ref hugePageBufferCount);
+                return hugeBuffer;
+            }
+
+            unsafe
+            {
+                return new IntPtr(NativeMemory.AlignedAlloc((nuint)Math.Max(size, 1), (nuint)Alignment));
+            }
+#endif
+        }
+
+        /// <summary>Frees memory previously allocated by <see cref="Allocate(int, out IntPtr)"/> method.</summary>
+        /// <param name="buffer">The handle returned by the original matching call to <see cref="Allocate(int, out IntPtr)"/> method.</param>
+        /// <param name="context">The context returned by the original matching call to <see cref="Allocate(int, out IntPtr)"/> method.</param>
+        public void Free(IntPtr buffer, IntPtr context)
+        {
+            if (buffer == IntPtr.Zero)
+                return;
+
+#if NETSTANDARD2_0 || NET461
+            Marshal.FreeHGlobal(context);
+#else
+            unsafe
+            {
+                NativeMemory.AlignedFree(buffer.ToPointer());
+            }
+#endif
+        }
+
+        /// <summary>Is <paramref name="value"/> a positive power of two?</summary>
+        internal static bool IsPowerOfTwo(int value)
+            => value > 0 && (value & (value - 1)) == 0;
+
+#if NETSTANDARD2_0 || NET461
+        private static bool IsHugePagesSupported => false;
+#else
+        private static bool IsHugePagesSupported => OperatingSystem.IsLinux();
+
+        // From <sys/mman.h>
+        private const int MADV_HUGEPAGE = 14;
+
+        [DllImport("libc", EntryPoint = "madvise", CallingConvention = CallingConvention.Cdecl)]
+        private static extern int Madvise(IntPtr address, nuint length, int advice);
+
+        private static bool TryAdviseHugePages(IntPtr buffer, nuint size)
+        {
+            try
+            {
+                return Madvise(buffer, size, MADV_HUGEPAGE) == 0;
+            }
+            catch (DllNotFoundException)
+            {
+                return false;
+            }
+            catch (EntryPointNotFoundException)
+            {
+                return false;
+            }
+        }
+#endif
+    }
+}
@@ -11,14 +11,7 @@ namespace K4AdotNet.BodyTracking
 
         private BodyFrame(NativeHandles.BodyFrameHandle handle)
         {
-            this.handle = handle;
-            this.handle.Disposed += Handle_Disposed;
-        }
-
-        private void Handle_Disposed(object? sender, EventArgs e)
-        {
-            handle.Disposed -= Handle_Disposed;
-            Disposed?.Invoke(this, EventArgs.Empty);
+            this.handle = NativeHandles.HandleWrapper<NativeHandles.BodyFrameHandle>.Create(handle, this, Sdk.FinalizerFreeMode);
         }
 
         /// <summary>
@@ -45,7 +38,11 @@ namespace K4AdotNet.BodyTracking
 
         /// <summary>Raised on object disposing (only once).</summary>
         /// <seealso cref="Dispose"/>
-        public event EventHandler? Disposed;
+        public event EventHandler? Disposed
+        {
+            add => handle.Disposed += value;
+            remove => handle.Disposed -= value;
+        }
 
         /// <summary>Creates new reference to the same unmanaged body frame object.</summary>
         /// <returns>New object that references exactly to the same underlying unmanaged object as original one. Not <see langword="null"/>.</returns>
@@ -4,6 +4,12 @@ using System.Runtime.InteropServices;
 namespace K4AdotNet.BodyTracking
 {
     /// <summary>DLL imports for most of native functions from <c>k4abt.h</c> header file.</summary>
+    /// <remarks>
+    /// Trivial getters and setters that neither block nor call back to managed code are marked with <c>SuppressGCTransition</c> attribute
+    /// for .NET 6 target to reduce the cost of call. Don't put this attribute on functions that can release objects
+    /// (releasing of image can call memory destroy callback implemented in managed code)
+    /// or that take locks and add references (like <c>k4abt_frame_get_capture</c>).
+    /// </remarks>
     internal static class NativeApi
     {
         public const int MAX_TRACKING_QUEUE_SIZE = 3;
@@ -126,6 +132,9 @@ namespace K4AdotNet.BodyTracking
         /// <param name="bodyFrameHandle">Handle to a body frame object returned by <see cref="TrackerPopResult(NativeHandles.TrackerHandle, out NativeHandles.BodyFrameHandle, Timeout)"/> function.</param>
         /// <returns>Returns the number of detected bodies. 0 if the function fails.</returns>
         /// <remarks>Called when the user has received a body frame handle and wants to access the data contained in it.</remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.BODY_TRACKING_DLL_NAME, EntryPoint = "k4abt_frame_get_num_bodies", CallingConvention = CallingConvention.Cdecl)]
         public static extern uint FrameGetNumBodies(NativeHandles.BodyFrameHandle bodyFrameHandle);
 
@@ -136,6 +145,9 @@ namespace K4AdotNet.BodyTracking
         /// <param name="skeleton">If successful this contains the body skeleton information.</param>
         /// <returns><see cref="NativeCallResults.Result.Succeeded"/> if a valid body skeleton is returned. All failures will return <see cref="NativeCallResults.Result.Failed"/>.</returns>
         /// <remarks>Called when the user has received a body frame handle and wants to access the data contained in it.</remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.BODY_TRACKING_DLL_NAME, EntryPoint = "k4abt_frame_get_body_skeleton", CallingConvention = CallingConvention.Cdecl)]
         public static extern NativeCallResults.Result FrameGetBodySkeleton(
             NativeHandles.BodyFrameHandle bodyFrameHandle,
@@ -150,6 +162,9 @@ namespace K4AdotNet.BodyTracking
         /// <remarks>
         /// Called when the user has received a body frame handle and wants to access the id of the body given a particular index.
         /// </remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.BODY_TRACKING_DLL_NAME, EntryPoint = "k4abt_frame_get_body_id", CallingConvention = CallingConvention.Cdecl)]
         public static extern BodyId FrameGetBodyId(
             NativeHandles.BodyFrameHandle bodyFrameHandle,
@@ -162,6 +177,9 @@ namespace K4AdotNet.BodyTracking
         /// Returns the device timestamp of the body frame. If the <paramref name="bodyFrameHandle"/> is invalid this function will return <see cref="Microseconds64.Zero"/>.
         /// It is also possible for <see cref="Microseconds64.Zero"/> to be a valid timestamp originating from the beginning of a recording or the start of streaming.
         /// </returns>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.BODY_TRACKING_DLL_NAME, EntryPoint = "k4abt_frame_get_device_timestamp_usec", CallingConvention = CallingConvention.Cdecl)]
         public static extern Microseconds64 FrameGetDeviceTimestamp(NativeHandles.BodyFrameHandle bodyFrameHandle);
 
@@ -172,6 +190,9 @@ namespace K4AdotNet.BodyTracking
         /// Returns the system timestamp of the body frame. If the <paramref name="bodyFrameHandle"/> is invalid this function will return 0.
         /// It is also possible for 0 to be a valid timestamp originating from the beginning of a recording or the start of streaming.
         /// </returns>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.BODY_TRACKING_DLL_NAME, EntryPoint = "k4abt_frame_get_system_timestamp_nsec", CallingConvention = CallingConvention.Cdecl)]
         public static extern Nanoseconds64 FrameGetSystemTimestamp(NativeHandles.BodyFrameHandle bodyFrameHandle);
 
@@ -1,28 +1,32 @@
 ﻿using System;
-using System.Collections.Generic;
 
 namespace K4AdotNet
 {
     // Helps to track disposable objects which some class creates and controls.
     // Implementation is thread safe.
+    // Tracked children are kept in intrusive doubly linked list of registrations,
+    // thus removal of disposed child takes O(1) time and doesn't require any search.
     internal sealed class ChildrenDisposer : IDisposable
     {
-        private readonly LinkedList<IDisposablePlus> trackedChildren = new();
+        private readonly object sync = new();
+        private Registration? head;
 
         public void Dispose()
         {
-            var list = new List<IDisposablePlus>();
+            Registration? list;
 
-            lock (trackedChildren)
+            lock (sync)
             {
-                list.AddRange(trackedChildren);
-                trackedChildren.Clear();
+                list = head;
+                head = null;
+                for (var registration = list; registration != null; registration = registration.Next)
+                    registration.IsLinked = false;
             }
 
-            foreach (var child in list)
+            for (var registration = list; registration != null; registration = registration.Next)
             {
-                child.Disposed -= OnChildObjectDisposed;
-                child.Dispose();
+                registration.Child.Disposed -= registration.Handler;
+                registration.Child.Dispose();
             }
         }
 
@@ -31,35 +35,67 @@ namespace K4AdotNet
             if (child is null || child.IsDisposed)
                 return child;
 
-            lock (trackedChildren)
+            var registration = new Registration(this, child);
+
+            lock (sync)
             {
-                trackedChildren.AddLast(child);
+                registration.Next = head;
+                if (head != null)
+                    head.Prev = registration;
+                head = registration;
+                registration.IsLinked = true;
             }
 
-            child.Disposed += OnChildObjectDisposed;
+            child.Disposed += registration.Handler;
 
             return child;
         }
 
-        private void OnChildObjectDisposed(object? sender, EventArgs e)
+        private void Unregister(Registration registration)
         {
-            if (sender is not IDisposablePlus child)
-                throw new ArgumentNullException(nameof(sender));
+            lock (sync)
+            {
+                // Already removed from list by Dispose()
+                if (!registration.IsLinked)
+                    return;
+
+                if (registration.Prev != null)
+                    registration.Prev.Next = registration.Next;
+                else
+                    head = registration.Next;
+                if (registration.Next != null)
+                    registration.Next.Prev = registration.Prev;
+
+                registration.Prev = registration.Next = null;
+                registration.IsLinked = false;
+            }
+        }
 
-            lock (trackedChildren)
+        // Node of intrusive list. Also owns handler of child's Disposed event,
+        // so that handler knows its node without any search.
+        private sealed class Registration
+        {
+            public readonly ChildrenDisposer Owner;
+            public readonly IDisposablePlus Child;
+            public readonly EventHandler Handler;
+
+            // These fields are guarded by Owner.sync
+            public Registration? Prev;
+            public Registration? Next;
+            public bool IsLinked;
+
+            public Registration(ChildrenDisposer owner, IDisposablePlus child)
             {
-                child.Disposed -= OnChildObjectDisposed;
-                for (var node = trackedChildren.First; node != null; node = node.Next)
-                {
-                    if (ReferenceEquals(node.Value, child))
-                    {
-                        trackedChildren.Remove(node);
-                        return;
-                    }
-                }
+                Owner = owner;
+                Child = child;
+                Handler = OnChildDisposed;
             }
 
-            System.Diagnostics.Trace.TraceWarning($"Cannot find child {child} in list of tracked children.");
+            private void OnChildDisposed(object? sender, EventArgs e)
+            {
+                Child.Disposed -= Handler;
+                Owner.Unregister(this);
+            }
         }
     }
 }
@@ -18,39 +18,44 @@ namespace K4AdotNet
 
         public delegate NativeCallResults.BufferResult GetInByteBufferMethod<T>(T parameter, IntPtr buffer, ref UIntPtr size);
 
-        public static bool TryGetValueInByteBuffer<T>(GetInByteBufferMethod<T> getMethod, T parameter,
+        // Values of this size and less are read by one native call to scratch buffer on stack
+        private const int SCRATCH_BUFFER_SIZE = 256;
+
+        public static unsafe bool TryGetValueInByteBuffer<T>(GetInByteBufferMethod<T> getMethod, T parameter,
             [NotNullWhen(returnValue: true)] out byte[]? result)
         {
-            var bufferSize = UIntPtr.Zero;
-            var res = getMethod(parameter, IntPtr.Zero, ref bufferSize);
+            // Most of values (tags, track names, codec IDs, serial numbers) are short:
+            // read them to scratch buffer on stack without preliminary request of size and without unmanaged allocations
+            var scratchBuffer = stackalloc byte[SCRATCH_BUFFER_SIZE];
+            var bufferSize = Int32ToUIntPtr(SCRATCH_BUFFER_SIZE);
+            var res = getMethod(parameter, new IntPtr(scratchBuffer), ref bufferSize);
+            if (res == NativeCallResults.BufferResult.Succeeded)
+            {
+                var size = UIntPtrToInt32(bufferSize);
+                result = size > 0 ? new byte[size] : Array.Empty<byte>();
+                if (size > 0)
+                    Marshal.Copy(new IntPtr(scratchBuffer), result, 0, size);
+                return true;
+            }
+
             if (res == NativeCallResults.BufferResult.TooSmall)
             {
+                // Long value: size is already known, read it directly to resulting array
                 var size = UIntPtrToInt32(bufferSize);
-                if (size > 1)
+                var array = new byte[size];
+                fixed (byte* buffer = array)
                 {
-                    IntPtr buffer = Marshal.AllocHGlobal(size);
-                    try
-                    {
-                        res = getMethod(parameter, buffer, ref bufferSize);
-                        if (res == NativeCallResults.BufferResult.Succeeded)
-                        {
-                            size = UIntPtrToInt32(bufferSize);
-                            result = new byte[size];
-                            Marshal.Copy(buffer, result, 0, size);
-                            return true;
-                        }
-                    }
-                    finally
-                    {
-                        Marshal.FreeHGlobal(buffer);
-                    }
+                    res = getMethod(parameter, new IntPtr(buffer), ref bufferSize);
                 }
-            }
 
-            if (res == NativeCallResults.BufferResult.Succeeded)
-            {
-                result = Array.Empty<byte>();
-                return true;
+                if (res == NativeCallResults.BufferResult.Succeeded)
+                {
+                    var actualSize = UIntPtrToInt32(bufferSize);
+                    if (actualSize < size)
+                        Array.Resize(ref array, actualSize);
+                    result = array;
+                    return true;
+                }
             }
 
             result = null;
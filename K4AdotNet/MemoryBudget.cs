@@ -0,0 +1,266 @@
+﻿using K4AdotNet.Sensor;
+using System;
+using System.Collections.Concurrent;
+using System.Diagnostics;
+using System.Threading;
+
+namespace K4AdotNet
+{
+    /// <summary>
+    /// Byte-budget accountant for native image buffers: implementation of <see cref="ICustomMemoryAllocator"/>
+    /// that delegates allocations to another allocator and tracks how many bytes are in use.
+    /// </summary>
+    /// <remarks><para>
+    /// Install instance of this class as <see cref="Sdk.CustomMemoryAllocator"/> to account all image buffers allocated by Sensor SDK
+    /// (captures from device and from playback) and pass it to <see cref="Image(ImageFormat, int, int, int, int, ICustomMemoryAllocator)"/>
+    /// constructor to account images created by application.
+    /// </para><para>
+    /// Budget does not refuse allocations: Sensor SDK cannot handle such failures gracefully.
+    /// Instead, producers consult it (<see cref="IsOverBudget"/>, <see cref="WaitForBudget(Timeout)"/>)
+    /// before pulling next capture, or pass captures to consumers via <see cref="CaptureQueue"/>,
+    /// which blocks, drops the oldest capture or fails fast when budget is exceeded (see <see cref="MemoryBudgetPolicy"/>).
+    /// </para><para>
+    /// Images created by application via this budget are attributed to their format on allocation.
+    /// Allocator callback of Sensor SDK does not know format of image: such buffer is attributed to format when the first <see cref="Image"/> object
+    /// for it is created, if the budget is the current <see cref="Sdk.CustomMemoryAllocator"/> at that moment.
+    /// Until then, its bytes are counted in <see cref="UnattributedBytes"/>.
+    /// </para><para>
+    /// Implementation is thread safe.
+    /// </para></remarks>
+    /// <seealso cref="CaptureQueue"/>
+    /// <seealso cref="Sdk.CustomMemoryAllocator"/>
+    public sealed class MemoryBudget : ICustomMemoryAllocator
+    {
+        private static readonly int formatCount = (int)ImageFormat.Custom + 1;
+
+        private readonly ICustomMemoryAllocator allocator;
+        private readonly Func<bool> isWithinBudget;
+        private readonly object sync = new();                                   // for waiters only, counters are lock-free
+        private readonly ConcurrentDictionary<IntPtr, Allocation> allocations = new();
+        private readonly long[] currentBytesPerFormat = new long[formatCount];
+        private readonly long[] peakBytesPerFormat = new long[formatCount];
+        private long limitBytes;
+        private long currentBytes;
+        private long peakBytes;
+        private long unattributedBytes;
+        private int waiterCount;
+
+        /// <summary>Creates budget on top of <see cref="HGlobalMemoryAllocator"/>.</summary>
+        /// <param name="limitBytes">Budget in bytes. Must be positive.</param>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="limitBytes"/> is not positive.</exception>
+        public MemoryBudget(long limitBytes)
+            : this(limitBytes, HGlobalMemoryAllocator.Instance)
+        { }
+
+        /// <summary>Creates budget on top of specified allocator.</summary>
+        /// <param name="limitBytes">Budget in bytes. Must be positive.</param>
+        /// <param name="allocator">Allocator that actually allocates and frees memory, for example, <see cref="PooledMemoryAllocator"/>. Not <see langword="null"/>.</param>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="limitBytes"/> is not positive.</exception>
+        /// <exception cref="ArgumentNullException"><paramref name="allocator"/> is <see langword="null"/>.</exception>
+        public MemoryBudget(long limitBytes, ICustomMemoryAllocator allocator)
+        {
+            if (limitBytes <= 0)
+                throw new ArgumentOutOfRangeException(nameof(limitBytes));
+            this.limitBytes = limitBytes;
+            this.allocator = allocator ?? throw new ArgumentNullException(nameof(allocator));
+            isWithinBudget = () => !IsOverBudget;
+        }
+
+        /// <summary>Budget in bytes. Can be changed at any moment. Must be positive.</summary>
+        /// <exception cref="ArgumentOutOfRangeException">Value is not positive.</exception>
+        public long LimitBytes
+        {
+            get => Interlocked.Read(ref limitBytes);
+            set
+            {
+                if (value <= 0)
+                    throw new ArgumentOutOfRangeException(nameof(value));
+                lock (sync)
+                {
+                    Interlocked.Exchange(ref limitBytes, value);
+                    if (waiterCount > 0)
+                        Monitor.PulseAll(sync);
+                }
+            }
+        }
+
+        /// <summary>Total size in bytes of buffers that are currently allocated via this budget.</summary>
+        public long CurrentBytes => Interlocked.Read(ref currentBytes);
+
+        /// <summary>The maximum value of <see cref="CurrentBytes"/> since creation or the last call of <see cref="ResetPeaks"/>.</summary>
+        public long PeakBytes => Interlocked.Read(ref peakBytes);
+
+        /// <summary>Part of <see cref="CurrentBytes"/> that is not attributed to any image format yet, because no <see cref="Image"/> object was created for these buffers.</summary>
+        public long UnattributedBytes => Interlocked.Read(ref unattributedBytes);
+
+        /// <summary>Is <see cref="CurrentBytes"/> greater than <see cref="LimitBytes"/>?</summary>
+        public bool IsOverBudget => CurrentBytes > LimitBytes;
+
+        /// <summary>Total size in bytes of currently allocated buffers of images of specified format.</summary>
+        /// <param name="format">Image format.</param>
+        /// <returns>Size in bytes. Zero for unknown formats.</returns>
+        public long GetCurrentBytes(ImageFormat format)
+            => IsKnownFormat(format) ? Interlocked.Read(ref currentBytesPerFormat[(int)format]) : 0;
+
+        /// <summary>The maximum value of <see cref="GetCurrentBytes(ImageFormat)"/> for specified format since creation or the last call of <see cref="ResetPeaks"/>.</summary>
+        /// <param name="format">Image format.</param>
+        /// <returns>Size in bytes. Zero for unknown formats.</returns>
+        public long GetPeakBytes(ImageFormat format)
+            => IsKnownFormat(format) ? Interlocked.Read(ref peakBytesPerFormat[(int)format]) : 0;
+
+        /// <summary>Resets <see cref="PeakBytes"/> and peaks per format to current values.</summary>
+        public void ResetPeaks()
+        {
+            Interlocked.Exchange(ref peakBytes, CurrentBytes);
+            for (var i = 0; i < formatCount; i++)
+                Interlocked.Exchange(ref peakBytesPerFormat[i], Interlocked.Read(ref currentBytesPerFormat[i]));
+        }
+
+        /// <summary>Blocks calling thread until <see cref="CurrentBytes"/> falls down to <see cref="LimitBytes"/>.</summary>
+        /// <param name="timeout">Maximum time to wait. <see cref="Timeout.NoWait"/> means just check. <see cref="Timeout.Infinite"/> means waiting without time limit.</param>
+        /// <returns><see langword="true"/> if usage is within budget, <see langword="false"/> if timeout elapsed.</returns>
+        public bool WaitForBudget(Timeout timeout = default)
+            => WaitUntil(isWithinBudget, timeout);
+
+        /// <summary>Allocates a buffer of size at least <paramref name="size"/> bytes by underlying allocator and accounts it.</summary>
+        /// <param name="size">Minimum size in bytes needed for the buffer.</param>
+        /// <param name="context">Context from underlying allocator. Must be passed to <see cref="Free(IntPtr, IntPtr)"/>.</param>
+        /// <returns>A pointer to the newly allocated memory. This memory must be released using the <see cref="Free(IntPtr, IntPtr)"/> method.</returns>
+        public IntPtr Allocate(int size, out IntPtr context)
+        {
+            var buffer = allocator.Allocate(size, out context);
+            if (buffer != IntPtr.Zero)
+                Account(buffer, new Allocation(size, Allocation.Unattributed));
+            return buffer;
+        }
+
+        /// <summary>Like <see cref="Allocate(int, out IntPtr)"/> but attributes buffer to image format at once. Is used on creation of images by application.</summary>
+        internal IntPtr Allocate(int size, ImageFormat format, out IntPtr context)
+        {
+            var buffer = allocator.Allocate(size, out context);
+            if (buffer != IntPtr.Zero)
+                Account(buffer, new Allocation(size, IsKnownFormat(format) ? (int)format : Allocation.Unattributed));
+            return buffer;
+        }
+
+        private void Account(IntPtr buffer, Allocation allocation)
+        {
+            allocations[buffer] = allocation;
+            if (allocation.Format == Allocation.Unattributed)
+                Interlocked.Add(ref unattributedBytes, allocation.Size);
+            else
+                AddFormatBytes(allocation.Format, allocation.Size);
+            UpdatePeak(ref peakBytes, Interlocked.Add(ref currentBytes, allocation.Size));
+        }
+
+        /// <summary>Frees memory previously allocated by <see cref="Allocate(int, out IntPtr)"/> method.</summary>
+        /// <param name="buffer">The buffer returned by the original matching call to <see cref="Allocate(int, out IntPtr)"/> method.</param>
+        /// <param name="context">The context returned by the original matching call to <see cref="Allocate(int, out IntPtr)"/> method.</param>
+        public void Free(IntPtr buffer, IntPtr context)
+        {
+            if (allocations.TryRemove(buffer, out var allocation))
+            {
+                // Exchange prevents concurrent attribution of buffer that is being released
+                var format = Interlocked.Exchange(ref allocation.Format, Allocation.Released);
+                if (format == Allocation.Unattributed)
+                    Interlocked.Add(ref unattributedBytes, -allocation.Size);
+                else
+                    Interlocked.Add(ref currentBytesPerFormat[format], -allocation.Size);
+                Interlocked.Add(ref currentBytes, -allocation.Size);
+                Notify();
+            }
+
+            allocator.Free(buffer, context);
+        }
+
+        /// <summary>Wakes up threads blocked in <see cref="WaitUntil(Func{bool}, Timeout)"/> to re-check their conditions.</summary>
+        internal void Notify()
+        {
+            // Waiters increment counter before checking of their conditions, thus nobody can miss this notification
+            if (Volatile.Read(ref waiterCount) == 0)
+                return;
+
+            lock (sync)
+            {
+                Monitor.PulseAll(sync);
+            }
+        }
+
+        /// <summary>Waits until <paramref name="condition"/> becomes true. Condition is re-checked on each release of memory and on <see cref="Notify"/>.</summary>
+        internal bool WaitUntil(Func<bool> condition, Timeout timeout)
+        {
+            lock (sync)
+            {
+                if (condition())
+                    return true;
+                if (timeout == Timeout.NoWait)
+                    return false;
+
+                var stopwatch = Stopwatch.StartNew();
+                Interlocked.Increment(ref waiterCount);
+                try
+                {
+                    while (!condition())
+                    {
+                        var remainingMs = timeout == Timeout.Infinite
+                            ? System.Threading.Timeout.Infinite
+                            : timeout.ValueMs - (int)stopwatch.ElapsedMilliseconds;
+                        if (timeout != Timeout.Infinite && remainingMs <= 0)
+                            return false;
+                        Monitor.Wait(sync, remainingMs);
+                    }
+                    return true;
+                }
+                finally
+                {
+                    Interlocked.Decrement(ref waiterCount);
+                }
+            }
+        }
+
+        /// <summary>Attributes buffer allocated by Sensor SDK to format of <see cref="Image"/> object created for it. Lock-free.</summary>
+        internal void Attribute(IntPtr buffer, ImageFormat format)
+        {
+            if (!IsKnownFormat(format) || !allocations.TryGetValue(buffer, out var allocation))
+                return;
+            if (Interlocked.CompareExchange(ref allocation.Format, (int)format, Allocation.Unattributed) != Allocation.Unattributed)
+                return;
+
+            Interlocked.Add(ref unattributedBytes, -allocation.Size);
+            AddFormatBytes((int)format, allocation.Size);
+        }
+
+        private void AddFormatBytes(int format, int size)
+            => UpdatePeak(ref peakBytesPerFormat[format], Interlocked.Add(ref currentBytesPerFormat[format], size));
+
+        private static void UpdatePeak(ref long peak, long current)
+        {
+            var value = Interlocked.Read(ref peak);
+            while (current > value)
+            {
+                var original = Interlocked.CompareExchange(ref peak, current, value);
+                if (original == value)
+                    break;
+                value = original;
+            }
+        }
+
+        private static bool IsKnownFormat(ImageFormat format)
+            => format >= 0 && (int)format < formatCount;
+
+        private sealed class Allocation
+        {
+            public const int Unattributed = -1;
+            public const int Released = -2;
+
+            public readonly int Size;
+            public int Format;          // index of image format, Unattributed or Released
+
+            public Allocation(int size, int format)
+            {
+                Size = size;
+                Format = format;
+            }
+        }
+    }
+}
@@ -0,0 +1,17 @@
+﻿namespace K4AdotNet
+{
+    /// <summary>What to do with new capture when <see cref="MemoryBudget"/> is exceeded.</summary>
+    /// <seealso cref="Sensor.CaptureQueue"/>
+    /// <seealso cref="MemoryBudget"/>
+    public enum MemoryBudgetPolicy
+    {
+        /// <summary>Block producer until consumers release enough memory.</summary>
+        Block = 0,
+
+        /// <summary>Drop (dispose) the oldest captures that are waiting for consumer until memory usage is within budget.</summary>
+        DropOldest,
+
+        /// <summary>Reject new capture immediately.</summary>
+        FailFast,
+    }
+}
@@ -6,25 +6,46 @@ namespace K4AdotNet.NativeHandles
     /// <summary>
     /// Helper wrapper around native handle structures that implement <see cref="INativeHandle"/> interface.
     /// Implements <see cref="IDisposablePlus"/> interface, which is really helpful in implementation of public classes.
-    /// Plus this class has a finalyzer that calls <see cref="INativeHandle.Release"/> for objects that were not disposed in an explicit manner.
+    /// Plus wrappers created by default have a finalyzer that calls <see cref="INativeHandle.Release"/> for objects that were not disposed in an explicit manner.
     /// </summary>
+    /// <remarks>
+    /// Finalizer-free wrappers (see <see cref="Sdk.FinalizerFreeMode"/>) are not registered for finalization at all:
+    /// they are cheaper to allocate and die in generation 0, but they leak native handle if are not disposed.
+    /// Number of such wrappers that are not disposed yet is reported by <see cref="Sdk.FinalizerFreeObjectCount"/>
+    /// and, if <see cref="Sdk.FinalizerFreeObjectTracking"/> is on, by <see cref="Sdk.GetUndisposedFinalizerFreeObjects"/>.
+    /// </remarks>
     /// <typeparam name="T">Type of native handle.</typeparam>
-    internal sealed class HandleWrapper<T> : IDisposablePlus, IEquatable<HandleWrapper<T>>
+    internal class HandleWrapper<T> : IDisposablePlus, IEquatable<HandleWrapper<T>>
         where T : struct, INativeHandle
     {
         private readonly T handle;                  // underlying native handle
+        private readonly object? owner;             // sender for Disposed event (public object wrapping this handle)
+        private readonly bool isFinalizerFree;      // to track number of not disposed finalizer-free wrappers
+        private readonly long trackingId;           // non-zero if creation of finalizer-free wrapper is tracked for leak detection
         private volatile int releaseCounter;        // to release handle only once
 
-        /// <summary>Creates <see cref="IDisposablePlus"/>-wrapper around specified handle.</summary>
-        /// <param name="handle">Handle to be wrapped. Must be valid.</param>
-        /// <exception cref="ArgumentException">If <paramref name="handle"/> is invalid.</exception>
-        public HandleWrapper(T handle)
+        private HandleWrapper(T handle, object? owner, bool isFinalizerFree)
         {
             if (!handle.IsValid)
                 throw new ArgumentException("Handle must be valid", nameof(handle));
             this.handle = handle;
+            this.owner = owner;
+            this.isFinalizerFree = isFinalizerFree;
+            if (isFinalizerFree)
+                trackingId = Sdk.IncrementFinalizerFreeObjectCount(owner?.GetType() ?? GetType());
         }
 
+        /// <summary>Creates <see cref="IDisposablePlus"/>-wrapper around specified handle.</summary>
+        /// <param name="handle">Handle to be wrapped. Must be valid.</param>
+        /// <param name="owner">Public object that wraps this handle. Is used as sender of <see cref="Disposed"/> event. Can be <see langword="null"/>.</param>
+        /// <param name="finalizerFree">Create wrapper without finalizer? Such wrapper must be disposed explicitly.</param>
+        /// <returns>Wrapper around <paramref name="handle"/>. Not <see langword="null"/>.</returns>
+        /// <exception cref="ArgumentException">If <paramref name="handle"/> is invalid.</exception>
+        public static HandleWrapper<T> Create(T handle, object? owner, bool finalizerFree)
+            => finalizerFree
+                ? new HandleWrapper<T>(handle, owner, isFinalizerFree: true)
+                : new Finalizable(handle, owner);
+
         /// <summary>Direct access to the underlying handle object.</summary>
         public T Value => handle;
 
@@ -40,10 +61,6 @@ namespace K4AdotNet.NativeHandles
             }
         }
 
-        /// <summary>Calls <see cref="INativeHandle.Release"/> for objects that were not disposed in an explicit manner.</summary>
-        ~HandleWrapper()
-            => ReleaseHandle();
-
         /// <summary>
         /// Disposes underlying handle
         /// plus raises <see cref="Disposed"/> event if it is the first call of this method for the object.
@@ -53,8 +70,11 @@ namespace K4AdotNet.NativeHandles
         {
             if (ReleaseHandle())
             {
-                GC.SuppressFinalize(this);
-                Disposed?.Invoke(this, EventArgs.Empty);
+                if (isFinalizerFree)
+                    Sdk.DecrementFinalizerFreeObjectCount(trackingId);
+                else
+                    GC.SuppressFinalize(this);
+                Disposed?.Invoke(owner ?? this, EventArgs.Empty);
             }
         }
 
@@ -77,6 +97,7 @@ namespace K4AdotNet.NativeHandles
         public bool IsDisposed => releaseCounter > 0;
 
         /// <summary>Raised on object disposing (only once).</summary>
+        /// <remarks>Sender is owner of wrapper if it was specified on creation, otherwise wrapper itself.</remarks>
         /// <seealso cref="Dispose"/>
         public event EventHandler? Disposed;
 
@@ -91,7 +112,7 @@ namespace K4AdotNet.NativeHandles
         /// <summary>Implicit conversion from handle to wrapper for usability.</summary>
         /// <param name="handle">Handle to be wrapped.</param>
         public static implicit operator HandleWrapper<T> (T handle)
-            => new(handle);
+            => new Finalizable(handle, owner: null);
 
         /// <summary>String representation of underlying native handle.</summary>
         /// <returns><c>{HandleTypeName}#{Address}</c></returns>
@@ -134,5 +155,17 @@ namespace K4AdotNet.NativeHandles
             => !(left == right);
 
         #endregion
+
+        // Default wrapper: releases handle on finalization if object was not disposed in an explicit manner
+        private sealed class Finalizable : HandleWrapper<T>
+        {
+            public Finalizable(T handle, object? owner)
+                : base(handle, owner, isFinalizerFree: false)
+            { }
+
+            /// <summary>Calls <see cref="INativeHandle.Release"/> for objects that were not disposed in an explicit manner.</summary>
+            ~Finalizable()
+                => ReleaseHandle();
+        }
     }
 }
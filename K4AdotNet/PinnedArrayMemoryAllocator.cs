@@ -0,0 +1,182 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace K4AdotNet
+{
+    /// <summary>
+    /// Implementation of <see cref="ICustomMemoryAllocator"/> interface that allocates buffers as managed arrays
+    /// on the pinned object heap and recycles released arrays instead of leaving them to garbage collector.
+    /// </summary>
+    /// <remarks><para>
+    /// Arrays are allocated by <see cref="GC.AllocateUninitializedArray{T}(int, bool)"/> with <c>pinned: true</c>.
+    /// Thus, unlike <see cref="Sensor.Image.CreateFromArray{T}(T[], Sensor.ImageFormat, int, int, int)"/>,
+    /// no <see cref="GCHandle"/> is required per image and ordinary managed heap is not fragmented by pinned buffers.
+    /// </para><para>
+    /// Allocator keeps all its arrays in a table of slots. Index of slot is used as context of buffer,
+    /// so that <see cref="Free(IntPtr, IntPtr)"/> finds array directly, without any search or dictionary.
+    /// </para><para>
+    /// Requested sizes are rounded up to the same size classes as in <see cref="PooledMemoryAllocator"/>.
+    /// The total amount of memory kept for reuse is limited by <see cref="MaxPooledBytes"/>.
+    /// Call <see cref="Trim"/> to give all pooled arrays back to garbage collector.
+    /// </para><para>
+    /// Use instance of this class as allocator for <see cref="Sensor.Image(Sensor.ImageFormat, int, int, int, int, ICustomMemoryAllocator)"/> constructor
+    /// or as <see cref="Sdk.CustomMemoryAllocator"/>. Implementation is thread safe.
+    /// </para></remarks>
+    /// <seealso cref="PooledMemoryAllocator"/>
+    public sealed class PinnedArrayMemoryAllocator : ICustomMemoryAllocator
+    {
+        /// <summary>Default value of <see cref="MaxPooledBytes"/>: 256 MB.</summary>
+        public const long DefaultMaxPooledBytes = PooledMemoryAllocator.DefaultMaxPooledBytes;
+
+        private readonly object sync = new();
+        private byte[]?[] slots = new byte[]?[64];              // all arrays of allocator that are in use or pooled, guarded by sync
+        private bool[] slotsInUse = new bool[64];               // is array of slot in use (not pooled), guarded by sync
+        private readonly Stack<int> freeSlots = new();          // indices of empty slots, guarded by sync
+        private readonly Stack<int>?[] pooledSlots = new Stack<int>?[PooledMemoryAllocator.GetSizeClass(PooledMemoryAllocator.MaxPooledBufferSize) + 1];
+        private int slotCount;
+        private long pooledBytes;
+        private long hitCount;
+        private long missCount;
+
+        /// <summary>Creates allocator with default memory cap.</summary>
+        /// <seealso cref="DefaultMaxPooledBytes"/>
+        public PinnedArrayMemoryAllocator()
+            : this(DefaultMaxPooledBytes)
+        { }
+
+        /// <summary>Creates allocator with specified memory cap.</summary>
+        /// <param name="maxPooledBytes">Maximum total size in bytes of released arrays kept for reuse. Cannot be negative.</param>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="maxPooledBytes"/> is negative.</exception>
+        public PinnedArrayMemoryAllocator(long maxPooledBytes)
+        {
+            if (maxPooledBytes < 0)
+                throw new ArgumentOutOfRangeException(nameof(maxPooledBytes));
+            MaxPooledBytes = maxPooledBytes;
+        }
+
+        /// <summary>Maximum total size in bytes of released arrays kept for reuse.</summary>
+        public long MaxPooledBytes { get; }
+
+        /// <summary>Current total size in bytes of released arrays kept for reuse.</summary>
+        public long PooledBytes => Interlocked.Read(ref pooledBytes);
+
+        /// <summary>Number of allocations served from the pool.</summary>
+        public long HitCount => Interlocked.Read(ref hitCount);
+
+        /// <summary>Number of allocations that required a new array.</summary>
+        public long MissCount => Interlocked.Read(ref missCount);
+
+        /// <summary>Allocates a buffer of size at least <paramref name="size"/> bytes.</summary>
+        /// <param name="size">Minimum size in bytes needed for the buffer. Cannot be negative.</param>
+        /// <param name="context">Index of slot with underlying array. Must be passed to <see cref="Free(IntPtr, IntPtr)"/>.</param>
+        /// <returns>A pointer to the first element of pinned array. This memory must be released using the <see cref="Free(IntPtr, IntPtr)"/> method.</returns>
+        public IntPtr Allocate(int size, out IntPtr context)
+        {
+            if (size < 0)
+                throw new ArgumentOutOfRangeException(nameof(size));
+
+            var isPooled = size <= PooledMemoryAllocator.MaxPooledBufferSize;
+            var sizeClass = isPooled ? PooledMemoryAllocator.GetSizeClass(size) : -1;
+
+            lock (sync)
+            {
+                var pool = isPooled ? pooledSlots[sizeClass] : null;
+                if (pool != null && pool.Count > 0)
+                {
+                    var pooledSlot = pool.Pop();
+                    pooledBytes -= slots[pooledSlot]!.Length;
+                    slotsInUse[pooledSlot] = true;
+                    hitCount++;
+                    context = new(pooledSlot);
+                    return Marshal.UnsafeAddrOfPinnedArrayElement(slots[pooledSlot]!, 0);
+                }
+            }
+
+            // Allocation of new array is performed out of lock
+            var array = GC.AllocateUninitializedArray<byte>(
+                isPooled ? PooledMemoryAllocator.GetSizeClassBytes(sizeClass) : Math.Max(size, 1),
+                pinned: true);
+
+            lock (sync)
+            {
+                missCount++;
+                var slot = freeSlots.Count > 0 ? freeSlots.Pop() : slotCount++;
+                if (slot >= slots.Length)
+                {
+                    Array.Resize(ref slots, slots.Length * 2);
+                    Array.Resize(ref slotsInUse, slots.Length);
+                }
+                slots[slot] = array;
+                slotsInUse[slot] = true;
+                context = new(slot);
+            }
+
+            return Marshal.UnsafeAddrOfPinnedArrayElement(array, 0);
+        }
+
+        /// <summary>Returns memory previously allocated by <see cref="Allocate(int, out IntPtr)"/> method to the pool.</summary>
+        /// <param name="buffer">The handle returned by the original matching call to <see cref="Allocate(int, out IntPtr)"/> method.</param>
+        /// <param name="context">The context returned by the original matching call to <see cref="Allocate(int, out IntPtr)"/> method.</param>
+        /// <remarks>Repeated call for the same buffer is ignored.</remarks>
+        public void Free(IntPtr buffer, IntPtr context)
+        {
+            if (buffer == IntPtr.Zero)
+                return;
+
+            var slot = context.ToInt32();
+
+            lock (sync)
+            {
+                // Unknown or already released buffer
+                if (slot < 0 || slot >= slotCount || !slotsInUse[slot]
+                    || Marshal.UnsafeAddrOfPinnedArrayElement(slots[slot]!, 0) != buffer)
+                {
+                    return;
+                }
+
+                var array = slots[slot]!;
+                slotsInUse[slot] = false;
+                var sizeClass = array.Length <= PooledMemoryAllocator.MaxPooledBufferSize
+                    ? PooledMemoryAllocator.GetSizeClass(array.Length)
+                    : -1;
+                if (sizeClass >= 0 && pooledBytes + array.Length <= MaxPooledBytes)
+                {
+                    (pooledSlots[sizeClass] ??= new Stack<int>()).Push(slot);
+                    pooledBytes += array.Length;
+                }
+                else
+                {
+                    ReleaseSlot(slot);
+                }
+            }
+        }
+
+        /// <summary>Gives all pooled arrays back to garbage collector.</summary>
+        /// <remarks>Arrays that are currently in use are not affected: they will be returned to the pool on release as usual.</remarks>
+        public void Trim()
+        {
+            lock (sync)
+            {
+                foreach (var pool in pooledSlots)
+                {
+                    while (pool != null && pool.Count > 0)
+                        ReleaseSlot(pool.Pop());
+                }
+                pooledBytes = 0;
+            }
+        }
+
+        // Must be called under lock
+        private void ReleaseSlot(int slot)
+        {
+            slots[slot] = null;
+            freeSlots.Push(slot);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,317 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace K4AdotNet
+{
+    /// <summary>
+    /// Implementation of <see cref="ICustomMemoryAllocator"/> interface that recycles released buffers
+    /// instead of returning them to the operating system on every call.
+    /// </summary>
+    /// <remarks><para>
+    /// Requested sizes are rounded up to size classes (four classes per power of two, so that at most 25% of a buffer is wasted).
+    /// Released buffers are kept in free lists keyed by size class: one buffer per size class in a thread-local slot
+    /// plus a global free list shared by all threads.
+    /// </para><para>
+    /// The total amount of memory kept in free lists is limited by <see cref="MaxPooledBytes"/>.
+    /// Buffers that stay unused in the global free list for longer than <see cref="IdleTimeout"/> are released to the operating system.
+    /// Thread-local slots are flushed to the global free list on each idle check (every half of <see cref="IdleTimeout"/>),
+    /// thus buffers cached by idle or exited threads are released too, after at most about two <see cref="IdleTimeout"/>s.
+    /// Call <see cref="Trim"/> to release all pooled buffers explicitly.
+    /// </para><para>
+    /// The same instance can be used as <see cref="Sdk.CustomMemoryAllocator"/>
+    /// and as allocator for <see cref="Sensor.Image(Sensor.ImageFormat, int, int, int, int, ICustomMemoryAllocator)"/> constructor.
+    /// Implementation is thread safe.
+    /// </para></remarks>
+    /// <seealso cref="Sdk.CustomMemoryAllocator"/>
+    /// <seealso cref="HGlobalMemoryAllocator"/>
+    public sealed class PooledMemoryAllocator : ICustomMemoryAllocator
+    {
+        /// <summary>Default value of <see cref="MaxPooledBytes"/>: 256 MB.</summary>
+        public const long DefaultMaxPooledBytes = 256L * 1024 * 1024;
+
+        /// <summary>Default value of <see cref="IdleTimeout"/>: 10 seconds.</summary>
+        public static readonly TimeSpan DefaultIdleTimeout = TimeSpan.FromSeconds(10);
+
+        /// <summary>The smallest size class in bytes. Smaller requests are rounded up to this value.</summary>
+        public const int MinPooledBufferSize = 1 << MIN_SIZE_CLASS_LOG2;
+
+        /// <summary>The biggest size class in bytes. Bigger requests are served directly by <see cref="Marshal.AllocHGlobal(int)"/> without pooling.</summary>
+        public const int MaxPooledBufferSize = 1 << MAX_SIZE_CLASS_LOG2;
+
+        private const int MIN_SIZE_CLASS_LOG2 = 12;
+        private const int MAX_SIZE_CLASS_LOG2 = 28;
+        private const int SIZE_CLASSES_PER_POWER_OF_TWO = 4;
+        private const int SIZE_CLASS_COUNT = 1 + (MAX_SIZE_CLASS_LOG2 - MIN_SIZE_CLASS_LOG2) * SIZE_CLASSES_PER_POWER_OF_TWO;
+
+        // Context value for buffers that are not pooled because of their size
+        private static readonly IntPtr notPooledContext = new(-1);
+
+        private readonly FreeList[] freeLists;
+        private readonly ThreadLocal<IntPtr[]> threadCaches;
+        private readonly int idleTimeoutMs;
+        private long pooledBytes;
+        private long hitCount;
+        private long missCount;
+        private int lastIdleTrimTicks;
+
+        /// <summary>Creates pooling allocator with default settings.</summary>
+        /// <seealso cref="DefaultMaxPooledBytes"/>
+        /// <seealso cref="DefaultIdleTimeout"/>
+        public PooledMemoryAllocator()
+            : this(DefaultMaxPooledBytes, DefaultIdleTimeout)
+        { }
+
+        /// <summary>Creates pooling allocator with specified memory cap and trim policy.</summary>
+        /// <param name="maxPooledBytes">Maximum total size in bytes of released buffers kept for reuse. Cannot be negative.</param>
+        /// <param name="idleTimeout">
+        /// Buffers that were not reused during this time are released to the operating system.
+        /// Use <see cref="System.Threading.Timeout.InfiniteTimeSpan"/> to keep buffers until explicit call of <see cref="Trim"/>.
+        /// </param>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="maxPooledBytes"/> is negative or <paramref name="idleTimeout"/> is negative or too big.</exception>
+        public PooledMemoryAllocator(long maxPooledBytes, TimeSpan idleTimeout)
+        {
+            if (maxPooledBytes < 0)
+                throw new ArgumentOutOfRangeException(nameof(maxPooledBytes));
+            if (idleTimeout != System.Threading.Timeout.InfiniteTimeSpan
+                && (idleTimeout < TimeSpan.Zero || idleTimeout.TotalMilliseconds > int.MaxValue))
+            {
+                throw new ArgumentOutOfRangeException(nameof(idleTimeout));
+            }
+
+            MaxPooledBytes = maxPooledBytes;
+            IdleTimeout = idleTimeout;
+            idleTimeoutMs = idleTimeout == System.Threading.Timeout.InfiniteTimeSpan ? -1 : (int)idleTimeout.TotalMilliseconds;
+            lastIdleTrimTicks = Environment.TickCount;
+
+            freeLists = new FreeList[SIZE_CLASS_COUNT];
+            for (var i = 0; i < freeLists.Length; i++)
+                freeLists[i] = new FreeList();
+            threadCaches = new(() => new IntPtr[SIZE_CLASS_COUNT], trackAllValues: true);
+        }
+
+        /// <summary>Maximum total size in bytes of released buffers kept for reuse.</summary>
+        public long MaxPooledBytes { get; }
+
+        /// <summary>Buffers that were not reused during this time are released to the operating system.</summary>
+        public TimeSpan IdleTimeout { get; }
+
+        /// <summary>Current total size in bytes of released buffers kept for reuse.</summary>
+        public long PooledBytes => Interlocked.Read(ref pooledBytes);
+
+        /// <summary>Number of allocations served from the pool.</summary>
+        public long HitCount => Interlocked.Read(ref hitCount);
+
+        /// <summary>Number of allocations that required a new buffer from the operating system.</summary>
+        public long MissCount => Interlocked.Read(ref missCount);
+
+        /// <summary>Allocates a buffer of size at least <paramref name="size"/> bytes.</summary>
+        /// <param name="size">Minimum size in bytes needed for the buffer. Cannot be negative.</param>
+        /// <param name="context">Size class of allocated buffer. Must be passed to <see cref="Free(IntPtr, IntPtr)"/>.</param>
+        /// <returns>A pointer to the allocated memory. This memory must be released using the <see cref="Free(IntPtr, IntPtr)"/> method.</returns>
+        public IntPtr Allocate(int size, out IntPtr context)
+        {
+            if (size > MaxPooledBufferSize)
+            {
+                Interlocked.Increment(ref missCount);
+                context = notPooledContext;
+                return Marshal.AllocHGlobal(size);
+            }
+
+            var sizeClass = GetSizeClass(size);
+            context = new(sizeClass);
+
+            var buffer = Interlocked.Exchange(ref threadCaches.Value![sizeClass], IntPtr.Zero);
+            if (buffer == IntPtr.Zero)
+                buffer = freeLists[sizeClass].TryPop();
+
+            if (buffer != IntPtr.Zero)
+            {
+                Interlocked.Increment(ref hitCount);
+                Interlocked.Add(ref pooledBytes, -GetSizeClassBytes(sizeClass));
+                return buffer;
+            }
+
+            Interlocked.Increment(ref missCount);
+            return Marshal.AllocHGlobal(GetSizeClassBytes(sizeClass));
+        }
+
+        /// <summary>Returns memory previously allocated by <see cref="Allocate(int, out IntPtr)"/> method to the pool.</summary>
+        /// <param name="buffer">The handle returned by the original matching call to <see cref="Allocate(int, out IntPtr)"/> method.</param>
+        /// <param name="context">The context returned by the original matching call to <see cref="Allocate(int, out IntPtr)"/> method.</param>
+        public void Free(IntPtr buffer, IntPtr context)
+        {
+            if (buffer == IntPtr.Zero)
+                return;
+
+            var sizeClass = context.ToInt32();
+            if (sizeClass < 0 || sizeClass >= SIZE_CLASS_COUNT)
+            {
+                Marshal.FreeHGlobal(buffer);
+                return;
+            }
+
+            var sizeClassBytes = GetSizeClassBytes(sizeClass);
+            if (Interlocked.Add(ref pooledBytes, sizeClassBytes) > MaxPooledBytes)
+            {
+                Interlocked.Add(ref pooledBytes, -sizeClassBytes);
+                Marshal.FreeHGlobal(buffer);
+            }
+            else
+            {
+                var displaced = Interlocked.Exchange(ref threadCaches.Value![sizeClass], buffer);
+                if (displaced != IntPtr.Zero)
+                    freeLists[sizeClass].Push(displaced);
+            }
+
+            TrimIdleBuffersIfItIsTime();
+        }
+
+        /// <summary>Releases all pooled buffers to the operating system.</summary>
+        /// <remarks>Buffers that are currently in use are not affected: they will be returned to the pool on release as usual.</remarks>
+        public void Trim()
+        {
+            foreach (var cache in threadCaches.Values)
+            {
+                for (var sizeClass = 0; sizeClass < cache.Length; sizeClass++)
+                {
+                    var buffer = Interlocked.Exchange(ref cache[sizeClass], IntPtr.Zero);
+                    if (buffer != IntPtr.Zero)
+                        ReleasePooledBuffer(buffer, sizeClass);
+                }
+            }
+
+            for (var sizeClass = 0; sizeClass < freeLists.Length; sizeClass++)
+            {
+                foreach (var buffer in freeLists[sizeClass].RemoveOlderThan(Environment.TickCount, 0))
+                    ReleasePooledBuffer(buffer, sizeClass);
+            }
+        }
+
+        private void TrimIdleBuffersIfItIsTime()
+        {
+            if (idleTimeoutMs < 0)
+                return;
+
+            var now = Environment.TickCount;
+            var last = lastIdleTrimTicks;
+            if (unchecked(now - last) < Math.Max(idleTimeoutMs / 2, 1))
+                return;
+            if (Interlocked.CompareExchange(ref lastIdleTrimTicks, now, last) != last)
+                return;
+
+            for (var sizeClass = 0; sizeClass < freeLists.Length; sizeClass++)
+            {
+                foreach (var buffer in freeLists[sizeClass].RemoveOlderThan(now, idleTimeoutMs))
+                    ReleasePooledBuffer(buffer, sizeClass);
+            }
+
+            // Slots of idle and exited threads would hold their buffers forever otherwise.
+            // Active threads lose only one fast-path hit per size class: the buffer is still reused from the global free list.
+            foreach (var cache in threadCaches.Values)
+            {
+                for (var sizeClass = 0; sizeClass < cache.Length; sizeClass++)
+                {
+                    var buffer = Interlocked.Exchange(ref cache[sizeClass], IntPtr.Zero);
+                    if (buffer != IntPtr.Zero)
+                        freeLists[sizeClass].Push(buffer);
+                }
+            }
+        }
+
+        private void ReleasePooledBuffer(IntPtr buffer, int sizeClass)
+        {
+            Interlocked.Add(ref pooledBytes, -GetSizeClassBytes(sizeClass));
+            Marshal.FreeHGlobal(buffer);
+        }
+
+        /// <summary>Index of the smallest size class that can hold <paramref name="size"/> bytes.</summary>
+        internal static int GetSizeClass(int size)
+        {
+            if (size <= MinPooledBufferSize)
+                return 0;
+
+            var log2 = Log2(size - 1);
+            var shift = log2 - 2;                       // quarter of power of two
+            var quarters = ((size - 1) >> shift) + 1;   // in range [5, 8]
+            return 1 + (log2 - MIN_SIZE_CLASS_LOG2) * SIZE_CLASSES_PER_POWER_OF_TWO + (quarters - 5);
+        }
+
+        /// <summary>Size in bytes of buffers in size class <paramref name="sizeClass"/>.</summary>
+        internal static int GetSizeClassBytes(int sizeClass)
+        {
+            if (sizeClass == 0)
+                return MinPooledBufferSize;
+
+            var log2 = MIN_SIZE_CLASS_LOG2 + (sizeClass - 1) / SIZE_CLASSES_PER_POWER_OF_TWO;
+            var quarters = 5 + (sizeClass - 1) % SIZE_CLASSES_PER_POWER_OF_TWO;
+            return quarters << (log2 - 2);
+        }
+
+        private static int Log2(int value)
+        {
+            var res = 0;
+            while ((value >>= 1) != 0)
+                res++;
+            return res;
+        }
+
+        // Global free list of buffers of one size class. The most recently released buffers are at the end of the list.
+        private sealed class FreeList
+        {
+            private readonly List<Entry> entries = new();
+
+            public void Push(IntPtr buffer)
+            {
+                lock (entries)
+                {
+                    entries.Add(new Entry(buffer, Environment.TickCount));
+                }
+            }
+
+            public IntPtr TryPop()
+            {
+                lock (entries)
+                {
+                    var count = entries.Count;
+                    if (count == 0)
+                        return IntPtr.Zero;
+                    var buffer = entries[count - 1].Buffer;
+                    entries.RemoveAt(count - 1);
+                    return buffer;
+                }
+            }
+
+            public IReadOnlyList<IntPtr> RemoveOlderThan(int nowTicks, int ageMs)
+            {
+                lock (entries)
+                {
+                    var count = 0;
+                    while (count < entries.Count && unchecked(nowTicks - entries[count].ReleaseTicks) >= ageMs)
+                        count++;
+                    if (count == 0)
+                        return Array.Empty<IntPtr>();
+
+                    var res = new IntPtr[count];
+                    for (var i = 0; i < count; i++)
+                        res[i] = entries[i].Buffer;
+                    entries.RemoveRange(0, count);
+                    return res;
+                }
+            }
+
+            private readonly struct Entry
+            {
+                public readonly IntPtr Buffer;
+                public readonly int ReleaseTicks;
+
+                public Entry(IntPtr buffer, int releaseTicks)
+                {
+                    Buffer = buffer;
+                    ReleaseTicks = releaseTicks;
+                }
+            }
+        }
+    }
+}
@@ -4,6 +4,11 @@ using System.Runtime.InteropServices;
 namespace K4AdotNet.Record
 {
     /// <summary>DLL imports for most of native functions from <c>record.h</c> and <c>playback.h</c> header files.</summary>
+    /// <remarks>
+    /// Trivial getters and setters that neither block nor call back to managed code are marked with <c>SuppressGCTransition</c> attribute
+    /// for .NET 6 target to reduce the cost of call. Don't put this attribute on functions that can release objects
+    /// (releasing of image can call memory destroy callback implemented in managed code).
+    /// </remarks>
     internal static class NativeApi
     {
         #region record.h
@@ -699,6 +704,9 @@ namespace K4AdotNet.Record
         /// Returns the device timestamp of the data block. If the <paramref name="dataBlockHandle"/> is invalid this function will return <see cref="Microseconds64.Zero"/>.
         /// It is also possible for <see cref="Microseconds64.Zero"/> to be a valid timestamp originating from when a device was first powered on.
         /// </returns>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.RECORD_DLL_NAME, EntryPoint = "k4a_playback_data_block_get_device_timestamp_usec", CallingConvention = CallingConvention.Cdecl)]
         public static extern Microseconds64 PlaybackDataBlockGetDeviceTimestamp(NativeHandles.PlaybackDataBlockHandle dataBlockHandle);
 
@@ -711,6 +719,9 @@ namespace K4AdotNet.Record
         /// <returns>
         /// Returns the buffer size of the data block, or 0 if the data block is invalid.
         /// </returns>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.RECORD_DLL_NAME, EntryPoint = "k4a_playback_data_block_get_buffer_size", CallingConvention = CallingConvention.Cdecl)]
         public static extern UIntPtr PlaybackDataBlockGetBufferSize(NativeHandles.PlaybackDataBlockHandle dataBlockHandle);
 
@@ -724,6 +735,9 @@ namespace K4AdotNet.Record
         /// Returns a pointer to the data block buffer, or <see cref="IntPtr.Zero"/> if the data block is invalid.
         /// </returns>
         /// <remarks>Use this buffer to access the data written to a custom recording track.</remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.RECORD_DLL_NAME, EntryPoint = "k4a_playback_data_block_get_buffer", CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr PlaybackDataBlockGetBuffer(NativeHandles.PlaybackDataBlockHandle dataBlockHandle);
 
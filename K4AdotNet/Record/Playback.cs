@@ -1,4 +1,5 @@
 ﻿using System;
+using System.Collections.Generic;
 using System.Diagnostics.CodeAnalysis;
 using System.IO;
 using System.Text;
@@ -12,6 +13,16 @@ namespace K4AdotNet.Record
         private readonly NativeHandles.HandleWrapper<NativeHandles.PlaybackHandle> handle;      // This class is an wrapper around this handle
         private readonly Lazy<PlaybackTrackCollection> tracks;
 
+        // Recording is immutable, thus metadata read from it can be cached. All cache fields are guarded by metadataSync.
+        private readonly object metadataSync = new();
+        private readonly Dictionary<string, string?> tags = new();                  // null value means that tag doesn't exist
+        private readonly Dictionary<string, byte[]> attachmentNames = new();        // null-terminated UTF8 representation of names
+        private byte[]? rawCalibration;
+        private Sensor.BlittableCalibration calibration;
+        private bool hasCalibration;
+        private RecordConfiguration recordConfiguration;
+        private bool hasRecordConfiguration;
+
         /// <summary>Opens an existing recording file for reading.</summary>
         /// <param name="filePath">File system path of the existing recording. Not <see langword="null"/>. Not empty.</param>
         /// <exception cref="ArgumentNullException"><paramref name="filePath"/> is null or empty.</exception>
@@ -102,31 +113,88 @@ namespace K4AdotNet.Record
 
         /// <summary>Get the raw calibration blob for the Azure Kinect device used during recording.</summary>
         /// <returns>Raw calibration data terminated by <c>0</c> byte. Not <see langword="null"/>.</returns>
-        /// <remarks>The raw calibration may not exist if the device was not specified during recording.</remarks>
+        /// <remarks><para>
+        /// The raw calibration may not exist if the device was not specified during recording.
+        /// </para><para>
+        /// Data is read from recording only once and then cached. Each call returns new copy of cached data.
+        /// </para></remarks>
         /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
         /// <exception cref="PlaybackException">Cannot read calibration data from recording. See logs for details.</exception>
         /// <seealso cref="Sensor.Device.GetRawCalibration"/>
         public byte[] GetRawCalibration()
+            => (byte[])GetCachedRawCalibration().Clone();
+
+        private byte[] GetCachedRawCalibration()
         {
-            if (!Helpers.TryGetValueInByteBuffer(NativeApi.PlaybackGetRawCalibration, handle.ValueNotDisposed, out var result))
-                throw new PlaybackException(FilePath);
-            return result;
+            var playbackHandle = handle.ValueNotDisposed;
+            lock (metadataSync)
+            {
+                if (rawCalibration is null)
+                {
+                    if (!Helpers.TryGetValueInByteBuffer(NativeApi.PlaybackGetRawCalibration, playbackHandle, out var result))
+                        throw new PlaybackException(FilePath);
+                    rawCalibration = result;
+                }
+                return rawCalibration;
+            }
         }
 
         /// <summary>Get the camera calibration for Azure Kinect device used during recording.</summary>
         /// <param name="calibration">Output: calibration data.</param>
-        /// <remarks>The calibration may not exist if the device was not specified during recording.</remarks>
+        /// <remarks><para>
+        /// The calibration may not exist if the device was not specified during recording.
+        /// </para><para>
+        /// Calibration is read from recording only once and then cached.
+        /// </para></remarks>
         /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
         /// <exception cref="PlaybackException">Cannot read calibration data from recording. See logs for details.</exception>
         public void GetCalibration(out Sensor.Calibration calibration)
-            => CheckResult(NativeApi.PlaybackGetCalibration(handle.ValueNotDisposed, out calibration));
+        {
+            GetBlittableCalibration(out var blittableCalibration);
+            blittableCalibration.ToCalibration(out calibration);
+        }
+
+        /// <summary>Get the camera calibration for Azure Kinect device used during recording in blittable representation.</summary>
+        /// <param name="calibration">Output: calibration data.</param>
+        /// <remarks>
+        /// Unlike <see cref="GetCalibration(out Sensor.Calibration)"/>, this method doesn't allocate any memory
+        /// (except of the first call that reads calibration from recording).
+        /// </remarks>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
+        /// <exception cref="PlaybackException">Cannot read calibration data from recording. See logs for details.</exception>
+        public void GetBlittableCalibration(out Sensor.BlittableCalibration calibration)
+        {
+            var playbackHandle = handle.ValueNotDisposed;
+            lock (metadataSync)
+            {
+                if (!hasCalibration)
+                {
+                    CheckResult(NativeApi.PlaybackGetCalibration(playbackHandle, out Sensor.Calibration result));
+                    this.calibration = new Sensor.BlittableCalibration(in result);
+                    hasCalibration = true;
+                }
+                calibration = this.calibration;
+            }
+        }
 
         /// <summary>Get the device configuration used during recording.</summary>
         /// <param name="config">Output: recording configuration.</param>
+        /// <remarks>Configuration is read from recording only once and then cached.</remarks>
         /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
         /// <exception cref="PlaybackException">Cannot read configuration from recording. See logs for details.</exception>
         public void GetRecordConfiguration(out RecordConfiguration config)
-            => CheckResult(NativeApi.PlaybackGetRecordConfiguration(handle.ValueNotDisposed, out config));
+        {
+            var playbackHandle = handle.ValueNotDisposed;
+            lock (metadataSync)
+            {
+                if (!hasRecordConfiguration)
+                {
+                    CheckResult(NativeApi.PlaybackGetRecordConfiguration(playbackHandle, out recordConfiguration));
+                    hasRecordConfiguration = true;
+                }
+                config = recordConfiguration;
+            }
+        }
 
         /// <summary>Reads the value of a tag from a recording.</summary>
         /// <param name="name">The name of the tag to read. Not <see langword="null"/> and not empty. Can contain only ASCII characters.</param>
@@ -138,6 +206,7 @@ namespace K4AdotNet.Record
         /// <remarks>
         /// Tags are global to a file, and should store data related to the entire recording, such as camera configuration or
         /// recording location.
+        /// Value of tag (or absence of it) is read from recording only once and then cached.
         /// </remarks>
         /// <exception cref="ArgumentNullException"><paramref name="name"/> is <see langword="null"/> or empty.</exception>
         /// <exception cref="ArgumentException"><paramref name="name"/> contains non-ASCII characters.</exception>
@@ -150,16 +219,20 @@ namespace K4AdotNet.Record
             if (!Helpers.IsAsciiCompatible(name))
                 throw new ArgumentException("Tag name can contain only ASCII symbols.", nameof(name));
 
-            var nameAsBytes = Helpers.StringToBytes(name, Encoding.ASCII);
-
-            if (!Helpers.TryGetValueInByteBuffer(GetTag, nameAsBytes, out var valueAsBytes))
+            handle.CheckNotDisposed();
+            lock (metadataSync)
             {
-                value = null;
-                return false;
+                if (!tags.TryGetValue(name, out value))
+                {
+                    var nameAsBytes = Helpers.StringToBytes(name, Encoding.ASCII);
+                    value = Helpers.TryGetValueInByteBuffer(GetTag, nameAsBytes, out var valueAsBytes)
+                        ? Encoding.UTF8.GetString(valueAsBytes, 0, valueAsBytes.Length - 1)
+                        : null;
+                    tags.Add(name, value);
+                }
             }
 
-            value = Encoding.UTF8.GetString(valueAsBytes, 0, valueAsBytes.Length - 1);
-            return true;
+            return value != null;
         }
 
         private NativeCallResults.BufferResult GetTag(byte[] name, IntPtr buffer, ref UIntPtr size)
@@ -184,6 +257,80 @@ namespace K4AdotNet.Record
             return Helpers.TryGetValueInByteBuffer(GetAttachment, attachmentNameAsBytes, out attachmentData);
         }
 
+#if !(NETSTANDARD2_0 || NET461)
+
+        /// <summary>Reads an attachment file from a recording to caller-provided memory.</summary>
+        /// <param name="attachmentName">Attachment file name. Not <see langword="null"/>, not empty.</param>
+        /// <param name="destination">Memory for attachment data.</param>
+        /// <param name="size">
+        /// Output: size of attachment data in bytes written to <paramref name="destination"/>.
+        /// Or required size of <paramref name="destination"/> if it is too small.
+        /// Or zero if attachment doesn't exist.
+        /// </param>
+        /// <returns>
+        /// <see langword="true"/> attachment successfully read to <paramref name="destination"/>,
+        /// <see langword="false"/> if attachment cannot be read (most likely, attachment with specified name doesn't exist in recording)
+        /// or if <paramref name="destination"/> is too small (in this case <paramref name="size"/> is positive).
+        /// </returns>
+        /// <remarks>
+        /// Attachment data is not cached (attachments can be big), but this method doesn't allocate memory
+        /// and can be used with pooled buffers.
+        /// </remarks>
+        /// <exception cref="ArgumentNullException"><paramref name="attachmentName"/> is <see langword="null"/> or empty.</exception>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
+        /// <seealso cref="TryGetAttachment(string, out byte[])"/>
+        public unsafe bool TryGetAttachment(string attachmentName, Span<byte> destination, out int size)
+        {
+            if (string.IsNullOrEmpty(attachmentName))
+                throw new ArgumentNullException(nameof(attachmentName));
+
+            var playbackHandle = handle.ValueNotDisposed;
+
+            byte[]? attachmentNameAsBytes;
+            lock (metadataSync)
+            {
+                if (!attachmentNames.TryGetValue(attachmentName, out attachmentNameAsBytes))
+                {
+                    attachmentNameAsBytes = Helpers.StringToBytes(attachmentName, Encoding.UTF8);
+                    attachmentNames.Add(attachmentName, attachmentNameAsBytes);
+                }
+            }
+
+            NativeCallResults.BufferResult res;
+            fixed (byte* buffer = destination)
+            {
+                var bufferSize = Helpers.Int32ToUIntPtr(destination.Length);
+                res = NativeApi.PlaybackGetAttachment(playbackHandle, attachmentNameAsBytes, new IntPtr(buffer), ref bufferSize);
+                size = Helpers.UIntPtrToInt32(bufferSize);
+            }
+
+            if (res == NativeCallResults.BufferResult.Succeeded)
+                return true;
+            if (res != NativeCallResults.BufferResult.TooSmall)
+                size = 0;
+            return false;
+        }
+
+        /// <summary>Copies raw calibration blob for the Azure Kinect device used during recording to caller-provided memory.</summary>
+        /// <param name="destination">Memory for raw calibration data.</param>
+        /// <param name="size">Output: size of raw calibration data in bytes (including terminating <c>0</c> byte).</param>
+        /// <returns>
+        /// <see langword="true"/> data was copied to <paramref name="destination"/>,
+        /// <see langword="false"/> <paramref name="destination"/> is too small (in this case <paramref name="size"/> contains required size).
+        /// </returns>
+        /// <remarks>Data is read from recording only once and then cached. Subsequent calls don't allocate memory.</remarks>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
+        /// <exception cref="PlaybackException">Cannot read calibration data from recording. See logs for details.</exception>
+        /// <seealso cref="GetRawCalibration"/>
+        public bool TryGetRawCalibration(Span<byte> destination, out int size)
+        {
+            var data = GetCachedRawCalibration();
+            size = data.Length;
+            return data.AsSpan().TryCopyTo(destination);
+        }
+
+#endif
+
         private NativeCallResults.BufferResult GetAttachment(byte[] attachmentName, IntPtr buffer, ref UIntPtr size)
             => NativeApi.PlaybackGetAttachment(handle.ValueNotDisposed, attachmentName, buffer, ref size);
 
@@ -11,14 +11,7 @@ namespace K4AdotNet.Record
 
         private PlaybackDataBlock(NativeHandles.PlaybackDataBlockHandle handle)
         {
-            this.handle = handle;
-            this.handle.Disposed += Handle_Disposed;
-        }
-
-        private void Handle_Disposed(object? sender, EventArgs e)
-        {
-            handle.Disposed -= Handle_Disposed;
-            Disposed?.Invoke(this, EventArgs.Empty);
+            this.handle = NativeHandles.HandleWrapper<NativeHandles.PlaybackDataBlockHandle>.Create(handle, this, Sdk.FinalizerFreeMode);
         }
 
         /// <summary>
@@ -35,7 +28,11 @@ namespace K4AdotNet.Record
 
         /// <summary>Raised on object disposing (only once).</summary>
         /// <seealso cref="Dispose"/>
-        public event EventHandler? Disposed;
+        public event EventHandler? Disposed
+        {
+            add => handle.Disposed += value;
+            remove => handle.Disposed -= value;
+        }
 
         /// <summary>Gets the device timestamp of a data block in microseconds.</summary>
         /// <exception cref="ObjectDisposedException">This property cannot be asked for disposed object.</exception>
@@ -12,6 +12,12 @@ namespace K4AdotNet.Record
         private readonly Playback playback;
         private readonly byte[] nameAsBytes;
 
+        // Track information is immutable, thus it is read from recording only once. Cache fields are guarded by cacheSync.
+        private readonly object cacheSync = new();
+        private string? codecId;
+        private byte[]? codecContext;
+        private RecordVideoSettings? videoSettings;
+
         /// <summary>Creates track object with specified <paramref name="index"/> for specified <paramref name="playback"/>.</summary>
         /// <param name="playback">Owner. Not <see langword="null"/>.</param>
         /// <param name="index">Zero-based index of track.</param>
@@ -47,16 +53,25 @@ namespace K4AdotNet.Record
         public bool IsBuiltIn { get; }
 
         /// <summary>Gets the video-specific track information for this track.</summary>
+        /// <remarks>Value is read from recording only once and then cached.</remarks>
         /// <exception cref="InvalidOperationException">This is not a video track.</exception>
         /// <exception cref="ObjectDisposedException">Appropriated <see cref="Playback"/> object was disposed object.</exception>
         public RecordVideoSettings VideoSettings
         {
             get
             {
-                var res = NativeApi.PlaybackTrackGetVideoSetting(PlaybackHandle, nameAsBytes, out var videoSettings);
-                if (res != NativeCallResults.Result.Succeeded)
-                    throw new InvalidOperationException("This is not a video track.");
-                return videoSettings;
+                var playbackHandle = PlaybackHandle;
+                lock (cacheSync)
+                {
+                    if (!videoSettings.HasValue)
+                    {
+                        var res = NativeApi.PlaybackTrackGetVideoSetting(playbackHandle, nameAsBytes, out var settings);
+                        if (res != NativeCallResults.Result.Succeeded)
+                            throw new InvalidOperationException("This is not a video track.");
+                        videoSettings = settings;
+                    }
+                    return videoSettings.Value;
+                }
             }
         }
 
@@ -64,6 +79,7 @@ namespace K4AdotNet.Record
         /// <remarks>
         /// The codec ID is a string that corresponds to the codec of the track's data. Some of the existing formats are listed
         /// here: https://www.matroska.org/technical/specs/codecid/index.html. It can also be custom defined by the user.
+        /// Value is read from recording only once and then cached.
         /// </remarks>
         /// <exception cref="PlaybackException">Cannot get coded ID for this track for some reason. See logs for details.</exception>
         /// <exception cref="ObjectDisposedException">Appropriated <see cref="Playback"/> object was disposed object.</exception>
@@ -71,9 +87,17 @@ namespace K4AdotNet.Record
         {
             get
             {
-                if (!Helpers.TryGetValueInByteBuffer(GetCodecId, nameAsBytes, out var codecIdAsBytes))
-                    throw new PlaybackException("Cannot get codec ID for track #" + Index, playback.FilePath);
-                return Encoding.UTF8.GetString(codecIdAsBytes, 0, codecIdAsBytes.Length - 1);
+                _ = PlaybackHandle;     // to check that playback is not disposed
+                lock (cacheSync)
+                {
+                    if (codecId is null)
+                    {
+                        if (!Helpers.TryGetValueInByteBuffer(GetCodecId, nameAsBytes, out var codecIdAsBytes))
+                            throw new PlaybackException("Cannot get codec ID for track #" + Index, playback.FilePath);
+                        codecId = Encoding.UTF8.GetString(codecIdAsBytes, 0, codecIdAsBytes.Length - 1);
+                    }
+                    return codecId;
+                }
             }
         }
 
@@ -84,19 +108,52 @@ namespace K4AdotNet.Record
         /// <remarks>
         /// The codec context is a codec-specific buffer that contains any required codec metadata that is only known to the
         /// codec. It is mapped to the matroska <c>CodecPrivate</c> element. Not <see langword="null"/>.
+        /// Value is read from recording only once and then cached. Each call returns new copy of cached data.
         /// </remarks>
         /// <exception cref="PlaybackException">Cannot get coded context for this track for some reason. See logs for details.</exception>
         /// <exception cref="ObjectDisposedException">Appropriated <see cref="Playback"/> object was disposed object.</exception>
         public byte[] CodecContext
         {
-            get
+            get => (byte[])GetCachedCodecContext().Clone();
+        }
+
+        private byte[] GetCachedCodecContext()
+        {
+            _ = PlaybackHandle;     // to check that playback is not disposed
+            lock (cacheSync)
             {
-                if (!Helpers.TryGetValueInByteBuffer(GetCodecContext, nameAsBytes, out var codecContext))
-                    throw new PlaybackException("Cannot get codec context for track #" + Index, playback.FilePath);
+                if (codecContext is null)
+                {
+                    if (!Helpers.TryGetValueInByteBuffer(GetCodecContext, nameAsBytes, out var result))
+                        throw new PlaybackException("Cannot get codec context for track #" + Index, playback.FilePath);
+                    codecContext = result;
+                }
                 return codecContext;
             }
         }
 
+#if !(NETSTANDARD2_0 || NET461)
+
+        /// <summary>Copies the codec context for this track to caller-provided memory.</summary>
+        /// <param name="destination">Memory for codec context.</param>
+        /// <param name="size">Output: size of codec context in bytes.</param>
+        /// <returns>
+        /// <see langword="true"/> codec context was copied to <paramref name="destination"/>,
+        /// <see langword="false"/> <paramref name="destination"/> is too small (in this case <paramref name="size"/> contains required size).
+        /// </returns>
+        /// <remarks>Codec context is read from recording only once and then cached. Subsequent calls don't allocate memory.</remarks>
+        /// <exception cref="PlaybackException">Cannot get coded context for this track for some reason. See logs for details.</exception>
+        /// <exception cref="ObjectDisposedException">Appropriated <see cref="Playback"/> object was disposed object.</exception>
+        /// <seealso cref="CodecContext"/>
+        public bool TryGetCodecContext(Span<byte> destination, out int size)
+        {
+            var data = GetCachedCodecContext();
+            size = data.Length;
+            return data.AsSpan().TryCopyTo(destination);
+        }
+
+#endif
+
         private NativeCallResults.BufferResult GetCodecContext(byte[] trackNameAsBytes, IntPtr buffer, ref UIntPtr size)
             => NativeApi.PlaybackTrackGetCodecContext(PlaybackHandle, trackNameAsBytes, buffer, ref size);
 
@@ -139,7 +139,7 @@ namespace K4AdotNet.Record
         /// <exception cref="ArgumentException"><paramref name="attachmentName"/> is not a valid file name.</exception>
         /// <exception cref="InvalidOperationException"><see cref="AddAttachment(string, byte[])"/> must be called before <see cref="WriteHeader"/>.</exception>
         /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
-        /// <seealso cref="Playback.TryGetAttachment"/>
+        /// <seealso cref="Playback.TryGetAttachment(string, out byte[])"/>
         public void AddAttachment(string attachmentName, byte[] attachmentData)
         {
             if (string.IsNullOrEmpty(attachmentName))
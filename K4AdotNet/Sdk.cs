@@ -1,9 +1,11 @@
 ﻿using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.Diagnostics.CodeAnalysis;
 using System.IO;
 using System.Linq;
+using System.Threading;
 
 [assembly: CLSCompliant(isCompliant: true)]
 
@@ -230,6 +232,114 @@ namespace K4AdotNet
             }
         }
 
+        // to keep callbacks alive for allocators passed directly to Image constructor
+        private static readonly Dictionary<ICustomMemoryAllocator, Sensor.NativeApi.MemoryDestroyCallback> imageMemoryDestroyCallbacks = new();
+
+        /// <summary>Gets native callback to destroy memory allocated by <paramref name="memoryAllocator"/>. For internal needs.</summary>
+        /// <param name="memoryAllocator">Instance of memory allocator. Not <see langword="null"/>.</param>
+        /// <returns>Reference to native callback to destroy memory. Callback is kept alive forever.</returns>
+        internal static Sensor.NativeApi.MemoryDestroyCallback GetMemoryDestroyCallback(ICustomMemoryAllocator memoryAllocator)
+        {
+            if (ReferenceEquals(memoryAllocator, HGlobalMemoryAllocator.Instance))
+                return HGlobalMemoryAllocator.MemoryDestroyCallback;
+
+            lock (customMemoryAllocatorSync)
+            {
+                if (!imageMemoryDestroyCallbacks.TryGetValue(memoryAllocator, out var memoryDestroyCallback))
+                {
+                    memoryDestroyCallback = new(memoryAllocator.Free);
+                    imageMemoryDestroyCallbacks.Add(memoryAllocator, memoryDestroyCallback);
+                }
+                return memoryDestroyCallback;
+            }
+        }
+
+        #endregion
+
+        #region Finalizer-free mode
+
+        private static volatile bool finalizerFreeMode;
+        private static volatile bool finalizerFreeObjectTracking;
+        private static long finalizerFreeObjectCount;
+        private static long lastFinalizerFreeObjectTrackingId;
+        private static readonly ConcurrentDictionary<long, string> trackedFinalizerFreeObjects = new();
+
+        /// <summary>
+        /// High-throughput mode: new objects of high-rate classes are created without finalizers.
+        /// Affected classes: <see cref="Sensor.Image"/>, <see cref="Sensor.Capture"/>,
+        /// <see cref="BodyTracking.BodyFrame"/> and <see cref="Record.PlaybackDataBlock"/>.
+        /// Default value is <see langword="false"/>.
+        /// </summary>
+        /// <remarks><para>
+        /// By default each object of these classes is registered for finalization to release unmanaged resources if it was not disposed.
+        /// At high frame rates that means steady load on finalizer queue and promotion of objects to generations 1 and 2.
+        /// In finalizer-free mode, objects are not registered for finalization and die in generation 0.
+        /// </para><para>
+        /// The price is that objects created in this mode MUST be disposed in an explicit manner, otherwise unmanaged resources leak.
+        /// Use <see cref="FinalizerFreeObjectCount"/> to detect such leaks
+        /// and <see cref="FinalizerFreeObjectTracking"/> to find out where leaked objects were created.
+        /// </para><para>
+        /// Switching of mode affects only objects that are created after switching.
+        /// </para></remarks>
+        /// <seealso cref="FinalizerFreeObjectCount"/>
+        public static bool FinalizerFreeMode
+        {
+            get => finalizerFreeMode;
+            set => finalizerFreeMode = value;
+        }
+
+        /// <summary>
+        /// Number of objects created in <see cref="FinalizerFreeMode"/> that are not disposed yet.
+        /// Helpful for detection of leaks: in steady state of application this value must not grow.
+        /// </summary>
+        /// <seealso cref="FinalizerFreeMode"/>
+        /// <seealso cref="FinalizerFreeObjectTracking"/>
+        public static long FinalizerFreeObjectCount => Interlocked.Read(ref finalizerFreeObjectCount);
+
+        /// <summary>
+        /// Debugging aid for leaks in <see cref="FinalizerFreeMode"/>: remember type and creation stack trace of each object created in this mode
+        /// until it is disposed. Default value is <see langword="false"/>.
+        /// </summary>
+        /// <remarks>
+        /// Capturing of stack trace is expensive, thus don't turn tracking on in production.
+        /// Switching affects only objects that are created after switching.
+        /// </remarks>
+        /// <seealso cref="GetUndisposedFinalizerFreeObjects"/>
+        public static bool FinalizerFreeObjectTracking
+        {
+            get => finalizerFreeObjectTracking;
+            set => finalizerFreeObjectTracking = value;
+        }
+
+        /// <summary>
+        /// Describes objects that were created in <see cref="FinalizerFreeMode"/> while <see cref="FinalizerFreeObjectTracking"/> was on
+        /// and that are not disposed yet.
+        /// </summary>
+        /// <returns>Type name and creation stack trace of each such object, in order of creation. Not <see langword="null"/>.</returns>
+        /// <seealso cref="FinalizerFreeObjectTracking"/>
+        public static IReadOnlyList<string> GetUndisposedFinalizerFreeObjects()
+            => trackedFinalizerFreeObjects.OrderBy(item => item.Key).Select(item => item.Value).ToArray();
+
+        // Returns tracking identifier (or zero if tracking is off) to be passed to DecrementFinalizerFreeObjectCount()
+        internal static long IncrementFinalizerFreeObjectCount(Type objectType)
+        {
+            Interlocked.Increment(ref finalizerFreeObjectCount);
+            if (!finalizerFreeObjectTracking)
+                return 0;
+
+            var trackingId = Interlocked.Increment(ref lastFinalizerFreeObjectTrackingId);
+            trackedFinalizerFreeObjects[trackingId] = objectType.FullName + " created" + Environment.NewLine
+                + new StackTrace(skipFrames: 3, fNeedFileInfo: true);
+            return trackingId;
+        }
+
+        internal static void DecrementFinalizerFreeObjectCount(long trackingId)
+        {
+            Interlocked.Decrement(ref finalizerFreeObjectCount);
+            if (trackingId != 0)
+                trackedFinalizerFreeObjects.TryRemove(trackingId, out _);
+        }
+
         #endregion
 
         #region Body tracking SDK availability and initialization
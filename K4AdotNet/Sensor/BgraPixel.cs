@@ -0,0 +1,76 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>One pixel of image in <see cref="ImageFormat.ColorBgra32"/> format.</summary>
+    /// <remarks>Memory layout of this structure matches layout of pixel in <see cref="ImageFormat.ColorBgra32"/> images.</remarks>
+    /// <seealso cref="ImageFormat.ColorBgra32"/>
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    public struct BgraPixel : IEquatable<BgraPixel>
+    {
+        /// <summary>Blue channel.</summary>
+        public byte B;
+
+        /// <summary>Green channel.</summary>
+        public byte G;
+
+        /// <summary>Red channel.</summary>
+        public byte R;
+
+        /// <summary>Alpha channel. Unused in the Azure Kinect APIs.</summary>
+        public byte A;
+
+        /// <summary>Constructs pixel with given channel values.</summary>
+        /// <param name="b">Blue channel.</param>
+        /// <param name="g">Green channel.</param>
+        /// <param name="r">Red channel.</param>
+        /// <param name="a">Alpha channel.</param>
+        public BgraPixel(byte b, byte g, byte r, byte a = byte.MaxValue)
+        {
+            B = b;
+            G = g;
+            R = r;
+            A = a;
+        }
+
+        /// <summary>Per-channel comparison.</summary>
+        /// <param name="other">Other pixel to be compared to this one.</param>
+        /// <returns><see langword="true"/> if all channels are equal.</returns>
+        public bool Equals(BgraPixel other)
+            => B == other.B && G == other.G && R == other.R && A == other.A;
+
+        /// <summary>Overloads <see cref="Object.Equals(object)"/> to be consistent with <see cref="Equals(BgraPixel)"/>.</summary>
+        /// <param name="obj">Object to be compared with this pixel.</param>
+        /// <returns><see langword="true"/> if <paramref name="obj"/> is a <see cref="BgraPixel"/> and is equal to this one.</returns>
+        /// <seealso cref="Equals(BgraPixel)"/>
+        public override bool Equals(object? obj)
+            => obj is BgraPixel pixel && Equals(pixel);
+
+        /// <summary>To be consistent with <see cref="Equals(BgraPixel)"/>.</summary>
+        /// <param name="left">Left part of operator.</param>
+        /// <param name="right">Right part of operator.</param>
+        /// <returns><see langword="true"/> if <paramref name="left"/> is equal to <paramref name="right"/>.</returns>
+        /// <seealso cref="Equals(BgraPixel)"/>
+        public static bool operator ==(BgraPixel left, BgraPixel right)
+            => left.Equals(right);
+
+        /// <summary>To be consistent with <see cref="Equals(BgraPixel)"/>.</summary>
+        /// <param name="left">Left part of operator.</param>
+        /// <param name="right">Right part of operator.</param>
+        /// <returns><see langword="true"/> if <paramref name="left"/> is not equal to <paramref name="right"/>.</returns>
+        /// <seealso cref="Equals(BgraPixel)"/>
+        public static bool operator !=(BgraPixel left, BgraPixel right)
+            => !left.Equals(right);
+
+        /// <summary>Calculates hash code.</summary>
+        /// <returns>Hash code. Consistent with overridden equality.</returns>
+        public override int GetHashCode()
+            => B | (G << 8) | (R << 16) | (A << 24);
+
+        /// <summary>Formats pixel as <c>#AARRGGBB</c> string.</summary>
+        /// <returns><c>#AARRGGBB</c>.</returns>
+        public override string ToString()
+            => $"#{A:X2}{R:X2}{G:X2}{B:X2}";
+    }
+}
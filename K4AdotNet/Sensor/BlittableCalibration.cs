@@ -0,0 +1,222 @@
+﻿using System;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Sensor
+{
+    // Defined in k4atypes.h:
+    // typedef struct _k4a_calibration_t
+    // {
+    //     k4a_calibration_camera_t depth_camera_calibration;
+    //     k4a_calibration_camera_t color_camera_calibration;
+    //     k4a_calibration_extrinsics_t extrinsics[K4A_CALIBRATION_TYPE_NUM][K4A_CALIBRATION_TYPE_NUM];
+    //     k4a_depth_mode_t depth_mode;
+    //     k4a_color_resolution_t color_resolution;
+    // } k4a_calibration_t;
+    //
+    /// <summary>
+    /// Blittable version of <see cref="Calibration"/>: extrinsics are stored inline in structure instead of separate array.
+    /// Can be passed to native code by pointer without any marshaling.
+    /// </summary>
+    /// <remarks>
+    /// Each call of conversion method of <see cref="Calibration"/> structure has to copy the whole structure (about 1 KB)
+    /// to blittable form. Use <see cref="BlittableCalibration"/> directly if you are going to call conversion methods
+    /// many times per frame (for instance, to project body joints).
+    /// </remarks>
+    /// <seealso cref="Calibration"/>
+    [StructLayout(LayoutKind.Sequential)]
+    public unsafe struct BlittableCalibration
+    {
+        private const int ExtrinsicsCount = (int)CalibrationGeometry.Count * (int)CalibrationGeometry.Count;
+        private const int FloatsPerExtrinsics = 12;     // 3x3 rotation + 3 translation
+
+        /// <summary>Depth camera calibration.</summary>
+        public CameraCalibration DepthCameraCalibration;
+
+        /// <summary>Color camera calibration.</summary>
+        public CameraCalibration ColorCameraCalibration;
+
+        // Inline storage for ExtrinsicsCount values of CalibrationExtrinsics type
+        private fixed float extrinsics[ExtrinsicsCount * FloatsPerExtrinsics];
+
+        /// <summary>Depth camera mode for which calibration was obtained.</summary>
+        public DepthMode DepthMode;
+
+        /// <summary>Color camera resolution for which calibration was obtained.</summary>
+        public ColorResolution ColorResolution;
+
+        /// <summary>Creates blittable copy of <paramref name="calibration"/> data.</summary>
+        /// <param name="calibration">Calibration data to be copied.</param>
+        public BlittableCalibration(in Calibration calibration)
+        {
+            this = default;
+
+            DepthCameraCalibration = calibration.DepthCameraCalibration;
+            ColorCameraCalibration = calibration.ColorCameraCalibration;
+            DepthMode = calibration.DepthMode;
+            ColorResolution = calibration.ColorResolution;
+
+            var src = calibration.Extrinsics;
+            if (src != null)
+            {
+                var count = Math.Min(src.Length, ExtrinsicsCount);
+                fixed (CalibrationExtrinsics* srcPtr = src)
+                fixed (float* dstPtr = extrinsics)
+                {
+                    var sizeBytes = count * sizeof(CalibrationExtrinsics);
+                    Buffer.MemoryCopy(srcPtr, dstPtr, sizeBytes, sizeBytes);
+                }
+            }
+        }
+
+        /// <summary>Converts to <see cref="Calibration"/> structure.</summary>
+        /// <param name="calibration">Output: calibration data with the same content.</param>
+        public void ToCalibration(out Calibration calibration)
+        {
+            calibration.DepthCameraCalibration = DepthCameraCalibration;
+            calibration.ColorCameraCalibration = ColorCameraCalibration;
+            calibration.DepthMode = DepthMode;
+            calibration.ColorResolution = ColorResolution;
+            calibration.Extrinsics = new CalibrationExtrinsics[ExtrinsicsCount];
+            fixed (float* srcPtr = extrinsics)
+            fixed (CalibrationExtrinsics* dstPtr = calibration.Extrinsics)
+            {
+                var sizeBytes = ExtrinsicsCount * sizeof(CalibrationExtrinsics);
+                Buffer.MemoryCopy(srcPtr, dstPtr, sizeBytes, sizeBytes);
+            }
+        }
+
+        #region Helper methods
+
+        /// <summary>Does this calibration data look as valid?</summary>
+        /// <remarks>
+        /// WARNING! This property performs only some basic and simple checks.
+        /// If it returns <see langword="true"/>, calibration data can still be meaningless/incorrect.
+        /// </remarks>
+        public bool IsValid
+            => (DepthMode != DepthMode.Off || ColorResolution != ColorResolution.Off)
+            && ColorCameraCalibration.ResolutionWidth == ColorResolution.WidthPixels()
+            && ColorCameraCalibration.ResolutionHeight == ColorResolution.HeightPixels()
+            && DepthCameraCalibration.ResolutionWidth == DepthMode.WidthPixels()
+            && DepthCameraCalibration.ResolutionHeight == DepthMode.HeightPixels()
+            && ColorCameraCalibration.Intrinsics.ParameterCount >= 0
+            && ColorCameraCalibration.Intrinsics.ParameterCount <= CalibrationIntrinsicParameters.ParameterCount
+            && DepthCameraCalibration.Intrinsics.ParameterCount >= 0
+            && DepthCameraCalibration.Intrinsics.ParameterCount <= CalibrationIntrinsicParameters.ParameterCount;
+
+        /// <summary>Helper method to get mutual extrinsics parameters for a given couple of sensors in Azure Kinect device.</summary>
+        /// <param name="sourceSensor">Source coordinate system for transformation.</param>
+        /// <param name="targetSensor">Destination coordinate system for transformation.</param>
+        /// <returns>Extracted parameters of transformation from <paramref name="sourceSensor"/> to <paramref name="targetSensor"/>.</returns>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="sourceSensor"/> or <paramref name="targetSensor"/> has invalid value.</exception>
+        /// <seealso cref="SetExtrinsics(CalibrationGeometry, CalibrationGeometry, CalibrationExtrinsics)"/>
+        public CalibrationExtrinsics GetExtrinsics(CalibrationGeometry sourceSensor, CalibrationGeometry targetSensor)
+        {
+            var index = GetExtrinsicsIndex(sourceSensor, targetSensor);
+            fixed (float* ptr = extrinsics)
+                return ((CalibrationExtrinsics*)ptr)[index];
+        }
+
+        /// <summary>Helper method to set mutual extrinsics parameters for a given couple of sensors in Azure Kinect device.</summary>
+        /// <param name="sourceSensor">Source coordinate system for transformation.</param>
+        /// <param name="targetSensor">Destination coordinate system for transformation.</param>
+        /// <param name="extrinsics">Parameters of source-to-destination transformation to be set.</param>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="sourceSensor"/> or <paramref name="targetSensor"/> has invalid value.</exception>
+        /// <seealso cref="GetExtrinsics(CalibrationGeometry, CalibrationGeometry)"/>
+        public void SetExtrinsics(CalibrationGeometry sourceSensor, CalibrationGeometry targetSensor, CalibrationExtrinsics extrinsics)
+        {
+            var index = GetExtrinsicsIndex(sourceSensor, targetSensor);
+            fixed (float* ptr = this.extrinsics)
+                ((CalibrationExtrinsics*)ptr)[index] = extrinsics;
+        }
+
+        private static int GetExtrinsicsIndex(CalibrationGeometry sourceSensor, CalibrationGeometry targetSensor)
+        {
+            if ((uint)sourceSensor >= (uint)CalibrationGeometry.Count)
+                throw new ArgumentOutOfRangeException(nameof(sourceSensor));
+            if ((uint)targetSensor >= (uint)CalibrationGeometry.Count)
+                throw new ArgumentOutOfRangeException(nameof(targetSensor));
+            return (int)sourceSensor * (int)CalibrationGeometry.Count + (int)targetSensor;
+        }
+
+        #endregion
+
+        #region Wrappers around native API
+
+        /// <inheritdoc cref="Calibration.Convert2DTo2D(Float2, float, CalibrationGeometry, CalibrationGeometry)"/>
+        public Float2? Convert2DTo2D(Float2 sourcePoint2D, float sourceDepthMm, CalibrationGeometry sourceCamera, CalibrationGeometry targetCamera)
+        {
+            if (!sourceCamera.IsCamera())
+                throw new ArgumentOutOfRangeException(nameof(sourceCamera));
+            if (!targetCamera.IsCamera())
+                throw new ArgumentOutOfRangeException(nameof(targetCamera));
+            var res = NativeApi.Calibration2DTo2D(in this, in sourcePoint2D, sourceDepthMm, sourceCamera, targetCamera, out var targetPoint2D, out var validFlag);
+            if (res != NativeCallResults.Result.Succeeded)
+                throw new InvalidOperationException("Cannot transform 2D point to 2D point: invalid calibration data.");
+            if (validFlag == 0)
+                return null;
+            return targetPoint2D;
+        }
+
+        /// <inheritdoc cref="Calibration.ConvertColor2DToDepth2D(Float2, Image)"/>
+        public Float2? ConvertColor2DToDepth2D(Float2 sourcePoint2D, Image depthImage)
+        {
+            if (depthImage is null)
+                throw new ArgumentNullException(nameof(depthImage));
+            if (depthImage.IsDisposed)
+                throw new ObjectDisposedException(nameof(depthImage));
+            if (depthImage.Format != ImageFormat.Depth16 || depthImage.WidthPixels != DepthMode.WidthPixels() || depthImage.HeightPixels != DepthMode.HeightPixels())
+                throw new ArgumentException($"Invalid format or size of {nameof(depthImage)}", nameof(depthImage));
+            var res = NativeApi.CalibrationColor2DToDepth2D(in this, in sourcePoint2D, Image.ToHandle(depthImage), out var targetPoint2D, out var validFlag);
+            if (res != NativeCallResults.Result.Succeeded)
+                throw new InvalidOperationException("Cannot transform color 2D point to depth 2D point: invalid calibration data.");
+            if (validFlag == 0)
+                return null;
+            return targetPoint2D;
+        }
+
+        /// <inheritdoc cref="Calibration.Convert2DTo3D(Float2, float, CalibrationGeometry, CalibrationGeometry)"/>
+        public Float3? Convert2DTo3D(Float2 sourcePoint2D, float sourceDepthMm, CalibrationGeometry sourceCamera, CalibrationGeometry targetCameraOrSensor)
+        {
+            if (!sourceCamera.IsCamera())
+                throw new ArgumentOutOfRangeException(nameof(sourceCamera));
+            if (!targetCameraOrSensor.IsCamera() && !targetCameraOrSensor.IsImuPart())
+                throw new ArgumentOutOfRangeException(nameof(targetCameraOrSensor));
+            var res = NativeApi.Calibration2DTo3D(in this, in sourcePoint2D, sourceDepthMm, sourceCamera, targetCameraOrSensor, out var targetPoint3DMm, out var validFlag);
+            if (res != NativeCallResults.Result.Succeeded)
+                throw new InvalidOperationException("Cannot transform 2D point to 3D point: invalid calibration data.");
+            if (validFlag == 0)
+                return null;
+            return targetPoint3DMm;
+        }
+
+        /// <inheritdoc cref="Calibration.Convert3DTo2D(Float3, CalibrationGeometry, CalibrationGeometry)"/>
+        public Float2? Convert3DTo2D(Float3 sourcePoint3DMm, CalibrationGeometry sourceCameraOrSensor, CalibrationGeometry targetCamera)
+        {
+            if (!sourceCameraOrSensor.IsCamera() && !sourceCameraOrSensor.IsImuPart())
+                throw new ArgumentOutOfRangeException(nameof(sourceCameraOrSensor));
+            if (!targetCamera.IsCamera())
+                throw new ArgumentOutOfRangeException(nameof(targetCamera));
+            var res = NativeApi.Calibration3DTo2D(in this, in sourcePoint3DMm, sourceCameraOrSensor, targetCamera, out var targetPoint2D, out var validFlag);
+            if (res != NativeCallResults.Result.Succeeded)
+                throw new InvalidOperationException("Cannot transform 3D point to 2D point: invalid calibration data.");
+            if (validFlag == 0)
+                return null;
+            return targetPoint2D;
+        }
+
+        /// <inheritdoc cref="Calibration.Convert3DTo3D(Float3, CalibrationGeometry, CalibrationGeometry)"/>
+        public Float3 Convert3DTo3D(Float3 sourcePoint3DMm, CalibrationGeometry sourceCameraOrSensor, CalibrationGeometry targetCameraOrSensor)
+        {
+            if (!sourceCameraOrSensor.IsCamera() && !sourceCameraOrSensor.IsImuPart())
+                throw new ArgumentOutOfRangeException(nameof(sourceCameraOrSensor));
+            if (!targetCameraOrSensor.IsCamera() && !targetCameraOrSensor.IsImuPart())
+                throw new ArgumentOutOfRangeException(nameof(targetCameraOrSensor));
+            var res = NativeApi.Calibration3DTo3D(in this, in sourcePoint3DMm, sourceCameraOrSensor, targetCameraOrSensor, out var targetPoint3DMm);
+            if (res != NativeCallResults.Result.Succeeded)
+                throw new InvalidOperationException("Cannot transform 3D point to 3D point: invalid calibration data.");
+            return targetPoint3DMm;
+        }
+
+        #endregion
+    }
+}
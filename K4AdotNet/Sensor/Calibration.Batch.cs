@@ -0,0 +1,402 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using K4AdotNet.BodyTracking;
+using System;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Sensor
+{
+    // Batch conversion methods implemented in managed code (see CameraModel)
+    partial struct Calibration
+    {
+        #region Batch conversions
+
+        /// <summary>Creates managed model of intrinsic parameters of a given camera.</summary>
+        /// <param name="camera">Depth or color camera.</param>
+        /// <returns>Model of <paramref name="camera"/>. Not <see langword="null"/>.</returns>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="camera"/> is not a camera.</exception>
+        /// <exception cref="InvalidOperationException">Calibration data of <paramref name="camera"/> is invalid or uses unsupported lens distortion model.</exception>
+        public CameraModel GetCameraModel(CalibrationGeometry camera)
+        {
+            if (!camera.IsCamera())
+                throw new ArgumentOutOfRangeException(nameof(camera));
+            var cameraCalibration = GetCameraCalibration(camera);
+            if (!CameraModel.IsSupportedModel(cameraCalibration.Intrinsics.Model))
+                throw new InvalidOperationException($"Invalid calibration data of {camera} camera: unsupported lens distortion model {cameraCalibration.Intrinsics.Model}.");
+            return new(in cameraCalibration);
+        }
+
+        /// <summary>Returns cached table of unprojection rays for all pixels of a given camera.</summary>
+        /// <param name="camera">Depth or color camera.</param>
+        /// <returns>Table of rays of <paramref name="camera"/>. Not <see langword="null"/>.</returns>
+        /// <remarks>
+        /// Table is computed on the first call and then shared between all consumers of the same calibration data.
+        /// Cached tables are retained after they are no longer used, up to <see cref="CameraRayTable.CacheCapacityBytes"/> in total;
+        /// <see cref="CameraRayTable.ClearCache"/> releases them.
+        /// See <see cref="CameraRayTable"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="camera"/> is not a camera.</exception>
+        /// <exception cref="InvalidOperationException">
+        /// Calibration data of <paramref name="camera"/> is invalid or uses unsupported lens distortion model,
+        /// or <paramref name="camera"/> is not active in the mode of calibration.
+        /// </exception>
+        public CameraRayTable GetRayTable(CalibrationGeometry camera)
+        {
+            if (!camera.IsCamera())
+                throw new ArgumentOutOfRangeException(nameof(camera));
+            var cameraCalibration = GetCameraCalibration(camera);
+            if (!CameraModel.IsSupportedModel(cameraCalibration.Intrinsics.Model))
+                throw new InvalidOperationException($"Invalid calibration data of {camera} camera: unsupported lens distortion model {cameraCalibration.Intrinsics.Model}.");
+            if (cameraCalibration.ResolutionWidth <= 0 || cameraCalibration.ResolutionHeight <= 0)
+                throw new InvalidOperationException($"{camera} camera is not active in the mode of calibration.");
+            return CameraRayTable.GetOrCreate(in cameraCalibration);
+        }
+
+        /// <summary>
+        /// Returns cached map from images of a given camera to images of ideal pinhole camera
+        /// with the same focal lengths, principal point and resolution but without lens distortion.
+        /// </summary>
+        /// <param name="camera">Depth or color camera.</param>
+        /// <returns>Undistortion map of <paramref name="camera"/>. Not <see langword="null"/>.</returns>
+        /// <remarks>See <see cref="GetUndistortionMap(CalibrationGeometry, in PinholeIntrinsics)"/> for details.</remarks>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="camera"/> is not a camera.</exception>
+        /// <exception cref="InvalidOperationException">
+        /// Calibration data of <paramref name="camera"/> is invalid or uses unsupported lens distortion model,
+        /// or <paramref name="camera"/> is not active in the mode of calibration.
+        /// </exception>
+        public UndistortionMap GetUndistortionMap(CalibrationGeometry camera)
+        {
+            if (!camera.IsCamera())
+                throw new ArgumentOutOfRangeException(nameof(camera));
+            return GetUndistortionMap(camera, PinholeIntrinsics.FromCameraCalibration(GetCameraCalibration(camera)));
+        }
+
+        /// <summary>Returns cached map from images of a given camera to images of ideal pinhole camera with given intrinsics.</summary>
+        /// <param name="camera">Depth or color camera.</param>
+        /// <param name="target">Intrinsics of target pinhole camera.</param>
+        /// <returns>Undistortion map of <paramref name="camera"/>. Not <see langword="null"/>.</returns>
+        /// <remarks>
+        /// Map is computed on the first call and then shared between all consumers of the same calibration data and target intrinsics.
+        /// Cached maps are retained after they are no longer used, up to <see cref="UndistortionMap.CacheCapacityBytes"/> in total;
+        /// <see cref="UndistortionMap.ClearCache"/> releases them.
+        /// Use <see cref="UndistortionMap.Remap(Image, Image)"/> to undistort depth maps, infrared and color images.
+        /// See <see cref="UndistortionMap"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="camera"/> is not a camera.</exception>
+        /// <exception cref="ArgumentException"><paramref name="target"/> is invalid.</exception>
+        /// <exception cref="InvalidOperationException">
+        /// Calibration data of <paramref name="camera"/> is invalid or uses unsupported lens distortion model,
+        /// or <paramref name="camera"/> is not active in the mode of calibration.
+        /// </exception>
+        public UndistortionMap GetUndistortionMap(CalibrationGeometry camera, in PinholeIntrinsics target)
+        {
+            if (!camera.IsCamera())
+                throw new ArgumentOutOfRangeException(nameof(camera));
+            var cameraCalibration = GetCameraCalibration(camera);
+            if (!CameraModel.IsSupportedModel(cameraCalibration.Intrinsics.Model))
+                throw new InvalidOperationException($"Invalid calibration data of {camera} camera: unsupported lens distortion model {cameraCalibration.Intrinsics.Model}.");
+            if (cameraCalibration.ResolutionWidth <= 0 || cameraCalibration.ResolutionHeight <= 0)
+                throw new InvalidOperationException($"{camera} camera is not active in the mode of calibration.");
+            return UndistortionMap.GetOrCreate(in cameraCalibration, in target);
+        }
+
+        /// <summary>Helper method to create <see cref="ManagedTransformation"/> object from this calibration data. For details see <see cref="ManagedTransformation(in Calibration)"/>.</summary>
+        /// <returns>Created transformation object. Not <see langword="null"/>.</returns>
+        /// <seealso cref="ManagedTransformation(in Calibration)"/>.
+        public ManagedTransformation CreateManagedTransformation()
+            => new(in this);
+
+        /// <summary>Converts depth image to point cloud in managed code.</summary>
+        /// <param name="depthImage">Input depth image. Not <see langword="null"/>. Must have resolution of <paramref name="camera"/> camera.</param>
+        /// <param name="camera">Geometry in which depth map was computed (<see cref="CalibrationGeometry.Depth"/> or <see cref="CalibrationGeometry.Color"/>).</param>
+        /// <param name="points">
+        /// Output: 3D points in the coordinate system of <paramref name="camera"/>, row by row.
+        /// Cannot be shorter than number of pixels in <paramref name="depthImage"/>.
+        /// </param>
+        /// <param name="inMeters"><see langword="true"/> to output coordinates in meters, <see langword="false"/> to output coordinates in millimeters.</param>
+        /// <param name="validPointsOnly">
+        /// <see langword="true"/> to write only valid points one after another (compact point cloud),
+        /// <see langword="false"/> to write point for each pixel with zeros for invalid pixels.
+        /// </param>
+        /// <returns>Number of valid points.</returns>
+        /// <remarks>
+        /// Managed alternative of <see cref="Transformation.DepthImageToPointCloud(Image, CalibrationGeometry, Image)"/>
+        /// that does not depend on depth engine. Uses cached ray table of <paramref name="camera"/> (see <see cref="GetRayTable(CalibrationGeometry)"/>).
+        /// See <see cref="CameraRayTable.DepthToPointCloud(ReadOnlyImageView{short}, Span{Float3}, bool, bool)"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="camera"/> is not a camera.</exception>
+        /// <exception cref="ArgumentNullException"><paramref name="depthImage"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="depthImage"/> has invalid format or resolution or <paramref name="points"/> has invalid length.
+        /// </exception>
+        /// <exception cref="InvalidOperationException">Calibration data of <paramref name="camera"/> is invalid.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="depthImage"/> is disposed.</exception>
+        public int DepthImageToPointCloud(Image depthImage, CalibrationGeometry camera, Span<Float3> points, bool inMeters = false, bool validPointsOnly = false)
+        {
+            if (depthImage is null)
+                throw new ArgumentNullException(nameof(depthImage));
+            if (depthImage.Format != ImageFormat.Depth16)
+                throw new ArgumentException($"{nameof(depthImage)} must have {ImageFormat.Depth16} format but has {depthImage.Format}.", nameof(depthImage));
+            var rayTable = GetRayTable(camera);
+            return rayTable.DepthToPointCloud(depthImage.GetReadOnlyView<short>(), points, inMeters, validPointsOnly);
+        }
+
+        /// <summary>Converts depth image to point cloud in managed code.</summary>
+        /// <param name="depthImage">Input depth image. Not <see langword="null"/>. Must have resolution of <paramref name="camera"/> camera.</param>
+        /// <param name="camera">Geometry in which depth map was computed (<see cref="CalibrationGeometry.Depth"/> or <see cref="CalibrationGeometry.Color"/>).</param>
+        /// <param name="points">
+        /// Output: 3D points in the coordinate system of <paramref name="camera"/>, row by row.
+        /// Cannot be shorter than number of pixels in <paramref name="depthImage"/>.
+        /// </param>
+        /// <param name="inMeters"><see langword="true"/> to output coordinates in meters, <see langword="false"/> to output coordinates in millimeters.</param>
+        /// <param name="validPointsOnly">
+        /// <see langword="true"/> to write only valid points one after another (compact point cloud),
+        /// <see langword="false"/> to write point for each pixel with zeros for invalid pixels.
+        /// </param>
+        /// <returns>Number of valid points.</returns>
+        /// <remarks>See <see cref="DepthImageToPointCloud(Image, CalibrationGeometry, Span{Float3}, bool, bool)"/> for details.</remarks>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="camera"/> is not a camera.</exception>
+        /// <exception cref="ArgumentNullException"><paramref name="depthImage"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="depthImage"/> has invalid format or resolution or <paramref name="points"/> has invalid length.
+        /// </exception>
+        /// <exception cref="InvalidOperationException">Calibration data of <paramref name="camera"/> is invalid.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="depthImage"/> is disposed.</exception>
+        public int DepthImageToPointCloud(Image depthImage, CalibrationGeometry camera, Span<Vector3> points, bool inMeters = false, bool validPointsOnly = false)
+            => DepthImageToPointCloud(depthImage, camera, MemoryMarshal.Cast<Vector3, Float3>(points), inMeters, validPointsOnly);
+
+        /// <summary>
+        /// Transforms 2D pixel coordinates with associated depth values of the source camera
+        /// into 3D points of the target coordinate system. Batch version of <see cref="Convert2DTo3D(Float2, float, CalibrationGeometry, CalibrationGeometry)"/>.
+        /// </summary>
+        /// <param name="sourcePoints2D">The 2D pixels in <paramref name="sourceCamera"/> coordinates.</param>
+        /// <param name="sourceDepthsMm">The depths of <paramref name="sourcePoints2D"/> in millimeters. Must have the same length as <paramref name="sourcePoints2D"/>.</param>
+        /// <param name="sourceCamera">The current camera.</param>
+        /// <param name="targetCameraOrSensor">The target camera or IMU sensor.</param>
+        /// <param name="targetPoints3DMm">
+        /// Output: 3D coordinates of the input pixels in the coordinate system of <paramref name="targetCameraOrSensor"/> in millimeters.
+        /// Invalid points are set to <see cref="Float3.Zero"/>. Cannot be shorter than <paramref name="sourcePoints2D"/>.
+        /// </param>
+        /// <param name="validFlags">
+        /// Output: validity mask. <see langword="false"/> for points that are outside of the range of valid calibration and for zero depths.
+        /// Cannot be shorter than <paramref name="sourcePoints2D"/>.
+        /// </param>
+        /// <returns>Number of valid points.</returns>
+        /// <remarks>
+        /// Unlike <see cref="Convert2DTo3D(Float2, float, CalibrationGeometry, CalibrationGeometry)"/>, this method does not call Sensor SDK.
+        /// Points are unprojected by managed <see cref="CameraModel"/> and then transformed by extrinsics,
+        /// results are equal to the native ones up to floating-point rounding.
+        /// </remarks>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="sourceCamera"/> is not a camera or <paramref name="targetCameraOrSensor"/> is neither camera nor IMU sensor.
+        /// </exception>
+        /// <exception cref="ArgumentException">
+        /// Invalid length of <paramref name="sourceDepthsMm"/>, <paramref name="targetPoints3DMm"/> or <paramref name="validFlags"/>.
+        /// </exception>
+        /// <exception cref="InvalidOperationException">
+        /// Cannot perform transformation. Most likely, calibration data is invalid.
+        /// </exception>
+        /// <seealso cref="CameraModel.Unproject(ReadOnlySpan{Float2}, ReadOnlySpan{float}, Span{Float3}, Span{bool})"/>
+        public int Convert2DTo3D(ReadOnlySpan<Float2> sourcePoints2D, ReadOnlySpan<float> sourceDepthsMm,
+            CalibrationGeometry sourceCamera, CalibrationGeometry targetCameraOrSensor,
+            Span<Float3> targetPoints3DMm, Span<bool> validFlags)
+        {
+            if (!sourceCamera.IsCamera())
+                throw new ArgumentOutOfRangeException(nameof(sourceCamera));
+            if (!targetCameraOrSensor.IsCamera() && !targetCameraOrSensor.IsImuPart())
+                throw new ArgumentOutOfRangeException(nameof(targetCameraOrSensor));
+            if (!IsValid)
+                throw new InvalidOperationException("Cannot transform 2D points to 3D points: invalid calibration data.");
+
+            var validCount = GetCameraModel(sourceCamera).Unproject(sourcePoints2D, sourceDepthsMm, targetPoints3DMm, validFlags);
+
+            if (sourceCamera != targetCameraOrSensor)
+            {
+                var extrinsics = GetExtrinsics(sourceCamera, targetCameraOrSensor);
+                for (var i = 0; i < sourcePoints2D.Length; i++)
+                {
+                    if (validFlags[i])
+                        targetPoints3DMm[i] = extrinsics.Transform(targetPoints3DMm[i]);
+                }
+            }
+
+            return validCount;
+        }
+
+        /// <summary>
+        /// Transforms 3D points of a source coordinate system into 2D pixel coordinates of the target camera.
+        /// Batch version of <see cref="Convert3DTo2D(Float3, CalibrationGeometry, CalibrationGeometry)"/>.
+        /// </summary>
+        /// <param name="sourcePoints3DMm">The 3D coordinates in millimeters representing points in <paramref name="sourceCameraOrSensor"/>.</param>
+        /// <param name="sourceCameraOrSensor">The current camera or IMU sensor.</param>
+        /// <param name="targetCamera">The target camera.</param>
+        /// <param name="targetPoints2D">
+        /// Output: the 2D pixels in <paramref name="targetCamera"/> coordinates. Invalid points are set to zeros.
+        /// Cannot be shorter than <paramref name="sourcePoints3DMm"/>.
+        /// </param>
+        /// <param name="validFlags">
+        /// Output: validity mask. <see langword="false"/> for points that are behind the camera or outside of the range of valid calibration.
+        /// Cannot be shorter than <paramref name="sourcePoints3DMm"/>.
+        /// </param>
+        /// <returns>Number of valid points.</returns>
+        /// <remarks>
+        /// Unlike <see cref="Convert3DTo2D(Float3, CalibrationGeometry, CalibrationGeometry)"/>, this method does not call Sensor SDK.
+        /// Extrinsics are extracted once per call, then points are transformed and projected by managed <see cref="CameraModel"/>.
+        /// Results are equal to the native ones up to floating-point rounding.
+        /// </remarks>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="sourceCameraOrSensor"/> is neither camera nor IMU sensor or <paramref name="targetCamera"/> is not a camera.
+        /// </exception>
+        /// <exception cref="ArgumentException">Invalid length of <paramref name="targetPoints2D"/> or <paramref name="validFlags"/>.</exception>
+        /// <exception cref="InvalidOperationException">
+        /// Cannot perform transformation. Most likely, calibration data is invalid.
+        /// </exception>
+        /// <seealso cref="CameraModel.Project(ReadOnlySpan{Float3}, Span{Float2}, Span{bool})"/>
+        public int Convert3DTo2D(ReadOnlySpan<Float3> sourcePoints3DMm, CalibrationGeometry sourceCameraOrSensor, CalibrationGeometry targetCamera,
+            Span<Float2> targetPoints2D, Span<bool> validFlags)
+        {
+            if (!sourceCameraOrSensor.IsCamera() && !sourceCameraOrSensor.IsImuPart())
+                throw new ArgumentOutOfRangeException(nameof(sourceCameraOrSensor));
+            if (!targetCamera.IsCamera())
+                throw new ArgumentOutOfRangeException(nameof(targetCamera));
+            if (!IsValid)
+                throw new InvalidOperationException("Cannot transform 3D points to 2D points: invalid calibration data.");
+
+            CalibrationExtrinsics? extrinsics = sourceCameraOrSensor != targetCamera
+                ? GetExtrinsics(sourceCameraOrSensor, targetCamera)
+                : null;
+            return GetCameraModel(targetCamera).Project(sourcePoints3DMm, extrinsics, targetPoints2D, validFlags);
+        }
+
+        /// <summary>
+        /// Transforms 3D points of a source coordinate system into 3D points of the target coordinate system.
+        /// Batch version of <see cref="Convert3DTo3D(Float3, CalibrationGeometry, CalibrationGeometry)"/>.
+        /// </summary>
+        /// <param name="sourcePoints3DMm">The 3D coordinates in millimeters representing points in <paramref name="sourceCameraOrSensor"/>.</param>
+        /// <param name="sourceCameraOrSensor">The current coordinate system of camera or IMU sensor.</param>
+        /// <param name="targetCameraOrSensor">The target coordinate system of camera or IMU sensor.</param>
+        /// <param name="targetPoints3DMm">
+        /// Output: the new 3D coordinates of the input points in the coordinate space <paramref name="targetCameraOrSensor"/> in millimeters.
+        /// Cannot be shorter than <paramref name="sourcePoints3DMm"/>. Can be the same memory as <paramref name="sourcePoints3DMm"/> (in-place transformation).
+        /// </param>
+        /// <remarks>
+        /// Unlike <see cref="Convert3DTo3D(Float3, CalibrationGeometry, CalibrationGeometry)"/>, this method does not call Sensor SDK.
+        /// Extrinsics are extracted once per call.
+        /// </remarks>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="sourceCameraOrSensor"/> or <paramref name="targetCameraOrSensor"/> is neither camera nor IMU sensor.
+        /// </exception>
+        /// <exception cref="ArgumentException">Invalid length of <paramref name="targetPoints3DMm"/>.</exception>
+        /// <exception cref="InvalidOperationException">
+        /// Cannot perform transformation. Most likely, calibration data is invalid.
+        /// </exception>
+        public void Convert3DTo3D(ReadOnlySpan<Float3> sourcePoints3DMm, CalibrationGeometry sourceCameraOrSensor, CalibrationGeometry targetCameraOrSensor,
+            Span<Float3> targetPoints3DMm)
+        {
+            if (!sourceCameraOrSensor.IsCamera() && !sourceCameraOrSensor.IsImuPart())
+                throw new ArgumentOutOfRangeException(nameof(sourceCameraOrSensor));
+            if (!targetCameraOrSensor.IsCamera() && !targetCameraOrSensor.IsImuPart())
+                throw new ArgumentOutOfRangeException(nameof(targetCameraOrSensor));
+            if (targetPoints3DMm.Length < sourcePoints3DMm.Length)
+                throw new ArgumentException($"{nameof(targetPoints3DMm)} cannot be shorter than {nameof(sourcePoints3DMm)}.", nameof(targetPoints3DMm));
+            if (!IsValid)
+                throw new InvalidOperationException("Cannot transform 3D points to 3D points: invalid calibration data.");
+
+            if (sourceCameraOrSensor == targetCameraOrSensor)
+            {
+                sourcePoints3DMm.CopyTo(targetPoints3DMm);
+                return;
+            }
+
+            var extrinsics = GetExtrinsics(sourceCameraOrSensor, targetCameraOrSensor);
+            for (var i = 0; i < sourcePoints3DMm.Length; i++)
+                targetPoints3DMm[i] = extrinsics.Transform(sourcePoints3DMm[i]);
+        }
+
+        /// <summary>Projects all joints of a skeleton into 2D pixel coordinates of a given camera.</summary>
+        /// <param name="skeleton">Skeleton from body tracker. Positions of joints are in depth camera coordinate system.</param>
+        /// <param name="targetCamera">The target camera.</param>
+        /// <param name="jointPoints2D">
+        /// Output: 2D pixel coordinates of joints in order of <see cref="JointType"/>.
+        /// Must have at least <see cref="JointTypes.All"/>.Count elements.
+        /// </param>
+        /// <param name="validFlags">Output: validity mask for <paramref name="jointPoints2D"/>. Must have at least <see cref="JointTypes.All"/>.Count elements.</param>
+        /// <returns>Number of successfully projected joints.</returns>
+        /// <remarks>
+        /// Result is the same as result of <see cref="Convert3DTo2D(Float3, CalibrationGeometry, CalibrationGeometry)"/> for
+        /// <see cref="Joint.PositionMm"/> of each joint with <see cref="CalibrationGeometry.Depth"/> as source, but it is computed in managed code at once.
+        /// </remarks>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="targetCamera"/> is not a camera.</exception>
+        /// <exception cref="ArgumentException">Invalid length of <paramref name="jointPoints2D"/> or <paramref name="validFlags"/>.</exception>
+        /// <exception cref="InvalidOperationException">Cannot perform transformation. Most likely, calibration data is invalid.</exception>
+        public int Convert3DTo2D(in Skeleton skeleton, CalibrationGeometry targetCamera, Span<Float2> jointPoints2D, Span<bool> validFlags)
+        {
+            Span<Float3> positions = stackalloc Float3[JointCount];
+            GetJointPositions(in skeleton, positions);
+            return Convert3DTo2D(positions, CalibrationGeometry.Depth, targetCamera, jointPoints2D, validFlags);
+        }
+
+        /// <summary>Projects all joints of all bodies from body frame into 2D pixel coordinates of a given camera.</summary>
+        /// <param name="bodyFrame">Body frame from body tracker. Not <see langword="null"/>.</param>
+        /// <param name="targetCamera">The target camera.</param>
+        /// <param name="jointPoints2D">
+        /// Output: 2D pixel coordinates of joints. Joints of body with index <c>i</c> are placed starting from
+        /// index <c>i * JointTypes.All.Count</c> in order of <see cref="JointType"/>.
+        /// Must have at least <see cref="BodyFrame.BodyCount"/> * <see cref="JointTypes.All"/>.Count elements.
+        /// </param>
+        /// <param name="validFlags">
+        /// Output: validity mask for <paramref name="jointPoints2D"/>.
+        /// Cannot be shorter than <see cref="BodyFrame.BodyCount"/> * <see cref="JointTypes.All"/>.Count elements.
+        /// </param>
+        /// <returns>Number of bodies, that is <see cref="BodyFrame.BodyCount"/>.</returns>
+        /// <exception cref="ArgumentNullException"><paramref name="bodyFrame"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="bodyFrame"/> is disposed.</exception>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="targetCamera"/> is not a camera.</exception>
+        /// <exception cref="ArgumentException">Invalid length of <paramref name="jointPoints2D"/> or <paramref name="validFlags"/>.</exception>
+        /// <exception cref="InvalidOperationException">Cannot perform transformation. Most likely, calibration data is invalid.</exception>
+        /// <seealso cref="Convert3DTo2D(in Skeleton, CalibrationGeometry, Span{Float2}, Span{bool})"/>
+        public int Convert3DTo2D(BodyFrame bodyFrame, CalibrationGeometry targetCamera, Span<Float2> jointPoints2D, Span<bool> validFlags)
+        {
+            if (bodyFrame is null)
+                throw new ArgumentNullException(nameof(bodyFrame));
+            if (bodyFrame.IsDisposed)
+                throw new ObjectDisposedException(nameof(bodyFrame));
+
+            var bodyCount = bodyFrame.BodyCount;
+            var pointCount = bodyCount * JointCount;
+            if (jointPoints2D.Length < pointCount)
+                throw new ArgumentException($"{nameof(jointPoints2D)} is too short for {bodyCount} bodies.", nameof(jointPoints2D));
+            if (validFlags.Length < pointCount)
+                throw new ArgumentException($"{nameof(validFlags)} is too short for {bodyCount} bodies.", nameof(validFlags));
+
+            var positions = pointCount <= 256 ? stackalloc Float3[pointCount] : new Float3[pointCount];
+            for (var i = 0; i < bodyCount; i++)
+            {
+                bodyFrame.GetBodySkeleton(i, out var skeleton);
+                GetJointPositions(in skeleton, positions.Slice(i * JointCount, JointCount));
+            }
+
+            Convert3DTo2D(positions, CalibrationGeometry.Depth, targetCamera, jointPoints2D, validFlags);
+            return bodyCount;
+        }
+
+        #endregion
+
+        private static int JointCount => JointTypes.All.Count;
+
+        private static void GetJointPositions(in Skeleton skeleton, Span<Float3> positions)
+        {
+            // Skeleton is a sequence of joints
+            var joints = MemoryMarshal.CreateReadOnlySpan(ref Unsafe.As<Skeleton, Joint>(ref Unsafe.AsRef(in skeleton)), JointCount);
+            for (var i = 0; i < joints.Length; i++)
+                positions[i] = joints[i].PositionMm;
+        }
+
+        private readonly CameraCalibration GetCameraCalibration(CalibrationGeometry camera)
+            => camera == CalibrationGeometry.Depth ? DepthCameraCalibration : ColorCameraCalibration;
+    }
+}
+
+#endif
@@ -14,7 +14,12 @@ namespace K4AdotNet.Sensor
     // } k4a_calibration_t;
     //
     /// <summary>Information about device calibration in particular depth mode and color resolution.</summary>
+    /// <remarks>
+    /// This structure is not blittable because of <see cref="Extrinsics"/> array.
+    /// For intensive usage of conversion methods, consider <see cref="BlittableCalibration"/>.
+    /// </remarks>
     /// <seealso cref="Transformation"/>
+    /// <seealso cref="BlittableCalibration"/>
     [StructLayout(LayoutKind.Sequential)]
     public partial struct Calibration
     {
@@ -226,7 +231,8 @@ namespace K4AdotNet.Sensor
                 throw new ArgumentOutOfRangeException(nameof(sourceCamera));
             if (!targetCamera.IsCamera())
                 throw new ArgumentOutOfRangeException(nameof(targetCamera));
-            var res = NativeApi.Calibration2DTo2D(in this, in sourcePoint2D, sourceDepthMm, sourceCamera, targetCamera, out var targetPoint2D, out var validFlag);
+            var blittable = new BlittableCalibration(in this);
+            var res = NativeApi.Calibration2DTo2D(in blittable, in sourcePoint2D, sourceDepthMm, sourceCamera, targetCamera, out var targetPoint2D, out var validFlag);
             if (res != NativeCallResults.Result.Succeeded)
                 throw new InvalidOperationException("Cannot transform 2D point to 2D point: invalid calibration data.");
             if (validFlag == 0)
@@ -265,7 +271,8 @@ namespace K4AdotNet.Sensor
                 throw new ObjectDisposedException(nameof(depthImage));
             if (depthImage.Format != ImageFormat.Depth16 || depthImage.WidthPixels != DepthMode.WidthPixels() || depthImage.HeightPixels != DepthMode.HeightPixels())
                 throw new ArgumentException($"Invalid format or size of {nameof(depthImage)}", nameof(depthImage));
-            var res = NativeApi.CalibrationColor2DToDepth2D(in this, in sourcePoint2D, Image.ToHandle(depthImage), out var targetPoint2D, out var validFlag);
+            var blittable = new BlittableCalibration(in this);
+            var res = NativeApi.CalibrationColor2DToDepth2D(in blittable, in sourcePoint2D, Image.ToHandle(depthImage), out var targetPoint2D, out var validFlag);
             if (res != NativeCallResults.Result.Succeeded)
                 throw new InvalidOperationException("Cannot transform color 2D point to depth 2D point: invalid calibration data.");
             if (validFlag == 0)
@@ -305,7 +312,8 @@ namespace K4AdotNet.Sensor
                 throw new ArgumentOutOfRangeException(nameof(sourceCamera));
             if (!targetCameraOrSensor.IsCamera() && !targetCameraOrSensor.IsImuPart())
                 throw new ArgumentOutOfRangeException(nameof(targetCameraOrSensor));
-            var res = NativeApi.Calibration2DTo3D(in this, in sourcePoint2D, sourceDepthMm, sourceCamera, targetCameraOrSensor, out var targetPoint3DMm, out var validFlag);
+            var blittable = new BlittableCalibration(in this);
+            var res = NativeApi.Calibration2DTo3D(in blittable, in sourcePoint2D, sourceDepthMm, sourceCamera, targetCameraOrSensor, out var targetPoint3DMm, out var validFlag);
             if (res != NativeCallResults.Result.Succeeded)
                 throw new InvalidOperationException("Cannot transform 2D point to 3D point: invalid calibration data.");
             if (validFlag == 0)
@@ -340,7 +348,8 @@ namespace K4AdotNet.Sensor
                 throw new ArgumentOutOfRangeException(nameof(sourceCameraOrSensor));
             if (!targetCamera.IsCamera())
                 throw new ArgumentOutOfRangeException(nameof(targetCamera));
-            var res = NativeApi.Calibration3DTo2D(in this, in sourcePoint3DMm, sourceCameraOrSensor, targetCamera, out var targetPoint2D, out var validFlag);
+            var blittable = new BlittableCalibration(in this);
+            var res = NativeApi.Calibration3DTo2D(in blittable, in sourcePoint3DMm, sourceCameraOrSensor, targetCamera, out var targetPoint2D, out var validFlag);
             if (res != NativeCallResults.Result.Succeeded)
                 throw new InvalidOperationException("Cannot transform 3D point to 2D point: invalid calibration data.");
             if (validFlag == 0)
@@ -368,7 +377,8 @@ namespace K4AdotNet.Sensor
                 throw new ArgumentOutOfRangeException(nameof(sourceCameraOrSensor));
             if (!targetCameraOrSensor.IsCamera() && !targetCameraOrSensor.IsImuPart())
                 throw new ArgumentOutOfRangeException(nameof(targetCameraOrSensor));
-            var res = NativeApi.Calibration3DTo3D(in this, in sourcePoint3DMm, sourceCameraOrSensor, targetCameraOrSensor, out var targetPoint3DMm);
+            var blittable = new BlittableCalibration(in this);
+            var res = NativeApi.Calibration3DTo3D(in blittable, in sourcePoint3DMm, sourceCameraOrSensor, targetCameraOrSensor, out var targetPoint3DMm);
             if (res != NativeCallResults.Result.Succeeded)
                 throw new InvalidOperationException("Cannot transform 3D point to 3D point: invalid calibration data.");
             return targetPoint3DMm;
@@ -380,6 +390,12 @@ namespace K4AdotNet.Sensor
         public Transformation CreateTransformation()
             => new(in this);
 
+        /// <summary>Creates blittable copy of this calibration data.</summary>
+        /// <returns>Blittable calibration data that can be passed to native code without marshaling.</returns>
+        /// <seealso cref="BlittableCalibration.ToCalibration(out Calibration)"/>
+        public BlittableCalibration ToBlittable()
+            => new(in this);
+
         #endregion
     }
 }
@@ -0,0 +1,141 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Sensor
+{
+    // Cache of heavy data computed from calibration (ray tables, undistortion maps), shared by all consumers of the same calibration.
+    // Keys are compared bitwise, thus they must be structures without padding.
+    // Value is computed outside of lock, concurrent requests of the same key wait for this single computation.
+    // Values are held strongly while their total size fits into capacity, the least recently used ones are evicted first.
+    // The most recently computed value is kept even if it alone exceeds capacity.
+    internal sealed class CalibrationDataCache<TKey, TValue>
+        where TKey : unmanaged
+        where TValue : class
+    {
+        private readonly Dictionary<TKey, Entry> entries = new(BitwiseComparer.Instance);
+        private readonly long capacityBytes;
+        private readonly Func<TValue, long> getSizeBytes;
+        private long totalBytes;            // of computed values in cache
+        private long lastUseStamp;
+
+        public CalibrationDataCache(long capacityBytes, Func<TValue, long> getSizeBytes)
+        {
+            this.capacityBytes = capacityBytes;
+            this.getSizeBytes = getSizeBytes;
+        }
+
+        public TValue GetOrAdd<TState>(in TKey key, TState state, Func<TState, TValue> factory)
+        {
+            Entry entry;
+            lock (entries)
+            {
+                if (!entries.TryGetValue(key, out entry!))
+                {
+                    entry = new(new(() => factory(state)));
+                    entries.Add(key, entry);
+                }
+
+                entry.LastUse = ++lastUseStamp;
+            }
+
+            TValue value;
+            try
+            {
+                value = entry.Value.Value;
+            }
+            catch
+            {
+                // Failures are not cached
+                lock (entries)
+                {
+                    if (entries.TryGetValue(key, out var current) && current == entry)
+                        entries.Remove(key);
+                }
+                throw;
+            }
+
+            if (entry.SizeBytes == 0)
+            {
+                lock (entries)
+                {
+                    // Entry can be already removed by Clear()
+                    if (entry.SizeBytes == 0 && entries.TryGetValue(key, out var current) && current == entry)
+                    {
+                        entry.SizeBytes = Math.Max(1, getSizeBytes(value));
+                        totalBytes += entry.SizeBytes;
+                        RemoveLeastRecentlyUsed(except: entry);
+                    }
+                }
+            }
+
+            return value;
+        }
+
+        public void Clear()
+        {
+            lock (entries)
+            {
+                entries.Clear();
+                totalBytes = 0;
+            }
+        }
+
+        private void RemoveLeastRecentlyUsed(Entry except)
+        {
+            while (totalBytes > capacityBytes)
+            {
+                var oldestKey = default(TKey);
+                Entry? oldestEntry = null;
+                foreach (var item in entries)
+                {
+                    if (item.Value != except && item.Value.SizeBytes > 0 && (oldestEntry is null || item.Value.LastUse < oldestEntry.LastUse))
+                    {
+                        oldestKey = item.Key;
+                        oldestEntry = item.Value;
+                    }
+                }
+
+                if (oldestEntry is null)
+                    return;
+                entries.Remove(oldestKey);
+                totalBytes -= oldestEntry.SizeBytes;
+            }
+        }
+
+        private sealed class Entry
+        {
+            public Entry(Lazy<TValue> value)
+                => Value = value;
+
+            public Lazy<TValue> Value { get; }
+
+            public long LastUse { get; set; }
+
+            // Zero until value is computed and accounted
+            public long SizeBytes { get; set; }
+        }
+
+        private sealed class BitwiseComparer : IEqualityComparer<TKey>
+        {
+            public static readonly BitwiseComparer Instance = new();
+
+            public bool Equals(TKey x, TKey y)
+                => AsBytes(ref x).SequenceEqual(AsBytes(ref y));
+
+            public int GetHashCode(TKey key)
+            {
+                var hashCode = new HashCode();
+                hashCode.AddBytes(AsBytes(ref key));
+                return hashCode.ToHashCode();
+            }
+
+            private static ReadOnlySpan<byte> AsBytes(ref TKey key)
+                => MemoryMarshal.AsBytes(MemoryMarshal.CreateReadOnlySpan(ref key, 1));
+        }
+    }
+}
+
+#endif
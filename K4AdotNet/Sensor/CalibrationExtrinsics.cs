@@ -18,5 +18,12 @@ namespace K4AdotNet.Sensor
 
         /// <summary>Translation vector (in millimeters).</summary>
         public Float3 Translation;
+
+        // Rotation plus translation. The same as transformation_3d_to_3d() in Sensor SDK.
+        internal readonly Float3 Transform(Float3 point)
+            => new(
+                Rotation.M11 * point.X + Rotation.M12 * point.Y + Rotation.M13 * point.Z + Translation.X,
+                Rotation.M21 * point.X + Rotation.M22 * point.Y + Rotation.M23 * point.Z + Translation.Y,
+                Rotation.M31 * point.X + Rotation.M32 * point.Y + Rotation.M33 * point.Z + Translation.Z);
     }
 }
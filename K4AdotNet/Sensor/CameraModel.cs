@@ -0,0 +1,612 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>
+    /// Managed implementation of intrinsic camera model used by Sensor SDK:
+    /// <see cref="CalibrationModel.BrownConrady"/> and (deprecated) <c>Rational6KT</c> lens distortion models.
+    /// </summary>
+    /// <remarks><para>
+    /// Native conversion methods of <see cref="Calibration"/> perform one native call per point.
+    /// This class does the same math as Sensor SDK (<c>intrinsic_transformations.c</c>) in managed code
+    /// and processes batches of points without native calls. Results are equal to the native ones up to floating-point rounding.
+    /// </para><para>
+    /// Unprojection (2D pixel to 3D ray) inverts the distortion iteratively by Gauss-Newton method starting from
+    /// approximate analytical inverse of distortion, exactly as Sensor SDK does.
+    /// Projection (3D point to 2D pixel) applies distortion directly.
+    /// Batch methods process eight points at once using AVX instructions if they are supported by CPU.
+    /// </para><para>
+    /// Instances are immutable and thread safe.
+    /// </para></remarks>
+    /// <seealso cref="Calibration.Convert2DTo3D(ReadOnlySpan{Float2}, ReadOnlySpan{float}, CalibrationGeometry, CalibrationGeometry, Span{Float3}, Span{bool})"/>
+    /// <seealso cref="Calibration.Convert3DTo2D(ReadOnlySpan{Float3}, CalibrationGeometry, CalibrationGeometry, Span{Float2}, Span{bool})"/>
+    public sealed class CameraModel
+    {
+        // The same as in Sensor SDK
+        private const int MaxUnprojectPasses = 20;
+        private const float ConvergedErrorSquared = 1e-22f;
+        private const float MaxValidErrorSquared = 1e-6f;
+
+        // Number of points processed at once by vectorized code
+        private const int BlockSize = 8;
+
+        private readonly float cx, cy, fx, fy;
+        private readonly float k1, k2, k3, k4, k5, k6;
+        private readonly float codx, cody, p1, p2;
+        private readonly float maxRadiusSquared;
+        private readonly bool isRational6KT;
+
+        /// <summary>Creates model from camera calibration data.</summary>
+        /// <param name="cameraCalibration">Calibration of depth or color camera, for example, <see cref="Calibration.DepthCameraCalibration"/>.</param>
+        /// <exception cref="ArgumentException">
+        /// Lens distortion model of <paramref name="cameraCalibration"/> is neither <see cref="CalibrationModel.BrownConrady"/> nor <c>Rational6KT</c>.
+        /// </exception>
+        public CameraModel(in CameraCalibration cameraCalibration)
+        {
+            if (!IsSupportedModel(cameraCalibration.Intrinsics.Model))
+                throw new ArgumentException($"Unsupported lens distortion model {cameraCalibration.Intrinsics.Model}.", nameof(cameraCalibration));
+
+            CameraCalibration = cameraCalibration;
+
+            ref readonly var parameters = ref cameraCalibration.Intrinsics.Parameters;
+            cx = parameters.Cx;
+            cy = parameters.Cy;
+            fx = parameters.Fx;
+            fy = parameters.Fy;
+            k1 = parameters.K1;
+            k2 = parameters.K2;
+            k3 = parameters.K3;
+            k4 = parameters.K4;
+            k5 = parameters.K5;
+            k6 = parameters.K6;
+            codx = parameters.Codx;
+            cody = parameters.Cody;
+            p1 = parameters.P1;
+            p2 = parameters.P2;
+#pragma warning disable CS0612 // Type or member is obsolete
+            isRational6KT = cameraCalibration.Intrinsics.Model == CalibrationModel.Rational6KT;
+#pragma warning restore CS0612 // Type or member is obsolete
+
+            // Non-positive radius means that it is not specified. In this case, projection is not limited.
+            var metricRadius = cameraCalibration.MetricRadius;
+            maxRadiusSquared = metricRadius > 0 ? metricRadius * metricRadius : float.PositiveInfinity;
+        }
+
+        /// <summary>Camera calibration data from which this model was created.</summary>
+        public CameraCalibration CameraCalibration { get; }
+
+        /// <summary>Transforms a 2D pixel coordinate into a 3D ray in camera coordinate system.</summary>
+        /// <param name="point2D">The 2D pixel coordinate.</param>
+        /// <param name="ray">
+        /// Result: X and Y coordinates of 3D point on the ray with Z equal to <c>1</c>.
+        /// In other words, undistorted normalized coordinates of <paramref name="point2D"/>.
+        /// </param>
+        /// <returns>
+        /// <see langword="true"/> if <paramref name="point2D"/> is in the range of valid calibration,
+        /// <see langword="false"/> otherwise (<paramref name="ray"/> is meaningless in this case).
+        /// </returns>
+        public bool TryUnproject(Float2 point2D, out Float2 ray)
+        {
+            var isValid = TryUnprojectCore(point2D.X, point2D.Y, out var x, out var y);
+            ray = new Float2(x, y);
+            return isValid;
+        }
+
+        /// <summary>Transforms 2D pixel coordinates with associated depth values into 3D points in camera coordinate system.</summary>
+        /// <param name="points2D">The 2D pixel coordinates.</param>
+        /// <param name="depthsMm">Depths of <paramref name="points2D"/> in millimeters. Must have the same length as <paramref name="points2D"/>.</param>
+        /// <param name="points3DMm">
+        /// Output: 3D coordinates of points in millimeters. Cannot be shorter than <paramref name="points2D"/>.
+        /// Invalid points are set to <see cref="Float3.Zero"/>.
+        /// </param>
+        /// <param name="validFlags">
+        /// Output: validity mask. <see langword="false"/> if depth is zero or if point is outside of the range of valid calibration.
+        /// Cannot be shorter than <paramref name="points2D"/>.
+        /// </param>
+        /// <returns>Number of valid points.</returns>
+        /// <remarks>
+        /// For each point, result is the same as result of <see cref="Calibration.Convert2DTo3D(Float2, float, CalibrationGeometry, CalibrationGeometry)"/>
+        /// with the same source and target camera.
+        /// </remarks>
+        /// <exception cref="ArgumentException">Invalid length of <paramref name="depthsMm"/>, <paramref name="points3DMm"/> or <paramref name="validFlags"/>.</exception>
+        public int Unproject(ReadOnlySpan<Float2> points2D, ReadOnlySpan<float> depthsMm, Span<Float3> points3DMm, Span<bool> validFlags)
+        {
+            if (depthsMm.Length != points2D.Length)
+                throw new ArgumentException($"{nameof(depthsMm)} must have the same length as {nameof(points2D)}.", nameof(depthsMm));
+            if (points3DMm.Length < points2D.Length)
+                throw new ArgumentException($"{nameof(points3DMm)} cannot be shorter than {nameof(points2D)}.", nameof(points3DMm));
+            if (validFlags.Length < points2D.Length)
+                throw new ArgumentException($"{nameof(validFlags)} cannot be shorter than {nameof(points2D)}.", nameof(validFlags));
+
+            var validCount = 0;
+            var i = 0;
+
+            if (Avx.IsSupported)
+            {
+                Span<float> u = stackalloc float[BlockSize];
+                Span<float> v = stackalloc float[BlockSize];
+                Span<float> x = stackalloc float[BlockSize];
+                Span<float> y = stackalloc float[BlockSize];
+                for (; i < points2D.Length; i += BlockSize)
+                {
+                    var count = Math.Min(BlockSize, points2D.Length - i);
+                    var activeMask = 0;
+                    for (var j = 0; j < count; j++)
+                    {
+                        u[j] = points2D[i + j].X;
+                        v[j] = points2D[i + j].Y;
+                        if (depthsMm[i + j] != 0f)
+                            activeMask |= 1 << j;
+                    }
+
+                    var validMask = activeMask == 0 ? 0 : UnprojectBlockAvx(u, v, activeMask, x, y);
+
+                    for (var j = 0; j < count; j++)
+                    {
+                        var isValid = (validMask & (1 << j)) != 0;
+                        var depth = depthsMm[i + j];
+                        points3DMm[i + j] = isValid ? new Float3(x[j] * depth, y[j] * depth, depth) : Float3.Zero;
+                        validFlags[i + j] = isValid;
+                        if (isValid)
+                            validCount++;
+                    }
+                }
+
+                return validCount;
+            }
+
+            for (; i < points2D.Length; i++)
+            {
+                var depth = depthsMm[i];
+                var x = 0f;
+                var y = 0f;
+                var isValid = depth != 0f && TryUnprojectCore(points2D[i].X, points2D[i].Y, out x, out y);
+                points3DMm[i] = isValid ? new Float3(x * depth, y * depth, depth) : Float3.Zero;
+                validFlags[i] = isValid;
+                if (isValid)
+                    validCount++;
+            }
+
+            return validCount;
+        }
+
+        /// <summary>Transforms a 3D point in camera coordinate system into a 2D pixel coordinate.</summary>
+        /// <param name="point3D">The 3D point in camera coordinate system. Any units can be used.</param>
+        /// <param name="point2D">Result: the 2D pixel coordinate.</param>
+        /// <returns>
+        /// <see langword="true"/> if <paramref name="point3D"/> is in front of camera and in the range of valid calibration,
+        /// <see langword="false"/> otherwise (<paramref name="point2D"/> is meaningless in this case).
+        /// </returns>
+        public bool TryProject(Float3 point3D, out Float2 point2D)
+        {
+            point2D = default;
+            if (!(point3D.Z > 0f))
+                return false;
+            var isValid = TryProjectCore(point3D.X / point3D.Z, point3D.Y / point3D.Z, withJacobian: false, out var u, out var v, out _, out _, out _, out _);
+            point2D = new Float2(u, v);
+            return isValid;
+        }
+
+        /// <summary>Transforms 3D points in camera coordinate system into 2D pixel coordinates.</summary>
+        /// <param name="points3D">The 3D points in camera coordinate system. Any units can be used.</param>
+        /// <param name="points2D">
+        /// Output: the 2D pixel coordinates. Cannot be shorter than <paramref name="points3D"/>.
+        /// Invalid points are set to zeros.
+        /// </param>
+        /// <param name="validFlags">
+        /// Output: validity mask. <see langword="false"/> if point is not in front of camera or if it is outside of the range of valid calibration.
+        /// Cannot be shorter than <paramref name="points3D"/>.
+        /// </param>
+        /// <returns>Number of valid points.</returns>
+        /// <remarks>
+        /// For each point, result is the same as result of <see cref="Calibration.Convert3DTo2D(Float3, CalibrationGeometry, CalibrationGeometry)"/>
+        /// with the same source and target camera.
+        /// </remarks>
+        /// <exception cref="ArgumentException">Invalid length of <paramref name="points2D"/> or <paramref name="validFlags"/>.</exception>
+        public int Project(ReadOnlySpan<Float3> points3D, Span<Float2> points2D, Span<bool> validFlags)
+            => Project(points3D, null, points2D, validFlags);
+
+        // Projection with optional extrinsic transformation of points to camera coordinate system
+        internal int Project(ReadOnlySpan<Float3> points3D, CalibrationExtrinsics? extrinsics, Span<Float2> points2D, Span<bool> validFlags)
+        {
+            if (points2D.Length < points3D.Length)
+                throw new ArgumentException($"{nameof(points2D)} cannot be shorter than {nameof(points3D)}.", nameof(points2D));
+            if (validFlags.Length < points3D.Length)
+                throw new ArgumentException($"{nameof(validFlags)} cannot be shorter than {nameof(points3D)}.", nameof(validFlags));
+
+            var transform = extrinsics.HasValue;
+            var extr = extrinsics.GetValueOrDefault();
+            var validCount = 0;
+            var i = 0;
+
+            if (Avx.IsSupported)
+            {
+                Span<float> x = stackalloc float[BlockSize];
+                Span<float> y = stackalloc float[BlockSize];
+                Span<float> u = stackalloc float[BlockSize];
+                Span<float> v = stackalloc float[BlockSize];
+                for (; i < points3D.Length; i += BlockSize)
+                {
+                    var count = Math.Min(BlockSize, points3D.Length - i);
+                    var activeMask = 0;
+                    for (var j = 0; j < count; j++)
+                    {
+                        var point = transform ? extr.Transform(points3D[i + j]) : points3D[i + j];
+                        if (point.Z > 0f)
+                        {
+                            x[j] = point.X / point.Z;
+                            y[j] = point.Y / point.Z;
+                            activeMask |= 1 << j;
+                        }
+                    }
+
+                    var validMask = activeMask == 0 ? 0 : ProjectBlockAvx(x, y, activeMask, u, v);
+
+                    for (var j = 0; j < count; j++)
+                    {
+                        var isValid = (validMask & (1 << j)) != 0;
+                        points2D[i + j] = isValid ? new Float2(u[j], v[j]) : default;
+                        validFlags[i + j] = isValid;
+                        if (isValid)
+                            validCount++;
+                    }
+                }
+
+                return validCount;
+            }
+
+            for (; i < points3D.Length; i++)
+            {
+                var point = transform ? extr.Transform(points3D[i]) : points3D[i];
+                var isValid = TryProject(point, out var point2D);
+                points2D[i] = isValid ? point2D : default;
+                validFlags[i] = isValid;
+                if (isValid)
+                    validCount++;
+            }
+
+            return validCount;
+        }
+
+        internal static bool IsSupportedModel(CalibrationModel model)
+#pragma warning disable CS0612 // Type or member is obsolete
+            => model == CalibrationModel.BrownConrady || model == CalibrationModel.Rational6KT;
+#pragma warning restore CS0612 // Type or member is obsolete
+
+        #region Scalar implementation (port of intrinsic_transformations.c from Sensor SDK)
+
+        private bool TryUnprojectCore(float u, float v, out float x, out float y)
+        {
+            // Correction for radial distortion
+            var xpd = (u - cx) / fx - codx;
+            var ypd = (v - cy) / fy - cody;
+
+            var rs = xpd * xpd + ypd * ypd;
+            var rss = rs * rs;
+            var rsc = rss * rs;
+            var a = 1f + k1 * rs + k2 * rss + k3 * rsc;
+            var b = 1f + k4 * rs + k5 * rss + k6 * rsc;
+            var ai = a != 0f ? 1f / a : 1f;
+            var di = ai * b;
+
+            x = xpd * di;
+            y = ypd * di;
+
+            // Approximate correction for tangential parameters
+            var twoXy = 2f * x * y;
+            var xx = x * x;
+            var yy = y * y;
+
+            x -= (yy + 3f * xx) * p2 + twoXy * p1;
+            y -= (xx + 3f * yy) * p1 + twoXy * p2;
+
+            // Add on center of distortion
+            x += codx;
+            y += cody;
+
+            return TryUnprojectIteratively(u, v, ref x, ref y);
+        }
+
+        private bool TryUnprojectIteratively(float u, float v, ref float x, ref float y)
+        {
+            var bestX = 0f;
+            var bestY = 0f;
+            var bestErr = float.MaxValue;
+
+            for (var pass = 0; pass < MaxUnprojectPasses; pass++)
+            {
+                if (!TryProjectCore(x, y, withJacobian: true, out var pu, out var pv, out var j00, out var j01, out var j10, out var j11))
+                    return false;
+
+                var errX = u - pu;
+                var errY = v - pv;
+                var err = errX * errX + errY * errY;
+                if (err >= bestErr)
+                {
+                    x = bestX;
+                    y = bestY;
+                    break;
+                }
+
+                bestErr = err;
+                bestX = x;
+                bestY = y;
+                if (pass + 1 == MaxUnprojectPasses || bestErr < ConvergedErrorSquared)
+                    break;
+
+                var invDet = 1f / (j00 * j11 - j01 * j10);
+                x += invDet * j11 * errX + -invDet * j01 * errY;
+                y += -invDet * j10 * errX + invDet * j00 * errY;
+            }
+
+            return !(bestErr > MaxValidErrorSquared);
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private bool TryProjectCore(float x, float y, bool withJacobian, out float u, out float v,
+            out float j00, out float j01, out float j10, out float j11)
+        {
+            var xp = x - codx;
+            var yp = y - cody;
+
+            var xp2 = xp * xp;
+            var yp2 = yp * yp;
+            var xyp = xp * yp;
+            var rs = xp2 + yp2;
+            if (rs > maxRadiusSquared)
+            {
+                u = v = j00 = j01 = j10 = j11 = 0f;
+                return false;
+            }
+
+            var rss = rs * rs;
+            var rsc = rss * rs;
+            var a = 1f + k1 * rs + k2 * rss + k3 * rsc;
+            var b = 1f + k4 * rs + k5 * rss + k6 * rsc;
+            var bi = b != 0f ? 1f / b : 1f;
+            var d = a * bi;
+
+            var xpd = xp * d;
+            var ypd = yp * d;
+
+            var rs2xp2 = rs + 2f * xp2;
+            var rs2yp2 = rs + 2f * yp2;
+
+            // The only difference of Brown-Conrady from Rational6KT is multiplier 2 for tangential terms xyp*p1 and xyp*p2
+            var tangentialFactor = isRational6KT ? 1f : 2f;
+            xpd += rs2xp2 * p2 + tangentialFactor * xyp * p1;
+            ypd += rs2yp2 * p1 + tangentialFactor * xyp * p2;
+
+            u = (xpd + codx) * fx + cx;
+            v = (ypd + cody) * fy + cy;
+
+            if (!withJacobian)
+            {
+                j00 = j01 = j10 = j11 = 0f;
+                return true;
+            }
+
+            // Jacobian
+            var dudrs = k1 + 2f * k2 * rs + 3f * k3 * rss;
+            var dvdrs = k4 + 2f * k5 * rs + 3f * k6 * rss;
+            var bis = bi * bi;
+            var dddrs = (dudrs * b - a * dvdrs) * bis;
+
+            var dddrs2 = dddrs * 2f;
+            var xpDddrs2 = xp * dddrs2;
+            var ypXpDddrs2 = yp * xpDddrs2;
+
+            j00 = fx * (d + xp * xpDddrs2 + 6f * xp * p2 + tangentialFactor * yp * p1);
+            j01 = fx * (ypXpDddrs2 + 2f * yp * p2 + tangentialFactor * xp * p1);
+            j10 = fy * (ypXpDddrs2 + 2f * xp * p1 + tangentialFactor * yp * p2);
+            j11 = fy * (d + yp * yp * dddrs2 + 6f * yp * p1 + tangentialFactor * xp * p2);
+
+            return true;
+        }
+
+        #endregion
+
+        #region Vectorized implementation
+
+        // The same algorithm as in TryUnprojectCore() for eight points at once.
+        // Each lane follows its own path: lanes that have finished iterations are masked out.
+        // Returns bit mask of valid points.
+        private int UnprojectBlockAvx(ReadOnlySpan<float> uValues, ReadOnlySpan<float> vValues, int activeMask, Span<float> xValues, Span<float> yValues)
+        {
+            var one = Vector256.Create(1f);
+            var two = Vector256.Create(2f);
+            var three = Vector256.Create(3f);
+            var zero = Vector256<float>.Zero;
+
+            var u = Vector256.Create(uValues[0], uValues[1], uValues[2], uValues[3], uValues[4], uValues[5], uValues[6], uValues[7]);
+            var v = Vector256.Create(vValues[0], vValues[1], vValues[2], vValues[3], vValues[4], vValues[5], vValues[6], vValues[7]);
+            var active = MaskToVector(activeMask);
+
+            var vcodx = Vector256.Create(codx);
+            var vcody = Vector256.Create(cody);
+            var vp1 = Vector256.Create(p1);
+            var vp2 = Vector256.Create(p2);
+
+            // Initial approximation: correction for radial distortion
+            var xpd = Avx.Subtract(Avx.Divide(Avx.Subtract(u, Vector256.Create(cx)), Vector256.Create(fx)), vcodx);
+            var ypd = Avx.Subtract(Avx.Divide(Avx.Subtract(v, Vector256.Create(cy)), Vector256.Create(fy)), vcody);
+            var rs = Avx.Add(Avx.Multiply(xpd, xpd), Avx.Multiply(ypd, ypd));
+            var rss = Avx.Multiply(rs, rs);
+            var rsc = Avx.Multiply(rss, rs);
+            var a = Polynomial(one, k1, k2, k3, rs, rss, rsc);
+            var b = Polynomial(one, k4, k5, k6, rs, rss, rsc);
+            var ai = Avx.BlendVariable(Avx.Divide(one, a), one, Avx.CompareEqual(a, zero));
+            var di = Avx.Multiply(ai, b);
+            var x = Avx.Multiply(xpd, di);
+            var y = Avx.Multiply(ypd, di);
+
+            // Approximate correction for tangential parameters
+            var twoXy = Avx.Multiply(Avx.Multiply(two, x), y);
+            var xx = Avx.Multiply(x, x);
+            var yy = Avx.Multiply(y, y);
+            var dx = Avx.Add(Avx.Multiply(Avx.Add(yy, Avx.Multiply(three, xx)), vp2), Avx.Multiply(twoXy, vp1));
+            var dy = Avx.Add(Avx.Multiply(Avx.Add(xx, Avx.Multiply(three, yy)), vp1), Avx.Multiply(twoXy, vp2));
+            x = Avx.Add(Avx.Subtract(x, dx), vcodx);
+            y = Avx.Add(Avx.Subtract(y, dy), vcody);
+
+            // Iterative refinement
+            var valid = active;
+            var bestX = zero;
+            var bestY = zero;
+            var bestErr = Vector256.Create(float.MaxValue);
+            var convergedErr = Vector256.Create(ConvergedErrorSquared);
+
+            for (var pass = 0; pass < MaxUnprojectPasses && Avx.MoveMask(active) != 0; pass++)
+            {
+                ProjectAvx(x, y, withJacobian: true, out var pu, out var pv, out var j00, out var j01, out var j10, out var j11, out var inRadius);
+
+                // Lanes outside of valid radius are invalid
+                valid = Avx.AndNot(Avx.AndNot(inRadius, active), valid);
+                active = Avx.And(active, inRadius);
+
+                var errX = Avx.Subtract(u, pu);
+                var errY = Avx.Subtract(v, pv);
+                var err = Avx.Add(Avx.Multiply(errX, errX), Avx.Multiply(errY, errY));
+
+                // Lanes where error has not decreased return to the best solution
+                var worse = Avx.And(active, Avx.Compare(err, bestErr, FloatComparisonMode.OrderedGreaterThanOrEqualNonSignaling));
+                x = Avx.BlendVariable(x, bestX, worse);
+                y = Avx.BlendVariable(y, bestY, worse);
+                active = Avx.AndNot(worse, active);
+
+                bestErr = Avx.BlendVariable(bestErr, err, active);
+                bestX = Avx.BlendVariable(bestX, x, active);
+                bestY = Avx.BlendVariable(bestY, y, active);
+
+                if (pass + 1 == MaxUnprojectPasses)
+                    break;
+                active = Avx.AndNot(Avx.Compare(bestErr, convergedErr, FloatComparisonMode.OrderedLessThanNonSignaling), active);
+
+                // Gauss-Newton step
+                var invDet = Avx.Divide(one, Avx.Subtract(Avx.Multiply(j00, j11), Avx.Multiply(j01, j10)));
+                var negInvDet = Avx.Subtract(zero, invDet);
+                dx = Avx.Add(Avx.Multiply(Avx.Multiply(invDet, j11), errX), Avx.Multiply(Avx.Multiply(negInvDet, j01), errY));
+                dy = Avx.Add(Avx.Multiply(Avx.Multiply(negInvDet, j10), errX), Avx.Multiply(Avx.Multiply(invDet, j00), errY));
+                x = Avx.BlendVariable(x, Avx.Add(x, dx), active);
+                y = Avx.BlendVariable(y, Avx.Add(y, dy), active);
+            }
+
+            valid = Avx.AndNot(Avx.Compare(bestErr, Vector256.Create(MaxValidErrorSquared), FloatComparisonMode.OrderedGreaterThanNonSignaling), valid);
+
+            for (var j = 0; j < BlockSize; j++)
+            {
+                xValues[j] = x.GetElement(j);
+                yValues[j] = y.GetElement(j);
+            }
+
+            return Avx.MoveMask(valid);
+        }
+
+        // Projection of eight normalized points at once. Returns bit mask of valid points.
+        private int ProjectBlockAvx(ReadOnlySpan<float> xValues, ReadOnlySpan<float> yValues, int activeMask, Span<float> uValues, Span<float> vValues)
+        {
+            var x = Vector256.Create(xValues[0], xValues[1], xValues[2], xValues[3], xValues[4], xValues[5], xValues[6], xValues[7]);
+            var y = Vector256.Create(yValues[0], yValues[1], yValues[2], yValues[3], yValues[4], yValues[5], yValues[6], yValues[7]);
+
+            ProjectAvx(x, y, withJacobian: false, out var u, out var v, out _, out _, out _, out _, out var inRadius);
+
+            for (var j = 0; j < BlockSize; j++)
+            {
+                uValues[j] = u.GetElement(j);
+                vValues[j] = v.GetElement(j);
+            }
+
+            return Avx.MoveMask(Avx.And(MaskToVector(activeMask), inRadius));
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private void ProjectAvx(Vector256<float> x, Vector256<float> y, bool withJacobian,
+            out Vector256<float> u, out Vector256<float> v,
+            out Vector256<float> j00, out Vector256<float> j01, out Vector256<float> j10, out Vector256<float> j11,
+            out Vector256<float> inRadius)
+        {
+            var one = Vector256.Create(1f);
+            var two = Vector256.Create(2f);
+            var vp1 = Vector256.Create(p1);
+            var vp2 = Vector256.Create(p2);
+            var vfx = Vector256.Create(fx);
+            var vfy = Vector256.Create(fy);
+            var tangentialFactor = Vector256.Create(isRational6KT ? 1f : 2f);
+
+            var xp = Avx.Subtract(x, Vector256.Create(codx));
+            var yp = Avx.Subtract(y, Vector256.Create(cody));
+
+            var xp2 = Avx.Multiply(xp, xp);
+            var yp2 = Avx.Multiply(yp, yp);
+            var xyp = Avx.Multiply(xp, yp);
+            var rs = Avx.Add(xp2, yp2);
+            inRadius = Avx.Compare(rs, Vector256.Create(maxRadiusSquared), FloatComparisonMode.UnorderedNotGreaterThanNonSignaling);
+
+            var rss = Avx.Multiply(rs, rs);
+            var rsc = Avx.Multiply(rss, rs);
+            var a = Polynomial(one, k1, k2, k3, rs, rss, rsc);
+            var b = Polynomial(one, k4, k5, k6, rs, rss, rsc);
+            var bi = Avx.BlendVariable(Avx.Divide(one, b), one, Avx.CompareEqual(b, Vector256<float>.Zero));
+            var d = Avx.Multiply(a, bi);
+
+            var xpd = Avx.Multiply(xp, d);
+            var ypd = Avx.Multiply(yp, d);
+
+            var rs2xp2 = Avx.Add(rs, Avx.Multiply(two, xp2));
+            var rs2yp2 = Avx.Add(rs, Avx.Multiply(two, yp2));
+
+            var tangentialXyp = Avx.Multiply(tangentialFactor, xyp);
+            xpd = Avx.Add(xpd, Avx.Add(Avx.Multiply(rs2xp2, vp2), Avx.Multiply(tangentialXyp, vp1)));
+            ypd = Avx.Add(ypd, Avx.Add(Avx.Multiply(rs2yp2, vp1), Avx.Multiply(tangentialXyp, vp2)));
+
+            u = Avx.Add(Avx.Multiply(Avx.Add(xpd, Vector256.Create(codx)), vfx), Vector256.Create(cx));
+            v = Avx.Add(Avx.Multiply(Avx.Add(ypd, Vector256.Create(cody)), vfy), Vector256.Create(cy));
+
+            if (!withJacobian)
+            {
+                j00 = j01 = j10 = j11 = Vector256<float>.Zero;
+                return;
+            }
+
+            // Jacobian
+            var dudrs = Avx.Add(Vector256.Create(k1), Avx.Add(Avx.Multiply(Vector256.Create(2f * k2), rs), Avx.Multiply(Vector256.Create(3f * k3), rss)));
+            var dvdrs = Avx.Add(Vector256.Create(k4), Avx.Add(Avx.Multiply(Vector256.Create(2f * k5), rs), Avx.Multiply(Vector256.Create(3f * k6), rss)));
+            var bis = Avx.Multiply(bi, bi);
+            var dddrs = Avx.Multiply(Avx.Subtract(Avx.Multiply(dudrs, b), Avx.Multiply(a, dvdrs)), bis);
+
+            var dddrs2 = Avx.Multiply(dddrs, two);
+            var xpDddrs2 = Avx.Multiply(xp, dddrs2);
+            var ypXpDddrs2 = Avx.Multiply(yp, xpDddrs2);
+            var six = Vector256.Create(6f);
+
+            j00 = Avx.Multiply(vfx, Sum(Avx.Add(d, Avx.Multiply(xp, xpDddrs2)), Avx.Multiply(Avx.Multiply(six, xp), vp2), Avx.Multiply(Avx.Multiply(tangentialFactor, yp), vp1)));
+            j01 = Avx.Multiply(vfx, Sum(ypXpDddrs2, Avx.Multiply(Avx.Multiply(two, yp), vp2), Avx.Multiply(Avx.Multiply(tangentialFactor, xp), vp1)));
+            j10 = Avx.Multiply(vfy, Sum(ypXpDddrs2, Avx.Multiply(Avx.Multiply(two, xp), vp1), Avx.Multiply(Avx.Multiply(tangentialFactor, yp), vp2)));
+            j11 = Avx.Multiply(vfy, Sum(Avx.Add(d, Avx.Multiply(yp2, dddrs2)), Avx.Multiply(Avx.Multiply(six, yp), vp1), Avx.Multiply(Avx.Multiply(tangentialFactor, xp), vp2)));
+        }
+
+        // c0 + c1 * rs + c2 * rss + c3 * rsc
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector256<float> Polynomial(Vector256<float> c0, float c1, float c2, float c3,
+            Vector256<float> rs, Vector256<float> rss, Vector256<float> rsc)
+            => Sum(Avx.Add(c0, Avx.Multiply(Vector256.Create(c1), rs)), Avx.Multiply(Vector256.Create(c2), rss), Avx.Multiply(Vector256.Create(c3), rsc));
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector256<float> Sum(Vector256<float> a, Vector256<float> b, Vector256<float> c)
+            => Avx.Add(Avx.Add(a, b), c);
+
+        private static Vector256<float> MaskToVector(int mask)
+            => Vector256.Create(
+                -(mask & 1), -((mask >> 1) & 1), -((mask >> 2) & 1), -((mask >> 3) & 1),
+                -((mask >> 4) & 1), -((mask >> 5) & 1), -((mask >> 6) & 1), -((mask >> 7) & 1)).AsSingle();
+
+        #endregion
+    }
+}
+
+#endif
@@ -0,0 +1,236 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+using System.Numerics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace K4AdotNet.Sensor
+{
+    // Conversion of depth maps to point clouds
+    partial class CameraRayTable
+    {
+        // Number of pixels processed at once by vectorized code
+        private const int BlockSize = 8;
+
+        private const float MillimetersToMeters = 0.001f;
+
+        /// <summary>Converts depth map to point cloud in managed code.</summary>
+        /// <param name="depthMap">
+        /// Depth map in the geometry of camera of this table (the same size as table).
+        /// Pixels are unsigned 16-bit depth values in millimeters, zero depth means invalid pixel.
+        /// </param>
+        /// <param name="points">
+        /// Output: 3D points in the coordinate system of camera of this table, row by row (the same order as <see cref="Rays"/>).
+        /// Cannot be shorter than number of pixels in <paramref name="depthMap"/>.
+        /// </param>
+        /// <param name="inMeters">
+        /// <see langword="true"/> to output coordinates in meters,
+        /// <see langword="false"/> to output coordinates in millimeters (as <see cref="Transformation.DepthImageToPointCloud(Image, CalibrationGeometry, Image)"/> does).
+        /// </param>
+        /// <param name="validPointsOnly">
+        /// <see langword="true"/> to write only valid points one after another (compact point cloud),
+        /// <see langword="false"/> to write point for each pixel with zeros for invalid pixels.
+        /// </param>
+        /// <returns>Number of valid points.</returns>
+        /// <remarks><para>
+        /// Managed alternative of <see cref="Transformation.DepthImageToPointCloud(Image, CalibrationGeometry, Image)"/>:
+        /// it does not need native transformation object nor depth engine, outputs floating-point coordinates
+        /// and writes directly to user memory.
+        /// </para><para>
+        /// Image is processed in horizontal bands on all CPU cores, eight pixels at once using AVX2 instructions if they are supported by CPU.
+        /// </para></remarks>
+        /// <exception cref="ArgumentException">Invalid size of <paramref name="depthMap"/> or invalid length of <paramref name="points"/>.</exception>
+        /// <seealso cref="Calibration.DepthImageToPointCloud(Image, CalibrationGeometry, Span{Float3}, bool, bool)"/>
+        public unsafe int DepthToPointCloud(ReadOnlyImageView<short> depthMap, Span<Float3> points, bool inMeters = false, bool validPointsOnly = false)
+        {
+            if (depthMap.WidthPixels != WidthPixels || depthMap.HeightPixels != HeightPixels)
+                throw new ArgumentException($"Size of depth map must be {WidthPixels}x{HeightPixels} pixels.", nameof(depthMap));
+            if (points.Length < rays.Length)
+                throw new ArgumentException($"{nameof(points)} cannot be shorter than number of pixels in {nameof(depthMap)}.", nameof(points));
+
+            var depthBuffer = depthMap.Buffer;
+            var depthStrideBytes = depthMap.StrideBytes;
+            var scale = inMeters ? MillimetersToMeters : 1f;
+            fixed (Float3* pointsPtr = points)
+            {
+                var pointsBuffer = new IntPtr(pointsPtr);
+                var validCounts = RowBands.Process(WidthPixels, HeightPixels, rowAlignment: 1,
+                    (firstRow, rowCount) => DepthToPointCloudBand(depthBuffer, depthStrideBytes, pointsBuffer, scale, validPointsOnly, firstRow, rowCount),
+                    out var rowsPerBand);
+
+                var validCount = 0;
+                for (var band = 0; band < validCounts.Length; band++)
+                {
+                    // Each band writes its points starting from its first pixel: close the gaps between bands
+                    var bandStart = band * rowsPerBand * WidthPixels;
+                    if (validPointsOnly && bandStart != validCount)
+                        points.Slice(bandStart, validCounts[band]).CopyTo(points.Slice(validCount));
+                    validCount += validCounts[band];
+                }
+
+                return validCount;
+            }
+        }
+
+        /// <summary>Converts depth map to point cloud in managed code.</summary>
+        /// <param name="depthMap">Depth map in the geometry of camera of this table (the same size as table). Zero depth means invalid pixel.</param>
+        /// <param name="points">
+        /// Output: 3D points in the coordinate system of camera of this table, row by row (the same order as <see cref="Rays"/>).
+        /// Cannot be shorter than number of pixels in <paramref name="depthMap"/>.
+        /// </param>
+        /// <param name="inMeters"><see langword="true"/> to output coordinates in meters, <see langword="false"/> to output coordinates in millimeters.</param>
+        /// <param name="validPointsOnly">
+        /// <see langword="true"/> to write only valid points one after another (compact point cloud),
+        /// <see langword="false"/> to write point for each pixel with zeros for invalid pixels.
+        /// </param>
+        /// <returns>Number of valid points.</returns>
+        /// <remarks>See <see cref="DepthToPointCloud(ReadOnlyImageView{short}, Span{Float3}, bool, bool)"/> for details.</remarks>
+        /// <exception cref="ArgumentException">Invalid size of <paramref name="depthMap"/> or invalid length of <paramref name="points"/>.</exception>
+        public int DepthToPointCloud(ReadOnlyImageView<short> depthMap, Span<Vector3> points, bool inMeters = false, bool validPointsOnly = false)
+            => DepthToPointCloud(depthMap, MemoryMarshal.Cast<Vector3, Float3>(points), inMeters, validPointsOnly);
+
+        private unsafe int DepthToPointCloudBand(IntPtr depthBuffer, int depthStrideBytes, IntPtr pointsBuffer, float scale, bool validPointsOnly,
+            int firstRow, int rowCount)
+        {
+            var width = WidthPixels;
+            var dst = (Float3*)pointsBuffer.ToPointer() + firstRow * width;
+            var validCount = 0;
+            fixed (Float2* raysPtr = rays)
+            {
+                for (var y = firstRow; y < firstRow + rowCount; y++)
+                {
+                    var depthRow = (ushort*)((byte*)depthBuffer.ToPointer() + (nint)y * depthStrideBytes);
+                    var rowValidCount = Avx2.IsSupported
+                        ? DepthRowToPointsAvx2(depthRow, raysPtr, y * width, scale, validPointsOnly, dst)
+                        : DepthRowToPoints(depthRow, raysPtr, y * width, 0, scale, validPointsOnly, dst);
+                    validCount += rowValidCount;
+                    dst += validPointsOnly ? rowValidCount : width;
+                }
+            }
+
+            return validCount;
+        }
+
+        // Converts one row of depth map to points in millimeters with zeros for invalid pixels, returns number of valid points
+        internal unsafe int DepthRowToPoints(ushort* depthRow, int y, Float3* dst)
+        {
+            fixed (Float2* raysPtr = rays)
+            {
+                return Avx2.IsSupported
+                    ? DepthRowToPointsAvx2(depthRow, raysPtr, y * WidthPixels, 1f, validPointsOnly: false, dst)
+                    : DepthRowToPoints(depthRow, raysPtr, y * WidthPixels, 0, 1f, validPointsOnly: false, dst);
+            }
+        }
+
+        private unsafe int DepthRowToPoints(ushort* depthRow, Float2* raysPtr, int rowOffset, int firstX, float scale, bool validPointsOnly, Float3* dst)
+        {
+            var validCount = 0;
+            for (var x = firstX; x < WidthPixels; x++)
+            {
+                var depth = depthRow[x];
+                if (depth != 0 && IsValid(rowOffset + x))
+                {
+                    var z = depth * scale;
+                    var ray = raysPtr[rowOffset + x];
+                    dst[validPointsOnly ? validCount : x - firstX] = new(ray.X * z, ray.Y * z, z);
+                    validCount++;
+                }
+                else if (!validPointsOnly)
+                {
+                    dst[x - firstX] = default;
+                }
+            }
+
+            return validCount;
+        }
+
+        private unsafe int DepthRowToPointsAvx2(ushort* depthRow, Float2* raysPtr, int rowOffset, float scale, bool validPointsOnly, Float3* dst)
+        {
+            var scaleVector = Vector256.Create(scale);
+            var bitSelectors = Vector256.Create(1, 2, 4, 8, 16, 32, 64, 128);
+            var duplicateLow = Vector256.Create(0, 0, 1, 1, 2, 2, 3, 3);
+            var duplicateHigh = Vector256.Create(4, 4, 5, 5, 6, 6, 7, 7);
+            var points = stackalloc float[BlockSize * 3];
+
+            var validCount = 0;
+            var x = 0;
+            for (; x + BlockSize <= WidthPixels; x += BlockSize)
+            {
+                // Depth of pixels with invalid rays is zeroed, thus all coordinates of such pixels are zeros
+                var depths = Avx2.ConvertToVector256Int32(Sse2.LoadVector128(depthRow + x));
+                var validBits = Vector256.Create(GetValidityBits(rowOffset + x));
+                var validRays = Avx2.CompareEqual(Avx2.And(validBits, bitSelectors), bitSelectors);
+                var z = Avx.Multiply(Avx.ConvertToVector256Single(Avx2.And(depths, validRays)), scaleVector);
+
+                // (x, y) pairs of pixels 0..3 and 4..7
+                var xy0 = Avx.Multiply(Avx.LoadVector256((float*)(raysPtr + rowOffset + x)), Avx2.PermuteVar8x32(z, duplicateLow));
+                var xy1 = Avx.Multiply(Avx.LoadVector256((float*)(raysPtr + rowOffset + x + BlockSize / 2)), Avx2.PermuteVar8x32(z, duplicateHigh));
+
+                var validMask = Avx.MoveMask(Avx.CompareNotEqual(z, Vector256<float>.Zero));
+                var blockDst = validPointsOnly ? (validMask == 0xFF ? (float*)(dst + validCount) : points) : (float*)(dst + x);
+                InterleaveAvx2(xy0, xy1, z, blockDst);
+
+                var blockValidCount = BitOperations.PopCount((uint)validMask);
+                if (validPointsOnly && blockDst == points)
+                {
+                    for (var mask = (uint)validMask; mask != 0; mask &= mask - 1)
+                        dst[validCount++] = ((Float3*)points)[BitOperations.TrailingZeroCount(mask)];
+                }
+                else
+                {
+                    validCount += blockValidCount;
+                }
+            }
+
+            if (x < WidthPixels)
+                validCount += DepthRowToPoints(depthRow, raysPtr, rowOffset, x, scale, validPointsOnly, validPointsOnly ? dst + validCount : dst + x);
+
+            return validCount;
+        }
+
+        // Converts (x0 y0 .. x3 y3), (x4 y4 .. x7 y7), (z0 .. z7) to (x0 y0 z0 x1 y1 z1 .. x7 y7 z7)
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static unsafe void InterleaveAvx2(Vector256<float> xy0, Vector256<float> xy1, Vector256<float> z, float* dst)
+        {
+            // x0 y0 z0 x1 y1 z1 x2 y2
+            var v0 = Avx.Blend(
+                Avx2.PermuteVar8x32(xy0, Vector256.Create(0, 1, 0, 2, 3, 0, 4, 5)),
+                Avx2.PermuteVar8x32(z, Vector256.Create(0, 0, 0, 0, 0, 1, 0, 0)),
+                0b0010_0100);
+            // z2 x3 y3 z3 x4 y4 z4 x5
+            var v1 = Avx.Blend(
+                Avx.Blend(
+                    Avx2.PermuteVar8x32(xy0, Vector256.Create(0, 6, 7, 0, 0, 0, 0, 0)),
+                    Avx2.PermuteVar8x32(xy1, Vector256.Create(0, 0, 0, 0, 0, 1, 0, 2)),
+                    0b1011_0000),
+                Avx2.PermuteVar8x32(z, Vector256.Create(2, 0, 0, 3, 0, 0, 4, 0)),
+                0b0100_1001);
+            // y5 z5 x6 y6 z6 x7 y7 z7
+            var v2 = Avx.Blend(
+                Avx2.PermuteVar8x32(xy1, Vector256.Create(3, 0, 4, 5, 0, 6, 7, 0)),
+                Avx2.PermuteVar8x32(z, Vector256.Create(0, 5, 0, 0, 6, 0, 0, 7)),
+                0b1001_0010);
+
+            Avx.Store(dst, v0);
+            Avx.Store(dst + BlockSize, v1);
+            Avx.Store(dst + 2 * BlockSize, v2);
+        }
+
+        // Validity bits of eight pixels starting from a given one
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private int GetValidityBits(int pixelIndex)
+        {
+            var wordIndex = pixelIndex / BitsPerWord;
+            var shift = pixelIndex % BitsPerWord;
+            var bits = (ulong)validityBitmap[wordIndex] >> shift;
+            if (shift > BitsPerWord - BlockSize)
+                bits |= (ulong)validityBitmap[wordIndex + 1] << (BitsPerWord - shift);
+            return (int)(bits & 0xFF);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,178 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+using System.Runtime.CompilerServices;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>
+    /// Per-pixel table of unprojection rays of a camera (so-called "XY table"):
+    /// for each pixel it stores normalized coordinates of the ray passing through the pixel center, that is 3D point at distance <c>Z = 1</c>.
+    /// </summary>
+    /// <remarks><para>
+    /// Having such a table, conversion of depth pixel <c>(x, y)</c> to 3D point costs one multiplication per coordinate:
+    /// <c>(Rays[i].X * depth, Rays[i].Y * depth, depth)</c> where <c>i = y * WidthPixels + x</c>.
+    /// Native <c>k4a_transformation_depth_image_to_point_cloud()</c> does the same internally, but its table is not accessible.
+    /// </para><para>
+    /// Tables are computed by managed <see cref="CameraModel"/> (in parallel) on the first request and cached.
+    /// The cache is keyed by intrinsic calibration data of camera, thus all consumers working with the same calibration
+    /// share one table. Cached tables stay in memory even if nobody uses them: the cache keeps the most recently requested tables
+    /// up to <see cref="CacheCapacityBytes"/> in total (one table for color camera of the maximum resolution takes about 100 MB).
+    /// Call <see cref="ClearCache"/> to release them.
+    /// </para><para>
+    /// Instances are immutable and thread safe.
+    /// </para></remarks>
+    /// <seealso cref="Calibration.GetRayTable(CalibrationGeometry)"/>
+    public sealed partial class CameraRayTable
+    {
+        private const int BitsPerWord = 64;
+
+        /// <summary>Total size of tables kept in cache: 256 MB. The most recently requested table is kept even if it is larger.</summary>
+        public const long CacheCapacityBytes = 256L << 20;
+
+        private static readonly CalibrationDataCache<Key, CameraRayTable> cache = new(CacheCapacityBytes,
+            table => (long)table.rays.Length * Unsafe.SizeOf<Float2>() + (long)table.validityBitmap.Length * sizeof(long));
+
+        private readonly Float2[] rays;
+        private readonly long[] validityBitmap;
+
+        private CameraRayTable(in CameraCalibration cameraCalibration)
+        {
+            var model = new CameraModel(in cameraCalibration);
+            CameraCalibration = cameraCalibration;
+            WidthPixels = cameraCalibration.ResolutionWidth;
+            HeightPixels = cameraCalibration.ResolutionHeight;
+
+            var pixelCount = WidthPixels * HeightPixels;
+            rays = new Float2[pixelCount];
+            validityBitmap = new long[(pixelCount + BitsPerWord - 1) / BitsPerWord];
+            ValidCount = Compute(model);
+        }
+
+        /// <summary>Calibration data of camera for which table was computed.</summary>
+        public CameraCalibration CameraCalibration { get; }
+
+        /// <summary>Width of table in pixels. Equal to resolution width of camera.</summary>
+        public int WidthPixels { get; }
+
+        /// <summary>Height of table in pixels. Equal to resolution height of camera.</summary>
+        public int HeightPixels { get; }
+
+        /// <summary>Number of pixels having valid ray.</summary>
+        public int ValidCount { get; }
+
+        /// <summary>
+        /// Normalized ray coordinates for all pixels, row by row without gaps (<see cref="WidthPixels"/> items per row).
+        /// Rays of invalid pixels (which are outside of the range of valid calibration) are set to <see cref="Float2.Zero"/>.
+        /// </summary>
+        public ReadOnlySpan<Float2> Rays => rays;
+
+        /// <summary>
+        /// Validity bitmap: pixel with index <c>i = y * WidthPixels + x</c> is valid if bit <c>i % 64</c> of item <c>i / 64</c> is set.
+        /// </summary>
+        /// <seealso cref="IsValid(int, int)"/>
+        public ReadOnlySpan<long> ValidityBitmap => validityBitmap;
+
+        /// <summary>Is ray of a given pixel valid?</summary>
+        /// <param name="x">Horizontal pixel coordinate.</param>
+        /// <param name="y">Vertical pixel coordinate.</param>
+        /// <returns><see langword="true"/> if ray of pixel is valid.</returns>
+        /// <exception cref="ArgumentOutOfRangeException">Pixel is out of table.</exception>
+        public bool IsValid(int x, int y)
+        {
+            if ((uint)x >= (uint)WidthPixels)
+                throw new ArgumentOutOfRangeException(nameof(x));
+            if ((uint)y >= (uint)HeightPixels)
+                throw new ArgumentOutOfRangeException(nameof(y));
+            return IsValid(y * WidthPixels + x);
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        internal bool IsValid(int pixelIndex)
+            => (validityBitmap[pixelIndex / BitsPerWord] & (1L << (pixelIndex % BitsPerWord))) != 0;
+
+        /// <summary>Returns table for a given camera calibration from cache or computes it if there is no such table in cache.</summary>
+        /// <param name="cameraCalibration">Calibration of depth or color camera, for example, <see cref="Calibration.DepthCameraCalibration"/>.</param>
+        /// <returns>Table. Not <see langword="null"/>.</returns>
+        /// <exception cref="ArgumentException">
+        /// Resolution of <paramref name="cameraCalibration"/> is not positive or
+        /// lens distortion model of <paramref name="cameraCalibration"/> is not supported by <see cref="CameraModel"/>.
+        /// </exception>
+        public static CameraRayTable GetOrCreate(in CameraCalibration cameraCalibration)
+        {
+            if (cameraCalibration.ResolutionWidth <= 0 || cameraCalibration.ResolutionHeight <= 0)
+                throw new ArgumentException("Invalid camera resolution.", nameof(cameraCalibration));
+            if (!CameraModel.IsSupportedModel(cameraCalibration.Intrinsics.Model))
+                throw new ArgumentException($"Unsupported lens distortion model {cameraCalibration.Intrinsics.Model}.", nameof(cameraCalibration));
+
+            return cache.GetOrAdd(new Key(in cameraCalibration), cameraCalibration, calibration => new CameraRayTable(in calibration));
+        }
+
+        /// <summary>Removes all tables from cache. Tables are garbage collected when nobody references them, requested tables are computed again.</summary>
+        public static void ClearCache()
+            => cache.Clear();
+
+        private int Compute(CameraModel model)
+        {
+            // Bands of rows must start at the beginning of bitmap words to be processed in parallel without synchronization
+            var rowAlignment = 1;
+            while (WidthPixels * rowAlignment % BitsPerWord != 0)
+                rowAlignment *= 2;
+
+            var validCounts = RowBands.Process(WidthPixels, HeightPixels, rowAlignment, (firstRow, rowCount) => ComputeBand(model, firstRow, rowCount), out _);
+
+            var validCount = 0;
+            foreach (var count in validCounts)
+                validCount += count;
+            return validCount;
+        }
+
+        private int ComputeBand(CameraModel model, int firstRow, int rowCount)
+        {
+            var width = WidthPixels;
+            var points2D = new Float2[width];
+            var depths = new float[width];
+            var points3D = new Float3[width];
+            var validFlags = new bool[width];
+            depths.AsSpan().Fill(1f);
+
+            var validCount = 0;
+            for (var y = firstRow; y < firstRow + rowCount; y++)
+            {
+                for (var x = 0; x < width; x++)
+                    points2D[x] = new(x, y);
+                validCount += model.Unproject(points2D, depths, points3D, validFlags);
+
+                var rowOffset = y * width;
+                var rowRays = rays.AsSpan(rowOffset, width);
+                for (var x = 0; x < width; x++)
+                {
+                    rowRays[x] = new(points3D[x].X, points3D[x].Y);
+                    if (validFlags[x])
+                        validityBitmap[(rowOffset + x) / BitsPerWord] |= 1L << ((rowOffset + x) % BitsPerWord);
+                }
+            }
+
+            return validCount;
+        }
+
+        // Rays depend only on intrinsics, resolution and metric radius of camera
+        private readonly struct Key
+        {
+            private readonly CalibrationIntrinsics intrinsics;
+            private readonly int resolutionWidth;
+            private readonly int resolutionHeight;
+            private readonly float metricRadius;
+
+            public Key(in CameraCalibration cameraCalibration)
+            {
+                intrinsics = cameraCalibration.Intrinsics;
+                resolutionWidth = cameraCalibration.ResolutionWidth;
+                resolutionHeight = cameraCalibration.ResolutionHeight;
+                metricRadius = cameraCalibration.MetricRadius;
+            }
+        }
+    }
+}
+
+#endif
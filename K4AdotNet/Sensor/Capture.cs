@@ -24,6 +24,13 @@ namespace K4AdotNet.Sensor
         private readonly ChildrenDisposer children = new();                                 // to track returned Image objects
         private readonly NativeHandles.HandleWrapper<NativeHandles.CaptureHandle> handle;   // this class is an wrapper around this handle
 
+        // Cached borrowed images, used if CacheImages is on. Access is synchronized by lock on children field.
+        private bool cacheImages;
+        private Image? cachedColorImage;
+        private Image? cachedDepthImage;
+        private Image? cachedIRImage;
+        private bool cachedImagesReleased;      // set by Dispose to prevent caching of new images until handle is disposed
+
         /// <summary>Creates an empty capture object.</summary>
         /// <exception cref="InvalidOperationException">
         /// Sensor SDK fails to create empty capture object for some reason. For details see logs.
@@ -33,20 +40,12 @@ namespace K4AdotNet.Sensor
             var res = NativeApi.CaptureCreate(out var handle);
             if (res != NativeCallResults.Result.Succeeded || !handle.IsValid)
                 throw new InvalidOperationException("Failed to create blank capture instance");
-            this.handle = handle;
-            this.handle.Disposed += Handle_Disposed;
-        }
-
-        private void Handle_Disposed(object? sender, EventArgs e)
-        {
-            handle.Disposed -= Handle_Disposed;
-            Disposed?.Invoke(this, EventArgs.Empty);
+            this.handle = NativeHandles.HandleWrapper<NativeHandles.CaptureHandle>.Create(handle, this, Sdk.FinalizerFreeMode);
         }
 
         private Capture(NativeHandles.CaptureHandle handle)
         {
-            this.handle = handle;
-            this.handle.Disposed += Handle_Disposed;
+            this.handle = NativeHandles.HandleWrapper<NativeHandles.CaptureHandle>.Create(handle, this, Sdk.FinalizerFreeMode);
         }
 
         internal static Capture? Create(NativeHandles.CaptureHandle handle)
@@ -66,6 +65,14 @@ namespace K4AdotNet.Sensor
         /// <seealso cref="DuplicateReference"/>
         public void Dispose()
         {
+            lock (children)
+            {
+                cachedImagesReleased = true;
+                ReleaseCachedImage(ref cachedColorImage);
+                ReleaseCachedImage(ref cachedDepthImage);
+                ReleaseCachedImage(ref cachedIRImage);
+            }
+
             children.Dispose();
             handle.Dispose();
         }
@@ -76,7 +83,11 @@ namespace K4AdotNet.Sensor
 
         /// <summary>Raised on object disposing (only once).</summary>
         /// <seealso cref="Dispose"/>
-        public event EventHandler? Disposed;
+        public event EventHandler? Disposed
+        {
+            add => handle.Disposed += value;
+            remove => handle.Disposed -= value;
+        }
 
         /// <summary>Creates new reference to the same unmanaged capture object.</summary>
         /// <returns>New object that references exactly to the same underlying unmanaged object as original one. Not <see langword="null"/>.</returns>
@@ -106,12 +117,27 @@ namespace K4AdotNet.Sensor
         /// </para><para>
         /// The capture will add a reference on any <see cref="Image"/> that is added to it with this setter.
         /// If an existing image is being replaced, the previous image will have the reference released.
+        /// </para><para>
+        /// If <see cref="CacheImages"/> is on, the same borrowed <see cref="Image"/> object is returned on each call (see <see cref="CacheImages"/> for details).
         /// </para></remarks>
         /// <exception cref="ObjectDisposedException">This property cannot be called for disposed objects.</exception>
         public Image? ColorImage
         {
-            get => children.Register(Image.Create(NativeApi.CaptureGetColorImage(handle.ValueNotDisposed)));
-            set => NativeApi.CaptureSetColorImage(handle.ValueNotDisposed, Image.ToHandle(value));
+            get
+            {
+                if (cacheImages)
+                    return GetCachedImage(ref cachedColorImage, ImageSlot.Color);
+                return children.Register(Image.Create(NativeApi.CaptureGetColorImage(handle.ValueNotDisposed)));
+            }
+
+            set
+            {
+                NativeApi.CaptureSetColorImage(handle.ValueNotDisposed, Image.ToHandle(value));
+                lock (children)
+                {
+                    ReleaseCachedImage(ref cachedColorImage);
+                }
+            }
         }
 
         /// <summary>Get and set the depth map associated with the given capture. Can be <see langword="null"/> if the capture doesn't have depth data.</summary>
@@ -134,12 +160,27 @@ namespace K4AdotNet.Sensor
         /// </para><para>
         /// The capture will add a reference on any <see cref="Image"/> that is added to it with this setter.
         /// If an existing image is being replaced, the previous image will have the reference released.
+        /// </para><para>
+        /// If <see cref="CacheImages"/> is on, the same borrowed <see cref="Image"/> object is returned on each call (see <see cref="CacheImages"/> for details).
         /// </para></remarks>
         /// <exception cref="ObjectDisposedException">This property cannot be called for disposed objects.</exception>
         public Image? DepthImage
         {
-            get => children.Register(Image.Create(NativeApi.CaptureGetDepthImage(handle.ValueNotDisposed)));
-            set => NativeApi.CaptureSetDepthImage(handle.ValueNotDisposed, Image.ToHandle(value));
+            get
+            {
+                if (cacheImages)
+                    return GetCachedImage(ref cachedDepthImage, ImageSlot.Depth);
+                return children.Register(Image.Create(NativeApi.CaptureGetDepthImage(handle.ValueNotDisposed)));
+            }
+
+            set
+            {
+                NativeApi.CaptureSetDepthImage(handle.ValueNotDisposed, Image.ToHandle(value));
+                lock (children)
+                {
+                    ReleaseCachedImage(ref cachedDepthImage);
+                }
+            }
         }
 
         /// <summary>Get and set the IR (infrared) image associated with the given capture. Can be <see langword="null"/> if the capture doesn't have IR data.</summary>
@@ -162,12 +203,86 @@ namespace K4AdotNet.Sensor
         /// </para><para>
         /// The capture will add a reference on any <see cref="Image"/> that is added to it with this setter.
         /// If an existing image is being replaced, the previous image will have the reference released.
+        /// </para><para>
+        /// If <see cref="CacheImages"/> is on, the same borrowed <see cref="Image"/> object is returned on each call (see <see cref="CacheImages"/> for details).
         /// </para></remarks>
         /// <exception cref="ObjectDisposedException">This property cannot be called for disposed objects.</exception>
         public Image? IRImage
         {
-            get => children.Register(Image.Create(NativeApi.CaptureGetIRImage(handle.ValueNotDisposed)));
-            set => NativeApi.CaptureSetIRImage(handle.ValueNotDisposed, Image.ToHandle(value));
+            get
+            {
+                if (cacheImages)
+                    return GetCachedImage(ref cachedIRImage, ImageSlot.IR);
+                return children.Register(Image.Create(NativeApi.CaptureGetIRImage(handle.ValueNotDisposed)));
+            }
+
+            set
+            {
+                NativeApi.CaptureSetIRImage(handle.ValueNotDisposed, Image.ToHandle(value));
+                lock (children)
+                {
+                    ReleaseCachedImage(ref cachedIRImage);
+                }
+            }
+        }
+
+        /// <summary>Turns on/off caching of <see cref="Image"/> objects returned by <see cref="ColorImage"/>, <see cref="DepthImage"/> and <see cref="IRImage"/> properties.</summary>
+        /// <remarks><para>
+        /// By default (<see langword="false"/>), each read of image property creates new <see cref="Image"/> object which is owned by caller.
+        /// </para><para>
+        /// If <see langword="true"/>, capture creates one <see cref="Image"/> object per image type on the first read and returns it on subsequent reads.
+        /// Such images are borrowed (see <see cref="Image.IsBorrowed"/>): they are owned by capture, and <see cref="Image.Dispose"/> does nothing for them,
+        /// so that the typical <c>using (var image = capture.DepthImage) { ... }</c> pattern still works.
+        /// Borrowed image is disposed when capture is disposed or when image of the same type is replaced via property setter of this object.
+        /// Changes made via other <see cref="Capture"/> objects referencing the same capture (see <see cref="DuplicateReference"/>) are not tracked.
+        /// </para><para>
+        /// Use <see cref="Image.DuplicateReference"/> to keep image for longer life time than life time of <see cref="Capture"/> object.
+        /// </para><para>
+        /// This mode eliminates managed allocations if image properties are read several times per frame.
+        /// </para></remarks>
+        /// <seealso cref="Image.IsBorrowed"/>
+        public bool CacheImages
+        {
+            get => cacheImages;
+            set => cacheImages = value;
+        }
+
+        private enum ImageSlot
+        {
+            Color,
+            Depth,
+            IR,
+        }
+
+        private Image? GetCachedImage(ref Image? cachedImage, ImageSlot slot)
+        {
+            lock (children)
+            {
+                if (cachedImage != null && !cachedImage.IsDisposed)
+                    return cachedImage;
+
+                // Capture is being disposed: new image would never be released
+                if (cachedImagesReleased)
+                    throw new ObjectDisposedException(nameof(Capture));
+
+                var captureHandle = handle.ValueNotDisposed;
+                var imageHandle = slot switch
+                {
+                    ImageSlot.Color => NativeApi.CaptureGetColorImage(captureHandle),
+                    ImageSlot.Depth => NativeApi.CaptureGetDepthImage(captureHandle),
+                    ImageSlot.IR => NativeApi.CaptureGetIRImage(captureHandle),
+                    _ => throw new ArgumentOutOfRangeException(nameof(slot)),
+                };
+
+                cachedImage = Image.CreateBorrowed(imageHandle);
+                return cachedImage;
+            }
+        }
+
+        private static void ReleaseCachedImage(ref Image? cachedImage)
+        {
+            cachedImage?.DisposeBorrowed();
+            cachedImage = null;
         }
 
         /// <summary>Get and set the temperature associated with the capture, in Celsius.</summary>
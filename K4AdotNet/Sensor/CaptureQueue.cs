@@ -0,0 +1,200 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using System.Threading;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>Queue of captures between producer (device or playback reading loop) and consumer (tracker, recorder, UI) bounded by <see cref="MemoryBudget"/>.</summary>
+    /// <remarks><para>
+    /// Without such bound, captures pile up in memory when consumer falls behind.
+    /// When <see cref="Budget"/> is exceeded, new capture is handled according to <see cref="Policy"/>:
+    /// producer is blocked, or the oldest captures in queue are dropped, or new capture is rejected.
+    /// </para><para>
+    /// Queue owns captures it contains: dropped captures and captures left in queue on disposing are disposed by queue.
+    /// Implementation is thread safe.
+    /// </para></remarks>
+    /// <seealso cref="MemoryBudget"/>
+    /// <seealso cref="MemoryBudgetPolicy"/>
+    public sealed class CaptureQueue : IDisposablePlus
+    {
+        private readonly Queue<Capture> captures = new();       // also used as sync object for consumers
+        private readonly Func<bool> canEnqueue;
+        private volatile int count;
+        private volatile bool isDisposed;
+        private long droppedCount;
+        private long rejectedCount;
+
+        /// <summary>Creates queue bounded by specified budget.</summary>
+        /// <param name="budget">Memory budget. Not <see langword="null"/>. Usually, it is also set as <see cref="Sdk.CustomMemoryAllocator"/>.</param>
+        /// <param name="policy">What to do with new capture when budget is exceeded.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="budget"/> is <see langword="null"/>.</exception>
+        public CaptureQueue(MemoryBudget budget, MemoryBudgetPolicy policy)
+        {
+            Budget = budget ?? throw new ArgumentNullException(nameof(budget));
+            Policy = policy;
+            canEnqueue = () => isDisposed || count == 0 || !Budget.IsOverBudget;
+        }
+
+        /// <summary>Disposes all captures in queue. Blocked producers and consumers get <see cref="ObjectDisposedException"/>.</summary>
+        public void Dispose()
+        {
+            lock (captures)
+            {
+                if (isDisposed)
+                    return;
+                isDisposed = true;
+                while (captures.Count > 0)
+                    captures.Dequeue().Dispose();
+                count = 0;
+                Monitor.PulseAll(captures);
+            }
+
+            Budget.Notify();
+            Disposed?.Invoke(this, EventArgs.Empty);
+        }
+
+        /// <summary>Gets a value indicating whether the object has been disposed of.</summary>
+        public bool IsDisposed => isDisposed;
+
+        /// <summary>Raised on object disposing (only once).</summary>
+        public event EventHandler? Disposed;
+
+        /// <summary>Memory budget that bounds this queue. Not <see langword="null"/>.</summary>
+        public MemoryBudget Budget { get; }
+
+        /// <summary>What to do with new capture when <see cref="Budget"/> is exceeded.</summary>
+        public MemoryBudgetPolicy Policy { get; }
+
+        /// <summary>Number of captures in queue.</summary>
+        public int Count => count;
+
+        /// <summary>Number of captures dropped by <see cref="MemoryBudgetPolicy.DropOldest"/> policy.</summary>
+        public long DroppedCount => Interlocked.Read(ref droppedCount);
+
+        /// <summary>Number of captures rejected by <see cref="MemoryBudgetPolicy.FailFast"/> policy or because of timeout in <see cref="MemoryBudgetPolicy.Block"/> policy.</summary>
+        public long RejectedCount => Interlocked.Read(ref rejectedCount);
+
+        /// <summary>Adds capture to the end of queue according to <see cref="Policy"/>.</summary>
+        /// <param name="capture">Capture to be added. Not <see langword="null"/>. On success, queue becomes owner of this object.</param>
+        /// <param name="timeout">Maximum time to wait for budget in case of <see cref="MemoryBudgetPolicy.Block"/> policy. Ignored for other policies.</param>
+        /// <returns>
+        /// <see langword="true"/> if capture has been added,
+        /// <see langword="false"/> if capture has been rejected (caller remains owner of <paramref name="capture"/> and is responsible for its disposing).
+        /// </returns>
+        /// <remarks>
+        /// Capture is always accepted if queue is empty: otherwise, producer and consumer would be blocked forever
+        /// when budget is exceeded by a single capture or by memory held outside of queue.
+        /// </remarks>
+        /// <exception cref="ArgumentNullException"><paramref name="capture"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ObjectDisposedException">Queue is disposed.</exception>
+        public bool TryEnqueue(Capture capture, Timeout timeout = default)
+        {
+            if (capture is null)
+                throw new ArgumentNullException(nameof(capture));
+            CheckNotDisposed();
+
+            switch (Policy)
+            {
+                case MemoryBudgetPolicy.Block:
+                    if (!Budget.WaitUntil(canEnqueue, timeout))
+                    {
+                        Interlocked.Increment(ref rejectedCount);
+                        return false;
+                    }
+                    break;
+
+                case MemoryBudgetPolicy.DropOldest:
+                    while (Budget.IsOverBudget && TryDequeueNoWait(out var oldest))
+                    {
+                        oldest.Dispose();
+                        Interlocked.Increment(ref droppedCount);
+                    }
+                    break;
+
+                case MemoryBudgetPolicy.FailFast:
+                    if (count > 0 && Budget.IsOverBudget)
+                    {
+                        Interlocked.Increment(ref rejectedCount);
+                        return false;
+                    }
+                    break;
+            }
+
+            lock (captures)
+            {
+                CheckNotDisposed();
+                captures.Enqueue(capture);
+                count = captures.Count;
+                Monitor.PulseAll(captures);
+            }
+
+            return true;
+        }
+
+        /// <summary>Takes capture from the beginning of queue.</summary>
+        /// <param name="capture">Capture from queue if method returned <see langword="true"/>. Caller becomes owner of this object and must dispose it.</param>
+        /// <param name="timeout">Maximum time to wait for capture. Default value is <see cref="Timeout.NoWait"/>.</param>
+        /// <returns><see langword="true"/> if capture has been taken, <see langword="false"/> if queue is empty and timeout elapsed.</returns>
+        /// <exception cref="ObjectDisposedException">Queue is disposed.</exception>
+        public bool TryDequeue([NotNullWhen(returnValue: true)] out Capture? capture, Timeout timeout = default)
+        {
+            var stopwatch = Stopwatch.StartNew();
+
+            lock (captures)
+            {
+                while (captures.Count == 0)
+                {
+                    CheckNotDisposed();
+                    var remainingMs = timeout == Timeout.Infinite
+                        ? System.Threading.Timeout.Infinite
+                        : timeout.ValueMs - (int)stopwatch.ElapsedMilliseconds;
+                    if (timeout != Timeout.Infinite && remainingMs <= 0)
+                    {
+                        capture = null;
+                        return false;
+                    }
+                    Monitor.Wait(captures, remainingMs);
+                }
+
+                capture = captures.Dequeue();
+                count = captures.Count;
+            }
+
+            OnDequeued();
+            return true;
+        }
+
+        private bool TryDequeueNoWait([NotNullWhen(returnValue: true)] out Capture? capture)
+        {
+            lock (captures)
+            {
+                if (captures.Count == 0)
+                {
+                    capture = null;
+                    return false;
+                }
+
+                capture = captures.Dequeue();
+                count = captures.Count;
+            }
+
+            OnDequeued();
+            return true;
+        }
+
+        // Empty queue unblocks producer (see TryEnqueue)
+        private void OnDequeued()
+        {
+            if (count == 0)
+                Budget.Notify();
+        }
+
+        private void CheckNotDisposed()
+        {
+            if (isDisposed)
+                throw new ObjectDisposedException(nameof(CaptureQueue));
+        }
+    }
+}
@@ -0,0 +1,70 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+using System.Runtime.InteropServices;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>Point of colored point cloud: 3D position and color of point.</summary>
+    /// <remarks>Size of structure is 16 bytes: position occupies the first 12 bytes and is followed by color in BGRA format.</remarks>
+    /// <seealso cref="ManagedTransformation"/>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct ColoredPoint : IEquatable<ColoredPoint>
+    {
+        /// <summary>Position of point.</summary>
+        public Float3 Position;
+
+        /// <summary>Color of point. Zero (transparent black) if point is not seen by color camera.</summary>
+        public BgraPixel Color;
+
+        /// <summary>Constructs point with given position and color.</summary>
+        /// <param name="position">Position of point.</param>
+        /// <param name="color">Color of point.</param>
+        public ColoredPoint(Float3 position, BgraPixel color)
+        {
+            Position = position;
+            Color = color;
+        }
+
+        /// <summary>Per-component comparison.</summary>
+        /// <param name="other">Other point to be compared to this one.</param>
+        /// <returns><see langword="true"/> if positions and colors are equal.</returns>
+        public bool Equals(ColoredPoint other)
+            => Position.Equals(other.Position) && Color.Equals(other.Color);
+
+        /// <summary>Overloads <see cref="Object.Equals(object)"/> to be consistent with <see cref="Equals(ColoredPoint)"/>.</summary>
+        /// <param name="obj">Object to be compared with this point.</param>
+        /// <returns><see langword="true"/> if <paramref name="obj"/> is a <see cref="ColoredPoint"/> and is equal to this one.</returns>
+        /// <seealso cref="Equals(ColoredPoint)"/>
+        public override bool Equals(object? obj)
+            => obj is ColoredPoint point && Equals(point);
+
+        /// <summary>To be consistent with <see cref="Equals(ColoredPoint)"/>.</summary>
+        /// <param name="left">Left part of operator.</param>
+        /// <param name="right">Right part of operator.</param>
+        /// <returns><see langword="true"/> if <paramref name="left"/> is equal to <paramref name="right"/>.</returns>
+        /// <seealso cref="Equals(ColoredPoint)"/>
+        public static bool operator ==(ColoredPoint left, ColoredPoint right)
+            => left.Equals(right);
+
+        /// <summary>To be consistent with <see cref="Equals(ColoredPoint)"/>.</summary>
+        /// <param name="left">Left part of operator.</param>
+        /// <param name="right">Right part of operator.</param>
+        /// <returns><see langword="true"/> if <paramref name="left"/> is not equal to <paramref name="right"/>.</returns>
+        /// <seealso cref="Equals(ColoredPoint)"/>
+        public static bool operator !=(ColoredPoint left, ColoredPoint right)
+            => !left.Equals(right);
+
+        /// <summary>Calculates hash code.</summary>
+        /// <returns>Hash code. Consistent with overridden equality.</returns>
+        public override int GetHashCode()
+            => Position.GetHashCode() ^ Color.GetHashCode();
+
+        /// <summary>Formats point as position followed by color.</summary>
+        /// <returns>String representation of point.</returns>
+        public override string ToString()
+            => $"{Position} {Color}";
+    }
+}
+
+#endif
@@ -17,7 +17,8 @@ namespace K4AdotNet.Sensor
     /// </para></remarks>
     /// <seealso cref="Capture"/>
     /// <seealso cref="ImuSample"/>
-    public sealed class Device : IDisposablePlus
+    /// <seealso cref="ICaptureSource"/>
+    public sealed class Device : IDisposablePlus, ICaptureSource
     {
         private readonly NativeHandles.HandleWrapper<NativeHandles.DeviceHandle> handle;    // This class is an wrapper around this native handle
 
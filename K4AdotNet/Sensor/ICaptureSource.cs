@@ -0,0 +1,55 @@
+﻿using System;
+using System.Diagnostics.CodeAnalysis;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>Source of captures and IMU samples: common surface of real <see cref="Device"/> and <see cref="SyntheticDevice"/>.</summary>
+    /// <remarks>
+    /// Write processing pipelines against this interface to be able to run them without hardware,
+    /// for example, to load-test pipeline with several <see cref="SyntheticDevice"/> objects on build machine.
+    /// Semantic of all members is the same as of corresponding members of <see cref="Device"/> class.
+    /// </remarks>
+    /// <seealso cref="Device"/>
+    /// <seealso cref="SyntheticDevice"/>
+    public interface ICaptureSource : IDisposable
+    {
+        /// <summary>Gets a value indicating whether the object has been disposed of.</summary>
+        bool IsDisposed { get; }
+
+        /// <summary>Raised on object disposing (only once).</summary>
+        event EventHandler? Disposed;
+
+        /// <summary>Device serial number. Not <see langword="null"/>.</summary>
+        string SerialNumber { get; }
+
+        /// <summary>Is device still connected?</summary>
+        bool IsConnected { get; }
+
+        /// <inheritdoc cref="Device.StartCameras(DeviceConfiguration)"/>
+        void StartCameras(DeviceConfiguration config);
+
+        /// <inheritdoc cref="Device.StopCameras"/>
+        void StopCameras();
+
+        /// <inheritdoc cref="Device.StartImu"/>
+        void StartImu();
+
+        /// <inheritdoc cref="Device.StopImu"/>
+        void StopImu();
+
+        /// <inheritdoc cref="Device.TryGetCapture(out Capture, Timeout)"/>
+        bool TryGetCapture([NotNullWhen(returnValue: true)] out Capture? capture, Timeout timeout = default);
+
+        /// <inheritdoc cref="Device.GetCapture"/>
+        Capture GetCapture();
+
+        /// <inheritdoc cref="Device.TryGetImuSample(out ImuSample, Timeout)"/>
+        bool TryGetImuSample(out ImuSample imuSample, Timeout timeout = default);
+
+        /// <inheritdoc cref="Device.GetImuSample"/>
+        ImuSample GetImuSample();
+
+        /// <inheritdoc cref="Device.GetCalibration(DepthMode, ColorResolution, out Calibration)"/>
+        void GetCalibration(DepthMode depthMode, ColorResolution colorResolution, out Calibration calibration);
+    }
+}
@@ -16,15 +16,55 @@ namespace K4AdotNet.Sensor
     {
         private readonly NativeHandles.HandleWrapper<NativeHandles.ImageHandle> handle;     // This class is an wrapper around this handle
 
+        // Immutable metadata of image: cached to avoid native calls on every property access
+        private readonly IntPtr buffer;
+        private readonly int sizeBytes;
+        private readonly ImageFormat format;
+        private readonly int widthPixels;
+        private readonly int heightPixels;
+        private readonly int strideBytes;
+
+        // Borrowed images are owned by capture: Dispose() does nothing for them (see Capture.CacheImages)
+        private bool isBorrowed;
+
         private Image(NativeHandles.ImageHandle handle)
         {
-            this.handle = handle;
-            this.handle.Disposed += Handle_Disposed;
+            this.handle = NativeHandles.HandleWrapper<NativeHandles.ImageHandle>.Create(handle, this, Sdk.FinalizerFreeMode);
+
+            buffer = NativeApi.ImageGetBuffer(handle);
+            sizeBytes = Helpers.UIntPtrToInt32(NativeApi.ImageGetSize(handle));
+            format = NativeApi.ImageGetFormat(handle);
+            widthPixels = NativeApi.ImageGetWidthPixels(handle);
+            heightPixels = NativeApi.ImageGetHeightPixels(handle);
+            strideBytes = NativeApi.ImageGetStrideBytes(handle);
+
+#if !ORBBECSDK_K4A_WRAPPER
+            // Buffers allocated by Sensor SDK itself (device and playback captures) get known format only here
+            if (Sdk.CustomMemoryAllocator is MemoryBudget budget)
+                budget.Attribute(buffer, format);
+#endif
+        }
+
+        // For new references to the same unmanaged image: metadata can be copied from source object
+        private Image(NativeHandles.ImageHandle handle, Image source)
+        {
+            this.handle = NativeHandles.HandleWrapper<NativeHandles.ImageHandle>.Create(handle, this, Sdk.FinalizerFreeMode);
+
+            buffer = source.buffer;
+            sizeBytes = source.sizeBytes;
+            format = source.format;
+            widthPixels = source.widthPixels;
+            heightPixels = source.heightPixels;
+            strideBytes = source.strideBytes;
         }
 
         internal static Image? Create(NativeHandles.ImageHandle handle)
             => handle.IsValid ? new(handle) : null;
 
+        // Creates image object which is owned by some other object (capture) and cannot be disposed by client code
+        internal static Image? CreateBorrowed(NativeHandles.ImageHandle handle)
+            => handle.IsValid ? new(handle) { isBorrowed = true } : null;
+
         /// <summary>Creates new image with specified format and size in pixels.</summary>
         /// <param name="format">Format of image. Must be format with known stride: <see cref="ImageFormats.StrideBytes(ImageFormat, int)"/>.</param>
         /// <param name="widthPixels">Width of image in pixels. Must be positive.</param>
@@ -60,6 +100,10 @@ namespace K4AdotNet.Sensor
         /// <paramref name="strideBytes"/> is equal to zero. In this case size of image in bytes must be specified to create image.
         /// </exception>
         public Image(ImageFormat format, int widthPixels, int heightPixels, int strideBytes)
+            : this(CreateImageHandle(format, widthPixels, heightPixels, strideBytes))
+        { }
+
+        private static NativeHandles.ImageHandle CreateImageHandle(ImageFormat format, int widthPixels, int heightPixels, int strideBytes)
         {
             if (widthPixels <= 0)
                 throw new ArgumentOutOfRangeException(nameof(widthPixels));
@@ -76,8 +120,7 @@ namespace K4AdotNet.Sensor
             if (res != NativeCallResults.Result.Succeeded || !handle.IsValid)
                 throw new ArgumentException($"Cannot create image with format {format}, size {widthPixels}x{heightPixels} pixels and stride {strideBytes} bytes.");
 
-            this.handle = handle;
-            this.handle.Disposed += Handle_Disposed;
+            return handle;
         }
 
         /// <summary>Creates new image with specified format, size in pixels and stride in bytes.</summary>
@@ -96,6 +139,70 @@ namespace K4AdotNet.Sensor
         /// or <paramref name="sizeBytes"/> is less than zero or <paramref name="sizeBytes"/> is less than size calculated from <paramref name="heightPixels"/> and <paramref name="strideBytes"/>.
         /// </exception>
         public Image(ImageFormat format, int widthPixels, int heightPixels, int strideBytes, int sizeBytes)
+            : this(format, widthPixels, heightPixels, strideBytes, sizeBytes, memoryAllocator: null)
+        { }
+
+        /// <summary>Creates new image with specified format, size in pixels and stride in bytes using specified memory allocator for image buffer.</summary>
+        /// <param name="format">Format of image.</param>
+        /// <param name="widthPixels">Width of image in pixels. Must be positive.</param>
+        /// <param name="heightPixels">Height of image in pixels. Must be positive.</param>
+        /// <param name="strideBytes">Image stride in bytes (the number of bytes per horizontal line of the image). Must be non-negative. Zero value can be used for <see cref="ImageFormat.ColorMjpg"/> and <see cref="ImageFormat.Custom"/>.</param>
+        /// <param name="sizeBytes">Size of image buffer in size. Non negative. Cannot be less than size calculated from image parameters.</param>
+        /// <param name="memoryAllocator">
+        /// Allocator to be used for image buffer, for example, <see cref="PooledMemoryAllocator"/>.
+        /// Buffer will be returned to this allocator on image release.
+        /// <see langword="null"/> means <see cref="Sdk.CustomMemoryAllocator"/> or <see cref="HGlobalMemoryAllocator"/> if not set.
+        /// </param>
+        /// <remarks>
+        /// Allocator is used directly and independently of <see cref="Sdk.CustomMemoryAllocator"/>, that is, it is not required to register it globally.
+        /// All instances of <see cref="ICustomMemoryAllocator"/> passed to this constructor will be keeping alive forever.
+        /// </remarks>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="widthPixels"/> or <paramref name="heightPixels"/> is equal to or less than zero
+        /// or <paramref name="strideBytes"/> is less than zero or <paramref name="strideBytes"/> is too small for specified <paramref name="format"/>
+        /// or <paramref name="sizeBytes"/> is less than zero or <paramref name="sizeBytes"/> is less than size calculated from <paramref name="heightPixels"/> and <paramref name="strideBytes"/>.
+        /// </exception>
+        public Image(ImageFormat format, int widthPixels, int heightPixels, int strideBytes, int sizeBytes, ICustomMemoryAllocator? memoryAllocator)
+            : this(CreateImageHandle(format, widthPixels, heightPixels, strideBytes, sizeBytes, memoryAllocator))
+        { }
+
+        /// <summary>Creates new image with stride padded to multiple of <paramref name="strideAlignmentBytes"/> using specified memory allocator for image buffer.</summary>
+        /// <param name="format">Format of image. Must be format with known stride: <see cref="ImageFormats.StrideBytes(ImageFormat, int)"/>.</param>
+        /// <param name="widthPixels">Width of image in pixels. Must be positive.</param>
+        /// <param name="heightPixels">Height of image in pixels. Must be positive.</param>
+        /// <param name="memoryAllocator">
+        /// Allocator to be used for image buffer. To have every row aligned, allocator must return buffers aligned at least to <paramref name="strideAlignmentBytes"/>,
+        /// for example, <see cref="AlignedMemoryAllocator"/>.
+        /// <see langword="null"/> means <see cref="Sdk.CustomMemoryAllocator"/> or <see cref="HGlobalMemoryAllocator"/> if not set.
+        /// </param>
+        /// <param name="strideAlignmentBytes">Alignment of rows in bytes. Must be a power of two. See <see cref="ImageFormats.StrideBytes(ImageFormat, int, int)"/>.</param>
+        /// <remarks>
+        /// Padding bytes at the end of rows are not initialized and are not a part of image data,
+        /// thus <see cref="StrideBytes"/> must be taken into account on access to image buffer.
+        /// </remarks>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="widthPixels"/> or <paramref name="heightPixels"/> is equal to or less than zero
+        /// or <paramref name="strideAlignmentBytes"/> is not a positive power of two.
+        /// </exception>
+        /// <exception cref="ArgumentException">
+        /// Image stride in bytes cannot be automatically calculated from <paramref name="widthPixels"/> for specified <paramref name="format"/>.
+        /// </exception>
+        /// <seealso cref="AlignedMemoryAllocator"/>
+        public Image(ImageFormat format, int widthPixels, int heightPixels, ICustomMemoryAllocator? memoryAllocator, int strideAlignmentBytes)
+            : this(CreateImageHandle(format, widthPixels, heightPixels, memoryAllocator, strideAlignmentBytes))
+        { }
+
+        private static NativeHandles.ImageHandle CreateImageHandle(ImageFormat format, int widthPixels, int heightPixels,
+            ICustomMemoryAllocator? memoryAllocator, int strideAlignmentBytes)
+        {
+            if (heightPixels <= 0)
+                throw new ArgumentOutOfRangeException(nameof(heightPixels));
+            var strideBytes = format.StrideBytes(widthPixels, strideAlignmentBytes);
+            return CreateImageHandle(format, widthPixels, heightPixels, strideBytes, format.ImageSizeBytes(strideBytes, heightPixels), memoryAllocator);
+        }
+
+        private static NativeHandles.ImageHandle CreateImageHandle(ImageFormat format, int widthPixels, int heightPixels, int strideBytes, int sizeBytes,
+            ICustomMemoryAllocator? memoryAllocator)
         {
             if (widthPixels <= 0)
                 throw new ArgumentOutOfRangeException(nameof(widthPixels));
@@ -115,28 +222,35 @@ namespace K4AdotNet.Sensor
             // For this reason, trying to use "standard" image creation, if possible.
             if (strideBytes == 0 && sizeBytes % heightPixels == 0)
                 strideBytes = sizeBytes / heightPixels;
-            if (strideBytes > 0 && strideBytes * heightPixels == sizeBytes)
+            if (memoryAllocator is null && strideBytes > 0 && strideBytes * heightPixels == sizeBytes)
             {
                 var result = NativeApi.ImageCreate(format, widthPixels, heightPixels, strideBytes, out var imageHandle);
                 if (result == NativeCallResults.Result.Succeeded && !imageHandle.IsValid)
-                {
-                    this.handle = imageHandle;
-                    this.handle.Disposed += Handle_Disposed;
-                    return;
-                }
+                    return imageHandle;
             }
 #endif
 
-            // Gets current memory allocator
-            Sdk.GetCustomMemoryAllocator(out var memoryAllocator, out var memoryDestroyCallback);
-            // If not set, use HGlobal
-            if (memoryAllocator is null || memoryDestroyCallback is null)
+            NativeApi.MemoryDestroyCallback? memoryDestroyCallback;
+            if (memoryAllocator is null)
             {
-                memoryAllocator = HGlobalMemoryAllocator.Instance;
-                memoryDestroyCallback = HGlobalMemoryAllocator.MemoryDestroyCallback;
+                // Gets current memory allocator
+                Sdk.GetCustomMemoryAllocator(out memoryAllocator, out memoryDestroyCallback);
+                // If not set, use HGlobal
+                if (memoryAllocator is null || memoryDestroyCallback is null)
+                {
+                    memoryAllocator = HGlobalMemoryAllocator.Instance;
+                    memoryDestroyCallback = HGlobalMemoryAllocator.MemoryDestroyCallback;
+                }
+            }
+            else
+            {
+                memoryDestroyCallback = Sdk.GetMemoryDestroyCallback(memoryAllocator);
             }
 
-            var buffer = memoryAllocator.Allocate(sizeBytes, out var memoryContext);
+            IntPtr memoryContext;
+            var buffer = memoryAllocator is MemoryBudget budget
+                ? budget.Allocate(sizeBytes, format, out memoryContext)
+                : memoryAllocator.Allocate(sizeBytes, out memoryContext);
             if (buffer == IntPtr.Zero)
                 throw new OutOfMemoryException($"Cannot allocate buffer of {sizeBytes} bytes.");
 
@@ -145,10 +259,12 @@ namespace K4AdotNet.Sensor
                 memoryDestroyCallback, memoryContext,
                 out var handle);
             if (res != NativeCallResults.Result.Succeeded || !handle.IsValid)
+            {
+                memoryAllocator.Free(buffer, memoryContext);
                 throw new ArgumentException($"Cannot create image with format {format}, size {widthPixels}x{heightPixels} pixels, stride {strideBytes} bytes from buffer of size {sizeBytes} bytes.");
+            }
 
-            this.handle = handle;
-            this.handle.Disposed += Handle_Disposed;
+            return handle;
         }
 
         /// <summary>Creates new image for specified underlying buffer with specified format and size in pixels.</summary>
@@ -318,12 +434,6 @@ namespace K4AdotNet.Sensor
 
 #endif
 
-                private void Handle_Disposed(object? sender, EventArgs e)
-        {
-            handle.Disposed -= Handle_Disposed;
-            Disposed?.Invoke(this, EventArgs.Empty);
-        }
-
         /// <summary>
         /// Call this method to free unmanaged resources associated with current instance.
         /// </summary>
@@ -332,20 +442,42 @@ namespace K4AdotNet.Sensor
         /// (Multiple objects of <see cref="Image"/> can reference one and the same image. For details see <see cref="DuplicateReference"/>.)
         /// </para><para>
         /// Can be called multiple times but event <see cref="Disposed"/> will be raised only once.
+        /// </para><para>
+        /// Does nothing for borrowed images (see <see cref="IsBorrowed"/>).
         /// </para></remarks>
         /// <seealso cref="Disposed"/>
         /// <seealso cref="IsDisposed"/>
         /// <seealso cref="DuplicateReference"/>
         public void Dispose()
+        {
+            if (!isBorrowed)
+                handle.Dispose();
+        }
+
+        // Disposes borrowed image. Must be called by owner only.
+        internal void DisposeBorrowed()
             => handle.Dispose();
 
+        /// <summary>Is this image object borrowed from <see cref="Capture"/>?</summary>
+        /// <remarks>
+        /// Borrowed images are returned by <see cref="Capture"/> if <see cref="Capture.CacheImages"/> is turned on.
+        /// Lifetime of such images is controlled by capture, and <see cref="Dispose"/> does nothing for them.
+        /// Use <see cref="DuplicateReference"/> to get owned reference to the same image.
+        /// </remarks>
+        /// <seealso cref="Capture.CacheImages"/>
+        public bool IsBorrowed => isBorrowed;
+
         /// <summary>Gets a value indicating whether the image has been disposed of.</summary>
         /// <seealso cref="Dispose"/>
         public bool IsDisposed => handle.IsDisposed;
 
         /// <summary>Raised on object disposing (only once).</summary>
         /// <seealso cref="Dispose"/>
-        public event EventHandler? Disposed;
+        public event EventHandler? Disposed
+        {
+            add => handle.Disposed += value;
+            remove => handle.Disposed -= value;
+        }
 
         /// <summary>Creates new reference to the same unmanaged image object.</summary>
         /// <returns>New object that references exactly to the same underlying unmanaged object as original one. Not <see langword="null"/>.</returns>
@@ -353,12 +485,19 @@ namespace K4AdotNet.Sensor
         /// <exception cref="ObjectDisposedException">This method cannot be called for disposed objects.</exception>
         /// <seealso cref="Dispose"/>
         public Image DuplicateReference()
-            => new(handle.ValueNotDisposed.DuplicateReference());
+            => new(handle.ValueNotDisposed.DuplicateReference(), this);
 
         /// <summary>Get the image buffer.</summary>
         /// <remarks>Use this buffer to access the raw image data.</remarks>
         /// <exception cref="ObjectDisposedException">This property cannot be called for disposed objects.</exception>
-        public IntPtr Buffer => NativeApi.ImageGetBuffer(handle.ValueNotDisposed);
+        public IntPtr Buffer
+        {
+            get
+            {
+                handle.CheckNotDisposed();
+                return buffer;
+            }
+        }
 
 #if !(NETSTANDARD2_0 || NET461)
 
@@ -368,29 +507,113 @@ namespace K4AdotNet.Sensor
         public unsafe Span<T> GetSpan<T>() where T : unmanaged
             => new(Buffer.ToPointer(), SizeBytes / Marshal.SizeOf<T>());
 
+        /// <summary>Stride-aware typed view of image pixels. Data is not copied.</summary>
+        /// <typeparam name="TPixel">
+        /// Type of pixel. Must correspond to <see cref="Format"/>:
+        /// <see cref="byte"/> for <see cref="ImageFormat.Custom8"/> and for luminance plane of <see cref="ImageFormat.ColorNV12"/>,
+        /// <see cref="ushort"/> or <see cref="short"/> for <see cref="ImageFormat.Depth16"/>, <see cref="ImageFormat.IR16"/>, <see cref="ImageFormat.Custom16"/> and <see cref="ImageFormat.ColorYUY2"/>,
+        /// <see cref="BgraPixel"/>, <see cref="uint"/> or <see cref="int"/> for <see cref="ImageFormat.ColorBgra32"/>,
+        /// any type fitting into stride for <see cref="ImageFormat.Custom"/>.
+        /// </typeparam>
+        /// <returns>View of image pixels. Valid only until this object is disposed.</returns>
+        /// <exception cref="InvalidOperationException"><typeparamref name="TPixel"/> is not compatible with <see cref="Format"/> of image.</exception>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed objects.</exception>
+        public ImageView<TPixel> GetView<TPixel>() where TPixel : unmanaged
+        {
+            CheckPixelType<TPixel>();
+            return new(buffer, widthPixels, heightPixels, strideBytes);
+        }
+
+        /// <summary>Stride-aware typed read-only view of image pixels. Data is not copied.</summary>
+        /// <typeparam name="TPixel">Type of pixel. Must correspond to <see cref="Format"/> (see <see cref="GetView{TPixel}"/> for details).</typeparam>
+        /// <returns>Read-only view of image pixels. Valid only until this object is disposed.</returns>
+        /// <exception cref="InvalidOperationException"><typeparamref name="TPixel"/> is not compatible with <see cref="Format"/> of image.</exception>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed objects.</exception>
+        public ReadOnlyImageView<TPixel> GetReadOnlyView<TPixel>() where TPixel : unmanaged
+        {
+            CheckPixelType<TPixel>();
+            return new(buffer, widthPixels, heightPixels, strideBytes);
+        }
+
+        private unsafe void CheckPixelType<TPixel>() where TPixel : unmanaged
+        {
+            handle.CheckNotDisposed();
+
+            var compatible = format switch
+            {
+                ImageFormat.Custom8 or ImageFormat.ColorNV12
+                    => typeof(TPixel) == typeof(byte),
+                ImageFormat.Depth16 or ImageFormat.IR16 or ImageFormat.Custom16 or ImageFormat.ColorYUY2
+                    => typeof(TPixel) == typeof(ushort) || typeof(TPixel) == typeof(short),
+                ImageFormat.ColorBgra32
+                    => typeof(TPixel) == typeof(BgraPixel) || typeof(TPixel) == typeof(uint) || typeof(TPixel) == typeof(int),
+                ImageFormat.Custom
+                    => widthPixels * sizeof(TPixel) <= strideBytes,
+                _ => false,
+            };
+
+            if (!compatible)
+                throw new InvalidOperationException($"Pixel type {typeof(TPixel).Name} is not compatible with {format} format of image.");
+        }
+
 #endif
 
         /// <summary>Get the image buffer size in bytes.</summary>
         /// <remarks>Use this function to know what the size of the image buffer is returned by <see cref="Buffer"/>.</remarks>
         /// <exception cref="ObjectDisposedException">This property cannot be called for disposed objects.</exception>
-        public int SizeBytes => Helpers.UIntPtrToInt32(NativeApi.ImageGetSize(handle.ValueNotDisposed));
+        public int SizeBytes
+        {
+            get
+            {
+                handle.CheckNotDisposed();
+                return sizeBytes;
+            }
+        }
 
         /// <summary>Get the format of the image.</summary>
         /// <exception cref="ObjectDisposedException">This property cannot be called for disposed objects.</exception>
-        public ImageFormat Format => NativeApi.ImageGetFormat(handle.ValueNotDisposed);
+        public ImageFormat Format
+        {
+            get
+            {
+                handle.CheckNotDisposed();
+                return format;
+            }
+        }
 
         /// <summary>Get the image width in pixels.</summary>
         /// <exception cref="ObjectDisposedException">This property cannot be called for disposed objects.</exception>
-        public int WidthPixels => NativeApi.ImageGetWidthPixels(handle.ValueNotDisposed);
+        public int WidthPixels
+        {
+            get
+            {
+                handle.CheckNotDisposed();
+                return widthPixels;
+            }
+        }
 
         /// <summary>Get the image height in pixels.</summary>
         /// <exception cref="ObjectDisposedException">This property cannot be called for disposed objects.</exception>
-        public int HeightPixels => NativeApi.ImageGetHeightPixels(handle.ValueNotDisposed);
+        public int HeightPixels
+        {
+            get
+            {
+                handle.CheckNotDisposed();
+                return heightPixels;
+            }
+        }
 
         /// <summary>Get the image stride in bytes (the number of bytes per horizontal line of the image).</summary>
         /// <remarks>Can be zero for compressed formats with unknown stride like MJPEG.</remarks>
         /// <exception cref="ObjectDisposedException">This property cannot be called for disposed objects.</exception>
-        public int StrideBytes => NativeApi.ImageGetStrideBytes(handle.ValueNotDisposed);
+        public int StrideBytes
+        {
+            get
+            {
+                handle.CheckNotDisposed();
+                return strideBytes;
+            }
+        }
 
         /// <summary>Deprecated in version 1.2 of Sensor SDK. Please use <see cref="DeviceTimestamp"/> property instead of this one.</summary>
         [Obsolete("Deprecated in version 1.2 of Sensor SDK. Please use DeviceTimestamp property instead of this one.")]
@@ -626,6 +849,201 @@ namespace K4AdotNet.Sensor
             Marshal.Copy(src, 0, Buffer, size);
         }
 
+#if !(NETSTANDARD2_0 || NET461)
+
+        /// <summary>Copies image data to <paramref name="dst"/> row by row with repacking of rows to the specified stride.</summary>
+        /// <typeparam name="T">Type of elements of destination memory.</typeparam>
+        /// <param name="dst">Destination memory. Must be long enough to hold all rows of image with <paramref name="dstStrideBytes"/> stride.</param>
+        /// <param name="dstStrideBytes">Stride of destination in bytes. Zero means tightly packed rows. Cannot be less than length of row in bytes.</param>
+        /// <remarks><para>
+        /// Only meaningful part of each row is copied (for example, <c>4 * WidthPixels</c> bytes for <see cref="ImageFormat.ColorBgra32"/>), padding at the end of rows is skipped.
+        /// Both planes of <see cref="ImageFormat.ColorNV12"/> images are copied. Images without stride (like <see cref="ImageFormat.ColorMjpg"/>) are copied as one row of <see cref="SizeBytes"/> bytes.
+        /// </para><para>
+        /// Big images are copied by several threads in parallel.
+        /// </para></remarks>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="dstStrideBytes"/> is negative or less than length of row in bytes
+        /// or <paramref name="dst"/> is too small.
+        /// </exception>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed objects.</exception>
+        public unsafe void CopyTo<T>(Span<T> dst, int dstStrideBytes) where T : unmanaged
+        {
+            GetRowLayout(out var srcStrideBytes, out var rowBytes, out var rowCount);
+            CheckStrideAndSize(ref dstStrideBytes, nameof(dstStrideBytes), (long)dst.Length * sizeof(T), nameof(dst) + "." + nameof(dst.Length), rowBytes, rowCount);
+
+            fixed (T* dstPtr = dst)
+                ImageRowCopier.CopyRows(buffer, srcStrideBytes, new IntPtr(dstPtr), dstStrideBytes, rowBytes, rowCount);
+        }
+
+        /// <summary>Fills image data from <paramref name="src"/> row by row with repacking of rows from the specified stride.</summary>
+        /// <typeparam name="T">Type of elements of source memory.</typeparam>
+        /// <param name="src">Source memory. Must be long enough to hold all rows of image with <paramref name="srcStrideBytes"/> stride.</param>
+        /// <param name="srcStrideBytes">Stride of source in bytes. Zero means tightly packed rows. Cannot be less than length of row in bytes.</param>
+        /// <remarks>
+        /// Only meaningful part of each row of image is written, padding at the end of rows is not touched.
+        /// For details see <see cref="CopyTo{T}(Span{T}, int)"/>.
+        /// </remarks>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="srcStrideBytes"/> is negative or less than length of row in bytes
+        /// or <paramref name="src"/> is too small.
+        /// </exception>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed objects.</exception>
+        public unsafe void FillFrom<T>(ReadOnlySpan<T> src, int srcStrideBytes) where T : unmanaged
+        {
+            GetRowLayout(out var dstStrideBytes, out var rowBytes, out var rowCount);
+            CheckStrideAndSize(ref srcStrideBytes, nameof(srcStrideBytes), (long)src.Length * sizeof(T), nameof(src) + "." + nameof(src.Length), rowBytes, rowCount);
+
+            fixed (T* srcPtr = src)
+                ImageRowCopier.CopyRows(new IntPtr(srcPtr), srcStrideBytes, buffer, dstStrideBytes, rowBytes, rowCount);
+        }
+
+        /// <summary>Copies image data to another image of the same format and size. Strides of images can differ.</summary>
+        /// <param name="dst">Destination image. Cannot be <see langword="null"/>. Must have the same <see cref="Format"/>, <see cref="WidthPixels"/> and <see cref="HeightPixels"/>.</param>
+        /// <remarks>
+        /// Metadata (timestamps, exposure, etc.) is not copied. For details of copying see <see cref="CopyTo{T}(Span{T}, int)"/>.
+        /// </remarks>
+        /// <exception cref="ArgumentNullException"><paramref name="dst"/> cannot be <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentException"><paramref name="dst"/> has another format or size, or its buffer is too small.</exception>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed objects. And <paramref name="dst"/> cannot be disposed.</exception>
+        public void CopyTo(Image dst)
+        {
+            if (dst is null)
+                throw new ArgumentNullException(nameof(dst));
+            GetRowLayout(out var srcStrideBytes, out var rowBytes, out var rowCount);
+            dst.handle.CheckNotDisposed();
+            if (dst.format != format || dst.widthPixels != widthPixels || dst.heightPixels != heightPixels)
+                throw new ArgumentException("Destination image must have the same format and size in pixels.", nameof(dst));
+            if (dst.buffer == buffer)
+                return;
+
+            var dstStrideBytes = dst.strideBytes > 0 ? dst.strideBytes : rowBytes;
+            if (dstStrideBytes < rowBytes || ImageRowCopier.GetRequiredBytes(dstStrideBytes, rowBytes, rowCount) > dst.sizeBytes)
+                throw new ArgumentException("Destination image buffer is too small.", nameof(dst));
+
+            ImageRowCopier.CopyRows(buffer, srcStrideBytes, dst.buffer, dstStrideBytes, rowBytes, rowCount);
+        }
+
+        /// <summary>Copies rectangular region of image to <paramref name="dst"/> memory.</summary>
+        /// <typeparam name="T">Type of elements of destination memory.</typeparam>
+        /// <param name="x">Horizontal position of the left column of region in pixels.</param>
+        /// <param name="y">Vertical position of the top row of region in pixels.</param>
+        /// <param name="widthPixels">Width of region in pixels.</param>
+        /// <param name="heightPixels">Height of region in pixels.</param>
+        /// <param name="dst">Destination memory. Must be long enough to hold all rows of region with <paramref name="dstStrideBytes"/> stride.</param>
+        /// <param name="dstStrideBytes">Stride of destination in bytes. Zero means tightly packed rows. Cannot be less than length of region row in bytes.</param>
+        /// <remarks>Supported only for formats with known number of bytes per pixel (see <see cref="ImageFormats.HasKnownBytesPerPixel(ImageFormat)"/>).</remarks>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// Region is out of image bounds
+        /// or <paramref name="dstStrideBytes"/> is negative or less than length of region row in bytes
+        /// or <paramref name="dst"/> is too small.
+        /// </exception>
+        /// <exception cref="InvalidOperationException">Number of bytes per pixel is unknown for <see cref="Format"/> of image.</exception>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed objects.</exception>
+        public unsafe void CopyRegionTo<T>(int x, int y, int widthPixels, int heightPixels, Span<T> dst, int dstStrideBytes) where T : unmanaged
+        {
+            var regionPtr = GetRegionPointer(x, y, widthPixels, heightPixels, out var rowBytes);
+            CheckStrideAndSize(ref dstStrideBytes, nameof(dstStrideBytes), (long)dst.Length * sizeof(T), nameof(dst) + "." + nameof(dst.Length), rowBytes, heightPixels);
+
+            fixed (T* dstPtr = dst)
+                ImageRowCopier.CopyRows(regionPtr, strideBytes, new IntPtr(dstPtr), dstStrideBytes, rowBytes, heightPixels);
+        }
+
+        /// <summary>Copies rectangular region of image to the specified position of another image of the same format.</summary>
+        /// <param name="x">Horizontal position of the left column of region in pixels.</param>
+        /// <param name="y">Vertical position of the top row of region in pixels.</param>
+        /// <param name="widthPixels">Width of region in pixels.</param>
+        /// <param name="heightPixels">Height of region in pixels.</param>
+        /// <param name="dst">Destination image. Cannot be <see langword="null"/>. Must have the same <see cref="Format"/>.</param>
+        /// <param name="dstX">Horizontal position of the left column of region in destination image.</param>
+        /// <param name="dstY">Vertical position of the top row of region in destination image.</param>
+        /// <remarks>
+        /// Supported only for formats with known number of bytes per pixel (see <see cref="ImageFormats.HasKnownBytesPerPixel(ImageFormat)"/>).
+        /// If <paramref name="dst"/> references to the same image buffer, source and destination regions must not overlap.
+        /// </remarks>
+        /// <exception cref="ArgumentNullException"><paramref name="dst"/> cannot be <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentException"><paramref name="dst"/> has another format.</exception>
+        /// <exception cref="ArgumentOutOfRangeException">Region is out of bounds of this image or of <paramref name="dst"/> image.</exception>
+        /// <exception cref="InvalidOperationException">Number of bytes per pixel is unknown for <see cref="Format"/> of image.</exception>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed objects. And <paramref name="dst"/> cannot be disposed.</exception>
+        public void CopyRegionTo(int x, int y, int widthPixels, int heightPixels, Image dst, int dstX, int dstY)
+        {
+            if (dst is null)
+                throw new ArgumentNullException(nameof(dst));
+            var regionPtr = GetRegionPointer(x, y, widthPixels, heightPixels, out var rowBytes);
+            dst.handle.CheckNotDisposed();
+            if (dst.format != format)
+                throw new ArgumentException("Destination image must have the same format.", nameof(dst));
+            if (dstX < 0 || dstX > dst.widthPixels - widthPixels)
+                throw new ArgumentOutOfRangeException(nameof(dstX));
+            if (dstY < 0 || dstY > dst.heightPixels - heightPixels)
+                throw new ArgumentOutOfRangeException(nameof(dstY));
+
+            var dstRegionPtr = dst.buffer + dstY * dst.strideBytes + dstX * format.BytesPerPixel();
+            ImageRowCopier.CopyRows(regionPtr, strideBytes, dstRegionPtr, dst.strideBytes, rowBytes, heightPixels);
+        }
+
+        // Stride of buffer, length of meaningful part of row and number of rows (including chroma plane for NV12)
+        private void GetRowLayout(out int bufferStrideBytes, out int rowBytes, out int rowCount)
+        {
+            handle.CheckNotDisposed();
+
+            if (format.HasKnownBytesPerPixel())
+            {
+                bufferStrideBytes = strideBytes;
+                rowBytes = widthPixels * format.BytesPerPixel();
+                rowCount = heightPixels;
+            }
+            else if (format == ImageFormat.ColorNV12 && strideBytes > 0)
+            {
+                bufferStrideBytes = strideBytes;
+                rowBytes = widthPixels;
+                rowCount = heightPixels + heightPixels / 2;
+            }
+            else if (strideBytes > 0)
+            {
+                bufferStrideBytes = strideBytes;
+                rowBytes = strideBytes;
+                rowCount = Math.Min(heightPixels, sizeBytes / strideBytes);
+            }
+            else
+            {
+                // No stride: whole buffer as one row
+                bufferStrideBytes = rowBytes = sizeBytes;
+                rowCount = 1;
+            }
+        }
+
+        private static void CheckStrideAndSize(ref int strideBytes, string strideParamName, long sizeBytes, string sizeParamName, int rowBytes, int rowCount)
+        {
+            if (strideBytes == 0)
+                strideBytes = rowBytes;
+            if (strideBytes < rowBytes)
+                throw new ArgumentOutOfRangeException(strideParamName);
+            if (sizeBytes < ImageRowCopier.GetRequiredBytes(strideBytes, rowBytes, rowCount))
+                throw new ArgumentOutOfRangeException(sizeParamName);
+        }
+
+        private IntPtr GetRegionPointer(int x, int y, int widthPixels, int heightPixels, out int rowBytes)
+        {
+            handle.CheckNotDisposed();
+            if (!format.HasKnownBytesPerPixel())
+                throw new InvalidOperationException($"Cannot copy region of image of {format} format: number of bytes per pixel is unknown.");
+            if (x < 0 || x > this.widthPixels)
+                throw new ArgumentOutOfRangeException(nameof(x));
+            if (y < 0 || y > this.heightPixels)
+                throw new ArgumentOutOfRangeException(nameof(y));
+            if (widthPixels < 0 || widthPixels > this.widthPixels - x)
+                throw new ArgumentOutOfRangeException(nameof(widthPixels));
+            if (heightPixels < 0 || heightPixels > this.heightPixels - y)
+                throw new ArgumentOutOfRangeException(nameof(heightPixels));
+
+            var bytesPerPixel = format.BytesPerPixel();
+            rowBytes = widthPixels * bytesPerPixel;
+            return buffer + y * strideBytes + x * bytesPerPixel;
+        }
+
+#endif
+
         /// <summary>Extracts handle from <paramref name="image"/>.</summary>
         /// <param name="image">Managed object. Can be <see langword="null"/>.</param>
         /// <returns>Appropriate unmanaged handle. Can be <see cref="IntPtr.Zero"/>.</returns>
@@ -645,11 +1063,11 @@ namespace K4AdotNet.Sensor
                 return true;
             if (handle.Equals(image.handle))
                 return true;
-            return image.Buffer == Buffer
-                && image.SizeBytes == SizeBytes
-                && image.Format == Format
-                && image.WidthPixels == WidthPixels
-                && image.HeightPixels == HeightPixels;
+            return image.buffer == buffer
+                && image.sizeBytes == sizeBytes
+                && image.format == format
+                && image.widthPixels == widthPixels
+                && image.heightPixels == heightPixels;
         }
 
         /// <summary>Two images are equal when they reference to one and the same unmanaged object.</summary>
@@ -662,7 +1080,7 @@ namespace K4AdotNet.Sensor
         /// <returns>Hash code. Consistent with overridden equality.</returns>
         /// <seealso cref="Equals(Image)"/>
         public override int GetHashCode()
-            => Buffer.GetHashCode();
+            => buffer.GetHashCode();
 
         /// <summary>To be consistent with <see cref="Equals(Image)"/>.</summary>
         /// <param name="left">Left part of operator. Can be <see langword="null"/>.</param>
@@ -683,7 +1101,7 @@ namespace K4AdotNet.Sensor
         /// <summary>Convenient (for debugging needs, first of all) string representation of object as an address of unmanaged object in memory.</summary>
         /// <returns><c>{Width}x{Height}@{Format}#{Address}</c></returns>
         public override string ToString()
-            => $"{WidthPixels}x{HeightPixels}@{Format}#{Buffer:X}";
+            => $"{widthPixels}x{heightPixels}@{format}#{buffer:X}";
 
 #endregion
 
@@ -89,6 +89,24 @@ namespace K4AdotNet.Sensor
             }
         }
 
+        /// <summary>Calculates image stride from image <paramref name="widthPixels"/> padded to multiple of <paramref name="alignmentBytes"/>.</summary>
+        /// <param name="imageFormat">Format of image. Must have predefined formula for stride based on image width (see <see cref="StrideBytes(ImageFormat, int)"/>).</param>
+        /// <param name="widthPixels">Width of image in pixels. Non-negative.</param>
+        /// <param name="alignmentBytes">Required alignment of rows in bytes. Must be a power of two.</param>
+        /// <returns>The smallest multiple of <paramref name="alignmentBytes"/> that is not less than default stride.</returns>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="widthPixels"/> cannot be less than zero,
+        /// or <paramref name="alignmentBytes"/> is not a positive power of two.
+        /// </exception>
+        /// <exception cref="ArgumentException">Cannot determine image stride in bytes from <paramref name="widthPixels"/> for specified <paramref name="imageFormat"/>.</exception>
+        /// <seealso cref="AlignedMemoryAllocator"/>
+        public static int StrideBytes(this ImageFormat imageFormat, int widthPixels, int alignmentBytes)
+        {
+            if (!AlignedMemoryAllocator.IsPowerOfTwo(alignmentBytes))
+                throw new ArgumentOutOfRangeException(nameof(alignmentBytes));
+            return checked(imageFormat.StrideBytes(widthPixels) + alignmentBytes - 1) & ~(alignmentBytes - 1);
+        }
+
         /// <summary>Calculate image data size in bytes.</summary>
         /// <param name="imageFormat">Image format. Any format can be used if <paramref name="strideBytes"/> is not null.</param>
         /// <param name="strideBytes">Image stride in bytes. Must be positive number. Cannot be zero.</param>
@@ -0,0 +1,72 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+using System.Threading.Tasks;
+
+namespace K4AdotNet.Sensor
+{
+    // Copying of rectangular block of rows between two buffers with different strides.
+    // Rows are copied via Span.CopyTo, that is a vectorized memmove.
+    // Big blocks are split into horizontal bands that are copied in parallel.
+    internal static class ImageRowCopier
+    {
+        // Copying of smaller blocks is not worth to be parallelized
+        public const int ParallelThresholdBytes = 4 * 1024 * 1024;
+
+        // Minimum amount of data per one parallel band
+        private const int MinBandBytes = 1024 * 1024;
+
+        public static unsafe void CopyRows(IntPtr src, int srcStrideBytes, IntPtr dst, int dstStrideBytes, int rowBytes, int rowCount)
+        {
+            if (rowBytes <= 0 || rowCount <= 0)
+                return;
+
+            var totalBytes = (long)rowBytes * rowCount;
+            var bandCount = totalBytes >= ParallelThresholdBytes
+                ? (int)Math.Min(Environment.ProcessorCount, totalBytes / MinBandBytes)
+                : 1;
+
+            if (bandCount <= 1)
+            {
+                CopyBand(src, srcStrideBytes, dst, dstStrideBytes, rowBytes, 0, rowCount);
+                return;
+            }
+
+            var rowsPerBand = (rowCount + bandCount - 1) / bandCount;
+            Parallel.For(0, bandCount, band =>
+            {
+                var firstRow = band * rowsPerBand;
+                var bandRows = Math.Min(rowsPerBand, rowCount - firstRow);
+                if (bandRows > 0)
+                    CopyBand(src, srcStrideBytes, dst, dstStrideBytes, rowBytes, firstRow, bandRows);
+            });
+        }
+
+        private static unsafe void CopyBand(IntPtr src, int srcStrideBytes, IntPtr dst, int dstStrideBytes, int rowBytes, int firstRow, int rowCount)
+        {
+            var srcPtr = (byte*)src.ToPointer() + (long)firstRow * srcStrideBytes;
+            var dstPtr = (byte*)dst.ToPointer() + (long)firstRow * dstStrideBytes;
+
+            // Both buffers are tightly packed: the whole band is one continuous block
+            if (srcStrideBytes == rowBytes && dstStrideBytes == rowBytes)
+            {
+                var blockBytes = (long)rowBytes * rowCount;
+                Buffer.MemoryCopy(srcPtr, dstPtr, blockBytes, blockBytes);
+                return;
+            }
+
+            for (var y = 0; y < rowCount; y++)
+            {
+                new ReadOnlySpan<byte>(srcPtr, rowBytes).CopyTo(new Span<byte>(dstPtr, rowBytes));
+                srcPtr += srcStrideBytes;
+                dstPtr += dstStrideBytes;
+            }
+        }
+
+        // Size of memory block required for specified rows
+        public static long GetRequiredBytes(int strideBytes, int rowBytes, int rowCount)
+            => rowCount > 0 ? (long)(rowCount - 1) * strideBytes + rowBytes : 0;
+    }
+}
+
+#endif
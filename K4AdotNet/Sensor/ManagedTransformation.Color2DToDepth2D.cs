@@ -0,0 +1,221 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+
+namespace K4AdotNet.Sensor
+{
+    // Batch search of depth pixels corresponding to color pixels
+    partial class ManagedTransformation
+    {
+        /// <summary>Transforms 2D pixel coordinates of color camera into 2D pixel coordinates of depth camera.</summary>
+        /// <param name="sourcePoints2D">The 2D pixels in color camera coordinates.</param>
+        /// <param name="depthImage">Input depth map. Not <see langword="null"/>. Must have resolution of depth camera.</param>
+        /// <param name="targetPoints2D">
+        /// Output: the 2D pixels in depth camera coordinates. Cannot be shorter than <paramref name="sourcePoints2D"/>.
+        /// Invalid points are set to zeros.
+        /// </param>
+        /// <param name="validFlags">
+        /// Output: for each point whether its corresponding depth pixel has been found. Cannot be shorter than <paramref name="sourcePoints2D"/>.
+        /// </param>
+        /// <returns>Number of valid points.</returns>
+        /// <remarks>
+        /// See <see cref="ConvertColor2DToDepth2D(ReadOnlySpan{Float2}, ReadOnlyImageView{short}, Span{Float2}, Span{bool})"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentNullException"><paramref name="depthImage"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="depthImage"/> has invalid format or resolution,
+        /// or <paramref name="targetPoints2D"/> or <paramref name="validFlags"/> is shorter than <paramref name="sourcePoints2D"/>.
+        /// </exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="depthImage"/> is disposed.</exception>
+        public int ConvertColor2DToDepth2D(ReadOnlySpan<Float2> sourcePoints2D, Image depthImage, Span<Float2> targetPoints2D, Span<bool> validFlags)
+        {
+            CheckImageParameter(nameof(depthImage), depthImage, ImageFormat.Depth16, calibration.DepthCameraCalibration);
+            return ConvertColor2DToDepth2D(sourcePoints2D, depthImage.GetReadOnlyView<short>(), targetPoints2D, validFlags);
+        }
+
+        /// <summary>Transforms 2D pixel coordinates of color camera into 2D pixel coordinates of depth camera.</summary>
+        /// <param name="sourcePoints2D">The 2D pixels in color camera coordinates.</param>
+        /// <param name="depthMap">Input depth map in millimeters (unsigned 16-bit values). Must have resolution of depth camera.</param>
+        /// <param name="targetPoints2D">
+        /// Output: the 2D pixels in depth camera coordinates. Cannot be shorter than <paramref name="sourcePoints2D"/>.
+        /// Invalid points are set to zeros.
+        /// </param>
+        /// <param name="validFlags">
+        /// Output: for each point whether its corresponding depth pixel has been found. Cannot be shorter than <paramref name="sourcePoints2D"/>.
+        /// </param>
+        /// <returns>Number of valid points.</returns>
+        /// <remarks><para>
+        /// Batch managed version of <see cref="Calibration.ConvertColor2DToDepth2D(Float2, Image)"/> with the same search as in Sensor SDK.
+        /// Color pixel is unprojected to depths of 50 mm and 14 m, these two 3D points are projected to depth camera with undistorted pinhole model
+        /// (nominal field-of-view of depth mode, principal point in the center of depth map). Epipolar line between these points is walked
+        /// with a step of one pixel along its major axis. Each step is distorted to depth map, depth pixel under it (rounded coordinates) is reprojected
+        /// to color camera. Result is the step in depth map coordinates whose reprojection is the closest to the color pixel,
+        /// it is valid if this distance is not greater than 10 pixels.
+        /// </para><para>
+        /// Camera models and extrinsics are prepared once per transformation object, arguments are validated once per call,
+        /// points are processed in parallel on all CPU cores.
+        /// </para></remarks>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="depthMap"/> has invalid resolution,
+        /// or <paramref name="targetPoints2D"/> or <paramref name="validFlags"/> is shorter than <paramref name="sourcePoints2D"/>.
+        /// </exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        public unsafe int ConvertColor2DToDepth2D(ReadOnlySpan<Float2> sourcePoints2D, ReadOnlyImageView<short> depthMap, Span<Float2> targetPoints2D, Span<bool> validFlags)
+        {
+            var depthRays = CheckDepthRays();
+            var colorModel = CheckColorModel();
+            CheckViewSize(nameof(depthMap), depthMap.WidthPixels, depthMap.HeightPixels, depthRays.WidthPixels, depthRays.HeightPixels);
+            if (targetPoints2D.Length < sourcePoints2D.Length)
+                throw new ArgumentException($"{nameof(targetPoints2D)} cannot be shorter than {nameof(sourcePoints2D)}.", nameof(targetPoints2D));
+            if (validFlags.Length < sourcePoints2D.Length)
+                throw new ArgumentException($"{nameof(validFlags)} cannot be shorter than {nameof(sourcePoints2D)}.", nameof(validFlags));
+
+            // Passive IR mode has wide field-of-view in Sensor SDK
+            (calibration.DepthMode.IsWideView() ? DepthMode.WideViewUnbinned : DepthMode.NarrowViewUnbinned)
+                .GetNominalFov(out var horizontalFovDegrees, out var verticalFovDegrees);
+            var search = new EpipolarSearch(depthMap.Buffer, depthMap.StrideBytes, depthRays.WidthPixels, depthRays.HeightPixels,
+                horizontalFovDegrees, verticalFovDegrees,
+                colorModel.CameraCalibration.ResolutionWidth, colorModel.CameraCalibration.ResolutionHeight);
+
+            fixed (Float2* sourcePtr = sourcePoints2D)
+            fixed (Float2* targetPtr = targetPoints2D)
+            fixed (bool* validPtr = validFlags)
+            {
+                var sourceBuffer = new IntPtr(sourcePtr);
+                var targetBuffer = new IntPtr(targetPtr);
+                var validBuffer = new IntPtr(validPtr);
+
+                // Search for one point costs about as much as processing of one row of depth map
+                var validCounts = RowBands.Process(depthRays.WidthPixels, sourcePoints2D.Length, rowAlignment: 1, (first, count) =>
+                {
+                    var validCount = 0;
+                    for (var i = first; i < first + count; i++)
+                    {
+                        var isValid = TryConvertColor2DToDepth2D(((Float2*)sourceBuffer)[i], in search, out var targetPoint);
+                        ((Float2*)targetBuffer)[i] = isValid ? targetPoint : default;
+                        ((bool*)validBuffer)[i] = isValid;
+                        if (isValid)
+                            validCount++;
+                    }
+
+                    return validCount;
+                }, out _);
+
+                var totalCount = 0;
+                foreach (var count in validCounts)
+                    totalCount += count;
+                return totalCount;
+            }
+        }
+
+        // Port of transformation_color_2d_to_depth_2d() from Sensor SDK
+        private unsafe bool TryConvertColor2DToDepth2D(Float2 colorPoint, in EpipolarSearch search, out Float2 depthPoint)
+        {
+            depthPoint = default;
+            var depthModel = this.depthModel!;
+            var colorModel = this.colorModel!;
+            if (!colorModel.TryUnproject(colorPoint, out var colorRay))
+                return false;
+
+            var start = search.ProjectPinhole(colorToDepth.Transform(PointOnRay(colorRay, MinSearchDepthMm)));
+            var stop = search.ProjectPinhole(colorToDepth.Transform(PointOnRay(colorRay, MaxSearchDepthMm)));
+            if (stop.X == start.X)
+                return false;       // Sensor SDK fails the whole call in this case
+
+            // One pixel along the major axis. Sensor SDK computes X from Y on steps along Y axis, this bug is not reproduced here.
+            var slope = (stop.Y - start.Y) / (stop.X - start.X);
+            var isXMajor = MathF.Abs(slope) < 1f;
+            var step = isXMajor ? new Float2(1f, slope) : new Float2(1f / slope, 1f);
+            if (isXMajor ? stop.X < start.X : stop.Y < start.Y)
+                step = new Float2(-step.X, -step.Y);
+
+            var bestError = float.MaxValue;
+            for (var p = start; IsBetween(p.X, start.X, stop.X) && IsBetween(p.Y, start.Y, stop.Y); p = new(p.X + step.X, p.Y + step.Y))
+            {
+                var ray = new Float2((p.X - search.Px) / search.Fx, (p.Y - search.Py) / search.Fy);
+                if (!depthModel.TryProject(PointOnRay(ray, 1f), out var depthPixel) || !IsWithinImage(depthPixel, search.Width, search.Height))
+                    continue;
+
+                // Rounding can give the pixel right after the last one in row or column: Sensor SDK reads the next row there, here it is clamped
+                var x = Math.Min((int)MathF.Floor(depthPixel.X + 0.5f), search.Width - 1);
+                var y = Math.Min((int)MathF.Floor(depthPixel.Y + 0.5f), search.Height - 1);
+                var depth = *(ushort*)((byte*)search.DepthBuffer.ToPointer() + (nint)y * search.DepthStrideBytes + x * sizeof(ushort));
+                if (depth == 0)
+                    continue;
+
+                // Unprojection of depthPixel gives back the ray, Sensor SDK recomputes it iteratively
+                var pointInColor = depthToColor.Transform(PointOnRay(ray, depth));
+                if (!colorModel.TryProject(pointInColor, out var projection) || !IsWithinImage(projection, search.ColorWidth, search.ColorHeight))
+                    continue;
+
+                var error = Square(projection.X - colorPoint.X) + Square(projection.Y - colorPoint.Y);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    depthPoint = depthPixel;
+                }
+            }
+
+            if (bestError > MaxReprojectionError * MaxReprojectionError)
+            {
+                depthPoint = default;
+                return false;
+            }
+
+            return true;
+        }
+
+        private static Float3 PointOnRay(Float2 ray, float depth)
+            => new(ray.X * depth, ray.Y * depth, depth);
+
+        private static bool IsBetween(float value, float bound1, float bound2)
+            => bound1 <= bound2 ? value >= bound1 && value <= bound2 : value >= bound2 && value <= bound1;
+
+        // Unlike IsInsideImage(), pixel centers are not shifted here (as in Sensor SDK)
+        private static bool IsWithinImage(Float2 point, int width, int height)
+            => point.X >= 0f && point.X < width && point.Y >= 0f && point.Y < height;
+
+        private static float Square(float value)
+            => value * value;
+
+        // Range of depths and acceptance threshold of Sensor SDK
+        private const float MinSearchDepthMm = 50f;
+        private const float MaxSearchDepthMm = 14000f;
+        private const float MaxReprojectionError = 10f;
+
+        // Parameters of search shared by all points of batch
+        private readonly struct EpipolarSearch
+        {
+            public readonly IntPtr DepthBuffer;
+            public readonly int DepthStrideBytes;
+            public readonly int Width;
+            public readonly int Height;
+            public readonly int ColorWidth;
+            public readonly int ColorHeight;
+            // Undistorted pinhole model of depth camera in which epipolar line is walked
+            public readonly float Px, Py, Fx, Fy;
+
+            public EpipolarSearch(IntPtr depthBuffer, int depthStrideBytes, int width, int height,
+                float horizontalFovDegrees, float verticalFovDegrees, int colorWidth, int colorHeight)
+            {
+                DepthBuffer = depthBuffer;
+                DepthStrideBytes = depthStrideBytes;
+                Width = width;
+                Height = height;
+                ColorWidth = colorWidth;
+                ColorHeight = colorHeight;
+                const float radiansPerDegree = 3.14159265f / 180f;
+                Px = 0.5f * width;
+                Py = 0.5f * height;
+                Fx = 0.5f / MathF.Tan(0.5f * horizontalFovDegrees * radiansPerDegree) * width;
+                Fy = 0.5f / MathF.Tan(0.5f * verticalFovDegrees * radiansPerDegree) * height;
+            }
+
+            public Float2 ProjectPinhole(Float3 point)
+                => new(point.X / point.Z * Fx + Px, point.Y / point.Z * Fy + Py);
+        }
+    }
+}
+
+#endif
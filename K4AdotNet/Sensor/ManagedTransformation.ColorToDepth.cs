@@ -0,0 +1,413 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace K4AdotNet.Sensor
+{
+    // Transformation of color images to depth camera
+    partial class ManagedTransformation
+    {
+        // Number of pixels processed at once by vectorized code
+        private const int BlockSize = 8;
+
+        /// <summary>Transforms a color image into the geometry of the depth camera.</summary>
+        /// <param name="depthImage">Input depth map. Not <see langword="null"/>. Must have resolution of depth camera.</param>
+        /// <param name="colorImage">
+        /// Input color image to be transformed. Not <see langword="null"/>. Must have resolution of color camera and one of the following formats:
+        /// <see cref="ImageFormat.ColorBgra32"/>, <see cref="ImageFormat.ColorYUY2"/> or <see cref="ImageFormat.ColorNV12"/>.
+        /// </param>
+        /// <param name="transformedColorImage">
+        /// Output color image in <see cref="ImageFormat.ColorBgra32"/> format. Not <see langword="null"/>. Must have resolution of depth camera.
+        /// </param>
+        /// <param name="interpolation">How color is sampled at projections of depth pixels.</param>
+        /// <remarks>
+        /// Managed counterpart of <see cref="Transformation.ColorImageToDepthCamera(Image, Image, Image)"/>.
+        /// See <see cref="ColorImageToDepthCamera(ReadOnlyImageView{short}, ReadOnlyImageView{BgraPixel}, ImageView{BgraPixel}, TransformationInterpolation)"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentNullException"><paramref name="depthImage"/>, <paramref name="colorImage"/> or <paramref name="transformedColorImage"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentException"><paramref name="depthImage"/>, <paramref name="colorImage"/> or <paramref name="transformedColorImage"/> has invalid format or resolution.</exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="depthImage"/>, <paramref name="colorImage"/> or <paramref name="transformedColorImage"/> is disposed.</exception>
+        public void ColorImageToDepthCamera(Image depthImage, Image colorImage, Image transformedColorImage,
+            TransformationInterpolation interpolation = TransformationInterpolation.Nearest)
+        {
+            CheckImageParameter(nameof(depthImage), depthImage, ImageFormat.Depth16, calibration.DepthCameraCalibration);
+            CheckColorImageParameter(nameof(colorImage), colorImage);
+            CheckImageParameter(nameof(transformedColorImage), transformedColorImage, ImageFormat.ColorBgra32, calibration.DepthCameraCalibration);
+
+            var depthMap = depthImage.GetReadOnlyView<short>();
+            var transformedColor = transformedColorImage.GetView<BgraPixel>();
+            switch (colorImage.Format)
+            {
+                case ImageFormat.ColorBgra32:
+                    ColorImageToDepthCamera(depthMap, colorImage.GetReadOnlyView<BgraPixel>(), transformedColor, interpolation);
+                    break;
+                case ImageFormat.ColorYUY2:
+                    ColorImageToDepthCamera(depthMap, colorImage.GetReadOnlyView<short>(), transformedColor, interpolation);
+                    break;
+                default:
+                    ColorImageToDepthCamera(depthMap, colorImage.GetReadOnlyView<byte>(), transformedColor, interpolation);
+                    break;
+            }
+        }
+
+        /// <summary>Transforms a BGRA color image into the geometry of the depth camera.</summary>
+        /// <param name="depthMap">Input depth map in millimeters (unsigned 16-bit values). Must have resolution of depth camera.</param>
+        /// <param name="colorImage">Input color image in <see cref="ImageFormat.ColorBgra32"/> format. Must have resolution of color camera.</param>
+        /// <param name="transformedColor">Output color image. Must have resolution of depth camera.</param>
+        /// <param name="interpolation">
+        /// <see cref="TransformationInterpolation.Nearest"/> to take color of the nearest pixel,
+        /// <see cref="TransformationInterpolation.Linear"/> for bilinear interpolation between four neighboring pixels.
+        /// </param>
+        /// <remarks><para>
+        /// Each depth pixel with valid depth is unprojected to 3D using cached ray table of depth camera,
+        /// transformed to color camera and projected to color image, where color is sampled.
+        /// Depth pixels without valid depth and pixels projected outside of color image get zero (transparent black) color.
+        /// </para><para>
+        /// Depth map is processed in horizontal bands on all CPU cores. Nearest sampling of BGRA images
+        /// gathers eight pixels at once using AVX2 instructions if they are supported by CPU.
+        /// </para></remarks>
+        /// <exception cref="ArgumentException"><paramref name="depthMap"/>, <paramref name="colorImage"/> or <paramref name="transformedColor"/> has invalid resolution.</exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        public void ColorImageToDepthCamera(ReadOnlyImageView<short> depthMap, ReadOnlyImageView<BgraPixel> colorImage, ImageView<BgraPixel> transformedColor,
+            TransformationInterpolation interpolation = TransformationInterpolation.Nearest)
+        {
+            CheckColorToDepthViews(depthMap, colorImage.WidthPixels, colorImage.HeightPixels, transformedColor);
+            ColorImageToDepthCamera(depthMap, new BgraSource(colorImage.Buffer, colorImage.StrideBytes), transformedColor, interpolation);
+        }
+
+        /// <summary>Transforms a YUY2 color image into the geometry of the depth camera without conversion of the whole color image to BGRA.</summary>
+        /// <param name="depthMap">Input depth map in millimeters (unsigned 16-bit values). Must have resolution of depth camera.</param>
+        /// <param name="colorImage">
+        /// Input color image in <see cref="ImageFormat.ColorYUY2"/> format: one 16-bit value per pixel (luma and one of chroma components).
+        /// Must have resolution of color camera.
+        /// </param>
+        /// <param name="transformedColor">Output color image. Must have resolution of depth camera.</param>
+        /// <param name="interpolation">How color is sampled at projections of depth pixels.</param>
+        /// <remarks>
+        /// Only sampled pixels are converted to BGRA (BT.601, limited range), interpolation is performed in YUV space.
+        /// See <see cref="ColorImageToDepthCamera(ReadOnlyImageView{short}, ReadOnlyImageView{BgraPixel}, ImageView{BgraPixel}, TransformationInterpolation)"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentException"><paramref name="depthMap"/>, <paramref name="colorImage"/> or <paramref name="transformedColor"/> has invalid resolution.</exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        public void ColorImageToDepthCamera(ReadOnlyImageView<short> depthMap, ReadOnlyImageView<short> colorImage, ImageView<BgraPixel> transformedColor,
+            TransformationInterpolation interpolation = TransformationInterpolation.Nearest)
+        {
+            CheckColorToDepthViews(depthMap, colorImage.WidthPixels, colorImage.HeightPixels, transformedColor);
+            ColorImageToDepthCamera(depthMap, new Yuy2Source(colorImage.Buffer, colorImage.StrideBytes), transformedColor, interpolation);
+        }
+
+        /// <summary>Transforms an NV12 color image into the geometry of the depth camera without conversion of the whole color image to BGRA.</summary>
+        /// <param name="depthMap">Input depth map in millimeters (unsigned 16-bit values). Must have resolution of depth camera.</param>
+        /// <param name="colorImage">
+        /// Luminance plane of input color image in <see cref="ImageFormat.ColorNV12"/> format. Must have resolution of color camera.
+        /// Chroma plane must follow luminance plane immediately and have the same stride (as in <see cref="Image"/> objects).
+        /// </param>
+        /// <param name="transformedColor">Output color image. Must have resolution of depth camera.</param>
+        /// <param name="interpolation">How color is sampled at projections of depth pixels.</param>
+        /// <remarks>
+        /// Only sampled pixels are converted to BGRA (BT.601, limited range), interpolation is performed in YUV space.
+        /// See <see cref="ColorImageToDepthCamera(ReadOnlyImageView{short}, ReadOnlyImageView{BgraPixel}, ImageView{BgraPixel}, TransformationInterpolation)"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentException"><paramref name="depthMap"/>, <paramref name="colorImage"/> or <paramref name="transformedColor"/> has invalid resolution.</exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        public void ColorImageToDepthCamera(ReadOnlyImageView<short> depthMap, ReadOnlyImageView<byte> colorImage, ImageView<BgraPixel> transformedColor,
+            TransformationInterpolation interpolation = TransformationInterpolation.Nearest)
+        {
+            CheckColorToDepthViews(depthMap, colorImage.WidthPixels, colorImage.HeightPixels, transformedColor);
+            ColorImageToDepthCamera(depthMap, new Nv12Source(colorImage.Buffer, colorImage.StrideBytes, colorImage.HeightPixels), transformedColor, interpolation);
+        }
+
+        private void CheckColorToDepthViews(ReadOnlyImageView<short> depthMap, int colorWidth, int colorHeight, ImageView<BgraPixel> transformedColor)
+        {
+            CheckDepthAndColorViews(depthMap, colorWidth, colorHeight);
+            CheckViewSize(nameof(transformedColor), transformedColor.WidthPixels, transformedColor.HeightPixels, depthRays!.WidthPixels, depthRays.HeightPixels);
+        }
+
+        private void CheckDepthAndColorViews(ReadOnlyImageView<short> depthMap, int colorWidth, int colorHeight)
+        {
+            var depthRays = CheckDepthRays();
+            var colorModel = CheckColorModel();
+            CheckViewSize(nameof(depthMap), depthMap.WidthPixels, depthMap.HeightPixels, depthRays.WidthPixels, depthRays.HeightPixels);
+            CheckViewSize("colorImage", colorWidth, colorHeight, colorModel.CameraCalibration.ResolutionWidth, colorModel.CameraCalibration.ResolutionHeight);
+        }
+
+        // Color images are accepted in BGRA, YUY2 and NV12 formats
+        private void CheckColorImageParameter(string paramName, Image paramValue)
+        {
+            if (paramValue == null)
+                throw new ArgumentNullException(paramName);
+            if (paramValue.Format != ImageFormat.ColorBgra32 && paramValue.Format != ImageFormat.ColorYUY2 && paramValue.Format != ImageFormat.ColorNV12)
+                throw new ArgumentException($"{paramName} must have {ImageFormat.ColorBgra32}, {ImageFormat.ColorYUY2} or {ImageFormat.ColorNV12} format but has {paramValue.Format}.", paramName);
+            CheckImageParameter(paramName, paramValue, paramValue.Format, calibration.ColorCameraCalibration);
+        }
+
+        private unsafe void ColorImageToDepthCamera<TSource>(ReadOnlyImageView<short> depthMap, TSource source, ImageView<BgraPixel> transformedColor,
+            TransformationInterpolation interpolation)
+            where TSource : struct, IColorSource
+        {
+            var width = depthRays!.WidthPixels;
+            var colorWidth = colorModel!.CameraCalibration.ResolutionWidth;
+            var colorHeight = colorModel.CameraCalibration.ResolutionHeight;
+            var depthBuffer = depthMap.Buffer;
+            var depthStrideBytes = depthMap.StrideBytes;
+            var outputBuffer = transformedColor.Buffer;
+            var outputStrideBytes = transformedColor.StrideBytes;
+            var linear = interpolation == TransformationInterpolation.Linear;
+
+            RowBands.Process(width, depthRays.HeightPixels, rowAlignment: 1, (firstRow, rowCount) =>
+            {
+                var points3D = new Float3[width];
+                var colorPoints = new Float2[width];
+                var validFlags = new bool[width];
+                for (var y = firstRow; y < firstRow + rowCount; y++)
+                {
+                    var depthRow = (ushort*)((byte*)depthBuffer.ToPointer() + (nint)y * depthStrideBytes);
+                    ProjectDepthRowToColor(depthRow, y, points3D, colorPoints, validFlags);
+
+                    var dst = (BgraPixel*)((byte*)outputBuffer.ToPointer() + (nint)y * outputStrideBytes);
+                    SampleColorRow(source, colorWidth, colorHeight, colorPoints, validFlags, linear, dst);
+                }
+
+                return 0;
+            }, out _);
+        }
+
+        // Samples color at projections of row of depth pixels, zero color for invalid pixels and pixels outside of color image
+        private static unsafe void SampleColorRow<TSource>(TSource source, int colorWidth, int colorHeight, Float2[] colorPoints, bool[] validFlags,
+            bool linear, BgraPixel* dst)
+            where TSource : struct, IColorSource
+        {
+            var x = 0;
+            if (!linear && typeof(TSource) == typeof(BgraSource) && Avx2.IsSupported)
+                x = GatherBgraRowAvx2(Unsafe.As<TSource, BgraSource>(ref source), colorWidth, colorHeight, colorPoints, validFlags, dst);
+            for (; x < colorPoints.Length; x++)
+            {
+                var point = colorPoints[x];
+                dst[x] = validFlags[x] && IsInsideImage(point, colorWidth, colorHeight)
+                    ? (linear ? SampleLinear(source, point, colorWidth, colorHeight) : SampleNearest(source, point))
+                    : default;
+            }
+        }
+
+        // Pixel centers have integer coordinates, thus image covers [-0.5, width - 0.5) x [-0.5, height - 0.5)
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static bool IsInsideImage(Float2 point, int width, int height)
+            => point.X >= -0.5f && point.X < width - 0.5f && point.Y >= -0.5f && point.Y < height - 0.5f;
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static BgraPixel SampleNearest<TSource>(in TSource source, Float2 point)
+            where TSource : struct, IColorSource
+            => source.GetPixel((int)MathF.Floor(point.X + 0.5f), (int)MathF.Floor(point.Y + 0.5f));
+
+        private static BgraPixel SampleLinear<TSource>(in TSource source, Float2 point, int width, int height)
+            where TSource : struct, IColorSource
+        {
+            var x = Math.Clamp(point.X, 0f, width - 1);
+            var y = Math.Clamp(point.Y, 0f, height - 1);
+            var x0 = (int)x;
+            var y0 = (int)y;
+            var x1 = Math.Min(x0 + 1, width - 1);
+            var y1 = Math.Min(y0 + 1, height - 1);
+            // Weights in 8-bit fixed point
+            var wx = (int)((x - x0) * 256f);
+            var wy = (int)((y - y0) * 256f);
+            return source.Interpolate(x0, y0, x1, y1, wx, wy);
+        }
+
+        // Nearest sampling of eight pixels at once, returns number of processed pixels of row
+        private static unsafe int GatherBgraRowAvx2(in BgraSource source, int colorWidth, int colorHeight, Float2[] colorPoints, bool[] validFlags, BgraPixel* dst)
+        {
+            var minCoord = Vector256.Create(-0.5f);
+            var maxX = Vector256.Create(colorWidth - 0.5f);
+            var maxY = Vector256.Create(colorHeight - 0.5f);
+            var half = Vector256.Create(0.5f);
+            var stride = Vector256.Create(source.StrideBytes);
+            var pixelBase = (int*)source.Buffer.ToPointer();
+
+            var x = 0;
+            fixed (Float2* pointsPtr = colorPoints)
+            fixed (bool* validPtr = validFlags)
+            {
+                for (; x + BlockSize <= colorPoints.Length; x += BlockSize)
+                {
+                    // (x0 y0 x1 y1 x2 y2 x3 y3), (x4 y4 .. x7 y7) to (x0 .. x7), (y0 .. y7)
+                    var xy0 = Avx.LoadVector256((float*)(pointsPtr + x));
+                    var xy1 = Avx.LoadVector256((float*)(pointsPtr + x + BlockSize / 2));
+                    var xs = Avx2.Permute4x64(Avx.Shuffle(xy0, xy1, 0b10_00_10_00).AsDouble(), 0b11_01_10_00).AsSingle();
+                    var ys = Avx2.Permute4x64(Avx.Shuffle(xy0, xy1, 0b11_01_11_01).AsDouble(), 0b11_01_10_00).AsSingle();
+
+                    var inside = Avx.And(
+                        Avx.And(Avx.CompareGreaterThanOrEqual(xs, minCoord), Avx.CompareLessThan(xs, maxX)),
+                        Avx.And(Avx.CompareGreaterThanOrEqual(ys, minCoord), Avx.CompareLessThan(ys, maxY)));
+                    var valid = Avx2.CompareGreaterThan(Avx2.ConvertToVector256Int32((byte*)(validPtr + x)), Vector256<int>.Zero);
+                    var mask = Avx2.And(inside.AsInt32(), valid);
+
+                    // Byte offsets of nearest pixels
+                    var xi = Avx.ConvertToVector256Int32WithTruncation(Avx.Floor(Avx.Add(xs, half)));
+                    var yi = Avx.ConvertToVector256Int32WithTruncation(Avx.Floor(Avx.Add(ys, half)));
+                    var offsets = Avx2.Add(Avx2.MultiplyLow(yi, stride), Avx2.ShiftLeftLogical(xi, 2));
+
+                    var pixels = Avx2.GatherMaskVector256(Vector256<int>.Zero, pixelBase, offsets, mask, 1);
+                    Avx.Store((int*)(dst + x), pixels);
+                }
+            }
+
+            return x;
+        }
+
+        // Source of color pixels, implemented by structures for generic specialization of sampling code
+        private interface IColorSource
+        {
+            BgraPixel GetPixel(int x, int y);
+
+            // Bilinear interpolation between pixels (x0, y0), (x1, y0), (x0, y1), (x1, y1) with weights of (x1, *) and (*, y1) in 1/256 units
+            BgraPixel Interpolate(int x0, int y0, int x1, int y1, int wx, int wy);
+        }
+
+        private readonly unsafe struct BgraSource : IColorSource
+        {
+            public readonly IntPtr Buffer;
+            public readonly int StrideBytes;
+
+            public BgraSource(IntPtr buffer, int strideBytes)
+            {
+                Buffer = buffer;
+                StrideBytes = strideBytes;
+            }
+
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            public BgraPixel GetPixel(int x, int y)
+                => ((BgraPixel*)((byte*)Buffer.ToPointer() + (nint)y * StrideBytes))[x];
+
+            public BgraPixel Interpolate(int x0, int y0, int x1, int y1, int wx, int wy)
+            {
+                var p00 = GetPixel(x0, y0);
+                var p10 = GetPixel(x1, y0);
+                var p01 = GetPixel(x0, y1);
+                var p11 = GetPixel(x1, y1);
+                return new(
+                    Lerp2D(p00.B, p10.B, p01.B, p11.B, wx, wy),
+                    Lerp2D(p00.G, p10.G, p01.G, p11.G, wx, wy),
+                    Lerp2D(p00.R, p10.R, p01.R, p11.R, wx, wy),
+                    Lerp2D(p00.A, p10.A, p01.A, p11.A, wx, wy));
+            }
+        }
+
+        // Two pixels are packed into four bytes: Y0 U Y1 V
+        private readonly unsafe struct Yuy2Source : IColorSource
+        {
+            private readonly IntPtr buffer;
+            private readonly int strideBytes;
+
+            public Yuy2Source(IntPtr buffer, int strideBytes)
+            {
+                this.buffer = buffer;
+                this.strideBytes = strideBytes;
+            }
+
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            public BgraPixel GetPixel(int x, int y)
+            {
+                GetYuv(x, y, out var luma, out var u, out var v);
+                return YuvToBgra(luma, u, v);
+            }
+
+            public BgraPixel Interpolate(int x0, int y0, int x1, int y1, int wx, int wy)
+            {
+                GetYuv(x0, y0, out var y00, out var u00, out var v00);
+                GetYuv(x1, y0, out var y10, out var u10, out var v10);
+                GetYuv(x0, y1, out var y01, out var u01, out var v01);
+                GetYuv(x1, y1, out var y11, out var u11, out var v11);
+                return YuvToBgra(
+                    Lerp2D(y00, y10, y01, y11, wx, wy),
+                    Lerp2D(u00, u10, u01, u11, wx, wy),
+                    Lerp2D(v00, v10, v01, v11, wx, wy));
+            }
+
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            private void GetYuv(int x, int y, out byte luma, out byte u, out byte v)
+            {
+                var row = (byte*)buffer.ToPointer() + (nint)y * strideBytes;
+                var pair = row + (x & ~1) * 2;
+                luma = row[x * 2];
+                u = pair[1];
+                v = pair[3];
+            }
+        }
+
+        // Luma plane is followed by plane of interleaved U V values, one pair per 2x2 block of pixels
+        private readonly unsafe struct Nv12Source : IColorSource
+        {
+            private readonly IntPtr buffer;
+            private readonly int strideBytes;
+            private readonly int heightPixels;
+
+            public Nv12Source(IntPtr buffer, int strideBytes, int heightPixels)
+            {
+                this.buffer = buffer;
+                this.strideBytes = strideBytes;
+                this.heightPixels = heightPixels;
+            }
+
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            public BgraPixel GetPixel(int x, int y)
+            {
+                GetYuv(x, y, out var luma, out var u, out var v);
+                return YuvToBgra(luma, u, v);
+            }
+
+            public BgraPixel Interpolate(int x0, int y0, int x1, int y1, int wx, int wy)
+            {
+                GetYuv(x0, y0, out var y00, out var u00, out var v00);
+                GetYuv(x1, y0, out var y10, out var u10, out var v10);
+                GetYuv(x0, y1, out var y01, out var u01, out var v01);
+                GetYuv(x1, y1, out var y11, out var u11, out var v11);
+                return YuvToBgra(
+                    Lerp2D(y00, y10, y01, y11, wx, wy),
+                    Lerp2D(u00, u10, u01, u11, wx, wy),
+                    Lerp2D(v00, v10, v01, v11, wx, wy));
+            }
+
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            private void GetYuv(int x, int y, out byte luma, out byte u, out byte v)
+            {
+                var origin = (byte*)buffer.ToPointer();
+                luma = origin[(nint)y * strideBytes + x];
+                var chroma = origin + (nint)(heightPixels + y / 2) * strideBytes + (x & ~1);
+                u = chroma[0];
+                v = chroma[1];
+            }
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static byte Lerp2D(byte v00, byte v10, byte v01, byte v11, int wx, int wy)
+        {
+            var top = v00 * (256 - wx) + v10 * wx;
+            var bottom = v01 * (256 - wx) + v11 * wx;
+            return (byte)((top * (256 - wy) + bottom * wy + (1 << 15)) >> 16);
+        }
+
+        // BT.601 limited range, integer approximation with 8-bit fraction
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static BgraPixel YuvToBgra(byte y, byte u, byte v)
+        {
+            var c = 298 * (y - 16) + 128;
+            var d = u - 128;
+            var e = v - 128;
+            return new(
+                ClampToByte((c + 516 * d) >> 8),
+                ClampToByte((c - 100 * d - 208 * e) >> 8),
+                ClampToByte((c + 409 * e) >> 8));
+        }
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static byte ClampToByte(int value)
+            => (byte)Math.Clamp(value, 0, byte.MaxValue);
+    }
+}
+
+#endif
@@ -0,0 +1,286 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+
+namespace K4AdotNet.Sensor
+{
+    // Fused generation of colored point clouds
+    partial class ManagedTransformation
+    {
+        private const float MillimetersToMeters = 0.001f;
+
+        /// <summary>Converts depth map to point cloud colored by color image in one pass.</summary>
+        /// <param name="depthImage">Input depth map. Not <see langword="null"/>. Must have resolution of depth camera.</param>
+        /// <param name="colorImage">
+        /// Input color image. Not <see langword="null"/>. Must have resolution of color camera and one of the following formats:
+        /// <see cref="ImageFormat.ColorBgra32"/>, <see cref="ImageFormat.ColorYUY2"/> or <see cref="ImageFormat.ColorNV12"/>.
+        /// </param>
+        /// <param name="points">
+        /// Output: colored points in the coordinate system of depth camera, only for pixels with valid depth, one after another.
+        /// Cannot be shorter than number of pixels in <paramref name="depthImage"/>.
+        /// </param>
+        /// <param name="coloredPointsOnly">
+        /// <see langword="true"/> to drop points not seen by color camera,
+        /// <see langword="false"/> to output such points with zero (transparent black) color.
+        /// </param>
+        /// <param name="inMeters"><see langword="true"/> to output coordinates in meters, <see langword="false"/> to output coordinates in millimeters.</param>
+        /// <param name="interpolation">How color is sampled at projections of depth pixels.</param>
+        /// <returns>Number of points written to <paramref name="points"/>.</returns>
+        /// <remarks>
+        /// See <see cref="DepthImageToColoredPointCloud(ReadOnlyImageView{short}, ReadOnlyImageView{BgraPixel}, Span{ColoredPoint}, bool, bool, TransformationInterpolation)"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentNullException"><paramref name="depthImage"/> or <paramref name="colorImage"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentException"><paramref name="depthImage"/> or <paramref name="colorImage"/> has invalid format or resolution, or <paramref name="points"/> is too short.</exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="depthImage"/> or <paramref name="colorImage"/> is disposed.</exception>
+        public unsafe int DepthImageToColoredPointCloud(Image depthImage, Image colorImage, Span<ColoredPoint> points,
+            bool coloredPointsOnly = false, bool inMeters = false, TransformationInterpolation interpolation = TransformationInterpolation.Nearest)
+        {
+            CheckColoredPointCloudImages(depthImage, colorImage);
+            CheckPointBuffer(nameof(points), points.Length);
+            fixed (ColoredPoint* pointsPtr = points)
+            {
+                var counts = ComputeColoredPointCloud(depthImage, colorImage,
+                    new(&pointsPtr->Position), sizeof(ColoredPoint), new(&pointsPtr->Color), sizeof(ColoredPoint),
+                    coloredPointsOnly, inMeters, interpolation, out var rowsPerBand);
+                return CloseGapsBetweenBands(counts, rowsPerBand, points);
+            }
+        }
+
+        /// <summary>Converts depth map to point cloud colored by color image in one pass, positions and colors are written to separate buffers.</summary>
+        /// <param name="depthImage">Input depth map. Not <see langword="null"/>. Must have resolution of depth camera.</param>
+        /// <param name="colorImage">
+        /// Input color image. Not <see langword="null"/>. Must have resolution of color camera and one of the following formats:
+        /// <see cref="ImageFormat.ColorBgra32"/>, <see cref="ImageFormat.ColorYUY2"/> or <see cref="ImageFormat.ColorNV12"/>.
+        /// </param>
+        /// <param name="positions">
+        /// Output: positions of points in the coordinate system of depth camera, only for pixels with valid depth, one after another.
+        /// Cannot be shorter than number of pixels in <paramref name="depthImage"/>.
+        /// </param>
+        /// <param name="colors">
+        /// Output: colors of points, in the same order as <paramref name="positions"/>.
+        /// Cannot be shorter than number of pixels in <paramref name="depthImage"/>.
+        /// </param>
+        /// <param name="coloredPointsOnly">
+        /// <see langword="true"/> to drop points not seen by color camera,
+        /// <see langword="false"/> to output such points with zero (transparent black) color.
+        /// </param>
+        /// <param name="inMeters"><see langword="true"/> to output coordinates in meters, <see langword="false"/> to output coordinates in millimeters.</param>
+        /// <param name="interpolation">How color is sampled at projections of depth pixels.</param>
+        /// <returns>Number of points written to <paramref name="positions"/> and <paramref name="colors"/>.</returns>
+        /// <remarks>
+        /// See <see cref="DepthImageToColoredPointCloud(ReadOnlyImageView{short}, ReadOnlyImageView{BgraPixel}, Span{ColoredPoint}, bool, bool, TransformationInterpolation)"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentNullException"><paramref name="depthImage"/> or <paramref name="colorImage"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="depthImage"/> or <paramref name="colorImage"/> has invalid format or resolution,
+        /// or <paramref name="positions"/> or <paramref name="colors"/> is too short.
+        /// </exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="depthImage"/> or <paramref name="colorImage"/> is disposed.</exception>
+        public unsafe int DepthImageToColoredPointCloud(Image depthImage, Image colorImage, Span<Float3> positions, Span<BgraPixel> colors,
+            bool coloredPointsOnly = false, bool inMeters = false, TransformationInterpolation interpolation = TransformationInterpolation.Nearest)
+        {
+            CheckColoredPointCloudImages(depthImage, colorImage);
+            CheckPointBuffer(nameof(positions), positions.Length);
+            CheckPointBuffer(nameof(colors), colors.Length);
+            fixed (Float3* positionsPtr = positions)
+            fixed (BgraPixel* colorsPtr = colors)
+            {
+                var counts = ComputeColoredPointCloud(depthImage, colorImage,
+                    new(positionsPtr), sizeof(Float3), new(colorsPtr), sizeof(BgraPixel),
+                    coloredPointsOnly, inMeters, interpolation, out var rowsPerBand);
+                CloseGapsBetweenBands(counts, rowsPerBand, colors);
+                return CloseGapsBetweenBands(counts, rowsPerBand, positions);
+            }
+        }
+
+        /// <summary>Converts depth map to point cloud colored by BGRA color image in one pass.</summary>
+        /// <param name="depthMap">Input depth map in millimeters (unsigned 16-bit values). Must have resolution of depth camera.</param>
+        /// <param name="colorImage">Input color image in <see cref="ImageFormat.ColorBgra32"/> format. Must have resolution of color camera.</param>
+        /// <param name="points">
+        /// Output: colored points in the coordinate system of depth camera, only for pixels with valid depth, one after another.
+        /// Cannot be shorter than number of pixels in <paramref name="depthMap"/>.
+        /// </param>
+        /// <param name="coloredPointsOnly">
+        /// <see langword="true"/> to drop points not seen by color camera,
+        /// <see langword="false"/> to output such points with zero (transparent black) color.
+        /// </param>
+        /// <param name="inMeters"><see langword="true"/> to output coordinates in meters, <see langword="false"/> to output coordinates in millimeters.</param>
+        /// <param name="interpolation">How color is sampled at projections of depth pixels.</param>
+        /// <returns>Number of points written to <paramref name="points"/>.</returns>
+        /// <remarks><para>
+        /// Replaces the sequence of <see cref="ColorImageToDepthCamera(ReadOnlyImageView{short}, ReadOnlyImageView{BgraPixel}, ImageView{BgraPixel}, TransformationInterpolation)"/>,
+        /// <see cref="CameraRayTable.DepthToPointCloud(ReadOnlyImageView{short}, Span{Float3}, bool, bool)"/> and merging of results:
+        /// depth map is read once and no intermediate images are allocated.
+        /// Points are the same as points of <see cref="CameraRayTable.DepthToPointCloud(ReadOnlyImageView{short}, Span{Float3}, bool, bool)"/> (up to rounding in case of meters),
+        /// colors are the same as colors of <see cref="ColorImageToDepthCamera(ReadOnlyImageView{short}, ReadOnlyImageView{BgraPixel}, ImageView{BgraPixel}, TransformationInterpolation)"/>.
+        /// </para><para>
+        /// Depth map is processed in horizontal bands on all CPU cores.
+        /// </para></remarks>
+        /// <exception cref="ArgumentException"><paramref name="depthMap"/> or <paramref name="colorImage"/> has invalid resolution, or <paramref name="points"/> is too short.</exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        public unsafe int DepthImageToColoredPointCloud(ReadOnlyImageView<short> depthMap, ReadOnlyImageView<BgraPixel> colorImage, Span<ColoredPoint> points,
+            bool coloredPointsOnly = false, bool inMeters = false, TransformationInterpolation interpolation = TransformationInterpolation.Nearest)
+        {
+            CheckDepthAndColorViews(depthMap, colorImage.WidthPixels, colorImage.HeightPixels);
+            CheckPointBuffer(nameof(points), points.Length);
+            fixed (ColoredPoint* pointsPtr = points)
+            {
+                var counts = ComputeColoredPointCloud(depthMap, new BgraSource(colorImage.Buffer, colorImage.StrideBytes),
+                    new(&pointsPtr->Position), sizeof(ColoredPoint), new(&pointsPtr->Color), sizeof(ColoredPoint),
+                    coloredPointsOnly, inMeters, interpolation, out var rowsPerBand);
+                return CloseGapsBetweenBands(counts, rowsPerBand, points);
+            }
+        }
+
+        /// <summary>Converts depth map to point cloud colored by BGRA color image in one pass, positions and colors are written to separate buffers.</summary>
+        /// <param name="depthMap">Input depth map in millimeters (unsigned 16-bit values). Must have resolution of depth camera.</param>
+        /// <param name="colorImage">Input color image in <see cref="ImageFormat.ColorBgra32"/> format. Must have resolution of color camera.</param>
+        /// <param name="positions">
+        /// Output: positions of points in the coordinate system of depth camera, only for pixels with valid depth, one after another.
+        /// Cannot be shorter than number of pixels in <paramref name="depthMap"/>.
+        /// </param>
+        /// <param name="colors">
+        /// Output: colors of points, in the same order as <paramref name="positions"/>.
+        /// Cannot be shorter than number of pixels in <paramref name="depthMap"/>.
+        /// </param>
+        /// <param name="coloredPointsOnly">
+        /// <see langword="true"/> to drop points not seen by color camera,
+        /// <see langword="false"/> to output such points with zero (transparent black) color.
+        /// </param>
+        /// <param name="inMeters"><see langword="true"/> to output coordinates in meters, <see langword="false"/> to output coordinates in millimeters.</param>
+        /// <param name="interpolation">How color is sampled at projections of depth pixels.</param>
+        /// <returns>Number of points written to <paramref name="positions"/> and <paramref name="colors"/>.</returns>
+        /// <remarks>
+        /// See <see cref="DepthImageToColoredPointCloud(ReadOnlyImageView{short}, ReadOnlyImageView{BgraPixel}, Span{ColoredPoint}, bool, bool, TransformationInterpolation)"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="depthMap"/> or <paramref name="colorImage"/> has invalid resolution,
+        /// or <paramref name="positions"/> or <paramref name="colors"/> is too short.
+        /// </exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        public unsafe int DepthImageToColoredPointCloud(ReadOnlyImageView<short> depthMap, ReadOnlyImageView<BgraPixel> colorImage,
+            Span<Float3> positions, Span<BgraPixel> colors,
+            bool coloredPointsOnly = false, bool inMeters = false, TransformationInterpolation interpolation = TransformationInterpolation.Nearest)
+        {
+            CheckDepthAndColorViews(depthMap, colorImage.WidthPixels, colorImage.HeightPixels);
+            CheckPointBuffer(nameof(positions), positions.Length);
+            CheckPointBuffer(nameof(colors), colors.Length);
+            fixed (Float3* positionsPtr = positions)
+            fixed (BgraPixel* colorsPtr = colors)
+            {
+                var counts = ComputeColoredPointCloud(depthMap, new BgraSource(colorImage.Buffer, colorImage.StrideBytes),
+                    new(positionsPtr), sizeof(Float3), new(colorsPtr), sizeof(BgraPixel),
+                    coloredPointsOnly, inMeters, interpolation, out var rowsPerBand);
+                CloseGapsBetweenBands(counts, rowsPerBand, colors);
+                return CloseGapsBetweenBands(counts, rowsPerBand, positions);
+            }
+        }
+
+        private void CheckColoredPointCloudImages(Image depthImage, Image colorImage)
+        {
+            CheckImageParameter(nameof(depthImage), depthImage, ImageFormat.Depth16, calibration.DepthCameraCalibration);
+            CheckColorImageParameter(nameof(colorImage), colorImage);
+            CheckDepthRays();
+            CheckColorModel();
+        }
+
+        private void CheckPointBuffer(string paramName, int length)
+        {
+            var pixelCount = CheckDepthRays().WidthPixels * depthRays!.HeightPixels;
+            if (length < pixelCount)
+                throw new ArgumentException($"{paramName} cannot be shorter than number of pixels in depth map ({pixelCount}).", paramName);
+        }
+
+        private int[] ComputeColoredPointCloud(Image depthImage, Image colorImage,
+            IntPtr positions, int positionStride, IntPtr colors, int colorStride,
+            bool coloredPointsOnly, bool inMeters, TransformationInterpolation interpolation, out int rowsPerBand)
+        {
+            var depthMap = depthImage.GetReadOnlyView<short>();
+            switch (colorImage.Format)
+            {
+                case ImageFormat.ColorBgra32:
+                    var bgraView = colorImage.GetReadOnlyView<BgraPixel>();
+                    return ComputeColoredPointCloud(depthMap, new BgraSource(bgraView.Buffer, bgraView.StrideBytes),
+                        positions, positionStride, colors, colorStride, coloredPointsOnly, inMeters, interpolation, out rowsPerBand);
+                case ImageFormat.ColorYUY2:
+                    var yuy2View = colorImage.GetReadOnlyView<short>();
+                    return ComputeColoredPointCloud(depthMap, new Yuy2Source(yuy2View.Buffer, yuy2View.StrideBytes),
+                        positions, positionStride, colors, colorStride, coloredPointsOnly, inMeters, interpolation, out rowsPerBand);
+                default:
+                    var nv12View = colorImage.GetReadOnlyView<byte>();
+                    return ComputeColoredPointCloud(depthMap, new Nv12Source(nv12View.Buffer, nv12View.StrideBytes, nv12View.HeightPixels),
+                        positions, positionStride, colors, colorStride, coloredPointsOnly, inMeters, interpolation, out rowsPerBand);
+            }
+        }
+
+        // Each band writes its points starting from its first pixel, returns number of points written by each band.
+        // Positions and colors are written with given strides in bytes, thus both interleaved and separate buffers are supported.
+        private unsafe int[] ComputeColoredPointCloud<TSource>(ReadOnlyImageView<short> depthMap, TSource source,
+            IntPtr positions, int positionStride, IntPtr colors, int colorStride,
+            bool coloredPointsOnly, bool inMeters, TransformationInterpolation interpolation, out int rowsPerBand)
+            where TSource : struct, IColorSource
+        {
+            var width = depthRays!.WidthPixels;
+            var colorWidth = colorModel!.CameraCalibration.ResolutionWidth;
+            var colorHeight = colorModel.CameraCalibration.ResolutionHeight;
+            var depthBuffer = depthMap.Buffer;
+            var depthStrideBytes = depthMap.StrideBytes;
+            var scale = inMeters ? MillimetersToMeters : 1f;
+            var linear = interpolation == TransformationInterpolation.Linear;
+
+            return RowBands.Process(width, depthRays.HeightPixels, rowAlignment: 1, (firstRow, rowCount) =>
+            {
+                var points3D = new Float3[width];
+                var colorPoints = new Float2[width];
+                var validFlags = new bool[width];
+                var rowColors = new BgraPixel[width];
+                var index = (nint)firstRow * width;
+                var count = 0;
+                fixed (BgraPixel* rowColorsPtr = rowColors)
+                {
+                    for (var y = firstRow; y < firstRow + rowCount; y++)
+                    {
+                        var depthRow = (ushort*)((byte*)depthBuffer.ToPointer() + (nint)y * depthStrideBytes);
+                        ProjectDepthRowToColor(depthRow, y, points3D, colorPoints, validFlags);
+                        SampleColorRow(source, colorWidth, colorHeight, colorPoints, validFlags, linear, rowColorsPtr);
+
+                        for (var x = 0; x < width; x++)
+                        {
+                            var point = points3D[x];
+                            if (point.Z == 0f)
+                                continue;
+                            if (coloredPointsOnly && !(validFlags[x] && IsInsideImage(colorPoints[x], colorWidth, colorHeight)))
+                                continue;
+
+                            *(Float3*)((byte*)positions.ToPointer() + (index + count) * positionStride) = new(point.X * scale, point.Y * scale, point.Z * scale);
+                            *(BgraPixel*)((byte*)colors.ToPointer() + (index + count) * colorStride) = rowColors[x];
+                            count++;
+                        }
+                    }
+                }
+
+                return count;
+            }, out rowsPerBand);
+        }
+
+        // Moves points of bands to close gaps between them, returns total number of points
+        private int CloseGapsBetweenBands<T>(int[] counts, int rowsPerBand, Span<T> buffer)
+        {
+            var width = depthRays!.WidthPixels;
+            var total = 0;
+            for (var band = 0; band < counts.Length; band++)
+            {
+                var bandStart = band * rowsPerBand * width;
+                if (bandStart != total)
+                    buffer.Slice(bandStart, counts[band]).CopyTo(buffer.Slice(total));
+                total += counts[band];
+            }
+
+            return total;
+        }
+    }
+}
+
+#endif
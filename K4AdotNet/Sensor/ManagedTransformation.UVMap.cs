@@ -0,0 +1,124 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+
+namespace K4AdotNet.Sensor
+{
+    // Maps of color image coordinates for depth pixels
+    partial class ManagedTransformation
+    {
+        /// <summary>Computes coordinates in color image for every pixel of depth map (UV map for texture mapping).</summary>
+        /// <param name="depthImage">Input depth map. Not <see langword="null"/>. Must have resolution of depth camera.</param>
+        /// <param name="uvMap">
+        /// Output: for each depth pixel (row by row) coordinates of corresponding point of color image.
+        /// Cannot be shorter than number of pixels in <paramref name="depthImage"/>.
+        /// </param>
+        /// <param name="validFlags">
+        /// Output: for each depth pixel whether it has corresponding point in color image.
+        /// Cannot be shorter than number of pixels in <paramref name="depthImage"/>.
+        /// </param>
+        /// <param name="normalized">
+        /// <see langword="true"/> for texture coordinates in range [0, 1) (<c>(0, 0)</c> is the top-left corner of color image),
+        /// <see langword="false"/> for coordinates in pixels (<c>(0, 0)</c> is the center of the top-left pixel of color image).
+        /// </param>
+        /// <returns>Number of depth pixels with corresponding points in color image.</returns>
+        /// <remarks>
+        /// See <see cref="DepthImageToColorUVMap(ReadOnlyImageView{short}, Span{Float2}, Span{bool}, bool)"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentNullException"><paramref name="depthImage"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentException"><paramref name="depthImage"/> has invalid format or resolution, or <paramref name="uvMap"/> or <paramref name="validFlags"/> is too short.</exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="depthImage"/> is disposed.</exception>
+        public int DepthImageToColorUVMap(Image depthImage, Span<Float2> uvMap, Span<bool> validFlags, bool normalized = false)
+        {
+            CheckImageParameter(nameof(depthImage), depthImage, ImageFormat.Depth16, calibration.DepthCameraCalibration);
+            return DepthImageToColorUVMap(depthImage.GetReadOnlyView<short>(), uvMap, validFlags, normalized);
+        }
+
+        /// <summary>Computes coordinates in color image for every pixel of depth map (UV map for texture mapping).</summary>
+        /// <param name="depthMap">Input depth map in millimeters (unsigned 16-bit values). Must have resolution of depth camera.</param>
+        /// <param name="uvMap">
+        /// Output: for each depth pixel (row by row) coordinates of corresponding point of color image, zeros for pixels without such point.
+        /// Cannot be shorter than number of pixels in <paramref name="depthMap"/>.
+        /// </param>
+        /// <param name="validFlags">
+        /// Output: for each depth pixel whether it has corresponding point in color image.
+        /// Cannot be shorter than number of pixels in <paramref name="depthMap"/>.
+        /// </param>
+        /// <param name="normalized">
+        /// <see langword="true"/> for texture coordinates in range [0, 1) (<c>(0, 0)</c> is the top-left corner of color image),
+        /// <see langword="false"/> for coordinates in pixels (<c>(0, 0)</c> is the center of the top-left pixel of color image).
+        /// </param>
+        /// <returns>Number of depth pixels with corresponding points in color image.</returns>
+        /// <remarks><para>
+        /// Depth pixel has corresponding point in color image if it has valid depth, valid unprojection and its projection lies inside of color image.
+        /// Coordinates are the same as results of <see cref="Calibration.Convert3DTo2D(ReadOnlySpan{Float3}, CalibrationGeometry, CalibrationGeometry, Span{Float2}, Span{bool})"/>
+        /// for 3D points of depth pixels, but they are computed in one pass over depth map using cached ray table of depth camera and
+        /// precomputed extrinsics. Thus color image can be sampled lazily, only where it is needed.
+        /// </para><para>
+        /// Depth map is processed in horizontal bands on all CPU cores.
+        /// </para></remarks>
+        /// <exception cref="ArgumentException"><paramref name="depthMap"/> has invalid resolution, or <paramref name="uvMap"/> or <paramref name="validFlags"/> is too short.</exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        public unsafe int DepthImageToColorUVMap(ReadOnlyImageView<short> depthMap, Span<Float2> uvMap, Span<bool> validFlags, bool normalized = false)
+        {
+            var depthRays = CheckDepthRays();
+            var colorModel = CheckColorModel();
+            CheckViewSize(nameof(depthMap), depthMap.WidthPixels, depthMap.HeightPixels, depthRays.WidthPixels, depthRays.HeightPixels);
+            CheckPointBuffer(nameof(uvMap), uvMap.Length);
+            CheckPointBuffer(nameof(validFlags), validFlags.Length);
+
+            var width = depthRays.WidthPixels;
+            var colorWidth = colorModel.CameraCalibration.ResolutionWidth;
+            var colorHeight = colorModel.CameraCalibration.ResolutionHeight;
+            var depthBuffer = depthMap.Buffer;
+            var depthStrideBytes = depthMap.StrideBytes;
+            // Pixel (x, y) covers [x - 0.5, x + 0.5) x [y - 0.5, y + 0.5)
+            var scale = normalized ? new Float2(1f / colorWidth, 1f / colorHeight) : new Float2(1f, 1f);
+            var offset = normalized ? 0.5f : 0f;
+
+            fixed (Float2* uvMapPtr = uvMap)
+            fixed (bool* validFlagsPtr = validFlags)
+            {
+                var uvBuffer = new IntPtr(uvMapPtr);
+                var validBuffer = new IntPtr(validFlagsPtr);
+                var validCounts = RowBands.Process(width, depthRays.HeightPixels, rowAlignment: 1, (firstRow, rowCount) =>
+                {
+                    var points3D = new Float3[width];
+                    var validCount = 0;
+                    for (var y = firstRow; y < firstRow + rowCount; y++)
+                    {
+                        var depthRow = (ushort*)((byte*)depthBuffer.ToPointer() + (nint)y * depthStrideBytes);
+                        var uvRow = new Span<Float2>((Float2*)uvBuffer.ToPointer() + (nint)y * width, width);
+                        var validRow = new Span<bool>((bool*)validBuffer.ToPointer() + (nint)y * width, width);
+                        ProjectDepthRowToColor(depthRow, y, points3D, uvRow, validRow);
+
+                        for (var x = 0; x < width; x++)
+                        {
+                            var point = uvRow[x];
+                            if (validRow[x] && IsInsideImage(point, colorWidth, colorHeight))
+                            {
+                                uvRow[x] = new((point.X + offset) * scale.X, (point.Y + offset) * scale.Y);
+                                validCount++;
+                            }
+                            else
+                            {
+                                uvRow[x] = default;
+                                validRow[x] = false;
+                            }
+                        }
+                    }
+
+                    return validCount;
+                }, out _);
+
+                var totalCount = 0;
+                foreach (var count in validCounts)
+                    totalCount += count;
+                return totalCount;
+            }
+        }
+    }
+}
+
+#endif
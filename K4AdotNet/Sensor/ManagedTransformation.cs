@@ -0,0 +1,392 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+using System.Buffers;
+using System.Runtime.CompilerServices;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>
+    /// Managed implementation of transformations between depth and color cameras.
+    /// Portable alternative of <see cref="Transformation"/> that does not depend on <see cref="Sdk.DEPTHENGINE_DLL_NAME"/> library.
+    /// </summary>
+    /// <remarks><para>
+    /// Images are processed in parallel on all CPU cores. Geometry is computed by managed <see cref="CameraModel"/>
+    /// and cached <see cref="CameraRayTable"/>, results are close to the results of <see cref="Transformation"/>.
+    /// </para><para>
+    /// The object does not own any unmanaged resources, thus it is not disposable.
+    /// Instances are immutable and thread safe.
+    /// </para></remarks>
+    /// <seealso cref="Calibration.CreateManagedTransformation"/>
+    public sealed partial class ManagedTransformation
+    {
+        private readonly Calibration calibration;
+        private readonly CameraRayTable? depthRays;
+        private readonly CameraModel? depthModel;
+        private readonly CameraModel? colorModel;
+        private readonly CalibrationExtrinsics depthToColor;
+        private readonly CalibrationExtrinsics colorToDepth;
+
+        /// <summary>Creates transformation object for a given calibration data.</summary>
+        /// <param name="calibration">Camera calibration data.</param>
+        /// <remarks>Ray table of depth camera is computed (or taken from cache) in constructor.</remarks>
+        /// <exception cref="InvalidOperationException">Calibration data is invalid or uses unsupported lens distortion model.</exception>
+        public ManagedTransformation(in Calibration calibration)
+        {
+            if (!calibration.IsValid)
+                throw new InvalidOperationException("Cannot create transformation object from specified calibration data.");
+
+            this.calibration = calibration;
+            if (calibration.DepthMode != DepthMode.Off)
+            {
+                depthRays = calibration.GetRayTable(CalibrationGeometry.Depth);
+                depthModel = calibration.GetCameraModel(CalibrationGeometry.Depth);
+            }
+            if (calibration.ColorResolution != ColorResolution.Off)
+                colorModel = calibration.GetCameraModel(CalibrationGeometry.Color);
+            depthToColor = calibration.GetExtrinsics(CalibrationGeometry.Depth, CalibrationGeometry.Color);
+            colorToDepth = calibration.GetExtrinsics(CalibrationGeometry.Color, CalibrationGeometry.Depth);
+        }
+
+        /// <summary>Calibration data for which this transformation was created.</summary>
+        public Calibration Calibration => calibration;
+
+        /// <summary>Depth mode for which this transformation was created.</summary>
+        public DepthMode DepthMode => calibration.DepthMode;
+
+        /// <summary>Resolution of color camera for which this transformation was created.</summary>
+        public ColorResolution ColorResolution => calibration.ColorResolution;
+
+        #region Depth to color
+
+        /// <summary>Transforms the depth map into the geometry of the color camera.</summary>
+        /// <param name="depthImage">Input depth map to be transformed. Not <see langword="null"/>. Must have resolution of depth camera.</param>
+        /// <param name="transformedDepthImage">Output depth image. Not <see langword="null"/>. Must have resolution of color camera.</param>
+        /// <remarks>
+        /// Managed counterpart of <see cref="Transformation.DepthImageToColorCamera(Image, Image)"/>.
+        /// See <see cref="DepthImageToColorCamera(ReadOnlyImageView{short}, ImageView{short})"/> for details.
+        /// </remarks>
+        /// <exception cref="ArgumentNullException"><paramref name="depthImage"/> or <paramref name="transformedDepthImage"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentException"><paramref name="depthImage"/> or <paramref name="transformedDepthImage"/> has invalid format or resolution.</exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="depthImage"/> or <paramref name="transformedDepthImage"/> is disposed.</exception>
+        public void DepthImageToColorCamera(Image depthImage, Image transformedDepthImage)
+        {
+            CheckImageParameter(nameof(depthImage), depthImage, ImageFormat.Depth16, calibration.DepthCameraCalibration);
+            CheckImageParameter(nameof(transformedDepthImage), transformedDepthImage, ImageFormat.Depth16, calibration.ColorCameraCalibration);
+            DepthImageToColorCamera(depthImage.GetReadOnlyView<short>(), transformedDepthImage.GetView<short>());
+        }
+
+        /// <summary>Transforms the depth map into the geometry of the color camera.</summary>
+        /// <param name="depthMap">Input depth map in millimeters (unsigned 16-bit values). Must have resolution of depth camera.</param>
+        /// <param name="transformedDepthMap">Output depth map in millimeters. Must have resolution of color camera.</param>
+        /// <remarks><para>
+        /// Algorithm is the same as in Sensor SDK: every four neighboring depth pixels with valid depth form a quad,
+        /// which is projected to the color camera and rasterized with interpolation of depth (in color camera coordinates) across the quad.
+        /// Overlapping quads are resolved by z-test: the nearest depth wins. Pixels not covered by any quad are set to zero.
+        /// </para><para>
+        /// Depth map is split into horizontal bands, each band is rasterized in parallel into its own z-buffer
+        /// covering only the color rows touched by the band, then z-buffers are merged into <paramref name="transformedDepthMap"/>.
+        /// </para></remarks>
+        /// <exception cref="ArgumentException"><paramref name="depthMap"/> or <paramref name="transformedDepthMap"/> has invalid resolution.</exception>
+        /// <exception cref="InvalidOperationException">Depth or color camera is off in calibration data.</exception>
+        public void DepthImageToColorCamera(ReadOnlyImageView<short> depthMap, ImageView<short> transformedDepthMap)
+        {
+            var depthRays = CheckDepthRays();
+            var colorModel = CheckColorModel();
+            CheckViewSize(nameof(depthMap), depthMap.WidthPixels, depthMap.HeightPixels, depthRays.WidthPixels, depthRays.HeightPixels);
+            var colorWidth = colorModel.CameraCalibration.ResolutionWidth;
+            var colorHeight = colorModel.CameraCalibration.ResolutionHeight;
+            CheckViewSize(nameof(transformedDepthMap), transformedDepthMap.WidthPixels, transformedDepthMap.HeightPixels, colorWidth, colorHeight);
+
+            var pixelCount = depthRays.WidthPixels * depthRays.HeightPixels;
+            var colorPoints = ArrayPool<Float2>.Shared.Rent(pixelCount);
+            var colorDepths = ArrayPool<float>.Shared.Rent(pixelCount);
+            try
+            {
+                ComputeColorCorrespondences(depthMap, colorPoints, colorDepths);
+                RasterizeDepthQuads(colorPoints, colorDepths, transformedDepthMap);
+            }
+            finally
+            {
+                ArrayPool<Float2>.Shared.Return(colorPoints);
+                ArrayPool<float>.Shared.Return(colorDepths);
+            }
+        }
+
+        // For each depth pixel: its projection to color camera and its depth (Z) in color camera coordinates, zero depth for invalid pixels
+        private unsafe void ComputeColorCorrespondences(ReadOnlyImageView<short> depthMap, Float2[] colorPoints, float[] colorDepths)
+        {
+            var depthRays = this.depthRays!;
+            var colorModel = this.colorModel!;
+            var width = depthRays.WidthPixels;
+            var depthBuffer = depthMap.Buffer;
+            var depthStrideBytes = depthMap.StrideBytes;
+
+            RowBands.Process(width, depthRays.HeightPixels, rowAlignment: 1, (firstRow, rowCount) =>
+            {
+                var points3D = new Float3[width];
+                var validFlags = new bool[width];
+                ref readonly var r = ref depthToColor.Rotation;
+                for (var y = firstRow; y < firstRow + rowCount; y++)
+                {
+                    var depthRow = (ushort*)((byte*)depthBuffer.ToPointer() + (nint)y * depthStrideBytes);
+                    var rowOffset = y * width;
+                    ProjectDepthRowToColor(depthRow, y, points3D, colorPoints.AsSpan(rowOffset, width), validFlags);
+
+                    for (var x = 0; x < width; x++)
+                    {
+                        var point = points3D[x];
+                        colorDepths[rowOffset + x] = validFlags[x]
+                            ? r.M31 * point.X + r.M32 * point.Y + r.M33 * point.Z + depthToColor.Translation.Z
+                            : 0f;
+                    }
+                }
+
+                return 0;
+            }, out _);
+        }
+
+        // Projects row of depth map to color camera: 3D points in depth camera coordinates, their projections
+        // and validity flags (pixel has valid depth and its projection is inside metric radius of color camera)
+        private unsafe void ProjectDepthRowToColor(ushort* depthRow, int y, Float3[] points3D, Span<Float2> colorPoints, Span<bool> validFlags)
+        {
+            fixed (Float3* points3DPtr = points3D)
+                depthRays!.DepthRowToPoints(depthRow, y, points3DPtr);
+
+            colorModel!.Project(points3D, depthToColor, colorPoints, validFlags);
+
+            for (var x = 0; x < points3D.Length; x++)
+            {
+                if (points3D[x].Z == 0f)
+                    validFlags[x] = false;
+            }
+        }
+
+        private unsafe void RasterizeDepthQuads(Float2[] colorPoints, float[] colorDepths, ImageView<short> transformedDepthMap)
+        {
+            var depthWidth = depthRays!.WidthPixels;
+            var depthHeight = depthRays.HeightPixels;
+            var colorWidth = transformedDepthMap.WidthPixels;
+            var colorHeight = transformedDepthMap.HeightPixels;
+            var outputBuffer = transformedDepthMap.Buffer;
+            var outputStrideBytes = transformedDepthMap.StrideBytes;
+
+            // Bands of quads. Quad with index (x, y) is formed by depth pixels (x - 1, y - 1), (x, y - 1), (x, y), (x - 1, y).
+            // Z-buffers are indexed by the first row of band.
+            var bands = new ZBufferBand[depthHeight];
+            RowBands.Process(depthWidth, depthHeight, rowAlignment: 1, (firstRow, rowCount) =>
+            {
+                bands[firstRow] = RasterizeBand(colorPoints, colorDepths, depthWidth, Math.Max(firstRow, 1), firstRow + rowCount, colorWidth, colorHeight);
+                return 0;
+            }, out var rowsPerBand);
+            var bandCount = (depthHeight + rowsPerBand - 1) / rowsPerBand;
+
+            try
+            {
+                // Merge of z-buffers of bands into output
+                RowBands.Process(colorWidth, colorHeight, rowAlignment: 1, (firstRow, rowCount) =>
+                {
+                    for (var y = firstRow; y < firstRow + rowCount; y++)
+                    {
+                        var dst = new Span<ushort>((byte*)outputBuffer.ToPointer() + (nint)y * outputStrideBytes, colorWidth);
+                        dst.Clear();
+                        for (var band = 0; band < bandCount; band++)
+                        {
+                            ref readonly var zBuffer = ref bands[band * rowsPerBand];
+                            if (y >= zBuffer.FirstRow && y < zBuffer.FirstRow + zBuffer.RowCount)
+                                MergeDepthRow(zBuffer.Buffer.AsSpan((y - zBuffer.FirstRow) * colorWidth, colorWidth), dst);
+                        }
+                    }
+
+                    return 0;
+                }, out _);
+            }
+            finally
+            {
+                for (var band = 0; band < bandCount; band++)
+                {
+                    var buffer = bands[band * rowsPerBand].Buffer;
+                    if (buffer != null)
+                        ArrayPool<ushort>.Shared.Return(buffer);
+                }
+            }
+        }
+
+        private static ZBufferBand RasterizeBand(Float2[] colorPoints, float[] colorDepths, int depthWidth, int firstQuadRow, int endQuadRow,
+            int colorWidth, int colorHeight)
+        {
+            // Range of color rows touched by quads of band
+            var minY = float.MaxValue;
+            var maxY = float.MinValue;
+            for (var i = (firstQuadRow - 1) * depthWidth; i < endQuadRow * depthWidth; i++)
+            {
+                if (colorDepths[i] != 0)
+                {
+                    minY = Math.Min(minY, colorPoints[i].Y);
+                    maxY = Math.Max(maxY, colorPoints[i].Y);
+                }
+            }
+
+            var firstRow = Math.Max(0, (int)MathF.Ceiling(Math.Max(minY, -1f)));
+            var endRow = Math.Min(colorHeight, (int)MathF.Floor(Math.Min(maxY, colorHeight)) + 1);
+            if (firstRow >= endRow)
+                return default;
+
+            var zBuffer = ArrayPool<ushort>.Shared.Rent((endRow - firstRow) * colorWidth);
+            Array.Clear(zBuffer, 0, (endRow - firstRow) * colorWidth);
+            var target = new ZBufferBand(zBuffer, firstRow, endRow - firstRow);
+
+            for (var y = firstQuadRow; y < endQuadRow; y++)
+            {
+                var topOffset = (y - 1) * depthWidth;
+                var bottomOffset = y * depthWidth;
+                for (var x = 1; x < depthWidth; x++)
+                {
+                    var z0 = colorDepths[topOffset + x - 1];
+                    var z1 = colorDepths[topOffset + x];
+                    var z2 = colorDepths[bottomOffset + x];
+                    var z3 = colorDepths[bottomOffset + x - 1];
+                    if (z0 == 0 || z1 == 0 || z2 == 0 || z3 == 0)
+                        continue;
+
+                    RasterizeQuad(
+                        colorPoints[topOffset + x - 1], z0, colorPoints[topOffset + x], z1,
+                        colorPoints[bottomOffset + x], z2, colorPoints[bottomOffset + x - 1], z3,
+                        in target, colorWidth);
+                }
+            }
+
+            return target;
+        }
+
+        // Quad with vertices p0 (top-left), p1 (top-right), p2 (bottom-right), p3 (bottom-left) is rasterized as two triangles: (p0, p1, p2) and (p0, p2, p3)
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static void RasterizeQuad(Float2 p0, float z0, Float2 p1, float z1, Float2 p2, float z2, Float2 p3, float z3,
+            in ZBufferBand target, int width)
+        {
+            var minX = Math.Max(0, (int)MathF.Ceiling(MathF.Min(MathF.Min(p0.X, p1.X), MathF.Min(p2.X, p3.X))));
+            var maxX = Math.Min(width - 1, (int)MathF.Floor(MathF.Max(MathF.Max(p0.X, p1.X), MathF.Max(p2.X, p3.X))));
+            var minY = Math.Max(target.FirstRow, (int)MathF.Ceiling(MathF.Min(MathF.Min(p0.Y, p1.Y), MathF.Min(p2.Y, p3.Y))));
+            var maxY = Math.Min(target.FirstRow + target.RowCount - 1, (int)MathF.Floor(MathF.Max(MathF.Max(p0.Y, p1.Y), MathF.Max(p2.Y, p3.Y))));
+            if (minX > maxX || minY > maxY)
+                return;
+
+            var triangle1 = new Triangle(p0, z0, p1, z1, p2, z2);
+            var triangle2 = new Triangle(p0, z0, p2, z2, p3, z3);
+            var zBuffer = target.Buffer;
+            for (var y = minY; y <= maxY; y++)
+            {
+                var rowOffset = (y - target.FirstRow) * width;
+                for (var x = minX; x <= maxX; x++)
+                {
+                    var point = new Float2(x, y);
+                    if (!triangle1.TryInterpolate(point, out var z) && !triangle2.TryInterpolate(point, out z))
+                        continue;
+
+                    // z-test: zero means empty pixel
+                    var depth = (ushort)MathF.Min(z + 0.5f, ushort.MaxValue);
+                    ref var dst = ref zBuffer[rowOffset + x];
+                    if (dst == 0 || depth < dst)
+                        dst = depth;
+                }
+            }
+        }
+
+        private static void MergeDepthRow(ReadOnlySpan<ushort> src, Span<ushort> dst)
+        {
+            for (var x = 0; x < dst.Length; x++)
+            {
+                var depth = src[x];
+                if (depth != 0 && (dst[x] == 0 || depth < dst[x]))
+                    dst[x] = depth;
+            }
+        }
+
+        // Part of z-buffer covering rows [FirstRow, FirstRow + RowCount) of color image
+        private readonly struct ZBufferBand
+        {
+            public readonly ushort[] Buffer;
+            public readonly int FirstRow;
+            public readonly int RowCount;
+
+            public ZBufferBand(ushort[] buffer, int firstRow, int rowCount)
+            {
+                Buffer = buffer;
+                FirstRow = firstRow;
+                RowCount = rowCount;
+            }
+        }
+
+        // Triangle with depth values at vertices, interpolation by barycentric coordinates
+        private readonly struct Triangle
+        {
+            private readonly Float2 a, b, c;
+            private readonly float za, zb, zc;
+            private readonly float area;
+
+            public Triangle(Float2 a, float za, Float2 b, float zb, Float2 c, float zc)
+            {
+                this.a = a;
+                this.b = b;
+                this.c = c;
+                this.za = za;
+                this.zb = zb;
+                this.zc = zc;
+                area = Area(a, b, c);
+            }
+
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            public bool TryInterpolate(Float2 point, out float z)
+            {
+                // Point is inside triangle if all three sub-triangles have the same orientation as triangle itself.
+                // Division is performed only for points inside triangle.
+                var wa = Area(b, c, point);
+                var wb = Area(c, a, point);
+                var wc = Area(a, b, point);
+                if (area == 0f || wa * area < 0f || wb * area < 0f || wc * area < 0f)
+                {
+                    z = 0f;
+                    return false;
+                }
+
+                z = (wa * za + wb * zb + wc * zc) / area;
+                return true;
+            }
+
+            // Doubled signed area of triangle (a, b, c)
+            [MethodImpl(MethodImplOptions.AggressiveInlining)]
+            private static float Area(Float2 a, Float2 b, Float2 c)
+                => (c.X - a.X) * (b.Y - a.Y) - (c.Y - a.Y) * (b.X - a.X);
+        }
+
+        #endregion
+
+        #region Helpers
+
+        private CameraRayTable CheckDepthRays()
+            => depthRays ?? throw new InvalidOperationException("Depth camera is off in calibration data of transformation.");
+
+        private CameraModel CheckColorModel()
+            => colorModel ?? throw new InvalidOperationException("Color camera is off in calibration data of transformation.");
+
+        private static void CheckViewSize(string paramName, int widthPixels, int heightPixels, int expectedWidth, int expectedHeight)
+        {
+            if (widthPixels != expectedWidth || heightPixels != expectedHeight)
+                throw new ArgumentException($"{paramName} must have size {expectedWidth}x{expectedHeight} pixels but has {widthPixels}x{heightPixels}.", paramName);
+        }
+
+        private static void CheckImageParameter(string paramName, Image paramValue, ImageFormat expectedFormat, in CameraCalibration cameraCalibration)
+        {
+            if (paramValue == null)
+                throw new ArgumentNullException(paramName);
+            if (paramValue.Format != expectedFormat)
+                throw new ArgumentException($"{paramName} must have {expectedFormat} format but has {paramValue.Format}.", paramName);
+            CheckViewSize(paramName, paramValue.WidthPixels, paramValue.HeightPixels, cameraCalibration.ResolutionWidth, cameraCalibration.ResolutionHeight);
+        }
+
+        #endregion
+    }
+}
+
+#endif
@@ -4,6 +4,12 @@ using System.Runtime.InteropServices;
 namespace K4AdotNet.Sensor
 {
     /// <summary>DLL imports for most of native functions from <c>k4a.h</c> header file.</summary>
+    /// <remarks>
+    /// Trivial getters and setters that neither block nor call back to managed code are marked with <c>SuppressGCTransition</c> attribute
+    /// for .NET 6 target to reduce the cost of call. Don't put this attribute on functions that can release objects
+    /// (releasing of image can call memory destroy callback implemented in managed code)
+    /// or that take locks and add references (like <c>k4a_capture_get_*_image</c>).
+    /// </remarks>
     internal static class NativeApi
     {
         /// <summary>Default device index.</summary>
@@ -147,6 +153,9 @@ namespace K4AdotNet.Sensor
         /// This function returns the temperature of the device at the time of the capture in Celsius.
         /// If the temperature is unavailable, the function will return <see cref="float.NaN"/>.
         /// </returns>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_capture_get_temperature_c", CallingConvention = CallingConvention.Cdecl)]
         public static extern float CaptureGetTemperatureC(NativeHandles.CaptureHandle captureHandle);
 
@@ -280,6 +289,9 @@ namespace K4AdotNet.Sensor
         /// The function will return <see cref="IntPtr.Zero"/> if there is an error, and will normally return a pointer to the image buffer.
         /// </returns>
         /// <remarks>Use this buffer to access the raw image data.</remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_buffer", CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr ImageGetBuffer(NativeHandles.ImageHandle imageHandle);
 
@@ -288,6 +300,9 @@ namespace K4AdotNet.Sensor
         /// <param name="imageHandle">Handle of the image for which the get operation is performed on.</param>
         /// <returns>The function will return <see cref="UIntPtr.Zero"/> if there is an error, and will normally return the image size.</returns>
         /// <remarks>Use this function to know what the size of the image buffer is returned by <see cref="ImageGetBuffer"/>.</remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_size", CallingConvention = CallingConvention.Cdecl)]
         public static extern UIntPtr ImageGetSize(NativeHandles.ImageHandle imageHandle);
 
@@ -299,6 +314,9 @@ namespace K4AdotNet.Sensor
         /// If the <paramref name="imageHandle"/> is invalid, the function will return <see cref="ImageFormat.Custom"/>.
         /// </returns>
         /// <remarks>Use this function to determine the format of the image buffer.</remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_format", CallingConvention = CallingConvention.Cdecl)]
         public static extern ImageFormat ImageGetFormat(NativeHandles.ImageHandle imageHandle);
 
@@ -309,6 +327,9 @@ namespace K4AdotNet.Sensor
         /// This function is not expected to fail, all images are created with a known width.
         /// If the <paramref name="imageHandle"/> is invalid, the function will return <c>0</c>.
         /// </returns>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_width_pixels", CallingConvention = CallingConvention.Cdecl)]
         public static extern int ImageGetWidthPixels(NativeHandles.ImageHandle imageHandle);
 
@@ -319,6 +340,9 @@ namespace K4AdotNet.Sensor
         /// This function is not expected to fail, all images are created with a known height.
         /// If the <paramref name="imageHandle"/> is invalid, the function will return <c>0</c>.
         /// </returns>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_height_pixels", CallingConvention = CallingConvention.Cdecl)]
         public static extern int ImageGetHeightPixels(NativeHandles.ImageHandle imageHandle);
 
@@ -329,6 +353,9 @@ namespace K4AdotNet.Sensor
         /// This function is not expected to fail, all images are created with a known stride.
         /// If the <paramref name="imageHandle"/> is invalid or the image's format does not have a stride, the function will return <c>0</c>.
         /// </returns>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_stride_bytes", CallingConvention = CallingConvention.Cdecl)]
         public static extern int ImageGetStrideBytes(NativeHandles.ImageHandle imageHandle);
 
@@ -344,6 +371,9 @@ namespace K4AdotNet.Sensor
         /// represent the mid-point of exposure.They may be used for relative comparison, but their absolute value has no
         /// defined meaning.
         /// </remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_device_timestamp_usec", CallingConvention = CallingConvention.Cdecl)]
         public static extern Microseconds64 ImageGetDeviceTimestamp(NativeHandles.ImageHandle imageHandle);
 
@@ -366,6 +396,9 @@ namespace K4AdotNet.Sensor
         /// timestamp is read from <c>QueryPerformanceCounter()</c>, it also measures realtime and is not impacted by adjustments to the
         /// system clock. It also starts from an arbitrary point in the past.
         /// </remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_system_timestamp_nsec", CallingConvention = CallingConvention.Cdecl)]
         public static extern Nanoseconds64 ImageGetSystemTimestamp(NativeHandles.ImageHandle imageHandle);
 
@@ -378,6 +411,9 @@ namespace K4AdotNet.Sensor
         /// it will return the image exposure time in microseconds.
         /// </returns>
         /// <remarks>Returns an exposure time in microseconds. This is only supported on color image formats.</remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_exposure_usec", CallingConvention = CallingConvention.Cdecl)]
         public static extern Microseconds64 ImageGetExposure(NativeHandles.ImageHandle imageHandle);
 
@@ -389,6 +425,9 @@ namespace K4AdotNet.Sensor
         /// not applicable to the image, the function will return <c>0</c>.
         /// </returns>
         /// <remarks>Returns the image's white balance. This function is only valid for color captures, and not for depth or IR captures.</remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_white_balance", CallingConvention = CallingConvention.Cdecl)]
         public static extern uint ImageGetWhiteBalance(NativeHandles.ImageHandle imageHandle);
 
@@ -399,6 +438,9 @@ namespace K4AdotNet.Sensor
         /// Returns the ISO speed of the image. <c>0</c> indicates the ISO speed was not available or an error occurred.
         /// </returns>
         /// <remarks>This function is only valid for color captures, and not for depth or IR captures.</remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_get_iso_speed", CallingConvention = CallingConvention.Cdecl)]
         public static extern uint ImageGetIsoSpeed(NativeHandles.ImageHandle imageHandle);
 
@@ -410,6 +452,9 @@ namespace K4AdotNet.Sensor
         /// Use this function in conjunction with <see cref="ImageCreate(ImageFormat, int, int, int, out NativeHandles.ImageHandle)"/>
         /// or <see cref="ImageCreateFromBuffer(ImageFormat, int, int, int, IntPtr, UIntPtr, MemoryDestroyCallback, IntPtr, out NativeHandles.ImageHandle)"/> to construct an image.
         /// </remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_set_device_timestamp_usec", CallingConvention = CallingConvention.Cdecl)]
         public static extern void ImageSetDeviceTimestamp(NativeHandles.ImageHandle imageHandle, Microseconds64 timestamp);
 
@@ -424,6 +469,9 @@ namespace K4AdotNet.Sensor
         /// The system timestamp is a high performance and increasing clock (from boot). The timestamp represents the time
         /// immediately after the image buffer was read by the host PC.
         /// </remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_set_system_timestamp_nsec", CallingConvention = CallingConvention.Cdecl)]
         public static extern void ImageSetSystemTimestamp(NativeHandles.ImageHandle imageHandle, Nanoseconds64 timestamp);
 
@@ -435,6 +483,9 @@ namespace K4AdotNet.Sensor
         /// Use this function in conjunction with <see cref="ImageCreate(ImageFormat, int, int, int, out NativeHandles.ImageHandle)"/>
         /// or <see cref="ImageCreateFromBuffer(ImageFormat, int, int, int, IntPtr, UIntPtr, MemoryDestroyCallback, IntPtr, out NativeHandles.ImageHandle)"/> to construct an image.
         /// </remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_set_exposure_usec", CallingConvention = CallingConvention.Cdecl)]
         public static extern void ImageSetExposure(NativeHandles.ImageHandle imageHandle, Microseconds64 exposure);
 
@@ -446,6 +497,9 @@ namespace K4AdotNet.Sensor
         /// Use this function in conjunction with <see cref="ImageCreate(ImageFormat, int, int, int, out NativeHandles.ImageHandle)"/>
         /// or <see cref="ImageCreateFromBuffer(ImageFormat, int, int, int, IntPtr, UIntPtr, MemoryDestroyCallback, IntPtr, out NativeHandles.ImageHandle)"/> to construct an image.
         /// </remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_set_white_balance", CallingConvention = CallingConvention.Cdecl)]
         public static extern void ImageSetWhiteBalance(NativeHandles.ImageHandle imageHandle, uint whiteBalance);
 
@@ -457,6 +511,9 @@ namespace K4AdotNet.Sensor
         /// Use this function in conjunction with <see cref="ImageCreate(ImageFormat, int, int, int, out NativeHandles.ImageHandle)"/>
         /// or <see cref="ImageCreateFromBuffer(ImageFormat, int, int, int, IntPtr, UIntPtr, MemoryDestroyCallback, IntPtr, out NativeHandles.ImageHandle)"/> to construct an image.
         /// </remarks>
+#if !(NETSTANDARD2_0 || NET461)
+        [SuppressGCTransition]
+#endif
         [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_image_set_iso_speed", CallingConvention = CallingConvention.Cdecl)]
         public static extern void ImageSetIsoSpeed(NativeHandles.ImageHandle imageHandle, uint isoSpeed);
 
@@ -934,11 +991,11 @@ namespace K4AdotNet.Sensor
         /// and should be ignored.
         /// </returns>
         /// <remarks>
-        /// This function represents an alternative to <see cref="Calibration2DTo2D"/>
+        /// This function represents an alternative to <see cref="Calibration2DTo2D(in Calibration, in Float2, float, CalibrationGeometry, CalibrationGeometry, out Float2, out int)"/>
         /// if the number of pixels that need to be transformed is small. This function searches along an epipolar line in the depth image to find the corresponding
         /// depth pixel. If a larger number of pixels need to be transformed, it might be computationally cheaper to call
         /// <see cref="TransformationDepthImageToColorCamera"/>
-        /// to get correspondence depth values for these color pixels, then call the function <see cref="Calibration2DTo2D"/>.
+        /// to get correspondence depth values for these color pixels, then call the function <see cref="Calibration2DTo2D(in Calibration, in Float2, float, CalibrationGeometry, CalibrationGeometry, out Float2, out int)"/>.
         ///
         /// If <paramref name="sourcePoint2D"/> does not map to a valid 2D coordinate in the depth camera coordinate system, <paramref name="valid"/> is set
         /// to <see langword="false"/>. If it is valid, <paramref name="valid"/> will be set to <see langword="true"/>.
@@ -952,6 +1009,59 @@ namespace K4AdotNet.Sensor
             out Float2 targetPoint2D,
             out int valid);
 
+        // Overloads of calibration functions for blittable representation of calibration data:
+        // pointer to structure is passed as is, without marshaling of the whole structure on each call.
+
+        /// <summary>The same as <see cref="Calibration3DTo3D(in Calibration, in Float3, CalibrationGeometry, CalibrationGeometry, out Float3)"/> but without marshaling of calibration data.</summary>
+        [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_calibration_3d_to_3d", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NativeCallResults.Result Calibration3DTo3D(
+            in BlittableCalibration calibration,
+            in Float3 sourcePoint3DMm,
+            CalibrationGeometry sourceCamera,
+            CalibrationGeometry targetCamera,
+            out Float3 targetPoint3DMm);
+
+        /// <summary>The same as <see cref="Calibration2DTo3D(in Calibration, in Float2, float, CalibrationGeometry, CalibrationGeometry, out Float3, out int)"/> but without marshaling of calibration data.</summary>
+        [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_calibration_2d_to_3d", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NativeCallResults.Result Calibration2DTo3D(
+            in BlittableCalibration calibration,
+            in Float2 sourcePoint2D,
+            float sourceDepthMm,
+            CalibrationGeometry sourceCamera,
+            CalibrationGeometry targetCamera,
+            out Float3 targetPoint3DMm,
+            out int valid);
+
+        /// <summary>The same as <see cref="Calibration3DTo2D(in Calibration, in Float3, CalibrationGeometry, CalibrationGeometry, out Float2, out int)"/> but without marshaling of calibration data.</summary>
+        [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_calibration_3d_to_2d", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NativeCallResults.Result Calibration3DTo2D(
+            in BlittableCalibration calibration,
+            in Float3 sourcePoint3DMm,
+            CalibrationGeometry sourceCamera,
+            CalibrationGeometry targetCamera,
+            out Float2 targetPoint2D,
+            out int valid);
+
+        /// <summary>The same as <see cref="Calibration2DTo2D(in Calibration, in Float2, float, CalibrationGeometry, CalibrationGeometry, out Float2, out int)"/> but without marshaling of calibration data.</summary>
+        [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_calibration_2d_to_2d", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NativeCallResults.Result Calibration2DTo2D(
+            in BlittableCalibration calibration,
+            in Float2 sourcePoint2D,
+            float sourceDepthMm,
+            CalibrationGeometry sourceCamera,
+            CalibrationGeometry targetCamera,
+            out Float2 targetPoint2D,
+            out int valid);
+
+        /// <summary>The same as <see cref="CalibrationColor2DToDepth2D(in Calibration, in Float2, NativeHandles.ImageHandle, out Float2, out int)"/> but without marshaling of calibration data.</summary>
+        [DllImport(Sdk.SENSOR_DLL_NAME, EntryPoint = "k4a_calibration_color_2d_to_depth_2d", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NativeCallResults.Result CalibrationColor2DToDepth2D(
+            in BlittableCalibration calibration,
+            in Float2 sourcePoint2D,
+            NativeHandles.ImageHandle depthImage,
+            out Float2 targetPoint2D,
+            out int valid);
+
         // K4A_EXPORT k4a_transformation_t k4a_transformation_create(const k4a_calibration_t *calibration);
         /// <summary>Get handle to transformation.</summary>
         /// <param name="calibration">Camera calibration data.</param>
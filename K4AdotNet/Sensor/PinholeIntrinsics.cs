@@ -0,0 +1,102 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>Intrinsics of ideal pinhole camera (without lens distortion): focal lengths, principal point and resolution.</summary>
+    /// <remarks>Pixel <c>(u, v)</c> of such camera corresponds to the ray <c>((u - Cx) / Fx, (v - Cy) / Fy, 1)</c>.</remarks>
+    /// <seealso cref="UndistortionMap"/>
+    public struct PinholeIntrinsics : IEquatable<PinholeIntrinsics>
+    {
+        /// <summary>Principal point in image, x.</summary>
+        public float Cx;
+
+        /// <summary>Principal point in image, y.</summary>
+        public float Cy;
+
+        /// <summary>Focal length x.</summary>
+        public float Fx;
+
+        /// <summary>Focal length y.</summary>
+        public float Fy;
+
+        /// <summary>Image width in pixels.</summary>
+        public int WidthPixels;
+
+        /// <summary>Image height in pixels.</summary>
+        public int HeightPixels;
+
+        /// <summary>Constructs intrinsics with given parameters.</summary>
+        /// <param name="cx">Principal point in image, x.</param>
+        /// <param name="cy">Principal point in image, y.</param>
+        /// <param name="fx">Focal length x.</param>
+        /// <param name="fy">Focal length y.</param>
+        /// <param name="widthPixels">Image width in pixels.</param>
+        /// <param name="heightPixels">Image height in pixels.</param>
+        public PinholeIntrinsics(float cx, float cy, float fx, float fy, int widthPixels, int heightPixels)
+        {
+            Cx = cx;
+            Cy = cy;
+            Fx = fx;
+            Fy = fy;
+            WidthPixels = widthPixels;
+            HeightPixels = heightPixels;
+        }
+
+        /// <summary>Creates pinhole intrinsics with the same focal lengths, principal point and resolution as a given camera has.</summary>
+        /// <param name="cameraCalibration">Calibration of depth or color camera, for example, <see cref="Calibration.DepthCameraCalibration"/>.</param>
+        /// <returns>Intrinsics of camera without lens distortion.</returns>
+        public static PinholeIntrinsics FromCameraCalibration(in CameraCalibration cameraCalibration)
+        {
+            ref readonly var parameters = ref cameraCalibration.Intrinsics.Parameters;
+            return new(parameters.Cx, parameters.Cy, parameters.Fx, parameters.Fy, cameraCalibration.ResolutionWidth, cameraCalibration.ResolutionHeight);
+        }
+
+        /// <summary>Are parameters valid: focal lengths and resolution are positive?</summary>
+        public bool IsValid
+            => Fx > 0f && Fy > 0f && WidthPixels > 0 && HeightPixels > 0;
+
+        /// <summary>Per-component comparison.</summary>
+        /// <param name="other">Other intrinsics to be compared to this one.</param>
+        /// <returns><see langword="true"/> if all parameters are equal.</returns>
+        public bool Equals(PinholeIntrinsics other)
+            => Cx.Equals(other.Cx) && Cy.Equals(other.Cy) && Fx.Equals(other.Fx) && Fy.Equals(other.Fy)
+            && WidthPixels == other.WidthPixels && HeightPixels == other.HeightPixels;
+
+        /// <summary>Overloads <see cref="Object.Equals(object)"/> to be consistent with <see cref="Equals(PinholeIntrinsics)"/>.</summary>
+        /// <param name="obj">Object to be compared with this one.</param>
+        /// <returns><see langword="true"/> if <paramref name="obj"/> is a <see cref="PinholeIntrinsics"/> and is equal to this one.</returns>
+        /// <seealso cref="Equals(PinholeIntrinsics)"/>
+        public override bool Equals(object? obj)
+            => obj is PinholeIntrinsics intrinsics && Equals(intrinsics);
+
+        /// <summary>To be consistent with <see cref="Equals(PinholeIntrinsics)"/>.</summary>
+        /// <param name="left">Left part of operator.</param>
+        /// <param name="right">Right part of operator.</param>
+        /// <returns><see langword="true"/> if <paramref name="left"/> is equal to <paramref name="right"/>.</returns>
+        /// <seealso cref="Equals(PinholeIntrinsics)"/>
+        public static bool operator ==(PinholeIntrinsics left, PinholeIntrinsics right)
+            => left.Equals(right);
+
+        /// <summary>To be consistent with <see cref="Equals(PinholeIntrinsics)"/>.</summary>
+        /// <param name="left">Left part of operator.</param>
+        /// <param name="right">Right part of operator.</param>
+        /// <returns><see langword="true"/> if <paramref name="left"/> is not equal to <paramref name="right"/>.</returns>
+        /// <seealso cref="Equals(PinholeIntrinsics)"/>
+        public static bool operator !=(PinholeIntrinsics left, PinholeIntrinsics right)
+            => !left.Equals(right);
+
+        /// <summary>Calculates hash code.</summary>
+        /// <returns>Hash code. Consistent with overridden equality.</returns>
+        public override int GetHashCode()
+            => HashCode.Combine(Cx, Cy, Fx, Fy, WidthPixels, HeightPixels);
+
+        /// <summary>Formats intrinsics as focal lengths, principal point and resolution.</summary>
+        /// <returns>String representation of intrinsics.</returns>
+        public override string ToString()
+            => $"f=({Fx}, {Fy}) c=({Cx}, {Cy}) {WidthPixels}x{HeightPixels}";
+    }
+}
+
+#endif
@@ -0,0 +1,110 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>Stride-aware typed read-only view over two-dimensional pixel data. Doesn't own and doesn't copy memory.</summary>
+    /// <typeparam name="TPixel">Type of pixel, for example, <see cref="ushort"/> for depth maps or <see cref="BgraPixel"/> for BGRA color images.</typeparam>
+    /// <remarks>
+    /// Rows of image can be padded, that is why access to pixel data is performed row-by-row (see <see cref="GetRow(int)"/>)
+    /// or by <c>(x, y)</c> indexing but not via one plain span.
+    /// View is valid only while underlying memory is alive: don't use view after disposing of <see cref="Image"/> object it was obtained from.
+    /// </remarks>
+    /// <seealso cref="Image.GetReadOnlyView{TPixel}"/>
+    /// <seealso cref="ImageView{TPixel}"/>
+    public readonly unsafe ref struct ReadOnlyImageView<TPixel>
+        where TPixel : unmanaged
+    {
+        private readonly byte* origin;
+
+        /// <summary>Creates read-only view over memory buffer.</summary>
+        /// <param name="buffer">Pointer to the first pixel of the first row. Cannot be <see cref="IntPtr.Zero"/>.</param>
+        /// <param name="widthPixels">Width of view in pixels. Non-negative.</param>
+        /// <param name="heightPixels">Height of view in pixels. Non-negative.</param>
+        /// <param name="strideBytes">Distance between starts of neighboring rows in bytes. Must be enough to fit <paramref name="widthPixels"/> pixels.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="buffer"/> is <see cref="IntPtr.Zero"/>.</exception>
+        /// <exception cref="ArgumentOutOfRangeException">Invalid value of <paramref name="widthPixels"/>, <paramref name="heightPixels"/> or <paramref name="strideBytes"/>.</exception>
+        public ReadOnlyImageView(IntPtr buffer, int widthPixels, int heightPixels, int strideBytes)
+        {
+            if (buffer == IntPtr.Zero)
+                throw new ArgumentNullException(nameof(buffer));
+            if (widthPixels < 0)
+                throw new ArgumentOutOfRangeException(nameof(widthPixels));
+            if (heightPixels < 0)
+                throw new ArgumentOutOfRangeException(nameof(heightPixels));
+            if (strideBytes < widthPixels * sizeof(TPixel))
+                throw new ArgumentOutOfRangeException(nameof(strideBytes));
+
+            origin = (byte*)buffer.ToPointer();
+            WidthPixels = widthPixels;
+            HeightPixels = heightPixels;
+            StrideBytes = strideBytes;
+        }
+
+        /// <summary>Width of view in pixels.</summary>
+        public int WidthPixels { get; }
+
+        /// <summary>Height of view in pixels.</summary>
+        public int HeightPixels { get; }
+
+        /// <summary>Distance between starts of neighboring rows in bytes.</summary>
+        public int StrideBytes { get; }
+
+        /// <summary>Pointer to the first pixel of the first row.</summary>
+        public IntPtr Buffer => new(origin);
+
+        /// <summary>Is view empty (has zero width or height)?</summary>
+        public bool IsEmpty => WidthPixels == 0 || HeightPixels == 0;
+
+        /// <summary>Access to one row of pixels.</summary>
+        /// <param name="y">Row index. From zero to <see cref="HeightPixels"/> exclusive.</param>
+        /// <returns>Read-only span of <see cref="WidthPixels"/> pixels of row <paramref name="y"/> without padding.</returns>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="y"/> is out of range.</exception>
+        public ReadOnlySpan<TPixel> GetRow(int y)
+        {
+            if ((uint)y >= (uint)HeightPixels)
+                throw new ArgumentOutOfRangeException(nameof(y));
+            return new(origin + (nint)y * StrideBytes, WidthPixels);
+        }
+
+        /// <summary>Access to pixel by its coordinates.</summary>
+        /// <param name="x">Column index. From zero to <see cref="WidthPixels"/> exclusive.</param>
+        /// <param name="y">Row index. From zero to <see cref="HeightPixels"/> exclusive.</param>
+        /// <returns>Read-only reference to pixel.</returns>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="x"/> or <paramref name="y"/> is out of range.</exception>
+        public ref readonly TPixel this[int x, int y]
+        {
+            get
+            {
+                if ((uint)x >= (uint)WidthPixels)
+                    throw new ArgumentOutOfRangeException(nameof(x));
+                if ((uint)y >= (uint)HeightPixels)
+                    throw new ArgumentOutOfRangeException(nameof(y));
+                return ref *((TPixel*)(origin + (nint)y * StrideBytes) + x);
+            }
+        }
+
+        /// <summary>Creates read-only view of sub-rectangle of this view. No data is copied.</summary>
+        /// <param name="x">Column of left-top corner of sub-rectangle.</param>
+        /// <param name="y">Row of left-top corner of sub-rectangle.</param>
+        /// <param name="widthPixels">Width of sub-rectangle in pixels.</param>
+        /// <param name="heightPixels">Height of sub-rectangle in pixels.</param>
+        /// <returns>View of sub-rectangle. It has the same stride as this view.</returns>
+        /// <exception cref="ArgumentOutOfRangeException">Sub-rectangle doesn't fit into this view.</exception>
+        public ReadOnlyImageView<TPixel> Slice(int x, int y, int widthPixels, int heightPixels)
+        {
+            if ((uint)x > (uint)WidthPixels)
+                throw new ArgumentOutOfRangeException(nameof(x));
+            if ((uint)y > (uint)HeightPixels)
+                throw new ArgumentOutOfRangeException(nameof(y));
+            if ((uint)widthPixels > (uint)(WidthPixels - x))
+                throw new ArgumentOutOfRangeException(nameof(widthPixels));
+            if ((uint)heightPixels > (uint)(HeightPixels - y))
+                throw new ArgumentOutOfRangeException(nameof(heightPixels));
+            return new(new IntPtr(origin + (nint)y * StrideBytes + (nint)x * sizeof(TPixel)), widthPixels, heightPixels, StrideBytes);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,40 @@
+﻿using System;
+using System.Threading.Tasks;
+
+namespace K4AdotNet.Sensor
+{
+    // Splitting of image rows into horizontal bands processed in parallel
+    internal static class RowBands
+    {
+        // Processing of small images is not worth to be parallelized
+        public const int MinBandPixels = 64 * 1024;
+
+        // Splits rows into bands (number of rows in band is multiple of rowAlignment) and processes them in parallel.
+        // Returns results of processBand(firstRow, rowCount) for each band.
+        public static int[] Process(int widthPixels, int heightPixels, int rowAlignment, Func<int, int, int> processBand, out int rowsPerBand)
+        {
+            var pixelCount = (long)widthPixels * heightPixels;
+            var bandCount = (int)Math.Max(1, Math.Min(Environment.ProcessorCount, pixelCount / MinBandPixels));
+            var bandRows = (heightPixels + bandCount - 1) / bandCount;
+            bandRows = Math.Max(rowAlignment, (bandRows + rowAlignment - 1) / rowAlignment * rowAlignment);
+            bandCount = Math.Max(1, (heightPixels + bandRows - 1) / bandRows);
+
+            var results = new int[bandCount];
+            if (bandCount == 1)
+            {
+                results[0] = processBand(0, heightPixels);
+            }
+            else
+            {
+                Parallel.For(0, bandCount, band =>
+                {
+                    var firstRow = band * bandRows;
+                    results[band] = processBand(firstRow, Math.Min(bandRows, heightPixels - firstRow));
+                });
+            }
+
+            rowsPerBand = bandRows;
+            return results;
+        }
+    }
+}
@@ -0,0 +1,765 @@
+﻿using System;
+using System.Diagnostics;
+using System.Diagnostics.CodeAnalysis;
+using System.Threading;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>Software emulation of device: produces captures and IMU samples without hardware.</summary>
+    /// <remarks><para>
+    /// Has the same surface as <see cref="Device"/> (see <see cref="ICaptureSource"/>) and supports any valid combination
+    /// of <see cref="DeviceConfiguration.DepthMode"/>, <see cref="DeviceConfiguration.ColorResolution"/>, <see cref="DeviceConfiguration.ColorFormat"/>
+    /// and <see cref="DeviceConfiguration.CameraFps"/>. Intended use is testing and load-testing of processing pipelines
+    /// on machines without Azure Kinect or Orbbec Femto devices: several synthetic devices can be driven in parallel at full frame rate.
+    /// </para><para>
+    /// Captures become available according to real-time clock (see <see cref="SyntheticDeviceSettings.RealTime"/>).
+    /// Like in Sensor SDK, only a couple of the latest captures is kept for client:
+    /// if client reads captures too slowly, the oldest ones are dropped (see <see cref="DroppedCaptureCount"/>).
+    /// Device timestamps follow nominal frame rate and <see cref="DeviceConfiguration.DepthDelayOffColor"/>,
+    /// system timestamps reflect moments when captures become available, including jitter (see <see cref="SyntheticDeviceSettings.Jitter"/>).
+    /// </para><para>
+    /// Content of images is either procedural (smooth depth scene, IR derived from depth, color gradients)
+    /// or taken from <see cref="SyntheticDeviceSettings.DepthContent"/>, <see cref="SyntheticDeviceSettings.IRContent"/>
+    /// and <see cref="SyntheticDeviceSettings.ColorContent"/>. In both cases content scrolls vertically from frame to frame
+    /// (see <see cref="SyntheticDeviceSettings.ScrollRowsPerFrame"/>).
+    /// </para><para>
+    /// Images and captures are regular <see cref="Image"/> and <see cref="Capture"/> objects,
+    /// that is Sensor SDK library is required, but device is not.
+    /// Calibration is created by <see cref="Calibration.CreateDummy(DepthMode, ColorResolution, float, out Calibration)"/>.
+    /// </para></remarks>
+    /// <seealso cref="ICaptureSource"/>
+    /// <seealso cref="SyntheticDeviceSettings"/>
+    public sealed class SyntheticDevice : IDisposablePlus, ICaptureSource
+    {
+        // Like in Sensor SDK, which keeps only two the latest captures in queue
+        private const int CaptureQueueCapacity = 2;
+        // IMU samples for one second
+        private const int ImuQueueCapacity = ImuSampleRateHz;
+        private const int ImuSampleRateHz = 1600;
+        private const float DummyDistanceBetweenDepthAndColorMm = 32f;
+
+        private static int instanceCounter;
+
+        private readonly object sync = new();
+        private CameraStream? cameras;      // null if cameras are not running
+        private ImuStream? imu;             // null if IMU is not running
+        private long droppedCaptureCount;
+        private long droppedImuSampleCount;
+        private volatile bool isDisposed;
+
+        /// <summary>Creates synthetic device with default settings.</summary>
+        public SyntheticDevice()
+            : this(new SyntheticDeviceSettings())
+        { }
+
+        /// <summary>Creates synthetic device with specified settings.</summary>
+        /// <param name="settings">Settings of device. Not <see langword="null"/>. Settings are read on each start of cameras.</param>
+        /// <exception cref="ArgumentNullException"><paramref name="settings"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentOutOfRangeException">Some of values in <paramref name="settings"/> are out of valid range.</exception>
+        public SyntheticDevice(SyntheticDeviceSettings settings)
+        {
+            if (settings is null)
+                throw new ArgumentNullException(nameof(settings));
+            settings.Validate();
+
+            Settings = settings;
+            SerialNumber = settings.SerialNumber
+                ?? "SYN" + Interlocked.Increment(ref instanceCounter).ToString("D9", System.Globalization.CultureInfo.InvariantCulture);
+            Seed = settings.Seed ?? GetStableHashCode(SerialNumber);
+        }
+
+        /// <summary>
+        /// Call this method to stop streaming and free all resources associated with current instance.
+        /// Threads blocked in <see cref="TryGetCapture(out Capture, Timeout)"/> or <see cref="TryGetImuSample(out ImuSample, Timeout)"/>
+        /// get <see cref="ObjectDisposedException"/>.
+        /// </summary>
+        /// <seealso cref="Disposed"/>
+        /// <seealso cref="IsDisposed"/>
+        public void Dispose()
+        {
+            lock (sync)
+            {
+                if (isDisposed)
+                    return;
+                isDisposed = true;
+                cameras = null;
+                imu = null;
+                Monitor.PulseAll(sync);
+            }
+
+            Disposed?.Invoke(this, EventArgs.Empty);
+        }
+
+        /// <summary>Gets a value indicating whether the object has been disposed of.</summary>
+        /// <seealso cref="Dispose"/>
+        public bool IsDisposed => isDisposed;
+
+        /// <summary>Raised on object disposing (only once).</summary>
+        /// <seealso cref="Dispose"/>
+        public event EventHandler? Disposed;
+
+        /// <summary>Settings of device. Not <see langword="null"/>.</summary>
+        public SyntheticDeviceSettings Settings { get; }
+
+        /// <summary>Device serial number. Not <see langword="null"/>.</summary>
+        /// <seealso cref="SyntheticDeviceSettings.SerialNumber"/>
+        public string SerialNumber { get; }
+
+        /// <summary>Seed of random generator of this device.</summary>
+        /// <seealso cref="SyntheticDeviceSettings.Seed"/>
+        public int Seed { get; }
+
+        /// <summary>Synthetic device is "connected" until it is disposed.</summary>
+        public bool IsConnected => !isDisposed;
+
+        /// <summary>Number of captures that were dropped because client did not read them in time.</summary>
+        /// <remarks>Frames dropped by <see cref="SyntheticDeviceSettings.DropProbability"/> are not counted here, like frames lost by real device.</remarks>
+        public long DroppedCaptureCount => Interlocked.Read(ref droppedCaptureCount);
+
+        /// <summary>Number of IMU samples that were dropped because client did not read them in time.</summary>
+        public long DroppedImuSampleCount => Interlocked.Read(ref droppedImuSampleCount);
+
+        /// <summary>Starts color and depth camera capture.</summary>
+        /// <param name="config">The configuration we want to run the device in. This can be initialized with <see cref="DeviceConfiguration.DisableAll"/>.</param>
+        /// <remarks>
+        /// Individual sensors configured to run will now start to stream captured data.
+        /// It is not valid to call this method a second time on the same device until <see cref="StopCameras"/> has been called.
+        /// </remarks>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
+        /// <exception cref="ArgumentException">
+        /// Configuration in <paramref name="config"/> is not valid (for details see <see cref="DeviceConfiguration.IsValid(out string)"/>),
+        /// or size of content from <see cref="Settings"/> does not correspond to <paramref name="config"/>,
+        /// or <see cref="ImageFormat.ColorMjpg"/> is requested without <see cref="SyntheticDeviceSettings.ColorContent"/>.
+        /// </exception>
+        /// <exception cref="InvalidOperationException">Cameras streaming is already running.</exception>
+        /// <seealso cref="StopCameras"/>
+        public void StartCameras(DeviceConfiguration config)
+        {
+            if (!config.IsValid(out var message))
+                throw new ArgumentException(message, nameof(config));
+            if (config.DepthMode == DepthMode.Off && config.ColorResolution == ColorResolution.Off)
+                throw new ArgumentException($"{nameof(config.DepthMode)} and {nameof(config.ColorResolution)} cannot be equal to Off simultaneously.", nameof(config));
+            Settings.Validate();
+
+            lock (sync)
+            {
+                CheckNotDisposed();
+                if (cameras != null)
+                    throw new InvalidOperationException("Cameras streaming is already running.");
+                cameras = new CameraStream(config, Settings, Seed);
+            }
+        }
+
+        /// <summary>Stops the color and depth camera capture.</summary>
+        /// <remarks>
+        /// This method may be called while another thread is blocking in <see cref="GetCapture"/> or <see cref="TryGetCapture(out Capture, Timeout)"/>.
+        /// Calling this method while another thread is in that method will result in that method failing with exception.
+        /// </remarks>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
+        /// <seealso cref="StartCameras(DeviceConfiguration)"/>
+        public void StopCameras()
+        {
+            lock (sync)
+            {
+                CheckNotDisposed();
+                cameras = null;
+                Monitor.PulseAll(sync);
+            }
+        }
+
+        /// <summary>Starts the IMU sample stream.</summary>
+        /// <remarks>
+        /// It is not valid to call this method a second time on the same device until <see cref="StopImu"/> has been called.
+        /// Like for real device, cameras must be started before the IMU.
+        /// </remarks>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
+        /// <exception cref="InvalidOperationException">IMU streaming is already running or cameras streaming is not running.</exception>
+        /// <seealso cref="StopImu"/>
+        public void StartImu()
+        {
+            lock (sync)
+            {
+                CheckNotDisposed();
+                if (imu != null || cameras is null)
+                    throw new InvalidOperationException("IMU streaming is already running or cameras streaming is not running.");
+                imu = new ImuStream(cameras, Settings.RealTime, Seed);
+            }
+        }
+
+        /// <summary>Stops the IMU capture.</summary>
+        /// <remarks>
+        /// This method may be called while another thread is blocking in <see cref="GetImuSample"/> or <see cref="TryGetImuSample(out ImuSample, Timeout)"/>.
+        /// Calling this method while another thread is in that method will result in that method failing with exception.
+        /// </remarks>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
+        /// <seealso cref="StartImu"/>
+        public void StopImu()
+        {
+            lock (sync)
+            {
+                CheckNotDisposed();
+                imu = null;
+                Monitor.PulseAll(sync);
+            }
+        }
+
+        /// <inheritdoc cref="Device.TryGetCapture(out Capture, Timeout)"/>
+        public bool TryGetCapture([NotNullWhen(returnValue: true)] out Capture? capture, Timeout timeout = default)
+        {
+            CameraStream stream;
+            long frameIndex;
+            bool hasColor, hasDepth;
+
+            lock (sync)
+            {
+                var deadline = GetDeadline(timeout);
+                stream = cameras ?? throw CheckNotDisposedAndCreateException("Cameras streaming is not running or has been stopped.");
+                while (true)
+                {
+                    var now = Stopwatch.GetTimestamp();
+                    frameIndex = stream.NextFrameIndex;
+                    var arrival = stream.GetFrameArrivalTicks(frameIndex);
+                    if (arrival <= now)
+                    {
+                        // Emulation of Sensor SDK queue: if client is too slow, the oldest captures are dropped
+                        var skip = stream.GetLatestArrivedFrameIndex(now) - frameIndex - (CaptureQueueCapacity - 1);
+                        if (skip > 0)
+                        {
+                            frameIndex += skip;
+                            Interlocked.Add(ref droppedCaptureCount, skip);
+                        }
+
+                        stream.NextFrameIndex = frameIndex + 1;
+                        if (stream.IsFrameDelivered(frameIndex, out hasColor, out hasDepth))
+                            break;
+                        continue;
+                    }
+
+                    if (now >= deadline)
+                    {
+                        capture = null;
+                        return false;
+                    }
+                    Wait(Math.Min(arrival, deadline) - now);
+
+                    if (!ReferenceEquals(stream, cameras))
+                        throw CheckNotDisposedAndCreateException("Cameras streaming is not running or has been stopped.");
+                }
+            }
+
+            capture = stream.CreateCapture(frameIndex, hasColor, hasDepth);
+            return true;
+        }
+
+        /// <inheritdoc cref="Device.GetCapture"/>
+        public Capture GetCapture()
+        {
+            var res = TryGetCapture(out var capture, Timeout.Infinite);
+            System.Diagnostics.Debug.Assert(res);
+            return capture!;
+        }
+
+        /// <inheritdoc cref="Device.TryGetImuSample(out ImuSample, Timeout)"/>
+        public bool TryGetImuSample(out ImuSample imuSample, Timeout timeout = default)
+        {
+            lock (sync)
+            {
+                var deadline = GetDeadline(timeout);
+                var stream = imu ?? throw CheckNotDisposedAndCreateException("IMU streaming is not running or has been stopped.");
+                while (true)
+                {
+                    var now = Stopwatch.GetTimestamp();
+                    var sampleIndex = stream.NextSampleIndex;
+                    var arrival = stream.GetSampleArrivalTicks(sampleIndex);
+                    if (arrival <= now)
+                    {
+                        var skip = stream.GetLatestArrivedSampleIndex(now) - sampleIndex - (ImuQueueCapacity - 1);
+                        if (skip > 0)
+                        {
+                            sampleIndex += skip;
+                            Interlocked.Add(ref droppedImuSampleCount, skip);
+                        }
+
+                        stream.NextSampleIndex = sampleIndex + 1;
+                        imuSample = stream.CreateSample(sampleIndex);
+                        return true;
+                    }
+
+                    if (now >= deadline)
+                    {
+                        imuSample = default;
+                        return false;
+                    }
+                    Wait(Math.Min(arrival, deadline) - now);
+
+                    if (!ReferenceEquals(stream, imu))
+                        throw CheckNotDisposedAndCreateException("IMU streaming is not running or has been stopped.");
+                }
+            }
+        }
+
+        /// <inheritdoc cref="Device.GetImuSample"/>
+        public ImuSample GetImuSample()
+        {
+            var res = TryGetImuSample(out var imuSample, Timeout.Infinite);
+            System.Diagnostics.Debug.Assert(res);
+            return imuSample;
+        }
+
+        /// <summary>Gets the camera calibration for synthetic device: calibration created by <see cref="Calibration.CreateDummy(DepthMode, ColorResolution, float, out Calibration)"/>.</summary>
+        /// <param name="depthMode">Mode in which depth camera is operated.</param>
+        /// <param name="colorResolution">Resolution in which color camera is operated.</param>
+        /// <param name="calibration">Output: calibration data.</param>
+        /// <exception cref="ArgumentOutOfRangeException"><paramref name="depthMode"/> and <paramref name="colorResolution"/> cannot be equal to <c>Off</c> simultaneously.</exception>
+        /// <exception cref="ObjectDisposedException">This method cannot be called for disposed object.</exception>
+        public void GetCalibration(DepthMode depthMode, ColorResolution colorResolution, out Calibration calibration)
+        {
+            if (depthMode == DepthMode.Off && colorResolution == ColorResolution.Off)
+                throw new ArgumentOutOfRangeException(nameof(depthMode) + " and " + nameof(colorResolution), $"{nameof(depthMode)} and {nameof(colorResolution)} cannot be equal to Off simultaneously.");
+            CheckNotDisposed();
+
+            Calibration.CreateDummy(depthMode, colorResolution, DummyDistanceBetweenDepthAndColorMm, out calibration);
+        }
+
+        /// <summary>Convenient string representation of object.</summary>
+        /// <returns><c>Synthetic device #{SerialNumber}</c></returns>
+        public override string ToString()
+            => "Synthetic device #" + SerialNumber;
+
+        private void CheckNotDisposed()
+        {
+            if (isDisposed)
+                throw new ObjectDisposedException(nameof(SyntheticDevice));
+        }
+
+        private Exception CheckNotDisposedAndCreateException(string invalidOperationMessage)
+        {
+            CheckNotDisposed();
+            return new InvalidOperationException(invalidOperationMessage);
+        }
+
+        private static long GetDeadline(Timeout timeout)
+            => timeout == Timeout.Infinite
+                ? long.MaxValue
+                : Stopwatch.GetTimestamp() + timeout.ValueMs * Stopwatch.Frequency / 1000;
+
+        // Must be called under lock
+        private void Wait(long durationTicks)
+        {
+            var delayMs = durationTicks * 1000 / Stopwatch.Frequency + 1;
+            Monitor.Wait(sync, (int)Math.Min(delayMs, int.MaxValue));
+        }
+
+        // FNV-1a: unlike string.GetHashCode() it is the same in all processes
+        private static int GetStableHashCode(string value)
+        {
+            var hash = 2166136261u;
+            foreach (var c in value)
+                hash = (hash ^ c) * 16777619u;
+            return unchecked((int)hash);
+        }
+
+        // Deterministic pseudo-random number in range [0, 1) for given seed, stream of events and index of event (SplitMix64 finalizer)
+        private static double Random(int seed, int stream, long index)
+        {
+            var x = unchecked((ulong)seed * 0x9E3779B97F4A7C15ul + (ulong)stream * 0xD1B54A32D192ED03ul + (ulong)index);
+            x = unchecked((x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ul);
+            x = unchecked((x ^ (x >> 27)) * 0x94D049BB133111EBul);
+            x ^= x >> 31;
+            return (x >> 11) * (1.0 / (1ul << 53));
+        }
+
+        private static long StopwatchTicksToNanoseconds(long ticks)
+            => (long)(ticks * (1_000_000_000.0 / Stopwatch.Frequency));
+
+        private sealed class CameraStream
+        {
+            private const int ColorDropStream = 1;
+            private const int DepthDropStream = 2;
+            private const int JitterStream = 3;
+            private const int TemperatureStream = 4;
+
+            private readonly DeviceConfiguration config;
+            private readonly bool realTime;
+            private readonly int seed;
+            private readonly int fps;
+            private readonly double dropProbability;
+            private readonly int jitterUsec;
+            private readonly int scrollRowsPerFrame;
+            private readonly ICustomMemoryAllocator? memoryAllocator;
+            private readonly Microseconds64 colorTimestampBase;
+            private readonly byte[]? depthContent;
+            private readonly byte[]? irContent;
+            private readonly byte[]? colorContent;
+
+            public CameraStream(DeviceConfiguration config, SyntheticDeviceSettings settings, int seed)
+            {
+                this.config = config;
+                this.seed = seed;
+                realTime = settings.RealTime;
+                fps = config.CameraFps.ToNumberHz();
+                dropProbability = settings.DropProbability;
+                jitterUsec = settings.Jitter.ValueUsec;
+                scrollRowsPerFrame = settings.ScrollRowsPerFrame;
+                memoryAllocator = settings.MemoryAllocator;
+
+                colorTimestampBase = settings.InitialDeviceTimestamp;
+                if (config.WiredSyncMode == WiredSyncMode.Subordinate)
+                    colorTimestampBase += config.SubordinateDelayOffMaster;
+
+                var depthWidth = config.DepthMode.WidthPixels();
+                var depthHeight = config.DepthMode.HeightPixels();
+                if (config.DepthMode.HasDepth())
+                {
+                    depthContent = settings.DepthContent ?? CreateDepthContent(config.DepthMode);
+                    CheckContentSize(depthContent, ImageFormat.Depth16, depthWidth, depthHeight, nameof(settings.DepthContent));
+                }
+                if (config.DepthMode != DepthMode.Off)
+                {
+                    irContent = settings.IRContent
+                        ?? (depthContent != null ? CreateIRContent(depthContent) : CreatePassiveIRContent(depthWidth, depthHeight));
+                    CheckContentSize(irContent, ImageFormat.IR16, depthWidth, depthHeight, nameof(settings.IRContent));
+                }
+
+                if (config.ColorResolution != ColorResolution.Off)
+                {
+                    var colorWidth = config.ColorResolution.WidthPixels();
+                    var colorHeight = config.ColorResolution.HeightPixels();
+                    colorContent = settings.ColorContent ?? CreateColorContent(config.ColorFormat, colorWidth, colorHeight);
+                    if (config.ColorFormat == ImageFormat.ColorMjpg)
+                    {
+                        if (colorContent.Length == 0)
+                            throw new ArgumentException($"{nameof(settings.ColorContent)} cannot be empty.");
+                    }
+                    else
+                    {
+                        CheckContentSize(colorContent, config.ColorFormat, colorWidth, colorHeight, nameof(settings.ColorContent));
+                    }
+                }
+
+                StartTicks = Stopwatch.GetTimestamp();
+                StartSystemTimestamp = new Nanoseconds64(StopwatchTicksToNanoseconds(StartTicks));
+            }
+
+            public long StartTicks { get; }
+
+            public Nanoseconds64 StartSystemTimestamp { get; }
+
+            public Microseconds64 ColorTimestampBase => colorTimestampBase;
+
+            public long NextFrameIndex { get; set; }
+
+            // Frame becomes available after the end of its exposure period
+            public long GetFrameArrivalTicks(long frameIndex)
+                => realTime
+                    ? StartTicks + (frameIndex + 1) * Stopwatch.Frequency / fps + GetJitterUsec(frameIndex) * Stopwatch.Frequency / 1_000_000
+                    : long.MinValue;
+
+            public long GetLatestArrivedFrameIndex(long nowTicks)
+                => realTime
+                    ? (nowTicks - StartTicks) * fps / Stopwatch.Frequency - 1
+                    : NextFrameIndex;
+
+            public bool IsFrameDelivered(long frameIndex, out bool hasColor, out bool hasDepth)
+            {
+                var colorDropped = dropProbability > 0 && Random(seed, ColorDropStream, frameIndex) < dropProbability;
+                var depthDropped = dropProbability > 0 && Random(seed, DepthDropStream, frameIndex) < dropProbability;
+                hasColor = colorContent != null && !colorDropped;
+                hasDepth = irContent != null && !depthDropped;
+                if (config.SynchronizedImagesOnly && (colorDropped || depthDropped))
+                    return false;
+                return hasColor || hasDepth;
+            }
+
+            public Capture CreateCapture(long frameIndex, bool hasColor, bool hasDepth)
+            {
+                var colorDeviceTimestamp = colorTimestampBase + frameIndex * 1_000_000 / fps;
+                var colorSystemTimestamp = StartSystemTimestamp + ((frameIndex + 1) * 1_000_000 / fps + GetJitterUsec(frameIndex)) * 1_000;
+
+                var capture = new Capture();
+                try
+                {
+                    if (hasColor)
+                    {
+                        using var image = CreateColorImage(frameIndex);
+                        image.DeviceTimestamp = colorDeviceTimestamp;
+                        image.SystemTimestamp = colorSystemTimestamp;
+#if !ORBBECSDK_K4A_WRAPPER
+                        image.Exposure = Microseconds64.FromMilliseconds(Math.Min(33.33, 500.0 / fps));
+                        image.WhiteBalance = 4500;
+                        image.IsoSpeed = 100;
+#endif
+                        capture.ColorImage = image;
+                    }
+
+                    if (hasDepth)
+                    {
+                        var depthDeviceTimestamp = colorDeviceTimestamp + config.DepthDelayOffColor.ValueUsec;
+                        var depthSystemTimestamp = colorSystemTimestamp + config.DepthDelayOffColor.ValueUsec * 1_000L;
+
+                        if (depthContent != null)
+                        {
+                            using var image = CreateImage(ImageFormat.Depth16, config.DepthMode.WidthPixels(), config.DepthMode.HeightPixels(), depthContent, frameIndex);
+                            image.DeviceTimestamp = depthDeviceTimestamp;
+                            image.SystemTimestamp = depthSystemTimestamp;
+                            capture.DepthImage = image;
+                        }
+
+                        using (var image = CreateImage(ImageFormat.IR16, config.DepthMode.WidthPixels(), config.DepthMode.HeightPixels(), irContent!, frameIndex))
+                        {
+                            image.DeviceTimestamp = depthDeviceTimestamp;
+                            image.SystemTimestamp = depthSystemTimestamp;
+                            capture.IRImage = image;
+                        }
+                    }
+
+#if !ORBBECSDK_K4A_WRAPPER
+                    capture.TemperatureC = 30f + (float)Random(seed, TemperatureStream, frameIndex);
+#endif
+                }
+                catch
+                {
+                    capture.Dispose();
+                    throw;
+                }
+
+                return capture;
+            }
+
+            private int GetJitterUsec(long frameIndex)
+                => jitterUsec > 0 ? (int)(Random(seed, JitterStream, frameIndex) * jitterUsec) : 0;
+
+            private Image CreateColorImage(long frameIndex)
+            {
+                var width = config.ColorResolution.WidthPixels();
+                var height = config.ColorResolution.HeightPixels();
+                if (config.ColorFormat != ImageFormat.ColorMjpg)
+                    return CreateImage(config.ColorFormat, width, height, colorContent!, frameIndex);
+
+                var image = new Image(ImageFormat.ColorMjpg, width, height, 0, colorContent!.Length, memoryAllocator);
+                image.FillFrom(colorContent);
+                return image;
+            }
+
+            // Creates image with tightly packed rows and fills it by content scrolled vertically
+            private unsafe Image CreateImage(ImageFormat format, int width, int height, byte[] content, long frameIndex)
+            {
+                var stride = format.StrideBytes(width);
+                var image = new Image(format, width, height, stride, content.Length, memoryAllocator);
+                try
+                {
+                    // Only luma plane of NV12 is scrolled, chroma plane is copied as is
+                    var shift = (int)(frameIndex * scrollRowsPerFrame % height);
+                    var planeSize = stride * height;
+                    var dst = (byte*)image.Buffer.ToPointer();
+                    fixed (byte* src = content)
+                    {
+                        var headSize = stride * shift;
+                        System.Buffer.MemoryCopy(src + headSize, dst, planeSize - headSize, planeSize - headSize);
+                        System.Buffer.MemoryCopy(src, dst + planeSize - headSize, headSize, headSize);
+                        if (content.Length > planeSize)
+                            System.Buffer.MemoryCopy(src + planeSize, dst + planeSize, content.Length - planeSize, content.Length - planeSize);
+                    }
+                }
+                catch
+                {
+                    image.Dispose();
+                    throw;
+                }
+
+                return image;
+            }
+
+            private static void CheckContentSize(byte[] content, ImageFormat format, int width, int height, string name)
+            {
+                var expectedSize = format.ImageSizeBytes(format.StrideBytes(width), height);
+                if (content.Length != expectedSize)
+                    throw new ArgumentException($"Size of {name} is {content.Length} bytes but {expectedSize} bytes are expected for {format} image {width}x{height}.");
+            }
+
+            // Floor plane which goes away from camera and sphere in the middle. Pixels outside of field of view of WFOV modes are invalid.
+            private static byte[] CreateDepthContent(DepthMode depthMode)
+            {
+                var width = depthMode.WidthPixels();
+                var height = depthMode.HeightPixels();
+                var isWideView = depthMode.IsWideView();
+                var radius = height / 4f;
+                var content = new byte[width * height * sizeof(ushort)];
+                var i = 0;
+                for (var y = 0; y < height; y++)
+                {
+                    for (var x = 0; x < width; x++, i += sizeof(ushort))
+                    {
+                        var dx = x - width / 2f;
+                        var dy = y - height / 2f;
+                        int depth;
+                        if (isWideView && dx * dx + dy * dy > width * width / 4f)
+                        {
+                            depth = 0;
+                        }
+                        else
+                        {
+                            depth = 3000 - 2000 * y / height;
+                            var d2 = radius * radius - dx * dx - dy * dy;
+                            if (d2 > 0)
+                                depth = Math.Min(depth, 1200 - (int)(Math.Sqrt(d2) * 400 / radius));
+                        }
+                        content[i] = (byte)depth;
+                        content[i + 1] = (byte)(depth >> 8);
+                    }
+                }
+                return content;
+            }
+
+            // Active IR: brightness decreases with square of distance
+            private static byte[] CreateIRContent(byte[] depthContent)
+            {
+                var content = new byte[depthContent.Length];
+                for (var i = 0; i < content.Length; i += sizeof(ushort))
+                {
+                    var depth = depthContent[i] | (depthContent[i + 1] << 8);
+                    var ir = depth > 0 ? (int)Math.Min(ushort.MaxValue, 4_000_000_000L / (depth * depth)) : 0;
+                    content[i] = (byte)ir;
+                    content[i + 1] = (byte)(ir >> 8);
+                }
+                return content;
+            }
+
+            // Passive IR: dim horizontal gradient
+            private static byte[] CreatePassiveIRContent(int width, int height)
+            {
+                var content = new byte[width * height * sizeof(ushort)];
+                var i = 0;
+                for (var y = 0; y < height; y++)
+                {
+                    for (var x = 0; x < width; x++, i += sizeof(ushort))
+                    {
+                        var ir = 100 + 400 * x / width;
+                        content[i] = (byte)ir;
+                        content[i + 1] = (byte)(ir >> 8);
+                    }
+                }
+                return content;
+            }
+
+            // Gradients with checkerboard pattern
+            private static byte[] CreateColorContent(ImageFormat format, int width, int height)
+            {
+                const int cellSize = 64;
+                switch (format)
+                {
+                    case ImageFormat.ColorBgra32:
+                    {
+                        var content = new byte[width * height * 4];
+                        var i = 0;
+                        for (var y = 0; y < height; y++)
+                        {
+                            for (var x = 0; x < width; x++, i += 4)
+                            {
+                                content[i] = (byte)(255 * x / width);
+                                content[i + 1] = (byte)(255 * y / height);
+                                content[i + 2] = (byte)((x / cellSize + y / cellSize) % 2 == 0 ? 224 : 32);
+                                content[i + 3] = byte.MaxValue;
+                            }
+                        }
+                        return content;
+                    }
+
+                    case ImageFormat.ColorNV12:
+                    {
+                        var content = new byte[width * height * 3 / 2];
+                        var i = 0;
+                        for (var y = 0; y < height; y++)
+                            for (var x = 0; x < width; x++, i++)
+                                content[i] = GetLuma(x, y, width, height, cellSize);
+                        for (; i < content.Length; i++)
+                            content[i] = 128;
+                        return content;
+                    }
+
+                    case ImageFormat.ColorYUY2:
+                    {
+                        var content = new byte[width * height * 2];
+                        var i = 0;
+                        for (var y = 0; y < height; y++)
+                        {
+                            for (var x = 0; x < width; x++, i += 2)
+                            {
+                                content[i] = GetLuma(x, y, width, height, cellSize);
+                                content[i + 1] = 128;
+                            }
+                        }
+                        return content;
+                    }
+
+                    default:
+                        throw new ArgumentException($"There is no procedural content for {format} format. Use {nameof(SyntheticDeviceSettings)}.{nameof(SyntheticDeviceSettings.ColorContent)} to specify content.");
+                }
+            }
+
+            private static byte GetLuma(int x, int y, int width, int height, int cellSize)
+                => (byte)(64 * (x + y) / (width + height) + ((x / cellSize + y / cellSize) % 2 == 0 ? 160 : 32));
+        }
+
+        private sealed class ImuStream
+        {
+            private const int AccelerometerNoiseStream = 10;
+            private const int GyroNoiseStream = 13;
+            private const int TemperatureStream = 16;
+            private const float Gravity = 9.81f;
+            private const float AccelerometerNoise = 0.02f;
+            private const float GyroNoise = 0.002f;
+
+            private readonly bool realTime;
+            private readonly int seed;
+            private readonly Microseconds64 timestampBase;
+
+            public ImuStream(CameraStream cameras, bool realTime, int seed)
+            {
+                this.realTime = realTime;
+                this.seed = seed;
+                StartTicks = Stopwatch.GetTimestamp();
+                // IMU uses the same device clock as cameras
+                timestampBase = cameras.ColorTimestampBase
+                    + (StartTicks - cameras.StartTicks) * 1_000_000 / Stopwatch.Frequency;
+            }
+
+            public long StartTicks { get; }
+
+            public long NextSampleIndex { get; set; }
+
+            public long GetSampleArrivalTicks(long sampleIndex)
+                => realTime
+                    ? StartTicks + (sampleIndex + 1) * Stopwatch.Frequency / ImuSampleRateHz
+                    : long.MinValue;
+
+            public long GetLatestArrivedSampleIndex(long nowTicks)
+                => realTime
+                    ? (nowTicks - StartTicks) * ImuSampleRateHz / Stopwatch.Frequency - 1
+                    : NextSampleIndex;
+
+            // Device is standing still: accelerometer measures gravity only, gyro measures nothing but noise
+            public ImuSample CreateSample(long sampleIndex)
+            {
+                var timestamp = timestampBase + sampleIndex * 1_000_000 / ImuSampleRateHz;
+                return new ImuSample
+                {
+                    Temperature = 30f + (float)Random(seed, TemperatureStream, sampleIndex / ImuSampleRateHz),
+                    AccelerometerSample = new Float3(
+                        Noise(AccelerometerNoiseStream, sampleIndex, AccelerometerNoise),
+                        Noise(AccelerometerNoiseStream + 1, sampleIndex, AccelerometerNoise),
+                        -Gravity + Noise(AccelerometerNoiseStream + 2, sampleIndex, AccelerometerNoise)),
+                    AccelerometerTimestamp = timestamp,
+                    GyroSample = new Float3(
+                        Noise(GyroNoiseStream, sampleIndex, GyroNoise),
+                        Noise(GyroNoiseStream + 1, sampleIndex, GyroNoise),
+                        Noise(GyroNoiseStream + 2, sampleIndex, GyroNoise)),
+                    GyroTimestamp = timestamp,
+                };
+            }
+
+            private float Noise(int stream, long sampleIndex, float amplitude)
+                => (float)((Random(seed, stream, sampleIndex) * 2 - 1) * amplitude);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+﻿using System;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>Settings of <see cref="SyntheticDevice"/>: content of images, timing and injected faults.</summary>
+    /// <remarks>
+    /// Settings are read by <see cref="SyntheticDevice.StartCameras(DeviceConfiguration)"/>,
+    /// thus changes made after start of cameras take effect on the next start.
+    /// </remarks>
+    /// <seealso cref="SyntheticDevice"/>
+    public sealed class SyntheticDeviceSettings
+    {
+        /// <summary>Serial number of device. If <see langword="null"/>, unique serial number is generated.</summary>
+        public string? SerialNumber { get; set; }
+
+        /// <summary>Seed for random generator of jitter, drops and IMU noise. If <see langword="null"/>, seed is derived from serial number.</summary>
+        /// <remarks>Devices with the same seed and settings produce the same sequence of timestamps and drops.</remarks>
+        public int? Seed { get; set; }
+
+        /// <summary>
+        /// <see langword="true"/> (default) - captures and IMU samples become available according to real-time clock, like from real device.
+        /// <see langword="false"/> - next capture and IMU sample are available immediately, which is useful to find throughput limits of pipeline.
+        /// </summary>
+        /// <remarks>Timestamps are generated in the same way in both modes.</remarks>
+        public bool RealTime { get; set; } = true;
+
+        /// <summary>Probability in range [0, 1] of drop of a frame of a camera. Default is zero.</summary>
+        /// <remarks>
+        /// Color and depth cameras drop frames independently of each other.
+        /// If <see cref="DeviceConfiguration.SynchronizedImagesOnly"/> is <see langword="true"/>, capture is dropped if any of its images is dropped.
+        /// Otherwise, capture can contain only some of images.
+        /// Dropped frames are visible as gaps in device timestamps.
+        /// </remarks>
+        public double DropProbability { get; set; }
+
+        /// <summary>Maximum deviation of moment when capture becomes available from its nominal time. Default is zero.</summary>
+        /// <remarks>
+        /// Emulates jitter of USB transfers: it affects system timestamps and moments of availability of captures in <see cref="RealTime"/> mode,
+        /// but not device timestamps which are generated by device clock.
+        /// </remarks>
+        public Microseconds32 Jitter { get; set; }
+
+        /// <summary>Initial value of device timestamps. Default is 200 milliseconds.</summary>
+        public Microseconds64 InitialDeviceTimestamp { get; set; } = Microseconds64.FromMilliseconds(200);
+
+        /// <summary>Number of rows content of images is scrolled by per frame. Default is 2. Zero means static content.</summary>
+        public int ScrollRowsPerFrame { get; set; } = 2;
+
+        /// <summary>
+        /// Raw content of depth images (<see cref="ImageFormat.Depth16"/>, tightly packed) to be used instead of procedural content.
+        /// For example, loaded from file by <see cref="System.IO.File.ReadAllBytes(string)"/>.
+        /// </summary>
+        /// <remarks>Size must correspond to <see cref="DeviceConfiguration.DepthMode"/>.</remarks>
+        public byte[]? DepthContent { get; set; }
+
+        /// <summary>
+        /// Raw content of IR images (<see cref="ImageFormat.IR16"/>, tightly packed) to be used instead of procedural content.
+        /// For example, loaded from file by <see cref="System.IO.File.ReadAllBytes(string)"/>.
+        /// </summary>
+        /// <remarks>Size must correspond to <see cref="DeviceConfiguration.DepthMode"/>.</remarks>
+        public byte[]? IRContent { get; set; }
+
+        /// <summary>
+        /// Raw content of color images in <see cref="DeviceConfiguration.ColorFormat"/> format to be used instead of procedural content.
+        /// For example, loaded from file by <see cref="System.IO.File.ReadAllBytes(string)"/>.
+        /// </summary>
+        /// <remarks>
+        /// For uncompressed formats, size must correspond to <see cref="DeviceConfiguration.ColorResolution"/> (tightly packed rows).
+        /// Required for <see cref="ImageFormat.ColorMjpg"/>, because there is no procedural content in this format.
+        /// </remarks>
+        public byte[]? ColorContent { get; set; }
+
+        /// <summary>Memory allocator for image buffers. If <see langword="null"/>, buffers are allocated by Sensor SDK.</summary>
+        /// <seealso cref="Image(ImageFormat, int, int, int, int, ICustomMemoryAllocator)"/>
+        public ICustomMemoryAllocator? MemoryAllocator { get; set; }
+
+        internal void Validate()
+        {
+            if (double.IsNaN(DropProbability) || DropProbability < 0 || DropProbability > 1)
+                throw new ArgumentOutOfRangeException(nameof(DropProbability));
+            if (Jitter.ValueUsec < 0)
+                throw new ArgumentOutOfRangeException(nameof(Jitter));
+            if (ScrollRowsPerFrame < 0)
+                throw new ArgumentOutOfRangeException(nameof(ScrollRowsPerFrame));
+        }
+    }
+}
@@ -0,0 +1,413 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+using System.Runtime.CompilerServices;
+using System.Runtime.Intrinsics;
+using System.Runtime.Intrinsics.X86;
+
+namespace K4AdotNet.Sensor
+{
+    // Remapping of images using map
+    partial class UndistortionMap
+    {
+        // Number of pixels processed at once by vectorized code
+        private const int BlockSize = 8;
+
+        /// <summary>Remaps image of source camera to image of target pinhole camera.</summary>
+        /// <param name="sourceImage">
+        /// Image of source camera in <see cref="ImageFormat.Depth16"/>, <see cref="ImageFormat.IR16"/> or <see cref="ImageFormat.ColorBgra32"/> format.
+        /// Not <see langword="null"/>. Must have resolution of source camera.
+        /// </param>
+        /// <param name="targetImage">
+        /// Output: undistorted image. Not <see langword="null"/>. Must have the same format as <paramref name="sourceImage"/>
+        /// and resolution of <see cref="Target"/>.
+        /// </param>
+        /// <remarks>
+        /// Depth maps are remapped by nearest neighbor sampling (interpolation between depths of different surfaces produces false points),
+        /// infrared and color images are remapped by bilinear interpolation.
+        /// </remarks>
+        /// <exception cref="ArgumentNullException"><paramref name="sourceImage"/> or <paramref name="targetImage"/> is <see langword="null"/>.</exception>
+        /// <exception cref="ArgumentException">Images have unsupported or different formats or invalid resolution.</exception>
+        /// <exception cref="ObjectDisposedException"><paramref name="sourceImage"/> or <paramref name="targetImage"/> is disposed.</exception>
+        public void Remap(Image sourceImage, Image targetImage)
+        {
+            if (sourceImage is null)
+                throw new ArgumentNullException(nameof(sourceImage));
+            if (targetImage is null)
+                throw new ArgumentNullException(nameof(targetImage));
+            if (targetImage.Format != sourceImage.Format)
+                throw new ArgumentException($"{nameof(targetImage)} must have {sourceImage.Format} format but has {targetImage.Format}.", nameof(targetImage));
+
+            switch (sourceImage.Format)
+            {
+                case ImageFormat.Depth16:
+                    Remap(sourceImage.GetReadOnlyView<short>(), targetImage.GetView<short>(), TransformationInterpolation.Nearest);
+                    break;
+                case ImageFormat.IR16:
+                    Remap(sourceImage.GetReadOnlyView<short>(), targetImage.GetView<short>(), TransformationInterpolation.Linear);
+                    break;
+                case ImageFormat.ColorBgra32:
+                    Remap(sourceImage.GetReadOnlyView<BgraPixel>(), targetImage.GetView<BgraPixel>(), TransformationInterpolation.Linear);
+                    break;
+                default:
+                    throw new ArgumentException($"Unsupported format {sourceImage.Format}.", nameof(sourceImage));
+            }
+        }
+
+        /// <summary>Remaps 16-bit image (depth map or infrared image) of source camera to image of target pinhole camera.</summary>
+        /// <param name="source">Image of source camera (unsigned 16-bit values). Must have resolution of source camera.</param>
+        /// <param name="target">Output: undistorted image, zeros for invalid pixels. Must have resolution of <see cref="Target"/>.</param>
+        /// <param name="interpolation">
+        /// <see cref="TransformationInterpolation.Nearest"/> for depth maps,
+        /// <see cref="TransformationInterpolation.Linear"/> for infrared images.
+        /// </param>
+        /// <remarks>
+        /// Image is processed in horizontal bands on all CPU cores, eight pixels at once using AVX2 instructions if they are supported by CPU.
+        /// </remarks>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="source"/> or <paramref name="target"/> has invalid resolution,
+        /// or <paramref name="source"/> takes more than <see cref="int.MaxValue"/> bytes with its stride.
+        /// </exception>
+        /// <exception cref="ArgumentOutOfRangeException">Unknown <paramref name="interpolation"/>.</exception>
+        public unsafe void Remap(ReadOnlyImageView<short> source, ImageView<short> target, TransformationInterpolation interpolation)
+        {
+            CheckViews(source.WidthPixels, source.HeightPixels, source.StrideBytes, sizeof(short), target.WidthPixels, target.HeightPixels, interpolation);
+
+            var sourceBuffer = source.Buffer;
+            var sourceStrideBytes = source.StrideBytes;
+            var targetBuffer = target.Buffer;
+            var targetStrideBytes = target.StrideBytes;
+            // Four bytes are read per pixel by vectorized nearest sampling, thus the last pixel of source image is read by scalar code
+            var maxGatherOffset = (source.HeightPixels - 1) * sourceStrideBytes + (source.WidthPixels - 2) * sizeof(short);
+            var linear = interpolation == TransformationInterpolation.Linear;
+
+            RemapBands((map, weights, y, width) =>
+            {
+                var dst = (ushort*)((byte*)targetBuffer.ToPointer() + (nint)y * targetStrideBytes);
+                if (linear)
+                    RemapRowLinear16(map, weights, (byte*)sourceBuffer.ToPointer(), sourceStrideBytes, dst, width);
+                else
+                    RemapRowNearest16(map, weights, (byte*)sourceBuffer.ToPointer(), sourceStrideBytes, maxGatherOffset, dst, width);
+            });
+        }
+
+        /// <summary>Remaps color image of source camera to image of target pinhole camera.</summary>
+        /// <param name="source">Image of source camera. Must have resolution of source camera.</param>
+        /// <param name="target">Output: undistorted image, zeros for invalid pixels. Must have resolution of <see cref="Target"/>.</param>
+        /// <param name="interpolation">Nearest neighbor sampling or bilinear interpolation.</param>
+        /// <remarks>
+        /// Image is processed in horizontal bands on all CPU cores, eight pixels at once using AVX2 instructions if they are supported by CPU.
+        /// </remarks>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="source"/> or <paramref name="target"/> has invalid resolution,
+        /// or <paramref name="source"/> takes more than <see cref="int.MaxValue"/> bytes with its stride.
+        /// </exception>
+        /// <exception cref="ArgumentOutOfRangeException">Unknown <paramref name="interpolation"/>.</exception>
+        public unsafe void Remap(ReadOnlyImageView<BgraPixel> source, ImageView<BgraPixel> target, TransformationInterpolation interpolation = TransformationInterpolation.Linear)
+        {
+            CheckViews(source.WidthPixels, source.HeightPixels, source.StrideBytes, sizeof(BgraPixel), target.WidthPixels, target.HeightPixels, interpolation);
+
+            var sourceBuffer = source.Buffer;
+            var sourceStrideBytes = source.StrideBytes;
+            var targetBuffer = target.Buffer;
+            var targetStrideBytes = target.StrideBytes;
+            var linear = interpolation == TransformationInterpolation.Linear;
+
+            RemapBands((map, weights, y, width) =>
+            {
+                var dst = (BgraPixel*)((byte*)targetBuffer.ToPointer() + (nint)y * targetStrideBytes);
+                if (linear)
+                    RemapRowLinear32(map, weights, (byte*)sourceBuffer.ToPointer(), sourceStrideBytes, dst, width);
+                else
+                    RemapRowNearest32(map, weights, (byte*)sourceBuffer.ToPointer(), sourceStrideBytes, dst, width);
+            });
+        }
+
+        private unsafe delegate void RemapRow(int* map, int* weights, int y, int width);
+
+        private unsafe void RemapBands(RemapRow remapRow)
+        {
+            var width = Target.WidthPixels;
+            RowBands.Process(width, Target.HeightPixels, rowAlignment: 1, (firstRow, rowCount) =>
+            {
+                fixed (int* mapPtr = sourcePixels)
+                fixed (int* weightsPtr = weights)
+                {
+                    for (var y = firstRow; y < firstRow + rowCount; y++)
+                        remapRow(mapPtr + (nint)y * width, weightsPtr + (nint)y * width, y, width);
+                }
+
+                return 0;
+            }, out _);
+        }
+
+        private void CheckViews(int sourceWidth, int sourceHeight, int sourceStrideBytes, int pixelSizeBytes,
+            int targetWidth, int targetHeight, TransformationInterpolation interpolation)
+        {
+            CheckViewSize("source", sourceWidth, sourceHeight, CameraCalibration.ResolutionWidth, CameraCalibration.ResolutionHeight);
+            // Vectorized code gathers source pixels by 32-bit byte offsets
+            if ((long)(sourceHeight - 1) * sourceStrideBytes + (long)sourceWidth * pixelSizeBytes > int.MaxValue)
+                throw new ArgumentException($"source with stride of {sourceStrideBytes} bytes is too large: offsets of its pixels do not fit into 32 bits.", "source");
+            CheckViewSize("target", targetWidth, targetHeight, Target.WidthPixels, Target.HeightPixels);
+            if (interpolation != TransformationInterpolation.Nearest && interpolation != TransformationInterpolation.Linear)
+                throw new ArgumentOutOfRangeException(nameof(interpolation));
+        }
+
+        private static void CheckViewSize(string paramName, int widthPixels, int heightPixels, int expectedWidth, int expectedHeight)
+        {
+            if (widthPixels != expectedWidth || heightPixels != expectedHeight)
+                throw new ArgumentException($"{paramName} must have size {expectedWidth}x{expectedHeight} pixels but has {widthPixels}x{heightPixels}.", paramName);
+        }
+
+        #region Row kernels
+
+        private static unsafe void RemapRowNearest16(int* map, int* weights, byte* source, int sourceStrideBytes, int maxGatherOffset, ushort* dst, int width)
+        {
+            var x = Avx2.IsSupported ? RemapRowNearest16Avx2(map, weights, source, sourceStrideBytes, maxGatherOffset, dst, width) : 0;
+            for (; x < width; x++)
+            {
+                var pixel = NearestPixel(map[x], weights[x]);
+                dst[x] = pixel == InvalidPixel ? (ushort)0 : ((ushort*)(source + (nint)(pixel >> 16) * sourceStrideBytes))[pixel & 0xFFFF];
+            }
+        }
+
+        private static unsafe void RemapRowLinear16(int* map, int* weights, byte* source, int sourceStrideBytes, ushort* dst, int width)
+        {
+            var x = Avx2.IsSupported ? RemapRowLinear16Avx2(map, weights, source, sourceStrideBytes, dst, width) : 0;
+            for (; x < width; x++)
+            {
+                var pixel = map[x];
+                if (pixel == InvalidPixel)
+                {
+                    dst[x] = 0;
+                    continue;
+                }
+
+                var top = (ushort*)(source + (nint)(pixel >> 16) * sourceStrideBytes) + (pixel & 0xFFFF);
+                var bottom = (ushort*)((byte*)top + sourceStrideBytes);
+                var wx = (uint)weights[x] & 0xFFFF;
+                var wy = (uint)weights[x] >> 16;
+                dst[x] = (ushort)Lerp2D16(top[0], top[1], bottom[0], bottom[1], wx, wy);
+            }
+        }
+
+        private static unsafe void RemapRowNearest32(int* map, int* weights, byte* source, int sourceStrideBytes, BgraPixel* dst, int width)
+        {
+            var x = Avx2.IsSupported ? RemapRowNearest32Avx2(map, weights, source, sourceStrideBytes, dst, width) : 0;
+            for (; x < width; x++)
+            {
+                var pixel = NearestPixel(map[x], weights[x]);
+                dst[x] = pixel == InvalidPixel ? default : ((BgraPixel*)(source + (nint)(pixel >> 16) * sourceStrideBytes))[pixel & 0xFFFF];
+            }
+        }
+
+        private static unsafe void RemapRowLinear32(int* map, int* weights, byte* source, int sourceStrideBytes, BgraPixel* dst, int width)
+        {
+            var x = Avx2.IsSupported ? RemapRowLinear32Avx2(map, weights, source, sourceStrideBytes, dst, width) : 0;
+            for (; x < width; x++)
+            {
+                var pixel = map[x];
+                if (pixel == InvalidPixel)
+                {
+                    dst[x] = default;
+                    continue;
+                }
+
+                var top = (BgraPixel*)(source + (nint)(pixel >> 16) * sourceStrideBytes) + (pixel & 0xFFFF);
+                var bottom = (BgraPixel*)((byte*)top + sourceStrideBytes);
+                var wx = (uint)weights[x] & 0xFFFF;
+                var wy = (uint)weights[x] >> 16;
+                dst[x] = new(
+                    Lerp2D8(top[0].B, top[1].B, bottom[0].B, bottom[1].B, wx, wy),
+                    Lerp2D8(top[0].G, top[1].G, bottom[0].G, bottom[1].G, wx, wy),
+                    Lerp2D8(top[0].R, top[1].R, bottom[0].R, bottom[1].R, wx, wy),
+                    Lerp2D8(top[0].A, top[1].A, bottom[0].A, bottom[1].A, wx, wy));
+            }
+        }
+
+        // Nearest pixel of 2x2 neighborhood: right (bottom) one if its weight is at least 1/2
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static int NearestPixel(int pixel, int weights)
+            => pixel == InvalidPixel ? InvalidPixel : pixel + (((weights + 0x0080_0080) >> 8) & 0x0001_0001);
+
+        // Weights are in 1/256 units, 16-bit values do not overflow 32-bit unsigned arithmetic
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static uint Lerp2D16(uint v00, uint v10, uint v01, uint v11, uint wx, uint wy)
+        {
+            var top = v00 * (256 - wx) + v10 * wx;
+            var bottom = v01 * (256 - wx) + v11 * wx;
+            return (top * (256 - wy) + bottom * wy + (1u << 15)) >> 16;
+        }
+
+        // 8-bit values are rounded after each step, so that vectorized code can work with 16-bit arithmetic
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static byte Lerp2D8(byte v00, byte v10, byte v01, byte v11, uint wx, uint wy)
+        {
+            var top = (v00 * (256 - wx) + v10 * wx + 128) >> 8;
+            var bottom = (v01 * (256 - wx) + v11 * wx + 128) >> 8;
+            return (byte)((top * (256 - wy) + bottom * wy + 128) >> 8);
+        }
+
+        #endregion
+
+        #region AVX2 implementation of row kernels (returns number of processed pixels of row)
+
+        private static unsafe int RemapRowNearest16Avx2(int* map, int* weights, byte* source, int sourceStrideBytes, int maxGatherOffset, ushort* dst, int width)
+        {
+            var stride = Vector256.Create(sourceStrideBytes);
+            var maxOffset = Vector256.Create(maxGatherOffset);
+            var lowWord = Vector256.Create(0xFFFF);
+
+            var x = 0;
+            for (; x + BlockSize <= width; x += BlockSize)
+            {
+                var pixels = Avx.LoadVector256(map + x);
+                var valid = Avx2.CompareGreaterThan(pixels, Vector256.Create(InvalidPixel));
+                var offsets = OffsetsAvx2(NearestPixelsAvx2(pixels, Avx.LoadVector256(weights + x)), stride, pixelSizeShift: 1);
+                if (Avx2.MoveMask(Avx2.And(Avx2.CompareGreaterThan(offsets, maxOffset), valid).AsByte()) != 0)
+                    break;
+
+                var values = Avx2.And(Avx2.GatherMaskVector256(Vector256<int>.Zero, (int*)source, offsets, valid, 1), lowWord);
+                StoreUInt16Avx2(values, dst + x);
+            }
+
+            return x;
+        }
+
+        private static unsafe int RemapRowLinear16Avx2(int* map, int* weights, byte* source, int sourceStrideBytes, ushort* dst, int width)
+        {
+            var stride = Vector256.Create(sourceStrideBytes);
+            var lowWord = Vector256.Create(0xFFFF);
+
+            var x = 0;
+            for (; x + BlockSize <= width; x += BlockSize)
+            {
+                var pixels = Avx.LoadVector256(map + x);
+                var valid = Avx2.CompareGreaterThan(pixels, Vector256.Create(InvalidPixel));
+                var offsets = OffsetsAvx2(pixels, stride, pixelSizeShift: 1);
+                var w = Avx.LoadVector256(weights + x);
+
+                // Each gather reads two neighboring pixels of row (neighborhood always lies inside of source image)
+                var top = Avx2.GatherMaskVector256(Vector256<int>.Zero, (int*)source, offsets, valid, 1);
+                var bottom = Avx2.GatherMaskVector256(Vector256<int>.Zero, (int*)(source + sourceStrideBytes), offsets, valid, 1);
+                var values = Lerp2D16Avx2(
+                    Avx2.And(top, lowWord), Avx2.ShiftRightLogical(top, 16),
+                    Avx2.And(bottom, lowWord), Avx2.ShiftRightLogical(bottom, 16),
+                    Avx2.And(w, lowWord), Avx2.ShiftRightLogical(w, 16));
+                StoreUInt16Avx2(values, dst + x);
+            }
+
+            return x;
+        }
+
+        private static unsafe int RemapRowNearest32Avx2(int* map, int* weights, byte* source, int sourceStrideBytes, BgraPixel* dst, int width)
+        {
+            var stride = Vector256.Create(sourceStrideBytes);
+
+            var x = 0;
+            for (; x + BlockSize <= width; x += BlockSize)
+            {
+                var pixels = Avx.LoadVector256(map + x);
+                var valid = Avx2.CompareGreaterThan(pixels, Vector256.Create(InvalidPixel));
+                var offsets = OffsetsAvx2(NearestPixelsAvx2(pixels, Avx.LoadVector256(weights + x)), stride, pixelSizeShift: 2);
+                Avx.Store((int*)(dst + x), Avx2.GatherMaskVector256(Vector256<int>.Zero, (int*)source, offsets, valid, 1));
+            }
+
+            return x;
+        }
+
+        private static unsafe int RemapRowLinear32Avx2(int* map, int* weights, byte* source, int sourceStrideBytes, BgraPixel* dst, int width)
+        {
+            var stride = Vector256.Create(sourceStrideBytes);
+            var lowWord = Vector256.Create(0xFFFF);
+
+            var x = 0;
+            for (; x + BlockSize <= width; x += BlockSize)
+            {
+                var pixels = Avx.LoadVector256(map + x);
+                var valid = Avx2.CompareGreaterThan(pixels, Vector256.Create(InvalidPixel));
+                var offsets = OffsetsAvx2(pixels, stride, pixelSizeShift: 2);
+
+                // Weights of pixel are replicated to 16-bit lanes of its four channels
+                var w = Avx.LoadVector256(weights + x);
+                var wx = Avx2.And(w, lowWord);
+                var wy = Avx2.ShiftRightLogical(w, 16);
+                wx = Avx2.Or(wx, Avx2.ShiftLeftLogical(wx, 16));
+                wy = Avx2.Or(wy, Avx2.ShiftLeftLogical(wy, 16));
+
+                var topRow = (int*)source;
+                var bottomRow = (int*)(source + sourceStrideBytes);
+                var p00 = Avx2.GatherMaskVector256(Vector256<int>.Zero, topRow, offsets, valid, 1).AsByte();
+                var p10 = Avx2.GatherMaskVector256(Vector256<int>.Zero, topRow + 1, offsets, valid, 1).AsByte();
+                var p01 = Avx2.GatherMaskVector256(Vector256<int>.Zero, bottomRow, offsets, valid, 1).AsByte();
+                var p11 = Avx2.GatherMaskVector256(Vector256<int>.Zero, bottomRow + 1, offsets, valid, 1).AsByte();
+
+                // Unpacking of bytes to 16-bit lanes: pixels 0, 1, 4, 5 to low part and pixels 2, 3, 6, 7 to high part
+                var zero = Vector256<byte>.Zero;
+                var low = Lerp2D8Avx2(
+                    Avx2.UnpackLow(p00, zero).AsUInt16(), Avx2.UnpackLow(p10, zero).AsUInt16(),
+                    Avx2.UnpackLow(p01, zero).AsUInt16(), Avx2.UnpackLow(p11, zero).AsUInt16(),
+                    Avx2.UnpackLow(wx, wx).AsUInt16(), Avx2.UnpackLow(wy, wy).AsUInt16());
+                var high = Lerp2D8Avx2(
+                    Avx2.UnpackHigh(p00, zero).AsUInt16(), Avx2.UnpackHigh(p10, zero).AsUInt16(),
+                    Avx2.UnpackHigh(p01, zero).AsUInt16(), Avx2.UnpackHigh(p11, zero).AsUInt16(),
+                    Avx2.UnpackHigh(wx, wx).AsUInt16(), Avx2.UnpackHigh(wy, wy).AsUInt16());
+                Avx.Store((byte*)(dst + x), Avx2.PackUnsignedSaturate(low.AsInt16(), high.AsInt16()));
+            }
+
+            return x;
+        }
+
+        // See NearestPixel(), invalid pixels are left as is
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector256<int> NearestPixelsAvx2(Vector256<int> pixels, Vector256<int> weights)
+            => Avx2.Add(pixels, Avx2.And(Avx2.ShiftRightArithmetic(Avx2.Add(weights, Vector256.Create(0x0080_0080)), 8), Vector256.Create(0x0001_0001)));
+
+        // Byte offsets of packed pixels in source image
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector256<int> OffsetsAvx2(Vector256<int> pixels, Vector256<int> stride, byte pixelSizeShift)
+        {
+            var xs = Avx2.And(pixels, Vector256.Create(0xFFFF));
+            var ys = Avx2.ShiftRightLogical(pixels, 16);
+            return Avx2.Add(Avx2.MultiplyLow(ys, stride), Avx2.ShiftLeftLogical(xs, pixelSizeShift));
+        }
+
+        // See Lerp2D16(), products are computed modulo 2^32 and the result is shifted as unsigned
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector256<int> Lerp2D16Avx2(Vector256<int> v00, Vector256<int> v10, Vector256<int> v01, Vector256<int> v11, Vector256<int> wx, Vector256<int> wy)
+        {
+            var one = Vector256.Create(256);
+            var wx1 = Avx2.Subtract(one, wx);
+            var wy1 = Avx2.Subtract(one, wy);
+            var top = Avx2.Add(Avx2.MultiplyLow(v00, wx1), Avx2.MultiplyLow(v10, wx));
+            var bottom = Avx2.Add(Avx2.MultiplyLow(v01, wx1), Avx2.MultiplyLow(v11, wx));
+            var sum = Avx2.Add(Avx2.Add(Avx2.MultiplyLow(top, wy1), Avx2.MultiplyLow(bottom, wy)), Vector256.Create(1 << 15));
+            return Avx2.ShiftRightLogical(sum, 16);
+        }
+
+        // See Lerp2D8(), all intermediate values fit into 16 bits
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static Vector256<ushort> Lerp2D8Avx2(Vector256<ushort> v00, Vector256<ushort> v10, Vector256<ushort> v01, Vector256<ushort> v11, Vector256<ushort> wx, Vector256<ushort> wy)
+        {
+            var one = Vector256.Create((ushort)256);
+            var half = Vector256.Create((ushort)128);
+            var wx1 = Avx2.Subtract(one, wx);
+            var wy1 = Avx2.Subtract(one, wy);
+            var top = Avx2.ShiftRightLogical(Avx2.Add(Avx2.Add(Avx2.MultiplyLow(v00, wx1), Avx2.MultiplyLow(v10, wx)), half), 8);
+            var bottom = Avx2.ShiftRightLogical(Avx2.Add(Avx2.Add(Avx2.MultiplyLow(v01, wx1), Avx2.MultiplyLow(v11, wx)), half), 8);
+            return Avx2.ShiftRightLogical(Avx2.Add(Avx2.Add(Avx2.MultiplyLow(top, wy1), Avx2.MultiplyLow(bottom, wy)), half), 8);
+        }
+
+        // Stores eight 16-bit values from 32-bit lanes
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        private static unsafe void StoreUInt16Avx2(Vector256<int> values, ushort* dst)
+        {
+            var packed = Avx2.PackUnsignedSaturate(values, values);
+            Sse2.Store(dst, Avx2.Permute4x64(packed.AsInt64(), 0b10_00_10_00).AsUInt16().GetLower());
+        }
+
+        #endregion
+    }
+}
+
+#endif
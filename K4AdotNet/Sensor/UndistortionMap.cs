@@ -0,0 +1,191 @@
+﻿#if !(NETSTANDARD2_0 || NET461)
+
+using System;
+
+namespace K4AdotNet.Sensor
+{
+    /// <summary>
+    /// Remap table from images of a real camera (with lens distortion) to images of ideal pinhole camera (without lens distortion).
+    /// For each pixel of pinhole camera, it stores the pixel of source camera from which image is sampled.
+    /// </summary>
+    /// <remarks><para>
+    /// Pixel <c>(u, v)</c> of pinhole camera sees the ray <c>((u - Cx) / Fx, (v - Cy) / Fy, 1)</c>
+    /// (see <see cref="PinholeIntrinsics"/>). This ray is projected to source camera by managed <see cref="CameraModel"/>,
+    /// that is, with exact lens distortion of Sensor SDK. Pixels whose rays are not seen by source camera are invalid and are set to zeros in remapped images.
+    /// </para><para>
+    /// Tables are computed (in parallel) on the first request and cached.
+    /// The cache is keyed by intrinsic calibration data of source camera and by target pinhole intrinsics, thus all consumers working with the same calibration
+    /// share one table. Cached maps stay in memory even if nobody uses them: the cache keeps the most recently requested maps
+    /// up to <see cref="CacheCapacityBytes"/> in total (one map for color camera of the maximum resolution takes about 100 MB).
+    /// Call <see cref="ClearCache"/> to release them.
+    /// </para><para>
+    /// Instances are immutable and thread safe.
+    /// </para></remarks>
+    /// <seealso cref="Calibration.GetUndistortionMap(CalibrationGeometry, in PinholeIntrinsics)"/>
+    public sealed partial class UndistortionMap
+    {
+        // Coordinates are packed into one integer: (y << 16) | x
+        private const int MaxResolution = short.MaxValue;
+        // Vectorized code gathers pixels by 32-bit byte offsets, thus image of the largest pixels (BGRA) must fit into 2 GB
+        private const int MaxPixelSizeBytes = 4;
+        private const int InvalidPixel = -1;
+
+        /// <summary>Total size of maps kept in cache: 256 MB. The most recently requested map is kept even if it is larger.</summary>
+        public const long CacheCapacityBytes = 256L << 20;
+
+        private static readonly CalibrationDataCache<Key, UndistortionMap> cache = new(CacheCapacityBytes,
+            map => ((long)map.sourcePixels.Length + map.weights.Length) * sizeof(int));
+
+        // Top-left pixel of 2x2 neighborhood of source point in source image (packed), or InvalidPixel
+        private readonly int[] sourcePixels;
+        // Weights of right and bottom pixels of neighborhood in 1/256 units (packed)
+        private readonly int[] weights;
+
+        private UndistortionMap(in CameraCalibration cameraCalibration, in PinholeIntrinsics target)
+        {
+            var model = new CameraModel(in cameraCalibration);
+            CameraCalibration = cameraCalibration;
+            Target = target;
+
+            var pixelCount = target.WidthPixels * target.HeightPixels;
+            sourcePixels = new int[pixelCount];
+            weights = new int[pixelCount];
+            ValidCount = Compute(model);
+        }
+
+        /// <summary>Calibration data of source camera (with lens distortion).</summary>
+        public CameraCalibration CameraCalibration { get; }
+
+        /// <summary>Intrinsics of target pinhole camera (without lens distortion). Remapped images have resolution of this camera.</summary>
+        public PinholeIntrinsics Target { get; }
+
+        /// <summary>Number of pixels of target camera which are seen by source camera.</summary>
+        public int ValidCount { get; }
+
+        /// <summary>Is pixel of target camera seen by source camera?</summary>
+        /// <param name="x">Horizontal pixel coordinate in target camera.</param>
+        /// <param name="y">Vertical pixel coordinate in target camera.</param>
+        /// <returns><see langword="true"/> if pixel is valid, <see langword="false"/> if it is set to zero in remapped images.</returns>
+        /// <exception cref="ArgumentOutOfRangeException">Pixel is out of target image.</exception>
+        public bool IsValid(int x, int y)
+        {
+            if ((uint)x >= (uint)Target.WidthPixels)
+                throw new ArgumentOutOfRangeException(nameof(x));
+            if ((uint)y >= (uint)Target.HeightPixels)
+                throw new ArgumentOutOfRangeException(nameof(y));
+            return sourcePixels[y * Target.WidthPixels + x] != InvalidPixel;
+        }
+
+        /// <summary>Returns map for a given camera calibration and target pinhole camera from cache or computes it if there is no such map in cache.</summary>
+        /// <param name="cameraCalibration">Calibration of depth or color camera, for example, <see cref="Calibration.DepthCameraCalibration"/>.</param>
+        /// <param name="target">Intrinsics of target pinhole camera, for example, <see cref="PinholeIntrinsics.FromCameraCalibration(in CameraCalibration)"/>.</param>
+        /// <returns>Map. Not <see langword="null"/>.</returns>
+        /// <exception cref="ArgumentException">
+        /// Resolution of <paramref name="cameraCalibration"/> is invalid,
+        /// lens distortion model of <paramref name="cameraCalibration"/> is not supported by <see cref="CameraModel"/>
+        /// or <paramref name="target"/> is invalid.
+        /// Resolutions for which BGRA image takes more than <see cref="int.MaxValue"/> bytes are not supported.
+        /// </exception>
+        public static UndistortionMap GetOrCreate(in CameraCalibration cameraCalibration, in PinholeIntrinsics target)
+        {
+            if (!IsValidResolution(cameraCalibration.ResolutionWidth, cameraCalibration.ResolutionHeight))
+                throw new ArgumentException("Invalid camera resolution.", nameof(cameraCalibration));
+            if (!CameraModel.IsSupportedModel(cameraCalibration.Intrinsics.Model))
+                throw new ArgumentException($"Unsupported lens distortion model {cameraCalibration.Intrinsics.Model}.", nameof(cameraCalibration));
+            if (!target.IsValid || target.WidthPixels > MaxResolution || target.HeightPixels > MaxResolution || !IsAddressable(target.WidthPixels, target.HeightPixels))
+                throw new ArgumentException($"Invalid pinhole intrinsics {target}.", nameof(target));
+
+            return cache.GetOrAdd(new Key(in cameraCalibration, in target), (cameraCalibration, target),
+                state => new UndistortionMap(in state.cameraCalibration, in state.target));
+        }
+
+        /// <summary>Removes all maps from cache. Maps are garbage collected when nobody references them, requested maps are computed again.</summary>
+        public static void ClearCache()
+            => cache.Clear();
+
+        // Bilinear interpolation needs 2x2 neighborhood, coordinates are packed into 16 bits
+        private static bool IsValidResolution(int widthPixels, int heightPixels)
+            => widthPixels >= 2 && heightPixels >= 2 && widthPixels <= MaxResolution && heightPixels <= MaxResolution
+                && IsAddressable(widthPixels, heightPixels);
+
+        private static bool IsAddressable(int widthPixels, int heightPixels)
+            => (long)widthPixels * heightPixels * MaxPixelSizeBytes <= int.MaxValue;
+
+        private int Compute(CameraModel model)
+        {
+            var validCounts = RowBands.Process(Target.WidthPixels, Target.HeightPixels, rowAlignment: 1, (firstRow, rowCount) => ComputeBand(model, firstRow, rowCount), out _);
+
+            var validCount = 0;
+            foreach (var count in validCounts)
+                validCount += count;
+            return validCount;
+        }
+
+        private int ComputeBand(CameraModel model, int firstRow, int rowCount)
+        {
+            var target = Target;
+            var width = target.WidthPixels;
+            var sourceWidth = CameraCalibration.ResolutionWidth;
+            var sourceHeight = CameraCalibration.ResolutionHeight;
+            var rays = new Float3[width];
+            var points2D = new Float2[width];
+            var validFlags = new bool[width];
+
+            var validCount = 0;
+            for (var y = firstRow; y < firstRow + rowCount; y++)
+            {
+                var rayY = (y - target.Cy) / target.Fy;
+                for (var x = 0; x < width; x++)
+                    rays[x] = new((x - target.Cx) / target.Fx, rayY, 1f);
+                model.Project(rays, points2D, validFlags);
+
+                var rowOffset = y * width;
+                for (var x = 0; x < width; x++)
+                {
+                    var point = points2D[x];
+                    // Pixel centers have integer coordinates, thus image covers [-0.5, width - 0.5) x [-0.5, height - 0.5)
+                    if (!validFlags[x] || !(point.X >= -0.5f && point.X < sourceWidth - 0.5f && point.Y >= -0.5f && point.Y < sourceHeight - 0.5f))
+                    {
+                        sourcePixels[rowOffset + x] = InvalidPixel;
+                        weights[rowOffset + x] = 0;
+                        continue;
+                    }
+
+                    // Neighborhood is shifted inside of image at borders, thus the weight of right (bottom) pixel can be 256
+                    var u = Math.Clamp(point.X, 0f, sourceWidth - 1);
+                    var v = Math.Clamp(point.Y, 0f, sourceHeight - 1);
+                    var x0 = Math.Min((int)u, sourceWidth - 2);
+                    var y0 = Math.Min((int)v, sourceHeight - 2);
+                    var wx = (int)((u - x0) * 256f);
+                    var wy = (int)((v - y0) * 256f);
+                    sourcePixels[rowOffset + x] = (y0 << 16) | x0;
+                    weights[rowOffset + x] = (wy << 16) | wx;
+                    validCount++;
+                }
+            }
+
+            return validCount;
+        }
+
+        // Maps depend only on intrinsics, resolution and metric radius of source camera and on target intrinsics
+        private readonly struct Key
+        {
+            private readonly CalibrationIntrinsics intrinsics;
+            private readonly int resolutionWidth;
+            private readonly int resolutionHeight;
+            private readonly float metricRadius;
+            private readonly PinholeIntrinsics target;
+
+            public Key(in CameraCalibration cameraCalibration, in PinholeIntrinsics target)
+            {
+                intrinsics = cameraCalibration.Intrinsics;
+                resolutionWidth = cameraCalibration.ResolutionWidth;
+                resolutionHeight = cameraCalibration.ResolutionHeight;
+                metricRadius = cameraCalibration.MetricRadius;
+                this.target = target;
+            }
+        }
+    }
+}
+
+#endif